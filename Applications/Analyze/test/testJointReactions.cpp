@@ -42,6 +42,17 @@ int main()
         Storage result2("DoublePendulum3D_JointReaction_ReactionLoads.sto"), standard2("std_DoublePendulum3D_JointReaction_ReactionLoads.sto");
         CHECK_STORAGE_AGAINST_STANDARD(result2, standard2, Array<double>(1e-5, 24), __FILE__, __LINE__, "DoublePendulum3D failed");
         cout << "DoublePendulum3D passed" << endl;
+
+        // Analyzing the frames in parallel must not change the results.
+        AnalyzeTool analyze3("DoublePendulum3D_Setup_JointReaction.xml");
+        analyze3.setName("DoublePendulum3D_parallel");
+        analyze3.setNumThreads(4);
+        analyze3.run();
+        Storage result3("DoublePendulum3D_parallel_JointReaction_ReactionLoads.sto");
+        ASSERT(result3.getSize() == result2.getSize(), __FILE__, __LINE__,
+            "Parallel analysis recorded a different number of frames.");
+        CHECK_STORAGE_AGAINST_STANDARD(result3, result2, Array<double>(1e-10, 24), __FILE__, __LINE__, "DoublePendulum3D parallel failed");
+        cout << "DoublePendulum3D parallel passed" << endl;
     }
     catch (const Exception& e) {
         e.print(cerr);
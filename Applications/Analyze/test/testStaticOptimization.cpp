@@ -25,7 +25,11 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Tools/AnalyzeTool.h>
 #include <OpenSim/Analyses/StaticOptimization.h>
+#include <OpenSim/Analyses/StaticOptimizationTarget.h>
+#include <OpenSim/Actuators/CoordinateActuator.h>
+#include <OpenSim/Actuators/PointActuator.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <ctime>
 
 using namespace OpenSim;
 using namespace std;
@@ -42,6 +46,8 @@ void testLapackErrorDLASD4();
 
 void testModelWithPassiveForces();
 
+void testAnalyticConstraintMatrix(const string& modelFile);
+
 int main()
 {
     Array<string> muscleModelNames;
@@ -77,6 +83,15 @@ int main()
         failures.push_back("testModelWithPassiveForces");
     }
     
+    try {
+        testAnalyticConstraintMatrix("arm26.osim");
+        testAnalyticConstraintMatrix("subject01_simbody.osim");
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testAnalyticConstraintMatrix");
+    }
+
     try {
         testLapackErrorDLASD4();
     }
@@ -200,6 +215,100 @@ void testModelWithPassiveForces() {
 
 }
 
+// Compare the constraint matrix built from the equations of motion against
+// the one obtained by perturbing each actuator and realizing to acceleration,
+// and report the per-frame cost of each.
+void testAnalyticConstraintMatrix(const string& modelFile)
+{
+    Model model(modelFile);
+    // Exercise the coordinate actuator path and the perturbation fallback
+    // alongside the model's muscles.
+    const Coordinate& firstCoord = model.getCoordinateSet().get(0);
+    CoordinateActuator* coordAct = new CoordinateActuator(firstCoord.getName());
+    coordAct->setName("reserve_" + firstCoord.getName());
+    coordAct->setOptimalForce(10.0);
+    model.addForce(coordAct);
+    const string bodyName = 
+        model.getBodySet().get(model.getBodySet().getSize()-1).getName();
+    PointActuator* pointAct = new PointActuator(bodyName);
+    pointAct->setName("point_" + bodyName);
+    pointAct->setOptimalForce(10.0);
+    model.addForce(pointAct);
+
+    SimTK::State& s = model.initSystem();
+    const CoordinateSet& coords = model.getCoordinateSet();
+    Array<int> accelerationIndices;
+    for (int i = 0; i < coords.getSize(); ++i) {
+        if (!coords[i].isConstrained(s)) {
+            coords[i].setSpeedValue(s, 0.1*(i+1));
+            accelerationIndices.append(i);
+        }
+    }
+    model.getMultibodySystem().realize(s, SimTK::Stage::Velocity);
+
+    // Target speeds held constant; only their derivatives (zero) are used.
+    Array<string> labels;
+    labels.append("time");
+    for (int i = 0; i < coords.getSize(); ++i)
+        labels.append(coords[i].getSpeedName());
+    Storage statesStore;
+    statesStore.setColumnLabels(labels);
+    SimTK::Vector speeds(coords.getSize());
+    for (int i = 0; i < coords.getSize(); ++i)
+        speeds[i] = coords[i].getSpeedValue(s);
+    for (int i = 0; i < 10; ++i)
+        statesStore.append(0.1*i, speeds);
+    GCVSplineSet statesSplineSet(5, &statesStore);
+
+    model.setAllControllersEnabled(false);
+    int na = model.getActuators().getSize();
+    int nacc = accelerationIndices.getSize();
+    StaticOptimizationTarget target(s, &model, na, nacc);
+    target.setStatesStore(&statesStore);
+    target.setStatesSplineSet(statesSplineSet);
+    SimTK::Vector parameters(na, 0.0);
+
+    const int nFrames = 20;
+    ASSERT(target.getUseAnalyticConstraintMatrix());
+    clock_t startTime = clock();
+    for (int i = 0; i < nFrames; ++i) {
+        model.getMultibodySystem().realize(s, SimTK::Stage::Velocity);
+        target.prepareToOptimize(s, &parameters[0]);
+    }
+    double analyticTime = 1.0e3*(clock()-startTime)/CLOCKS_PER_SEC/nFrames;
+    SimTK::Matrix analytic = target.getConstraintMatrix();
+    SimTK::Vector analyticConstant = target.getConstraintVector();
+
+    target.setUseAnalyticConstraintMatrix(false);
+    startTime = clock();
+    for (int i = 0; i < nFrames; ++i) {
+        model.getMultibodySystem().realize(s, SimTK::Stage::Velocity);
+        target.prepareToOptimize(s, &parameters[0]);
+    }
+    double perturbedTime = 1.0e3*(clock()-startTime)/CLOCKS_PER_SEC/nFrames;
+    const SimTK::Matrix& perturbed = target.getConstraintMatrix();
+
+    ASSERT(analytic.nrow() == nacc && analytic.ncol() == na,
+        __FILE__, __LINE__, "Constraint matrix has the wrong dimensions.");
+    for (int c = 0; c < nacc; ++c) {
+        ASSERT_EQUAL(target.getConstraintVector()[c], analyticConstant[c],
+            1e-10*std::max(1.0, std::abs(analyticConstant[c])),
+            __FILE__, __LINE__, "Constant constraint vector changed.");
+        for (int p = 0; p < na; ++p) {
+            ASSERT_EQUAL(perturbed(c,p), analytic(c,p),
+                1e-8*std::max(1.0, std::abs(perturbed(c,p))),
+                __FILE__, __LINE__,
+                "Analytic constraint matrix does not match perturbation.");
+        }
+    }
+
+    cout << modelFile << ": " << na << " actuators, " << nacc
+         << " accelerations. Constraint matrix per frame: analytic "
+         << analyticTime << "ms, perturbation " << perturbedTime
+         << "ms (speedup " << perturbedTime/std::max(analyticTime, 1e-6)
+         << "x)." << endl;
+}
+
 void testLapackErrorDLASD4() {
     // With OpenSim 3.2 64bit, the 64 bit lapack library (in Simbody 3.3.1) 
     // crashes with an error[1] if there are not enough actuators (or under 
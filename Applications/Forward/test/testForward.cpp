@@ -29,6 +29,7 @@
 #include <OpenSim/Tools/ForwardTool.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include "SimTKmath.h"
+#include <ctime>
 
 using namespace OpenSim;
 using namespace std;
@@ -39,6 +40,7 @@ void testPendulumExternalLoadWithPointInGround(); // test application of externa
 void testArm26();       // now add computation of controls and generation of muscle forces
 void testGait2354();    // controlled muscles and ground reactions forces 
 void testGait2354WithController(); // included additional controller
+void testArm26Batch();  // many perturbed simulations on several threads
 
 int main() {
     Object::renameType("Thelen2003Muscle", "Thelen2003Muscle_Deprecated");
@@ -80,6 +82,12 @@ int main() {
     catch (const std::exception& e)
         { cout << e.what() <<endl; failures.push_back("testGait2354WithController"); }  
 
+    // run perturbed copies of arm26 in batches
+    try { testArm26Batch(); 
+        cout << "\narm26 batch test PASSED " << endl; }
+    catch (const std::exception& e)
+        { cout << e.what() <<endl; failures.push_back("testArm26Batch"); }  
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -241,3 +249,80 @@ void testGait2354WithController() {
     
     CHECK_STORAGE_AGAINST_STANDARD(results, *standard, rms_tols, __FILE__, __LINE__, "testGait2354WithController failed");
 }
+
+void testArm26Batch() {
+    ForwardTool forward("arm26_Setup_Forward.xml");
+    forward.run();
+    Storage serial("Results/arm26_states.sto");
+
+    string elbowAngle;
+    Array<string> stateNames = forward.getModel().getStateVariableNames();
+    for (int i = 0; i < stateNames.getSize(); ++i) {
+        if (stateNames[i].find("r_elbow_flex") != string::npos &&
+                stateNames[i].find("speed") == string::npos)
+            elbowAngle = stateNames[i];
+    }
+    ASSERT(!elbowAngle.empty(), __FILE__, __LINE__, 
+        "arm26 has no elbow angle state.");
+
+    // A case without changes reproduces the serial simulation, and one that
+    // weakens the triceps ends elsewhere.
+    vector<ForwardCase> cases(2);
+    cases[0].name = "unchanged";
+    cases[1].name = "weak_triceps";
+    cases[1].propertyValues["TRIlong/max_isometric_force"] = "100";
+    ASSERT(forward.runBatch(cases, 2) == 2, __FILE__, __LINE__,
+        "Batch of arm26 cases did not complete.");
+
+    Storage unchanged("Results/arm26_unchanged_states.sto");
+    Storage weak("Results/arm26_weak_triceps_states.sto");
+    ASSERT(unchanged.getSize() == serial.getSize(), __FILE__, __LINE__,
+        "Unchanged case took different steps than the serial simulation.");
+    const Array<double>& expected = serial.getLastStateVector()->getData();
+    const Array<double>& found = unchanged.getLastStateVector()->getData();
+    double difference = 0;
+    for (int j = 0; j < expected.getSize(); ++j) {
+        ASSERT_EQUAL(expected[j], found[j], 1e-6, __FILE__, __LINE__,
+            "Unchanged case differs from the serial simulation.");
+        difference += fabs(weak.getLastStateVector()->getData()[j] - found[j]);
+    }
+    ASSERT(difference > 1e-6, __FILE__, __LINE__,
+        "Weakening the triceps did not change the simulation.");
+
+    // Sweep the initial elbow angle on 1 to 4 threads; the combined results
+    // must not depend on the number of threads.
+    cases.resize(16);
+    for (int i = 0; i < (int)cases.size(); ++i) {
+        cases[i] = ForwardCase();
+        cases[i].name = "elbow" + to_string(i);
+        cases[i].stateValues[elbowAngle] = 0.1 + 0.1*i;
+    }
+    Storage* reference = nullptr;
+    for (int numThreads = 1; numThreads <= 4; ++numThreads) {
+        std::clock_t start = std::clock();
+        SimTK::Real wallStart = SimTK::realTime();
+        int numCompleted = forward.runBatch(cases, numThreads, true);
+        cout << cases.size() << " arm26 cases on " << numThreads 
+             << " thread(s): " << SimTK::realTime() - wallStart 
+             << " s elapsed, " 
+             << double(std::clock() - start)/CLOCKS_PER_SEC << " s CPU." 
+             << endl;
+        ASSERT(numCompleted == (int)cases.size(), __FILE__, __LINE__,
+            "Batch of arm26 cases did not complete.");
+
+        Storage* combined = new Storage("Results/arm26_batch_states.sto");
+        ASSERT(combined->getSize() == (int)cases.size(), __FILE__, __LINE__,
+            "Combined results should have one row per case.");
+        if (!reference) { reference = combined; continue; }
+        for (int i = 0; i < combined->getSize(); ++i) {
+            const Array<double>& row = combined->getStateVector(i)->getData();
+            const Array<double>& refRow = 
+                reference->getStateVector(i)->getData();
+            for (int j = 0; j < row.getSize(); ++j)
+                ASSERT_EQUAL(refRow[j], row[j], 1e-10, __FILE__, __LINE__,
+                    "Results depend on the number of threads.");
+        }
+        delete combined;
+    }
+    delete reference;
+}
@@ -27,15 +27,50 @@
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/ForceSet.h>
+#include <OpenSim/Simulation/InverseDynamicsSolver.h>
+#include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Tools/InverseDynamicsTool.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
 using namespace OpenSim;
 using namespace std;
 
+// Solving with a GCVSplineSet, whose splines are evaluated all at once, must
+// agree with solving with the same splines in a plain FunctionSet.
+void testSolveWithSplineSet()
+{
+    Model model("arm26.osim");
+    SimTK::State& s = model.initSystem();
+    const int nq = model.getNumCoordinates();
+    InverseDynamicsSolver solver(model);
+
+    // The gait coordinates are more than the arm has.
+    Storage coordinates("subject01_walk1_ik.mot");
+    GCVSplineSet splines(5, &coordinates);
+    ASSERT(splines.getSize() > nq);
+    const double time = 0.5*(coordinates.getFirstTime() 
+                             + coordinates.getLastTime());
+    ASSERT_THROW(Exception, solver.solve(s, splines, time));
+
+    splines.setSize(nq);
+    FunctionSet functions;
+    for (int i = 0; i < nq; ++i)
+        functions.cloneAndAppend(splines[i]);
+
+    SimTK::Vector fromSplineSet = solver.solve(s, splines, time);
+    SimTK::Vector fromFunctionSet = solver.solve(s, functions, time);
+    ASSERT(fromSplineSet.size() == nq);
+    for (int i = 0; i < nq; ++i)
+        ASSERT_EQUAL(fromFunctionSet[i], fromSplineSet[i], 1e-10, 
+                     __FILE__, __LINE__, "Generalized forces do not match.");
+    cout << "testSolveWithSplineSet passed" << endl;
+}
+
 int main()
 {
     try {
+        testSolveWithSplineSet();
+
         InverseDynamicsTool id1("arm26_Setup_InverseDynamics.xml");
         id1.run();
         Storage result1("Results/arm26_InverseDynamics.sto"), standard1("std_arm26_InverseDynamics.sto");
@@ -43,6 +43,16 @@ int main()
         CHECK_STORAGE_AGAINST_STANDARD(result1, standard, Array<double>(0.2, 24), __FILE__, __LINE__, "testInverseKinematicsGait2354 failed");
         cout << "testInverseKinematicsGait2354 passed" << endl;
 
+        // Solving chunks of frames concurrently must reproduce the serial
+        // solution to within the accuracy of the assembler.
+        InverseKinematicsTool ikParallel("subject01_Setup_InverseKinematics.xml");
+        ikParallel.setNumThreads(4);
+        ikParallel.setOutputMotionFileName("subject01_walk1_ik_parallel.mot");
+        ikParallel.run();
+        Storage resultParallel(ikParallel.getOutputMotionFileName());
+        CHECK_STORAGE_AGAINST_STANDARD(resultParallel, result1, Array<double>(0.01, 24), __FILE__, __LINE__, "testInverseKinematicsGait2354 with 4 threads failed");
+        cout << "testInverseKinematicsGait2354 with 4 threads passed" << endl;
+
         InverseKinematicsTool ik2("subject01_Setup_InverseKinematics_NoModel.xml");
         Model mdl("subject01_simbody.osim");
         mdl.initSystem();
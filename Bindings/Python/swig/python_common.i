@@ -20,6 +20,14 @@ using namespace SimTK;
 
 %include "python_preliminaries.i"
 
+// NumPy
+// =====
+// Storage data can be exchanged with NumPy arrays (see below).
+%include "numpy.i"
+%init %{
+    import_array();
+%}
+
 // Tell SWIG about the simbody module.
 %import "python_simbody.i"
 
@@ -155,7 +163,52 @@ care of deleting it.
 // ====================
 //%include <OpenSim/Common/LoadOpenSimLibrary.h>
 
-// %include "numpy.i"
+// Storage and NumPy
+// =================
+// A Storage keeps each row in its own StateVector, so its data cannot be
+// viewed as a NumPy array. Instead, the data are copied to and from NumPy
+// arrays in a single call, straight from and to the rows.
+%apply (double* IN_ARRAY1, int DIM1) {(double* time, int numTimes)};
+%apply (double* IN_ARRAY2, int DIM1, int DIM2)
+        {(double* data, int numRows, int numColumns)};
+
+%extend OpenSim::Storage {
+    /** Append one row per entry of time; row i of data holds the states at
+    time[i]. */
+    void appendFromNumPy(double* time, int numTimes,
+                         double* data, int numRows, int numColumns) {
+        if (numTimes != numRows)
+            throw OpenSim::Exception("Storage.appendFromNumPy: time has " +
+                    std::to_string(numTimes) + " entries but data has " +
+                    std::to_string(numRows) + " rows.", __FILE__, __LINE__);
+        $self->appendRows(numRows, time, numColumns, data);
+    }
+    /** A new NumPy array with the time of each row. */
+    PyObject* getTimeAsNumPy() {
+        npy_intp dims[1] = {$self->getSize()};
+        PyObject* array = PyArray_SimpleNew(1, dims, NPY_DOUBLE);
+        if (array != NULL && dims[0] > 0) {
+            double* times = (double*)PyArray_DATA((PyArrayObject*)array);
+            $self->getTimeColumn(times);
+        }
+        return array;
+    }
+    /** A new NumPy array with a row for each row of this Storage and a column
+    for each state present in every row (see getSmallestNumberOfStates()). */
+    PyObject* getDataAsNumPy() {
+        const int numRows = $self->getSize();
+        const int numColumns = 
+                numRows > 0 ? $self->getSmallestNumberOfStates() : 0;
+        npy_intp dims[2] = {numRows, numColumns};
+        // Row-major, so that each row is a single block copy.
+        PyObject* array = PyArray_SimpleNew(2, dims, NPY_DOUBLE);
+        if (array == NULL) return NULL;
+        double* values = (double*)PyArray_DATA((PyArrayObject*)array);
+        for (int i = 0; i < numRows; ++i)
+            $self->getData(i, numColumns, values + (size_t)i*numColumns);
+        return array;
+    }
+};
 
 // Pythonic operators
 // ==================
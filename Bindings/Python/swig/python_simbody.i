@@ -19,6 +19,14 @@ using namespace SimTK;
 
 %include "python_preliminaries.i"
 
+// NumPy
+// =====
+// Vector and Matrix can be viewed as NumPy arrays (see below).
+%include "numpy.i"
+%init %{
+    import_array();
+%}
+
 
 // Relay exceptions to the target language.
 // This causes substantial code bloat and possibly hurts performance.
@@ -149,3 +157,125 @@ These typemaps work, though.
     }
 };
 
+// NumPy views
+// ===========
+// getNumPyView() and updNumPyView() return NumPy arrays that share the
+// elements of a Vector or Matrix instead of copying them; the first is
+// read-only, the second writable. A view keeps the Python object it was
+// taken from alive, but it is invalidated if the Vector or Matrix is resized,
+// and it does not keep alive an object owned by C++ (e.g., the Vector returned
+// by State.getQ()). np.asarray() gives a read-only view as well.
+// createFromNumPy() copies a NumPy array into a new Vector or Matrix in a
+// single call.
+%{
+// Wrap numElements[d] doubles along each of the ndim dimensions, starting at
+// data and stride[d] doubles apart, in a NumPy array whose base is owner.
+static PyObject* OpenSimCreateNumPyView(PyObject* owner, double* data,
+        int ndim, const int* numElements, const ptrdiff_t* stride,
+        bool writable) {
+    npy_intp dims[2], strides[2];
+    for (int d = 0; d < ndim; ++d) {
+        dims[d] = numElements[d];
+        strides[d] = stride[d] * (npy_intp)sizeof(double);
+    }
+    const int flags = NPY_ARRAY_ALIGNED | (writable ? NPY_ARRAY_WRITEABLE : 0);
+    PyObject* array = PyArray_New(&PyArray_Type, ndim, dims, NPY_DOUBLE,
+                                  strides, data, 0, flags, NULL);
+    if (array == NULL) return NULL;
+    Py_INCREF(owner);
+    if (PyArray_SetBaseObject((PyArrayObject*)array, owner) < 0) {
+        Py_DECREF(array);
+        return NULL;
+    }
+    return array;
+}
+%}
+
+%apply (double* IN_ARRAY1, int DIM1) {(double* data, int size)};
+%apply (double* IN_ARRAY2, int DIM1, int DIM2)
+        {(double* data, int nrow, int ncol)};
+%newobject SimTK::Vector_<double>::createFromNumPy;
+%newobject SimTK::Matrix_<double>::createFromNumPy;
+
+%extend SimTK::Vector_<double> {
+    PyObject* _createNumPyView(PyObject* owner, bool writable) {
+        const int n = $self->size();
+        if (n == 0) {
+            npy_intp dims[1] = {0};
+            return PyArray_SimpleNew(1, dims, NPY_DOUBLE);
+        }
+        double* data = &(*$self)[0];
+        const ptrdiff_t stride = n > 1 ? &(*$self)[1] - data : 1;
+        // Every element must lie on the same stride for NumPy.
+        if (&(*$self)[n - 1] - data != (n - 1) * stride)
+            throw std::runtime_error("This Vector's elements are not evenly "
+                    "spaced in memory, so it cannot be viewed as a NumPy "
+                    "array; copy it into a Vector first.");
+        return OpenSimCreateNumPyView(owner, data, 1, &n, &stride, writable);
+    }
+    static SimTK::Vector_<double>* createFromNumPy(double* data, int size) {
+        return new SimTK::Vector_<double>(size, data);
+    }
+%pythoncode %{
+    def getNumPyView(self):
+        """A read-only NumPy array that shares the elements of this Vector."""
+        return self._createNumPyView(self, False)
+
+    def updNumPyView(self):
+        """A writable NumPy array that shares the elements of this Vector."""
+        return self._createNumPyView(self, True)
+
+    def __array__(self, dtype=None, copy=None):
+        view = self.getNumPyView()
+        if dtype is None or view.dtype == dtype:
+            return view.copy() if copy else view
+        if copy is False:
+            raise ValueError("Converting this %s to %s requires a copy."
+                             % (type(self).__name__, dtype))
+        return view.astype(dtype)
+%}
+};
+
+%extend SimTK::Matrix_<double> {
+    PyObject* _createNumPyView(PyObject* owner, bool writable) {
+        const int size[2] = {$self->nrow(), $self->ncol()};
+        if (size[0] == 0 || size[1] == 0) {
+            npy_intp dims[2] = {size[0], size[1]};
+            return PyArray_SimpleNew(2, dims, NPY_DOUBLE);
+        }
+        double* data = &$self->updElt(0, 0);
+        const ptrdiff_t stride[2] = {
+            size[0] > 1 ? &$self->updElt(1, 0) - data : 1,
+            size[1] > 1 ? &$self->updElt(0, 1) - data : 1};
+        const ptrdiff_t last = &$self->updElt(size[0] - 1, size[1] - 1) - data;
+        if (last != (size[0] - 1) * stride[0] + (size[1] - 1) * stride[1])
+            throw std::runtime_error("This Matrix's elements are not evenly "
+                    "spaced in memory, so it cannot be viewed as a NumPy "
+                    "array; copy it into a Matrix first.");
+        return OpenSimCreateNumPyView(owner, data, 2, size, stride, writable);
+    }
+    static SimTK::Matrix_<double>* createFromNumPy(double* data,
+                                                   int nrow, int ncol) {
+        // NumPy passes the rows one after another.
+        return new SimTK::Matrix_<double>(nrow, ncol, data);
+    }
+%pythoncode %{
+    def getNumPyView(self):
+        """A read-only NumPy array that shares the elements of this Matrix."""
+        return self._createNumPyView(self, False)
+
+    def updNumPyView(self):
+        """A writable NumPy array that shares the elements of this Matrix."""
+        return self._createNumPyView(self, True)
+
+    def __array__(self, dtype=None, copy=None):
+        view = self.getNumPyView()
+        if dtype is None or view.dtype == dtype:
+            return view.copy() if copy else view
+        if copy is False:
+            raise ValueError("Converting this %s to %s requires a copy."
+                             % (type(self).__name__, dtype))
+        return view.astype(dtype)
+%}
+};
+
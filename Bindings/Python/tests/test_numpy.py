@@ -0,0 +1,117 @@
+"""Tests for sharing data between OpenSim and NumPy arrays.
+
+"""
+
+import time
+import unittest
+
+import numpy as np
+
+import opensim as osim
+
+class TestNumPyViews(unittest.TestCase):
+    def test_Vector(self):
+        v = osim.Vector(5, 0.0)
+
+        # A writable view and the Vector alias each other.
+        view = v.updNumPyView()
+        self.assertEqual(view.shape, (5,))
+        view[2] = 3.5
+        assert v.get(2) == 3.5
+        v.set(4, -1.0)
+        assert view[4] == -1.0
+
+        # A read-only view cannot be written to, but it sees changes made
+        # through the Vector.
+        readOnly = v.getNumPyView()
+        with self.assertRaises(ValueError):
+            readOnly[0] = 1.0
+        v.set(0, 2.0)
+        assert readOnly[0] == 2.0
+        assert np.asarray(v)[2] == 3.5
+
+        # np.array() copies rather than aliasing the Vector.
+        c = np.array(v)
+        assert not np.shares_memory(c, view)
+        c[2] = 0.0
+        assert v.get(2) == 3.5
+        assert not np.shares_memory(np.array(v, dtype=np.float32), view)
+        with self.assertRaises(ValueError):
+            v.__array__(np.float32, copy=False)
+
+        # The view keeps the Vector alive.
+        del v
+        assert view[2] == 3.5
+
+        # createFromNumPy() copies.
+        a = np.arange(4.0)
+        w = osim.Vector.createFromNumPy(a)
+        a[0] = 10.0
+        assert w.size() == 4
+        assert w.get(0) == 0.0 and w.get(3) == 3.0
+
+        assert osim.Vector().getNumPyView().shape == (0,)
+
+    def test_Matrix(self):
+        a = np.arange(12.0).reshape(3, 4)
+        m = osim.Matrix.createFromNumPy(a)
+        assert m.nrow() == 3 and m.ncol() == 4
+        for i in range(3):
+            for j in range(4):
+                assert m.get(i, j) == a[i, j]
+
+        view = m.updNumPyView()
+        np.testing.assert_array_equal(view, a)
+        view[1, 2] = -5.0
+        assert m.get(1, 2) == -5.0
+        m.set(2, 3, 7.0)
+        assert view[2, 3] == 7.0
+        assert m.getNumPyView()[1, 2] == -5.0
+        with self.assertRaises(ValueError):
+            m.getNumPyView()[0, 0] = 1.0
+
+        # np.array() copies rather than aliasing the Matrix.
+        c = np.array(m)
+        assert not np.shares_memory(c, view)
+        c[1, 2] = 0.0
+        assert m.get(1, 2) == -5.0
+
+    def test_Storage(self):
+        numRows = 100000
+        numColumns = 300
+        t = np.linspace(0, 1, numRows)
+        data = np.random.rand(numRows, numColumns)
+
+        start = time.time()
+        storage = osim.Storage()
+        storage.appendFromNumPy(t, data)
+        appendTime = time.time() - start
+        assert storage.getSize() == numRows
+
+        start = time.time()
+        copy = storage.getDataAsNumPy()
+        bulkTime = time.time() - start
+        np.testing.assert_array_equal(copy, data)
+        np.testing.assert_array_equal(storage.getTimeAsNumPy(), t)
+
+        # The arrays are copies.
+        copy[0, 0] = -1.0
+        assert storage.getStateVector(0).getData().get(0) == data[0, 0]
+
+        with self.assertRaises(RuntimeError):
+            storage.appendFromNumPy(t[:10], data[:5])
+
+        # Reading every element through the StateVectors is slow, so only
+        # time a subset of the rows.
+        numTimedRows = 1000
+        start = time.time()
+        for i in range(numTimedRows):
+            row = storage.getStateVector(i).getData()
+            for j in range(numColumns):
+                row.get(j)
+        elementTime = (time.time() - start) * numRows / numTimedRows
+
+        print('Storage %i x %i: appendFromNumPy %f s, getDataAsNumPy %f s, '
+              'element by element %f s (estimated)' % (numRows, numColumns,
+                  appendTime, bulkTime, elementTime))
+        assert bulkTime < elementTime
@@ -79,6 +79,7 @@ void ActiveForceLengthCurve::constructProperties()
     constructProperty_max_norm_active_fiber_length(1.8123);
     constructProperty_shallow_ascending_slope(0.8616);
     constructProperty_minimum_value(0.1);
+    constructProperty_fast_evaluator_tolerance();
 }
 
 void ActiveForceLengthCurve::buildCurve()
@@ -86,6 +87,9 @@ void ActiveForceLengthCurve::buildCurve()
     SimTK::Function* f = createSimTKFunction();
     m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
     delete f;
+    if(getFastEvaluatorTolerance() > 0) {
+        m_curve.buildFastEvaluator(getFastEvaluatorTolerance());
+    }
     setObjectIsUpToDateWithProperties();
 }
 
@@ -96,6 +100,19 @@ void ActiveForceLengthCurve::ensureCurveUpToDate()
     }
 }
 
+void ActiveForceLengthCurve::setFastEvaluatorTolerance(double tolerance)
+{
+    SmoothSegmentedFunction::setFastEvaluatorTolerance(
+        updProperty_fast_evaluator_tolerance(), tolerance);
+    ensureCurveUpToDate();
+}
+
+double ActiveForceLengthCurve::getFastEvaluatorTolerance() const
+{
+    return SmoothSegmentedFunction::getFastEvaluatorTolerance(
+        getProperty_fast_evaluator_tolerance());
+}
+
 //==============================================================================
 // OpenSim::Function Interface
 //==============================================================================
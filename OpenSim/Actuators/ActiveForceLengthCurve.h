@@ -129,6 +129,8 @@ public:
         "Slope of the shallow ascending limb");
     OpenSim_DECLARE_PROPERTY(minimum_value, double,
         "Minimum value of the active-force-length curve");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(fast_evaluator_tolerance, double,
+        "If set, the curve is evaluated with polynomials fit to it within this tolerance");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -201,6 +203,14 @@ public:
     */
     void setMinValue(double minimumValue);
 
+    /** Evaluate the curve with polynomials fit to it within the given
+    tolerance, or with the Bezier curve itself if the tolerance is 0; see
+    SmoothSegmentedFunction::buildFastEvaluator(). */
+    void setFastEvaluatorTolerance(double tolerance);
+
+    /** @returns The tolerance of the fast evaluator, or 0 if it is off. */
+    double getFastEvaluatorTolerance() const;
+
     /** Implement the generic OpenSim::Function interface **/
     double calcValue(const SimTK::Vector& x) const override
     {
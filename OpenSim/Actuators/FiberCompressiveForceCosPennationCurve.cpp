@@ -82,6 +82,7 @@ void FiberCompressiveForceCosPennationCurve::constructProperties()
     constructProperty_stiffness_at_perpendicular();
     constructProperty_curviness();
 
+    constructProperty_fast_evaluator_tolerance();
 }
 
 
@@ -99,6 +100,9 @@ void FiberCompressiveForceCosPennationCurve::buildCurve( bool computeIntegral )
     
     delete f;  
        
+    if(getFastEvaluatorTolerance() > 0) {
+        m_curve.buildFastEvaluator(getFastEvaluatorTolerance());
+    }
     setObjectIsUpToDateWithProperties();
 }
 
@@ -165,6 +169,19 @@ void FiberCompressiveForceCosPennationCurve::ensureCurveUpToDate()
     m_curve.setName(name);
 }
 
+void FiberCompressiveForceCosPennationCurve::setFastEvaluatorTolerance(double tolerance)
+{
+    SmoothSegmentedFunction::setFastEvaluatorTolerance(
+        updProperty_fast_evaluator_tolerance(), tolerance);
+    ensureCurveUpToDate();
+}
+
+double FiberCompressiveForceCosPennationCurve::getFastEvaluatorTolerance() const
+{
+    return SmoothSegmentedFunction::getFastEvaluatorTolerance(
+        getProperty_fast_evaluator_tolerance());
+}
+
 SimTK::Function* FiberCompressiveForceCosPennationCurve::createSimTKFunction() const
 {
     // back the OpenSim::Function with this SimTK::Function 
@@ -84,6 +84,8 @@ public:
         "Stiffness of the curve at pennation angle of 90 degrees");
     OpenSim_DECLARE_OPTIONAL_PROPERTY(curviness, double, 
         "Fiber curve bend, from linear to maximum bend (0-1)");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(fast_evaluator_tolerance, double,
+        "If set, the curve is evaluated with polynomials fit to it within this tolerance");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -302,6 +304,14 @@ public:
     double calcValue(double cosPennationAngle) const;
 
 
+    /** Evaluate the curve with polynomials fit to it within the given
+    tolerance, or with the Bezier curve itself if the tolerance is 0; see
+    SmoothSegmentedFunction::buildFastEvaluator(). */
+    void setFastEvaluatorTolerance(double tolerance);
+
+    /** @returns The tolerance of the fast evaluator, or 0 if it is off. */
+    double getFastEvaluatorTolerance() const;
+
     /** Implement the generic OpenSim::Function interface **/
     double calcValue(const SimTK::Vector& x) const override
     {
@@ -71,6 +71,7 @@ void FiberCompressiveForceLengthCurve::constructProperties()
     constructProperty_norm_length_at_zero_force(0.5);
     constructProperty_stiffness_at_zero_length();
     constructProperty_curviness();
+    constructProperty_fast_evaluator_tolerance();
 }
 
 
@@ -88,6 +89,9 @@ void FiberCompressiveForceLengthCurve::buildCurve( bool computeIntegral )
 
     delete f; 
 
+    if(getFastEvaluatorTolerance() > 0) {
+        m_curve.buildFastEvaluator(getFastEvaluatorTolerance());
+    }
     setObjectIsUpToDateWithProperties();
 }
 
@@ -151,6 +155,19 @@ void FiberCompressiveForceLengthCurve::ensureCurveUpToDate()
     m_curve.setName(name);
 }
 
+void FiberCompressiveForceLengthCurve::setFastEvaluatorTolerance(double tolerance)
+{
+    SmoothSegmentedFunction::setFastEvaluatorTolerance(
+        updProperty_fast_evaluator_tolerance(), tolerance);
+    ensureCurveUpToDate();
+}
+
+double FiberCompressiveForceLengthCurve::getFastEvaluatorTolerance() const
+{
+    return SmoothSegmentedFunction::getFastEvaluatorTolerance(
+        getProperty_fast_evaluator_tolerance());
+}
+
 
 //=============================================================================
 //  OpenSim::Function Interface
@@ -76,6 +76,7 @@ void FiberForceLengthCurve::constructProperties()
     constructProperty_stiffness_at_low_force();
     constructProperty_stiffness_at_one_norm_force();
     constructProperty_curviness();
+    constructProperty_fast_evaluator_tolerance();
 }
 
 void FiberForceLengthCurve::buildCurve(bool computeIntegral)
@@ -93,6 +94,9 @@ void FiberForceLengthCurve::buildCurve(bool computeIntegral)
     m_curve = *f;
     delete f;
 
+    if(getFastEvaluatorTolerance() > 0) {
+        m_curve.buildFastEvaluator(getFastEvaluatorTolerance());
+    }
     setObjectIsUpToDateWithProperties();
 }
 
@@ -158,6 +162,19 @@ void FiberForceLengthCurve::ensureCurveUpToDate()
     buildCurve();
 }
 
+void FiberForceLengthCurve::setFastEvaluatorTolerance(double tolerance)
+{
+    SmoothSegmentedFunction::setFastEvaluatorTolerance(
+        updProperty_fast_evaluator_tolerance(), tolerance);
+    ensureCurveUpToDate();
+}
+
+double FiberForceLengthCurve::getFastEvaluatorTolerance() const
+{
+    return SmoothSegmentedFunction::getFastEvaluatorTolerance(
+        getProperty_fast_evaluator_tolerance());
+}
+
 //==============================================================================
 // OpenSim::Function Interface
 //==============================================================================
@@ -174,6 +174,8 @@ public:
         "Fiber stiffness at a tension of 1 normalized force");
     OpenSim_DECLARE_OPTIONAL_PROPERTY(curviness, double,
         "Fiber curve bend, from linear (0) to maximum bend (1)");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(fast_evaluator_tolerance, double,
+        "If set, the curve is evaluated with polynomials fit to it within this tolerance");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -271,6 +273,14 @@ public:
                                double stiffnessAtOneNormForce,
                                double curviness);
 
+    /** Evaluate the curve with polynomials fit to it within the given
+    tolerance, or with the Bezier curve itself if the tolerance is 0; see
+    SmoothSegmentedFunction::buildFastEvaluator(). */
+    void setFastEvaluatorTolerance(double tolerance);
+
+    /** @returns The tolerance of the fast evaluator, or 0 if it is off. */
+    double getFastEvaluatorTolerance() const;
+
     /** Implement the generic OpenSim::Function interface **/
     double calcValue(const SimTK::Vector& x) const override
     {
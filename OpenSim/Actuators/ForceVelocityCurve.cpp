@@ -81,6 +81,7 @@ void ForceVelocityCurve::constructProperties()
     constructProperty_max_eccentric_velocity_force_multiplier(1.4);
     constructProperty_concentric_curviness(0.6);
     constructProperty_eccentric_curviness(0.9);
+    constructProperty_fast_evaluator_tolerance();
 }
 
 void ForceVelocityCurve::buildCurve()
@@ -88,6 +89,9 @@ void ForceVelocityCurve::buildCurve()
     SimTK::Function* f = createSimTKFunction();
     m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
     delete f;
+    if(getFastEvaluatorTolerance() > 0) {
+        m_curve.buildFastEvaluator(getFastEvaluatorTolerance());
+    }
     setObjectIsUpToDateWithProperties();
 }
 
@@ -98,6 +102,19 @@ void ForceVelocityCurve::ensureCurveUpToDate()
     }
 }
 
+void ForceVelocityCurve::setFastEvaluatorTolerance(double tolerance)
+{
+    SmoothSegmentedFunction::setFastEvaluatorTolerance(
+        updProperty_fast_evaluator_tolerance(), tolerance);
+    ensureCurveUpToDate();
+}
+
+double ForceVelocityCurve::getFastEvaluatorTolerance() const
+{
+    return SmoothSegmentedFunction::getFastEvaluatorTolerance(
+        getProperty_fast_evaluator_tolerance());
+}
+
 //==============================================================================
 // OpenSim::Function Interface
 //==============================================================================
@@ -160,6 +160,8 @@ public:
         "Concentric curve shape, from linear (0) to maximal curve (1)");
     OpenSim_DECLARE_PROPERTY(eccentric_curviness, double,
         "Eccentric curve shape, from linear (0) to maximal curve (1)");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(fast_evaluator_tolerance, double,
+        "If set, the curve is evaluated with polynomials fit to it within this tolerance");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -297,6 +299,14 @@ public:
     */
     void setEccentricCurviness(double aEccentricCurviness);
 
+    /** Evaluate the curve with polynomials fit to it within the given
+    tolerance, or with the Bezier curve itself if the tolerance is 0; see
+    SmoothSegmentedFunction::buildFastEvaluator(). */
+    void setFastEvaluatorTolerance(double tolerance);
+
+    /** @returns The tolerance of the fast evaluator, or 0 if it is off. */
+    double getFastEvaluatorTolerance() const;
+
     /** Implement the generic OpenSim::Function interface **/
     double calcValue(const SimTK::Vector& x) const override
     {
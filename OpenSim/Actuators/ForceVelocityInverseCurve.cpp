@@ -82,6 +82,7 @@ void ForceVelocityInverseCurve::constructProperties()
     constructProperty_max_eccentric_velocity_force_multiplier(1.4);
     constructProperty_concentric_curviness(0.6);
     constructProperty_eccentric_curviness(0.9);
+    constructProperty_fast_evaluator_tolerance();
 }
 
 void ForceVelocityInverseCurve::buildCurve()
@@ -89,6 +90,9 @@ void ForceVelocityInverseCurve::buildCurve()
     SimTK::Function* f = createSimTKFunction();
     m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
     delete f;
+    if(getFastEvaluatorTolerance() > 0) {
+        m_curve.buildFastEvaluator(getFastEvaluatorTolerance());
+    }
     setObjectIsUpToDateWithProperties();
 }
 
@@ -99,6 +103,19 @@ void ForceVelocityInverseCurve::ensureCurveUpToDate()
     }
 }
 
+void ForceVelocityInverseCurve::setFastEvaluatorTolerance(double tolerance)
+{
+    SmoothSegmentedFunction::setFastEvaluatorTolerance(
+        updProperty_fast_evaluator_tolerance(), tolerance);
+    ensureCurveUpToDate();
+}
+
+double ForceVelocityInverseCurve::getFastEvaluatorTolerance() const
+{
+    return SmoothSegmentedFunction::getFastEvaluatorTolerance(
+        getProperty_fast_evaluator_tolerance());
+}
+
 //==============================================================================
 // OpenSim::Function Interface
 //==============================================================================
@@ -88,6 +88,7 @@ void TendonForceLengthCurve::constructProperties()
     constructProperty_stiffness_at_one_norm_force();
     constructProperty_norm_force_at_toe_end();
     constructProperty_curviness();
+    constructProperty_fast_evaluator_tolerance();
 }
 
 void TendonForceLengthCurve::buildCurve(bool computeIntegral)
@@ -101,6 +102,9 @@ void TendonForceLengthCurve::buildCurve(bool computeIntegral)
                                      getName());
     m_curve = *f;
     delete f;
+    if(getFastEvaluatorTolerance() > 0) {
+        m_curve.buildFastEvaluator(getFastEvaluatorTolerance());
+    }
     setObjectIsUpToDateWithProperties();
 }
 
@@ -155,6 +159,19 @@ void TendonForceLengthCurve::ensureCurveUpToDate()
     buildCurve();
 }
 
+void TendonForceLengthCurve::setFastEvaluatorTolerance(double tolerance)
+{
+    SmoothSegmentedFunction::setFastEvaluatorTolerance(
+        updProperty_fast_evaluator_tolerance(), tolerance);
+    ensureCurveUpToDate();
+}
+
+double TendonForceLengthCurve::getFastEvaluatorTolerance() const
+{
+    return SmoothSegmentedFunction::getFastEvaluatorTolerance(
+        getProperty_fast_evaluator_tolerance());
+}
+
 //==============================================================================
 // GET AND SET METHODS
 //==============================================================================
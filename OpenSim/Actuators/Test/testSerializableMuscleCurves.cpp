@@ -253,6 +253,32 @@ void testActiveForceLengthCurve()
             fname.append(".csv");
             remove(fname.c_str());
 
+        cout <<"    e. setFastEvaluatorTolerance" << endl;
+            ActiveForceLengthCurve falCurveFast(falCurve4);
+            SimTK_TEST(falCurveFast.getFastEvaluatorTolerance() == 0);
+            falCurveFast.setFastEvaluatorTolerance(1e-9);
+            SimTK_TEST(falCurveFast.getFastEvaluatorTolerance() == 1e-9);
+            for(int i=0; i <= 100; i++){
+                double x = 0.4 + 1.5*i/100.0;
+                for(int order=0; order <= 2; order++){
+                    double d = falCurve4.calcDerivative(x,order);
+                    SimTK_TEST_EQ_TOL(falCurveFast.calcDerivative(x,order),
+                                      d, 1e-8);
+                }
+            }
+            falCurveFast.print("fast_ActiveForceLengthCurve.xml");
+            tmpObj = Object::
+                       makeObjectFromFile("fast_ActiveForceLengthCurve.xml");
+            ActiveForceLengthCurve falCurveRead = 
+                       *dynamic_cast<ActiveForceLengthCurve*>(tmpObj);
+            delete tmpObj;
+            remove("fast_ActiveForceLengthCurve.xml");
+            falCurveRead.ensureCurveUpToDate();
+            SimTK_TEST(falCurveRead.getFastEvaluatorTolerance() == 1e-9);
+            falCurveFast.setFastEvaluatorTolerance(0);
+            SimTK_TEST(falCurveFast.getFastEvaluatorTolerance() == 0);
+            SimTK_TEST_MUST_THROW(falCurveFast.setFastEvaluatorTolerance(-1));
+
         cout << "Passed: Testing Services for connectivity" << endl;                            
 
         //cout <<"**************************************************"<<endl;
@@ -492,7 +492,7 @@ void Thelen2003Muscle::calcMuscleLengthInfo(const SimTK::State& s,
 
         //Clamp the minimum fiber length to its minimum physical value.
         mli.fiberLength  = get_MuscleFixedWidthPennationModel().clampFiberLength(
-                                getStateVariableValue(s, STATE_FIBER_LENGTH_NAME));
+                                getStateVariableValue(s, _fiberLengthSV));
 
         mli.normFiberLength = mli.fiberLength/optFiberLength;       
         mli.pennationAngle  = get_MuscleFixedWidthPennationModel()
@@ -581,7 +581,7 @@ void Thelen2003Muscle::calcFiberVelocityInfo(const SimTK::State& s,
 
         //clamp activation to a legal range
         double a = get_MuscleFirstOrderActivationDynamicModel()
-            .clampActivation(getStateVariableValue(s, STATE_ACTIVATION_NAME));
+            .clampActivation(getStateVariableValue(s, _activationSV));
    
 
         double lce  = mli.fiberLength;   
@@ -725,7 +725,7 @@ void Thelen2003Muscle::calcMuscleDynamicsInfo(const SimTK::State& s,
 
         //1. Get fiber/tendon kinematic information
         double a = get_MuscleFirstOrderActivationDynamicModel()
-            .clampActivation(getStateVariableValue(s, STATE_ACTIVATION_NAME));
+            .clampActivation(getStateVariableValue(s, _activationSV));
 
         double lce      = mli.fiberLength;
         double fiberStateClamped = mvi.userDefinedVelocityExtras[1];
@@ -866,7 +866,7 @@ bool Thelen2003Muscle::
 
     //Is the fiber length  clamped and it is shortening, then the fiber length
     //not valid
-    if( (getStateVariableValue(s, STATE_FIBER_LENGTH_NAME) 
+    if( (getStateVariableValue(s, _fiberLengthSV) 
             <= getMinimumFiberLength())
         && dlceN <= 0){
         clamped = true;
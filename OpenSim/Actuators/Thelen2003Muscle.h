@@ -219,6 +219,12 @@ public:
         Part of the Muscle.h interface
     */
     void computeInitialFiberEquilibrium(SimTK::State& s) const override;
+
+    /** The curves of a Thelen2003Muscle are evaluated from its properties and
+    its activation and pennation models, so it can be computed concurrently
+    with other Forces. Subclasses must opt in themselves. */
+    bool canBeComputedConcurrently() const override
+    {   return getConcreteClassName() == "Thelen2003Muscle"; }
        
     ///@cond TO BE DEPRECATED. 
     /*  Once the ignore_tendon_compliance flag is implemented correctly get rid 
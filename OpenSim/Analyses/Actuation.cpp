@@ -192,6 +192,9 @@ void Actuation::setModel(Model& aModel)
 void Actuation::
 allocateStorage()
 {
+    // Forget any past storages; the list does not own them.
+    _storageList.setSize(0);
+
     // ACCELERATIONS
     _forceStore = new Storage(1000, "ActuatorForces");
     _forceStore->setDescription(getDescription());
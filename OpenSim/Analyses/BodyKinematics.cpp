@@ -251,20 +251,26 @@ constructColumnLabels()
 void BodyKinematics::
 allocateStorage()
 {
+    // Forget any past storages; the list does not own them.
+    _storageList.setSize(0);
+
     // ACCELERATIONS
     _aStore = new Storage(1000,"Accelerations");
     _aStore->setDescription(getDescription());
     _aStore->setColumnLabels(getColumnLabels());
+    _storageList.append(_aStore);
 
     // VELOCITIES
     _vStore = new Storage(1000,"Velocities");
     _vStore->setDescription(getDescription());
     _vStore->setColumnLabels(getColumnLabels());
+    _storageList.append(_vStore);
 
     // POSITIONS
     _pStore = new Storage(1000,"Positions");
     _pStore->setDescription(getDescription());
     _pStore->setColumnLabels(getColumnLabels());
+    _storageList.append(_pStore);
 }
 
 
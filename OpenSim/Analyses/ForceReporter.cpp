@@ -163,6 +163,7 @@ void ForceReporter::allocateStorage()
     // ACCELERATIONS
     _forceStore.setDescription(getDescription());
     // Keep references o all storages in a list for uniform access from GUI
+    _storageList.setSize(0);
     _storageList.append(&_forceStore);
     _storageList.setMemoryOwner(false);
 }
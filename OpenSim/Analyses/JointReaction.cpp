@@ -400,6 +400,7 @@ constructColumnLabels()
 void JointReaction::loadForcesFromFile()
 {
     delete _storeActuation; _storeActuation = NULL;
+    _storeActuationCursor.reset();
     // check if the forces storage file name is valid and, if so, load the file into storage
     if(_forcesFileNameProp.isValidFileName()) {
         
@@ -463,6 +464,8 @@ setupStorage()
     _storeReactionLoads.setName("Joint Reaction Loads");
     _storeReactionLoads.setDescription(getDescription());
     _storeReactionLoads.setColumnLabels(getColumnLabels());
+    _storageList.setSize(0);
+    _storageList.append(&_storeReactionLoads);
 
     // Actuator forces - if a forces file is specified, load the forces storage data to _storeActuation
     if(!(_forcesFileName == "")) loadForcesFromFile();
@@ -531,7 +534,8 @@ record(const SimTK::State& s)
         const Set<Actuator> *actuatorSet = &_model->getActuators();
         int nA = actuatorSet->getSize();
         Array<double> forces(0,nA);
-        _storeActuation->getDataAtTime(s.getTime(),nA,forces);
+        _storeActuation->getDataAtTime(_storeActuationCursor,s.getTime(),nA,
+            forces);
         int storageIndex = -1;
         for(int actuatorIndex=0;actuatorIndex<nA;actuatorIndex++)
         {
@@ -118,6 +118,10 @@ protected:
     /** Storage for holding actuator forces IF SPECIFIED by user.*/
     Storage *_storeActuation;
 
+    /** Where the previous lookup in _storeActuation left off; record() is
+    called with increasing times, so this makes each lookup O(1).*/
+    Storage::InterpolationCursor _storeActuationCursor;
+
     /** Storage for recording joint Reaction loads.*/
     Storage _storeReactionLoads;
 
@@ -196,6 +200,7 @@ public:
         step( const SimTK::State& s, int setNumber ) override;
     int
         end( SimTK::State& s ) override;
+    bool isFrameIndependent() const override { return true; }
 
 
     //-------------------------------------------------------------------------
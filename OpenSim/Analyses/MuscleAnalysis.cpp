@@ -435,6 +435,7 @@ MuscleAnalysis& MuscleAnalysis::operator=(const MuscleAnalysis &aAnalysis)
 void MuscleAnalysis::setModel(Model& aModel)
 {
     Super::setModel(aModel);
+    _maSolver.reset();
     allocateStorageObjects();
 }
 //_____________________________________________________________________________
@@ -646,24 +647,34 @@ int MuscleAnalysis::record(const SimTK::State& s)
     _musclePowerStore->append(tReal,muscPower.getSize(),&muscPower[0]);
 
     if (_computeMoments){
+        int nq = _momentArmStorageArray.getSize();
+
+        // Solve for the moment-arms of all muscles about all coordinates in
+        // one pass rather than one coordinate and muscle at a time.
+        SimTK::Array_<const GeometryPath*> paths(nm);
+        for(int j=0; j<nm; j++)
+            paths[j] = &_muscleArray[j]->getGeometryPath();
+        SimTK::Array_<const Coordinate*> coords(nq);
+        for(int i=0; i<nq; i++)
+            coords[i] = _momentArmStorageArray[i]->q;
+
+        if (!_maSolver)
+            _maSolver.reset(new MomentArmSolver(*_model));
+
+        _model->getMultibodySystem().realize(s, s.getSystemStage());
+        SimTK::Matrix maMatrix = _maSolver->solveMatrix(s, paths, coords);
+
         // LOOP OVER ACTIVE MOMENT ARM STORAGE OBJECTS
-        Coordinate *q = NULL;
         Storage *maStore=NULL, *mStore=NULL;
-        int nq = _momentArmStorageArray.getSize();
         Array<double> ma(0.0,nm),m(0.0,nm);
 
         for(int i=0; i<nq; i++) {
-
-            q = _momentArmStorageArray[i]->q;
             maStore = _momentArmStorageArray[i]->momentArmStore;
             mStore = _momentArmStorageArray[i]->momentStore;
-           
-            bool locked = q->getLocked(s);
 
-            _model->getMultibodySystem().realize(s, s.getSystemStage());
             // LOOP OVER MUSCLES
             for(int j=0; j<nm; j++) {
-                ma[j] = _muscleArray[j]->computeMomentArm(s,*q);
+                ma[j] = maMatrix(i, j);
                 m[j] = ma[j] * force[j];
             }
             maStore->append(s.getTime(),nm,&ma[0]);
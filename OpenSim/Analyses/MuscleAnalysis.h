@@ -141,6 +141,10 @@ private:
     /** Array of active muscles. */
     ArrayPtrs<Muscle> _muscleArray;
 
+    /** Solver for the moment-arms of all muscles about all coordinates. 
+        Cleared on copy and whenever the model changes. */
+    SimTK::ResetOnCopy<std::unique_ptr<MomentArmSolver> > _maSolver;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -230,6 +234,7 @@ public:
         step(const SimTK::State& s, int setNumber ) override;
     int
         end( SimTK::State& s ) override;
+    bool isFrameIndependent() const override { return true; }
 protected:
     virtual int
         record(const SimTK::State& s );
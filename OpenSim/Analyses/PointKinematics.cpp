@@ -263,20 +263,26 @@ constructColumnLabels()
 void PointKinematics::
 allocateStorage()
 {
+    // Forget any past storages; the list does not own them.
+    _storageList.setSize(0);
+
     // ACCELERATIONS
     _aStore = new Storage(1000,"PointAcceleration");
     _aStore->setDescription(getDescription());
     _aStore->setColumnLabels(getColumnLabels());
+    _storageList.append(_aStore);
 
     // VELOCITIES
     _vStore = new Storage(1000,"PointVelocity");
     _vStore->setDescription(getDescription());
     _vStore->setColumnLabels(getColumnLabels());
+    _storageList.append(_vStore);
 
     // POSITIONS
     _pStore = new Storage(1000,"PointPosition");
     _pStore->setDescription(getDescription());
     _pStore->setColumnLabels(getColumnLabels());
+    _storageList.append(_pStore);
 }
 
 
@@ -142,6 +142,7 @@ setupStorage()
     // ACCELERATIONS
     _statesStore.setDescription(getDescription());
     // Keep references o all storages in a list for uniform access from GUI
+    _storageList.setSize(0);
     _storageList.append(&_statesStore);
     _storageList.setMemoryOwner(false);
 }
@@ -105,6 +105,7 @@ public:
         step(const SimTK::State& s, int setNumber ) override;
     int
         end(SimTK::State& s ) override;
+    bool isFrameIndependent() const override { return true; }
 protected:
     virtual int
         record(const SimTK::State& s );
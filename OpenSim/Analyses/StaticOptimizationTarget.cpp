@@ -35,6 +35,8 @@
 #include <OpenSim/Simulation/Model/ActivationFiberLengthMuscle.h>
 #include <OpenSim/Simulation/Model/ForceSet.h>
 #include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
+#include <OpenSim/Simulation/Model/PathActuator.h>
+#include <OpenSim/Actuators/CoordinateActuator.h>
 #include "StaticOptimizationTarget.h"
 #include <iostream>
 
@@ -79,6 +81,8 @@ StaticOptimizationTarget(const SimTK::State& s, Model *aModel,int aNP,int aNC, b
     setActivationExponent(2.0);
     computeActuatorAreas(s);
 
+    _useAnalyticConstraintMatrix = true;
+
     // Gather indices into speed set corresponding to the unconstrained degrees of freedom (for which we will set acceleration constraints)
     _accelerationIndices.setSize(0);
     const CoordinateSet& coordSet = _model->getCoordinateSet();
@@ -136,17 +140,117 @@ prepareToOptimize(SimTK::State& s, double *x)
     pVector = 0;
     computeConstraintVector(s, pVector,_constraintVector);
 
-    for(int p=0; p<np; p++) {
-        pVector[p] = 1;
-        computeConstraintVector(s, pVector, cVector);
-        for(int c=0; c<nc; c++) _constraintMatrix(c,p) = (cVector[c] - _constraintVector[c]);
-        pVector[p] = 0;
+    if(_useAnalyticConstraintMatrix) {
+        computeConstraintMatrix(s);
+    } else {
+        for(int p=0; p<np; p++) {
+            pVector[p] = 1;
+            computeConstraintVector(s, pVector, cVector);
+            for(int c=0; c<nc; c++) _constraintMatrix(c,p) = (cVector[c] - _constraintVector[c]);
+            pVector[p] = 0;
+        }
     }
 #endif
 
     // return false to indicate that we still need to proceed with optimization
     return false;
 }
+//______________________________________________________________________________
+/**
+ * Compute the linear constraint matrix directly from the equations of motion.
+ *
+ * The accelerations are affine in the applied forces, so the column for a
+ * parameter is the change in udot caused by applying that actuator's optimal
+ * force alone. For path actuators (including muscles) and coordinate
+ * actuators, the equivalent body and mobility forces are available without
+ * realizing the system, so each column costs one constrained forward dynamics
+ * solve (SimbodyMatterSubsystem::calcAcceleration) against the already
+ * realized state. Any other actuator falls back to perturbing its parameter
+ * and realizing the system to Stage::Acceleration.
+ *
+ * The state must be realized to Stage::Acceleration with all parameters
+ * set to zero, as is done when computing the constant constraint vector.
+ */
+void StaticOptimizationTarget::
+computeConstraintMatrix(SimTK::State& s)
+{
+    int np = getNumParameters();
+    int nc = getNumConstraints();
+
+    const SimTK::SimbodyMatterSubsystem& matter = _model->getMatterSubsystem();
+    const ForceSet& fSet = _model->getForceSet();
+
+    const SimTK::SpatialVec zeroSpatialVec(SimTK::Vec3(0), SimTK::Vec3(0));
+    Vector mobilityForces(s.getNU(), 0.0);
+    SimTK::Vector_<SimTK::SpatialVec> bodyForces(matter.getNumBodies(),
+                                                 zeroSpatialVec);
+    SimTK::Vector_<SimTK::SpatialVec> A_GB;
+    Vector udot;
+
+    // Accelerations due to velocity and constraint terms alone; these are
+    // common to every column and are subtracted out below.
+    Vector udotBias;
+    matter.calcAcceleration(s, mobilityForces, bodyForces, udotBias, A_GB);
+
+    Array<int> perturbedParameters;
+    for(int i=0, p=0; i<fSet.getSize(); i++) {
+        ScalarActuator* act = dynamic_cast<ScalarActuator*>(&fSet.get(i));
+        if(!act) continue;
+
+        if(act->isDisabled(s)) {
+            // A disabled actuator does not contribute any acceleration.
+            for(int c=0; c<nc; c++) _constraintMatrix(c,p) = 0;
+            p++;
+            continue;
+        }
+
+        bool applied = false;
+        const PathActuator* pathAct = dynamic_cast<const PathActuator*>(act);
+        const CoordinateActuator* coordAct =
+            dynamic_cast<const CoordinateActuator*>(act);
+        // Only muscles and plain path and coordinate actuators are known to
+        // apply the overridden actuation along their path or coordinate.
+        // Other subclasses may compute their force differently (e.g.,
+        // McKibbenActuator ignores the override) and are perturbed below.
+        if(pathAct && (dynamic_cast<const Muscle*>(act) ||
+                       act->getConcreteClassName() == "PathActuator")) {
+            pathAct->getGeometryPath().addInEquivalentForces(s,
+                _optimalForce[p], bodyForces, mobilityForces);
+            applied = true;
+        } else if(coordAct && coordAct->getCoordinate() &&
+                  act->getConcreteClassName() == "CoordinateActuator") {
+            const Coordinate& coord = *coordAct->getCoordinate();
+            matter.addInMobilityForce(s, coord.getBodyIndex(),
+                SimTK::MobilizerUIndex(coord.getMobilizerQIndex()),
+                _optimalForce[p], mobilityForces);
+            applied = true;
+        }
+
+        if(applied) {
+            matter.calcAcceleration(s, mobilityForces, bodyForces, udot, A_GB);
+            for(int c=0; c<nc; c++) {
+                int ind = _accelerationIndices[c];
+                // constraint = target - actual acceleration
+                _constraintMatrix(c,p) = udotBias[ind] - udot[ind];
+            }
+            mobilityForces = 0;
+            bodyForces = zeroSpatialVec;
+        } else {
+            perturbedParameters.append(p);
+        }
+        p++;
+    }
+
+    // Remaining actuators require a full realization per parameter.
+    Vector pVector(np, 0.0), cVector(nc);
+    for(int i=0; i<perturbedParameters.getSize(); i++) {
+        int p = perturbedParameters[i];
+        pVector[p] = 1;
+        computeConstraintVector(s, pVector, cVector);
+        for(int c=0; c<nc; c++) _constraintMatrix(c,p) = (cVector[c] - _constraintVector[c]);
+        pVector[p] = 0;
+    }
+}
 //==============================================================================
 // SET AND GET
 //==============================================================================
@@ -65,6 +65,9 @@ private:
     
     SimTK::Matrix _constraintMatrix;
     SimTK::Vector _constraintVector;
+    /** Build the constraint matrix from the equations of motion rather
+    than by perturbing each parameter. */
+    bool _useAnalyticConstraintMatrix;
 
     const Storage *_statesStore;
     GCVSplineSet _statesSplineSet;
@@ -97,6 +100,15 @@ public:
     double getActivationExponent() const { return _activationExponent; }
     void setCurrentState( const SimTK::State* state) { _currentState = state; }
     const SimTK::State* getCurrentState() const { return _currentState; }
+    /** Choose whether prepareToOptimize() computes the linear constraint
+    matrix analytically (the default) or by perturbing each parameter and
+    realizing the system to Stage::Acceleration. */
+    void setUseAnalyticConstraintMatrix(bool aTrueFalse) { _useAnalyticConstraintMatrix = aTrueFalse; }
+    bool getUseAnalyticConstraintMatrix() const { return _useAnalyticConstraintMatrix; }
+    /** Linear map from parameters to constraint values, valid after
+    prepareToOptimize(). */
+    const SimTK::Matrix& getConstraintMatrix() const { return _constraintMatrix; }
+    const SimTK::Vector& getConstraintVector() const { return _constraintVector; }
 
     // UTILITY
     void validatePerturbationSize(double &aSize);
@@ -124,6 +136,7 @@ public:
 
 private:
     void computeConstraintVector(SimTK::State& s, const SimTK::Vector &x, SimTK::Vector &c) const;
+    void computeConstraintMatrix(SimTK::State& s);
     void computeAcceleration(SimTK::State& s, const SimTK::Vector &aF,SimTK::Vector &rAccel) const;
     void cumulativeTime(double &aTime, double aIncrement);
 };
@@ -208,6 +208,16 @@ public:
     void readFromXMLParentElement(SimTK::Xml::Element& parent,
                                   int                  versionNumber);
 
+    /** Same as above, but the caller has already looked up the first child
+    element of parent whose tag is this property's name; propertyElement is
+    that element, or an invalid (default-constructed) Element if there is
+    none. This lets a caller reading many properties from the same parent
+    index its child elements once rather than search them for every
+    property. **/
+    void readFromXMLParentElement(SimTK::Xml::Element& parent,
+                                  SimTK::Xml::Element  propertyElement,
+                                  int                  versionNumber);
+
     /** Given an XML parent element, append a single child element representing
     the serialized form of this property. **/
     void writeToXMLParentElement(SimTK::Xml::Element& parent) const;
@@ -329,6 +339,18 @@ protected:
     virtual void writeToXMLElement
        (SimTK::Xml::Element& propertyElement) const = 0;
 
+    /** Write the values of this property, including any objects it contains,
+    to a binary stream with the BinaryIO functions. The name and the "use
+    default value" attribute are written by the owning Object. 
+    @see Object::writeBinary() **/
+    virtual void writeToBinary(std::ostream& out) const = 0;
+
+    /** Replace the values of this property with those written to a binary
+    stream by writeToBinary(). Unlike readFromXMLElement(), no version
+    updating is done; binary data is only read by the version of OpenSim that
+    wrote it. **/
+    virtual void readFromBinary(std::istream& in) = 0;
+
 
     /** How may values are currently stored in this property? If this is an
     object property you can use this with getValueAsObject() to iterate over
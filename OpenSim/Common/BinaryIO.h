@@ -0,0 +1,135 @@
+#ifndef OPENSIM_BINARY_IO_H_
+#define OPENSIM_BINARY_IO_H_
+/* -------------------------------------------------------------------------- *
+ *                           OpenSim:  BinaryIO.h                             *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2016 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Exception.h"
+#include "SimTKcommon.h"
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+
+namespace OpenSim {
+
+/** Functions that write values to, and read them back from, the binary
+streams used by Object::writeBinary() and Object::readBinary(). Values are
+written in the byte order of the machine that writes them, so binary data is
+meant to be read on the same kind of machine, by the same version of OpenSim;
+it is not a replacement for the XML files. The read functions throw if the
+stream ends early. **/
+namespace BinaryIO {
+
+/** @cond **/ // Hide the helpers from Doxygen.
+inline void writeBytes(std::ostream& out, const void* data, size_t size)
+{   out.write(static_cast<const char*>(data), size); }
+
+inline void readBytes(std::istream& in, void* data, size_t size)
+{
+    in.read(static_cast<char*>(data), size);
+    if (in.gcount() != (std::streamsize)size)
+        throw Exception("BinaryIO: unexpected end of binary data.",
+                        __FILE__, __LINE__);
+}
+/** @endcond **/
+
+inline void write(std::ostream& out, bool value)
+{   const std::uint8_t byte = value ? 1 : 0; writeBytes(out, &byte, 1); }
+inline void read(std::istream& in, bool& value)
+{   std::uint8_t byte; readBytes(in, &byte, 1); value = (byte != 0); }
+
+inline void write(std::ostream& out, int value)
+{   const std::int32_t v = value; writeBytes(out, &v, sizeof(v)); }
+inline void read(std::istream& in, int& value)
+{   std::int32_t v; readBytes(in, &v, sizeof(v)); value = v; }
+
+inline void write(std::ostream& out, double value)
+{   writeBytes(out, &value, sizeof(value)); }
+inline void read(std::istream& in, double& value)
+{   readBytes(in, &value, sizeof(value)); }
+
+inline void write(std::ostream& out, const std::string& value)
+{
+    write(out, (int)value.size());
+    writeBytes(out, value.data(), value.size());
+}
+inline void read(std::istream& in, std::string& value)
+{
+    int size;
+    read(in, size);
+    if (size < 0)
+        throw Exception("BinaryIO: corrupt string length in binary data.",
+                        __FILE__, __LINE__);
+    value.resize(size);
+    if (size > 0)
+        readBytes(in, &value[0], size);
+}
+
+template <int M>
+inline void write(std::ostream& out, const SimTK::Vec<M>& value)
+{   for (int i = 0; i < M; ++i) write(out, value[i]); }
+template <int M>
+inline void read(std::istream& in, SimTK::Vec<M>& value)
+{   for (int i = 0; i < M; ++i) read(in, value[i]); }
+
+inline void write(std::ostream& out, const SimTK::Vector& value)
+{
+    write(out, value.size());
+    for (int i = 0; i < value.size(); ++i) write(out, value[i]);
+}
+inline void read(std::istream& in, SimTK::Vector& value)
+{
+    int size;
+    read(in, size);
+    if (size < 0)
+        throw Exception("BinaryIO: corrupt vector length in binary data.",
+                        __FILE__, __LINE__);
+    value.resize(size);
+    for (int i = 0; i < size; ++i) read(in, value[i]);
+}
+
+/** The rotation is written as its 9 matrix elements, so that reading it back
+gives exactly the same Transform. **/
+inline void write(std::ostream& out, const SimTK::Transform& value)
+{
+    const SimTK::Mat33& R = value.R().asMat33();
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            write(out, R(i, j));
+    write(out, value.p());
+}
+inline void read(std::istream& in, SimTK::Transform& value)
+{
+    SimTK::Mat33 R;
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            read(in, R(i, j));
+    SimTK::Vec3 p;
+    read(in, p);
+    value = SimTK::Transform(SimTK::Rotation(R, true), p);
+}
+
+} // namespace BinaryIO
+
+} // namespace OpenSim
+
+#endif // OPENSIM_BINARY_IO_H_
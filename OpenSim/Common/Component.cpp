@@ -274,6 +274,11 @@ void Component::baseAddToSystem(SimTK::MultibodySystem& system) const
     Component* mutableThis = const_cast<Component *>(this);
     mutableThis->_system = system;
 
+    // The state variables (of this and its subcomponents) are about to be
+    // added anew.
+    mutableThis->_allStateVariables.clear();
+    mutableThis->_stateVariableYIndexVersions.clear();
+
     // Allocate the ComponentMeasure, point it to this Component for 
     // making realize() calls, and add it to the system's default subsystem. 
     ComponentMeasure<double> mcMeasure(system.updDefaultSubsystem(), *this);
@@ -312,6 +317,28 @@ void Component::componentsSetPropertiesFromState(const SimTK::State& state)
         _components[i]->setPropertiesFromState(state);
 }
 
+void Component::updateStateVariableSystemIndices(const SimTK::State& state)
+{
+    // The layout of Y is fixed when Stage::Model is realized, so remember 
+    // the versions of the stages up to Model.
+    if (state.getSystemStage() >= Stage::Model) {
+        state.getSystemStageVersions(_stateVariableYIndexVersions);
+        _stateVariableYIndexVersions.resize(Stage::Model + 1);
+    } else {
+        _stateVariableYIndexVersions.clear();
+    }
+    updateAddedStateVariableSystemIndices(state);
+    extendUpdateStateVariableSystemIndices(state);
+    componentsUpdateStateVariableSystemIndices(state);
+}
+
+void Component::
+    componentsUpdateStateVariableSystemIndices(const SimTK::State& state)
+{
+    for(unsigned int i=0; i < _components.size(); i++)
+        _components[i]->updateStateVariableSystemIndices(state);
+}
+
 // Base class implementation of virtual method. Note that we're not handling
 // subcomponents here; this method gets called from extendRealizeAcceleration()
 // which will be invoked for each (sub) component by its own ComponentMeasure.
@@ -393,13 +420,14 @@ void Component::addStateVariable(Component::StateVariable*  stateVariable) const
     _namedStateVariableInfo[stateVariableName] =
         StateVariableInfo(stateVariable, order);
 
-    const AddedStateVariable* asv =
-        dynamic_cast<const Component::AddedStateVariable *>(stateVariable);
+    AddedStateVariable* asv =
+        dynamic_cast<Component::AddedStateVariable *>(stateVariable);
     // Now automatically add a cache variable to hold the derivative
     // to enable a similar interface for setting and getting the derivatives
     // based on the creator specified state name
     if(asv){
-        addCacheVariable(stateVariableName+"_deriv", 0.0, Stage::Dynamics);
+        asv->derivativeCV = 
+            addCacheVariable(stateVariableName+"_deriv", 0.0, Stage::Dynamics);
     }
 
 }
@@ -733,20 +761,121 @@ void Component::
     throw Exception(msg.str(),__FILE__,__LINE__);
 }
 
+// Get a handle to a state variable of this Component or its subcomponents.
+StateVariableHandle Component::
+    getStateVariableHandle(const std::string& name) const
+{
+    return StateVariableHandle(name);
+}
+
+// Find the StateVariable referred to by a handle, if not already known.
+const Component::StateVariable& Component::
+    resolveStateVariable(const StateVariableHandle& handle) const
+{
+    if (handle._stateVariable.empty()) {
+        const StateVariable* rsv = findStateVariable(handle._name);
+        if (rsv == nullptr) {
+            std::stringstream msg;
+            msg << "Component::resolveStateVariable: ERR- state named '" 
+                << handle._name << "' not found in " << getName() 
+                << " of type " << getConcreteClassName();
+            throw Exception(msg.str(),__FILE__,__LINE__);
+        }
+        handle._stateVariable.reset(rsv);
+    }
+    return *handle._stateVariable;
+}
+
+// Get the value of a state variable by its handle.
+double Component::
+    getStateVariableValue(const SimTK::State& s,
+                          const StateVariableHandle& handle) const
+{
+    return resolveStateVariable(handle).getValue(s);
+}
+
+// Set the value of a state variable by its handle.
+void Component::
+    setStateVariableValue(State& s, const StateVariableHandle& handle,
+                          double value) const
+{
+    resolveStateVariable(handle).setValue(s, value);
+}
+
+// Get the state variables of this Component and its subcomponents in the order
+// of getStateVariableNames(). They are found in extendRealizeTopology(), after
+// which they can be accessed without building or looking up their names.
+const SimTK::Array_<const Component::StateVariable*>& Component::
+    getAllStateVariables() const
+{
+    return _allStateVariables;
+}
+
+void Component::appendAllStateVariables(
+    SimTK::Array_<const StateVariable*>& stateVariables) const
+{
+    const int first = (int)stateVariables.size();
+    stateVariables.resize(first + (unsigned)_namedStateVariableInfo.size());
+    std::map<std::string, StateVariableInfo>::const_iterator it;
+    for (it = _namedStateVariableInfo.begin(); 
+         it != _namedStateVariableInfo.end(); ++it) {
+        stateVariables[first + it->second.order] = 
+            it->second.stateVariable.get();
+    }
+    for (unsigned int i = 0; i < _components.size(); ++i)
+        _components[i]->appendAllStateVariables(stateVariables);
+}
+
+// Added state variables are z's of the default subsystem, so their position
+// in Y is known once the State's z's have been allocated.
+void Component::
+    updateAddedStateVariableSystemIndices(const SimTK::State& s)
+{
+    std::map<std::string, StateVariableInfo>::iterator it;
+    for (it = _namedStateVariableInfo.begin(); 
+         it != _namedStateVariableInfo.end(); ++it) {
+        AddedStateVariable* asv = 
+            dynamic_cast<AddedStateVariable*>(it->second.stateVariable.get());
+        if (asv && asv->getSubsysIndex().isValid() && asv->getVarIndex() >= 0)
+            asv->setSystemYIndex(SimTK::SystemYIndex(s.getZStart() 
+                + s.getZStart(asv->getSubsysIndex()) + asv->getVarIndex()));
+    }
+}
+
 // Get all values of the state variables allocated by this Component. Includes
 // state variables allocated by its subcomponents.
 SimTK::Vector Component::
     getStateVariableValues(const SimTK::State& state) const
 {
-    int nsv = getNumStateVariables();
-    Array<std::string> names = getStateVariableNames();
+    Vector stateVariableValues;
+    getStateVariableValues(state, stateVariableValues);
+    return stateVariableValues;
+}
 
-    Vector stateVariableValues(nsv, SimTK::NaN);
-    for(int i=0; i<nsv; ++i){
-        stateVariableValues[i]=getStateVariableValue(state, names[i]);
+// Get all values of the state variables into an existing Vector. Those that
+// are in Y are copied straight from it, provided the State's variables are
+// laid out as they were when their Y indices were recorded.
+void Component::
+    getStateVariableValues(const SimTK::State& state, 
+                           SimTK::Vector& values) const
+{
+    const SimTK::Array_<const StateVariable*>& stateVariables = 
+        getAllStateVariables();
+    const int nsv = (int)stateVariables.size();
+    if (values.size() != nsv)
+        values.resize(nsv);
+
+    const bool useYIndices = !_stateVariableYIndexVersions.empty() &&
+        state.getLowestSystemStageDifference(_stateVariableYIndexVersions)
+            > Stage::Model;
+    const SimTK::Vector& y = state.getY();
+    for (int i = 0; i < nsv; ++i) {
+        const SimTK::SystemYIndex& yix = stateVariables[i]->getSystemYIndex();
+        if (useYIndices && yix.isValid() && yix < y.size())
+            values[i] = y[yix];
+        else
+            values[i] = stateVariables[i]->getValue(state);
     }
-
-    return stateVariableValues;
 }
 
 // Set all values of the state variables allocated by this Component. Includes
@@ -754,15 +883,16 @@ SimTK::Vector Component::
 void Component::
     setStateVariableValues(SimTK::State& state, const SimTK::Vector& values)
 {
-    int nsv = getNumStateVariables();
+    const SimTK::Array_<const StateVariable*>& stateVariables = 
+        getAllStateVariables();
+    const int nsv = (int)stateVariables.size();
     SimTK_ASSERT(values.size() == nsv, 
         "Component::setStateVariableValues() number values does not match number of state variables."); 
-    Array<std::string> names = getStateVariableNames();
 
-    Vector stateVariableValues(nsv, SimTK::NaN);
-    for(int i=0; i<nsv; ++i){
-        setStateVariableValue(state, names[i], values[i]);
-    }
+    // Set each value through its StateVariable, since setting some (e.g., a
+    // Coordinate's value) does more than set an entry of Y.
+    for (int i = 0; i < nsv; ++i)
+        stateVariables[i]->setValue(state, values[i]);
 }
 
 // Set the derivative of a state variable computed by this Component by name.
@@ -787,6 +917,14 @@ void Component::
     }
 }
 
+// Set the derivative of a state variable computed by this Component by handle.
+void Component::
+    setStateVariableDerivativeValue(const State& state,
+                    const StateVariableHandle& handle, double value) const
+{
+    resolveStateVariable(handle).setDerivative(state, value);
+}
+
 // Get the value of a discrete variable allocated by this Component by name.
 double Component::
 getDiscreteVariableValue(const SimTK::State& s, const std::string& name) const
@@ -883,6 +1021,18 @@ const int Component::getStateIndex(const std::string& name) const
     }
 }
 
+Component::StateVariable& Component::updStateVariable(const std::string& name)
+{
+    std::map<std::string, StateVariableInfo>::iterator it;
+    it = _namedStateVariableInfo.find(name);
+    if (it == _namedStateVariableInfo.end()) {
+        throw Exception(getConcreteClassName() + "::updStateVariable: "
+            "state variable '" + name + "' not found in '" + getName() + "'.",
+            __FILE__, __LINE__);
+    }
+    return *it->second.stateVariable;
+}
+
 SimTK::SystemYIndex Component::
 getStateVariableSystemIndex(const std::string& stateVariableName) const
 {
@@ -1019,6 +1169,19 @@ void Component::extendRealizeTopology(SimTK::State& s) const
                (s, ci.dependsOnStage, ci.prototype->clone());
         }
     }
+
+    // Allocate Cache Entries for the values of cached Outputs
+    for (const auto& output : _outputsTable) {
+        if (output.second->isValueCached() && 
+                output.second->getDependsOnStage() < SimTK::Stage::Infinity)
+            output.second->allocateValueCache(subSys, s);
+    }
+
+    // All state variables of this Component and its subcomponents have been
+    // added to the System, so they can be listed for 
+    // getStateVariableValues() and setStateVariableValues().
+    mutableThis->_allStateVariables.clear();
+    appendAllStateVariables(mutableThis->_allStateVariables);
 }
 
 
@@ -1116,13 +1279,13 @@ void Component::AddedStateVariable::setValue(SimTK::State& state, double value)
 double Component::AddedStateVariable::
     getDerivative(const SimTK::State& state) const
 {
-    return getOwner().getCacheVariableValue<double>(state, getName()+"_deriv");
+    return getOwner().getCacheVariableValue(state, derivativeCV);
 }
 
 void Component::AddedStateVariable::
     setDerivative(const SimTK::State& state, double deriv) const
 {
-    return getOwner().setCacheVariableValue<double>(state, getName()+"_deriv", deriv);
+    return getOwner().setCacheVariableValue(state, derivativeCV, deriv);
 }
 
 
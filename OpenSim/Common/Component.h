@@ -54,6 +54,54 @@
 namespace OpenSim {
 
 class ModelDisplayHints;
+class StateVariableHandle;
+
+//==============================================================================
+//                          CACHE VARIABLE HANDLE
+//==============================================================================
+/**
+ * A typed handle to a cache variable of a Component. A handle is returned by
+ * Component::addCacheVariable() and is meant to be kept by the Component
+ * (as a mutable member) that added the cache variable in its
+ * extendAddToSystem(); the cache entry itself is allocated when the System's
+ * topology is realized. Accessing a cache variable through its handle bypasses
+ * the lookup by name: the underlying SimTK::CacheEntryIndex is resolved on
+ * first access after the System's topology has been realized and is reused
+ * from then on. The resolved index is reset when the handle is copied, so a
+ * copied Component never refers to the cache entries of its source.
+ *
+ * @code
+ * // MyComponent.h
+ * mutable CacheVariableHandle<double> _lengthCV;
+ *
+ * // MyComponent::extendAddToSystem()
+ * _lengthCV = addCacheVariable("length", 0.0, SimTK::Stage::Position);
+ *
+ * // MyComponent::getLength()
+ * if (!isCacheVariableValid(s, _lengthCV)) ...
+ * return getCacheVariableValue(s, _lengthCV);
+ * @endcode
+ */
+template <typename T>
+class CacheVariableHandle {
+public:
+    CacheVariableHandle() {}
+
+    /** The name of the cache variable referred to by this handle. */
+    const std::string& getName() const { return _name; }
+    /** A default constructed handle does not refer to any cache variable. */
+    bool isEmpty() const { return _name.empty(); }
+
+private:
+    friend class Component;
+    explicit CacheVariableHandle(const std::string& name) : _name(name) {}
+
+    std::string _name;
+    // Index of the cache entry in the System's DefaultSubsystem. Resolved
+    // lazily, since it is only known once the topology is realized.
+    mutable SimTK::ResetOnCopy<SimTK::CacheEntryIndex> _index;
+};
+
 //==============================================================================
 //                            OPENSIM COMPONENT
 //==============================================================================
@@ -249,6 +297,15 @@ public:
     /** %Set Component's properties given a state. */
     void setPropertiesFromState(const SimTK::State& state);
 
+    /** Record where the state variables of this Component and its
+    subcomponents are in the Y vector of a State whose variables have been
+    allocated (i.e., realized to Stage::Model). The indices are used only
+    for States with the same layout; once Stage::Model is realized again 
+    (e.g., after switching joints between Euler angles and quaternions),
+    the state variables are read through their Components until this is
+    called again. */
+    void updateStateVariableSystemIndices(const SimTK::State& state);
+
     // End of Component Structural Interface (public non-virtual).
     ///@} 
 
@@ -687,6 +744,39 @@ public:
      */
     void setStateVariableValue(SimTK::State& state, const std::string& name, double value) const;
 
+    /**
+     * Get a handle to a state variable of this Component or of one of its
+     * subcomponents. The handle can be stored and used to get and set the
+     * value of the state variable without repeating the search by name.
+     * The state variable is resolved on first use and an exception is thrown
+     * at that time if it cannot be found.
+     *
+     * @param name    the name (string) of the state variable of interest
+     */
+    StateVariableHandle getStateVariableHandle(const std::string& name) const;
+
+    /**
+     * Get the value of a state variable by its handle.
+     * @see getStateVariableHandle()
+     *
+     * @param state   the State for which to get the value
+     * @param handle  handle to the state variable of interest
+     */
+    double getStateVariableValue(const SimTK::State& state,
+                                 const StateVariableHandle& handle) const;
+
+    /**
+     * %Set the value of a state variable by its handle.
+     * @see getStateVariableHandle()
+     *
+     * @param state   the State for which to set the value
+     * @param handle  handle to the state variable of interest
+     * @param value   the value to set
+     */
+    void setStateVariableValue(SimTK::State& state,
+                               const StateVariableHandle& handle,
+                               double value) const;
+
 
     /**
      * Get all values of the state variables allocated by this Component.
@@ -698,6 +788,20 @@ public:
      */
     SimTK::Vector getStateVariableValues(const SimTK::State& state) const;
 
+    /**
+     * Get all values of the state variables allocated by this Component and
+     * its subcomponents into an existing Vector, which is resized only if it
+     * does not already have length getNumStateVariables(). Use this to avoid
+     * allocating a Vector each time, e.g., when recording every integration
+     * step.
+     *
+     * @param state   the State for which to get the values
+     * @param values  Vector of state variable values in the order returned by
+     *                getStateVariableNames()
+     */
+    void getStateVariableValues(const SimTK::State& state, 
+                                SimTK::Vector& values) const;
+
     /**
      * %Set all values of the state variables allocated by this Component.
      * Includes state variables allocated by its subcomponents.
@@ -913,6 +1017,72 @@ public:
             throw Exception(msg.str(),__FILE__,__LINE__);
         }   
     }
+
+    /** Get the value of a cache variable by its handle.
+        @see addCacheVariable() */
+    template<typename T> const T&
+    getCacheVariableValue(const SimTK::State& state,
+                          const CacheVariableHandle<T>& handle) const
+    {
+        return SimTK::Value<T>::downcast(getDefaultSubsystem().getCacheEntry(
+            state, resolveCacheVariableIndex(handle))).get();
+    }
+
+    /** Obtain a writable cache variable value by its handle. Do not forget
+        to mark the cache value as valid after updating.
+        @see addCacheVariable() */
+    template<typename T> T&
+    updCacheVariableValue(const SimTK::State& state,
+                          const CacheVariableHandle<T>& handle) const
+    {
+        return SimTK::Value<T>::downcast(getDefaultSubsystem().updCacheEntry(
+            state, resolveCacheVariableIndex(handle))).upd();
+    }
+
+    /** Mark a cache variable value as valid by its handle.
+        @see addCacheVariable() */
+    template<typename T> void
+    markCacheVariableValid(const SimTK::State& state,
+                           const CacheVariableHandle<T>& handle) const
+    {
+        getDefaultSubsystem().markCacheValueRealized(state,
+            resolveCacheVariableIndex(handle));
+    }
+
+    /** Mark a cache variable value as invalid by its handle.
+        @see addCacheVariable() */
+    template<typename T> void
+    markCacheVariableInvalid(const SimTK::State& state,
+                             const CacheVariableHandle<T>& handle) const
+    {
+        getDefaultSubsystem().markCacheValueNotRealized(state,
+            resolveCacheVariableIndex(handle));
+    }
+
+    /** Check the validity of a cache variable value by its handle.
+        @see addCacheVariable() */
+    template<typename T> bool
+    isCacheVariableValid(const SimTK::State& state,
+                         const CacheVariableHandle<T>& handle) const
+    {
+        return getDefaultSubsystem().isCacheValueRealized(state,
+            resolveCacheVariableIndex(handle));
+    }
+
+    /** %Set a cache variable value by its handle, which also marks the
+        cache value as valid.
+        @see addCacheVariable() */
+    template<typename T> void
+    setCacheVariableValue(const SimTK::State& state,
+                          const CacheVariableHandle<T>& handle,
+                          const T& value) const
+    {
+        const SimTK::CacheEntryIndex& ceIndex =
+            resolveCacheVariableIndex(handle);
+        SimTK::Value<T>::downcast(
+            getDefaultSubsystem().updCacheEntry(state, ceIndex)).upd() = value;
+        getDefaultSubsystem().markCacheValueRealized(state, ceIndex);
+    }
     // End of Model Component State Accessors.
     //@} 
 
@@ -922,6 +1092,8 @@ class StateVariable;
 //template <class T> friend class ComponentSet;
 // Give the ComponentMeasure access to the realize() methods.
 template <class T> friend class ComponentMeasure;
+// Handles refer directly to a Component's StateVariables.
+friend class StateVariableHandle;
 
   /** Single call to construct the underlying infrastructure of a Component, which
      include: 1) its properties, 2) its structural connectors (to other components),
@@ -1157,6 +1329,20 @@ template <class T> friend class ComponentMeasure;
     @see extendInitStateFromProperties() **/
     virtual void extendSetPropertiesFromState(const SimTK::State& state) {};
 
+    /** Set the system (Y) indices of the state variables that this component
+    exposes but did not add with addStateVariable(), e.g., the q's and u's of
+    an underlying Simbody component. The indices of added state variables are
+    set by Component. Use updStateVariable() to access them. 
+
+    @see updateStateVariableSystemIndices() **/
+    virtual void extendUpdateStateVariableSystemIndices(
+        const SimTK::State& state) {};
+
+    /** Get writable access to a state variable of this Component (not of its
+    subcomponents), e.g., to set its system index. Throws an Exception if 
+    there is no state variable with that name. */
+    StateVariable& updStateVariable(const std::string& name);
+
     /** If a model component has allocated any continuous state variables
     using the addStateVariable() method, then %computeStateVariableDerivatives()
     must be implemented to provide time derivatives for those states.
@@ -1203,6 +1389,13 @@ template <class T> friend class ComponentMeasure;
     void setStateVariableDerivativeValue(const SimTK::State& state, 
                             const std::string& name, double deriv) const;
 
+    /**
+     * %Set the derivative of a state variable by its handle.
+     * @see getStateVariableHandle()
+     */
+    void setStateVariableDerivativeValue(const SimTK::State& state,
+                const StateVariableHandle& handle, double deriv) const;
+
 
     // End of Component Extension Interface (protected virtuals).
     ///@} 
@@ -1321,20 +1514,28 @@ template <class T> friend class ComponentMeasure;
                 SimTK::Stage::Velocity);
         @endcode
 
+       If the value is expensive to compute, pass isValueCached as true to
+       keep it in the State's cache, so that it is computed at most once per
+       realization however many times it is read. The value is then reused 
+       until the State's stage drops below dependsOn, so dependsOn must be a
+       Stage that is invalidated by every change the value depends on (e.g.,
+       not Stage::Model for a function of the q's).
+
        @see constructOutputForStateVariable()
      */
 #ifndef SWIG // SWIG can't parse the const at the end of the second argument.
     template <typename T, typename Class>
     void constructOutput(const std::string& name,
             T(Class::*const componentMemberFunction)(const SimTK::State&) const,
-            const SimTK::Stage& dependsOn = SimTK::Stage::Acceleration) {
+            const SimTK::Stage& dependsOn = SimTK::Stage::Acceleration,
+            bool isValueCached = false) {
         // The `const` in `Class::*const componentMemberFunction` means this
         // function can't assign componentMemberFunction to some other function
         // pointer. This is unlikely, since that function would have to match
         // the same template parameters (T and Class).
         constructOutput<T>(name, std::bind(componentMemberFunction,
                     static_cast<Class*>(this),
-                    std::placeholders::_1), dependsOn);
+                    std::placeholders::_1), dependsOn, isValueCached);
     }
 #endif
 
@@ -1355,14 +1556,18 @@ template <class T> friend class ComponentMeasure;
                SimTK::Stage::Position);
        @endcode
 
+      As above, pass isValueCached as true to keep the value in the State's
+      cache.
+
       @see constructOutputForStateVariable()
     */
     template <typename T>
     void constructOutput(const std::string& name, 
         const std::function<T(const SimTK::State&)> outputFunction, 
-        const SimTK::Stage& dependsOn = SimTK::Stage::Acceleration) {
+        const SimTK::Stage& dependsOn = SimTK::Stage::Acceleration,
+        bool isValueCached = false) {
         _outputsTable[name] = std::unique_ptr<const AbstractOutput>(new
-                Output<T>(name, outputFunction, dependsOn));
+                Output<T>(name, outputFunction, dependsOn, isValueCached));
     }
 
     /** Construct an Output for a StateVariable. While this method is a
@@ -1488,8 +1693,11 @@ template <class T> friend class ComponentMeasure;
     @param[in]      dependsOnStage      
         This is the highest computational stage on which this cache entry's
         value computation depends. State changes at this level or lower will
-        invalidate the cache entry. **/ 
-    template <class T> void 
+        invalidate the cache entry.
+    @returns
+        A handle to the cache variable, which can be used in place of its name
+        to access the cache variable efficiently. **/ 
+    template <class T> CacheVariableHandle<T>
     addCacheVariable(const std::string&     cacheVariableName,
                      const T&               variablePrototype, 
                      SimTK::Stage           dependsOnStage) const
@@ -1498,6 +1706,7 @@ template <class T> friend class ComponentMeasure;
         // during realizeTopology.
         _namedCacheVariableInfo[cacheVariableName] = 
             CacheInfo(new SimTK::Value<T>(variablePrototype), dependsOnStage);
+        return CacheVariableHandle<T>(cacheVariableName);
     }
 
     
@@ -1622,6 +1831,9 @@ private:
     /// Invoke setPropertiesFromState() on (sub)components of this Component
     void componentsSetPropertiesFromState(const SimTK::State& state);
 
+    /// Invoke updateStateVariableSystemIndices() on (sub)components
+    void componentsUpdateStateVariableSystemIndices(const SimTK::State& state);
+
     // Get the number of continuous states that the Component added to the 
     // underlying computational system. It includes the number of built-in states  
     // exposed by this component. It represents the number of state variables  
@@ -1635,11 +1847,48 @@ private:
     SimTK::DefaultSystemSubsystem& updDefaultSubsystem() const
         {   return updSystem().updDefaultSubsystem(); }
 
+    // Resolve (once) and return the cache entry index a handle refers to.
+    template <typename T> const SimTK::CacheEntryIndex&
+    resolveCacheVariableIndex(const CacheVariableHandle<T>& handle) const
+    {
+        if (!handle._index.isValid()) {
+            std::map<std::string, CacheInfo>::const_iterator it;
+            it = _namedCacheVariableInfo.find(handle._name);
+            if (it == _namedCacheVariableInfo.end() || 
+                    !it->second.index.isValid()) {
+                std::stringstream msg;
+                msg << "Component::resolveCacheVariableIndex: ERR- '"
+                    << handle._name << "' not found or not yet allocated.\n "
+                    << "for component '"<< getName() << "' of type " 
+                    << getConcreteClassName();
+                throw Exception(msg.str(),__FILE__,__LINE__);
+            }
+            handle._index = it->second.index;
+        }
+        return handle._index;
+    }
+
+    // Resolve (once) and return the StateVariable a handle refers to.
+    const StateVariable& 
+        resolveStateVariable(const StateVariableHandle& handle) const;
+
+    // Return the state variables of this Component and its subcomponents in
+    // the order of getStateVariableNames(), found in extendRealizeTopology().
+    const SimTK::Array_<const StateVariable*>& getAllStateVariables() const;
+    void appendAllStateVariables(
+        SimTK::Array_<const StateVariable*>& stateVariables) const;
+
+    // Update the system (Y) indices of the state variables added by this
+    // Component, now that the State's variables have been allocated.
+    void updateAddedStateVariableSystemIndices(const SimTK::State& s);
+
     void clearStateAllocations() {
         _namedModelingOptionInfo.clear();
         _namedStateVariableInfo.clear();
         _namedDiscreteVariableInfo.clear();
         _namedCacheVariableInfo.clear();    
+        _allStateVariables.clear();
+        _stateVariableYIndexVersions.clear();
     }
 
     // Reset by clearing underlying system indices, disconnecting connectors and
@@ -1706,6 +1955,12 @@ protected:
         const SimTK::SubsystemIndex& getSubsysIndex() const { return subsysIndex; }
         // return the index of the subsystem used to make resource allocations 
         const SimTK::SystemYIndex& getSystemYIndex() const { return sysYIndex; }
+        // The index of the variable in the State's Y vector, if the variable
+        // is one of its q's, u's or z's. It is set by 
+        // Component::updateStateVariableSystemIndices() once the State's 
+        // variables have been allocated.
+        void setSystemYIndex(const SimTK::SystemYIndex& yix) 
+        {   sysYIndex = yix; }
 
         bool isHidden() const { return hidden; }
         void hide()  { hidden = true; }
@@ -1828,10 +2083,14 @@ private:
         void setDerivative(const SimTK::State& state, double deriv) const override;
 
         private: // DATA
+        friend void Component::addStateVariable(StateVariable* sv) const;
         // Changes in state variables trigger recalculation of appropriate cache 
         // variables by automatically invalidating the realization stage specified
         // upon allocation of the state variable.
         SimTK::Stage    invalidatesStage;
+        // The cache variable holding the value of the derivative, which is
+        // added by the owner alongside this state variable.
+        CacheVariableHandle<double> derivativeCV;
     };
 
     // Structure to hold related info about discrete variables 
@@ -1902,6 +2161,18 @@ private:
     // Map names of continuous state variables of the Component to their 
     // underlying SimTK indices.
     mutable std::map<std::string, StateVariableInfo> _namedStateVariableInfo;
+    // The state variables of this Component and its subcomponents in the 
+    // order of getStateVariableNames(), so that getStateVariableValues() and
+    // setStateVariableValues() need not find each of them by name. Found 
+    // when the System's topology is realized, before any State exists, and 
+    // cleared along with the state variable allocations.
+    SimTK::ResetOnCopy<SimTK::Array_<const StateVariable*> > 
+        _allStateVariables;
+    // The Topology and Model stage versions of the State for which the Y 
+    // indices of the state variables were last recorded; the indices apply
+    // only to States whose variables have that layout.
+    SimTK::ResetOnCopy<SimTK::Array_<SimTK::StageVersion> > 
+        _stateVariableYIndexVersions;
     // Map names of discrete variables of the Component to their underlying
     // SimTK indices.
     mutable std::map<std::string, DiscreteVariableInfo> _namedDiscreteVariableInfo;
@@ -1911,6 +2182,34 @@ private:
 //==============================================================================
 };  // END of class Component
 //==============================================================================
+
+//==============================================================================
+//                          STATE VARIABLE HANDLE
+//==============================================================================
+/**
+ * A handle to a (continuous) state variable of a Component or of one of its
+ * subcomponents, obtained from Component::getStateVariableHandle(). The
+ * StateVariable is found by name on first use and is then accessed directly.
+ * The resolved StateVariable is forgotten when the handle is copied, so a
+ * handle kept by a Component never refers into the source of a copy.
+ */
+class StateVariableHandle {
+public:
+    StateVariableHandle() {}
+
+    /** The name of the state variable referred to by this handle. */
+    const std::string& getName() const { return _name; }
+    /** A default constructed handle does not refer to any state variable. */
+    bool isEmpty() const { return _name.empty(); }
+
+private:
+    friend class Component;
+    explicit StateVariableHandle(const std::string& name) : _name(name) {}
+
+    std::string _name;
+    // ReferencePtr is reset to null when copied.
+    mutable SimTK::ReferencePtr<const Component::StateVariable> _stateVariable;
+};
 //==============================================================================
 //==============================================================================
 // Implement methods for ComponentListIterator
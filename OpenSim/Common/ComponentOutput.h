@@ -60,19 +60,32 @@ namespace OpenSim {
  * the overhead is a single redirect to the corresponding member function
  * for the value.
  *
+ * An Output whose value is expensive to compute can instead keep its value
+ * in a cache entry of the State (see Component::constructOutput()). Its value
+ * is then computed at most once per realization of its dependsOnStage, and
+ * since each State has its own cache, it can be read concurrently from 
+ * different States. The value of an Output that is not cached is held by the 
+ * Output itself and is only valid until the Output is evaluated again.
+ *
  * @author  Ajay Seth
  */
 class OSIMCOMMON_API AbstractOutput {
 public:
-    AbstractOutput() : numSigFigs(8), dependsOnStage(SimTK::Stage::Infinity) {}
-    AbstractOutput(const std::string& name, SimTK::Stage dependsOnStage) : 
-        name(name), dependsOnStage(dependsOnStage), numSigFigs(8) {}
+    AbstractOutput() : numSigFigs(8), dependsOnStage(SimTK::Stage::Infinity),
+        valueCached(false) {}
+    AbstractOutput(const std::string& name, SimTK::Stage dependsOnStage,
+                   bool isValueCached = false) : 
+        name(name), dependsOnStage(dependsOnStage), numSigFigs(8),
+        valueCached(isValueCached) {}
     virtual ~AbstractOutput() { }
 
     /** Output's name */
     const std::string& getName() const { return name; }
     /** Output's dependence on System being realized to at least this System::Stage */
     const SimTK::Stage& getDependsOnStage() const { return dependsOnStage; }
+    /** Whether the Output's value is kept in the State's cache, where it
+        remains valid until the State's stage drops below dependsOnStage. */
+    bool isValueCached() const { return valueCached; }
 
     /** Output Interface */
     virtual std::string     getTypeName() const = 0;
@@ -90,10 +103,18 @@ public:
     void         setNumberOfSignificantDigits(unsigned int numSigFigs) 
     { numSigFigs = numSigFigs; }
 
+protected:
+    friend class Component;
+    /** Allocate the cache entry that holds the value of a cached Output in
+        the State. Invoked by the owning Component as it realizes Topology. */
+    virtual void allocateValueCache(const SimTK::Subsystem& subsystem,
+                                    SimTK::State& state) const = 0;
+
 private:
     unsigned int numSigFigs;
     SimTK::Stage dependsOnStage;
     std::string name;
+    bool valueCached;
 //=============================================================================
 };  // END class AbstractOutput
 
@@ -107,11 +128,14 @@ public:
     valid at a given realization Stage.
     @param name             The name of the output.
     @param outputFunction   The output function to be invoked (returns Output T)
-    @param dependsOnStage   Stage at which Output can be evaluated. */
+    @param dependsOnStage   Stage at which Output can be evaluated.
+    @param isValueCached    Whether to keep the value in the State's cache. */
     explicit Output(const std::string& name,
         const std::function<T(const SimTK::State&)> outputFunction,
-        const SimTK::Stage&     dependsOnStage) : 
-            AbstractOutput(name, dependsOnStage), _outputFcn(outputFunction)
+        const SimTK::Stage&     dependsOnStage,
+        bool                    isValueCached = false) : 
+            AbstractOutput(name, dependsOnStage, isValueCached),
+            _outputFcn(outputFunction)
     {}
     
     virtual ~Output() {}
@@ -120,7 +144,12 @@ public:
         void compatibleAssign(const AbstractOutput& o) override {
         if (!isA(o)) 
             SimTK_THROW2(SimTK::Exception::IncompatibleValues, o.getTypeName(), getTypeName());
+        // The cache entry, if any, belongs to this Output's Component.
+        const SimTK::SubsystemIndex subsystemIndex = _subsystemIndex;
+        const SimTK::CacheEntryIndex cacheIndex = _cacheIndex;
         *this = downcast(o);
+        _subsystemIndex = subsystemIndex;
+        _cacheIndex = cacheIndex;
     }
 
 
@@ -131,16 +160,39 @@ public:
         to a stage at or beyond the dependsOnStage, otherwise expect an
         Exception. */
     const T& getValue(const SimTK::State& state) const {
-        _result = SimTK::NaN;
         if (state.getSystemStage() < getDependsOnStage())
         {
             throw SimTK::Exception::StageTooLow(__FILE__, __LINE__,
                     state.getSystemStage(), getDependsOnStage(),
                     "Output::getValue(state)");
         }
+        if (_cacheIndex.isValid()) {
+            SimTK::Value<T>& cached = SimTK::Value<T>::updDowncast(
+                state.updCacheEntry(_subsystemIndex, _cacheIndex));
+            if (!state.isCacheValueRealized(_subsystemIndex, _cacheIndex)) {
+                cached.upd() = _outputFcn(state);
+                state.markCacheValueRealized(_subsystemIndex, _cacheIndex);
+            }
+            return cached.get();
+        }
+        _result = SimTK::NaN;
         _result = _outputFcn(state); 
         return _result;
     }
+
+    /** Get the values of several Outputs of the same type at once, e.g., for a
+        reporter that looks up its Outputs once and then reports them at every
+        step. values is resized to the number of outputs and values[i] is 
+        the value of outputs[i]. Each Output's value is computed as in 
+        getValue(), so the values of cached Outputs are computed at most once 
+        per realization. */
+    static void getValues(const SimTK::State& state,
+                          const SimTK::Array_<const Output<T>*>& outputs,
+                          SimTK::Array_<T>& values) {
+        values.resize(outputs.size());
+        for (unsigned i = 0; i < outputs.size(); ++i)
+            values[i] = outputs[i]->getValue(state);
+    }
     
     /** determine the value type for this Output*/
     std::string getTypeName() const override 
@@ -154,12 +206,29 @@ public:
         return s.str();
     }
 
-    AbstractOutput* clone() const override { return new Output(*this); }
+    AbstractOutput* clone() const override {
+        Output* copy = new Output(*this);
+        // The copy has no cache entry until its Component allocates one.
+        copy->_cacheIndex.invalidate();
+        return copy;
+    }
     SimTK_DOWNCAST(Output, AbstractOutput);
 
+protected:
+    void allocateValueCache(const SimTK::Subsystem& subsystem,
+                            SimTK::State& state) const override {
+        _subsystemIndex = subsystem.getMySubsystemIndex();
+        _cacheIndex = subsystem.allocateLazyCacheEntry(state, 
+            getDependsOnStage(), new SimTK::Value<T>());
+    }
+
 private:
     mutable T _result;
     std::function<T(const SimTK::State&)> _outputFcn;
+    // Where the value of a cached Output is kept in the State. Invalid if
+    // the value is not cached or the cache entry has not been allocated.
+    mutable SimTK::SubsystemIndex _subsystemIndex;
+    mutable SimTK::CacheEntryIndex _cacheIndex;
 
 //=============================================================================
 };  // END class Output
@@ -55,6 +55,21 @@ public:
     }
 };
 
+class IncorrectNumRows : public InvalidRow {
+public:
+    IncorrectNumRows(const std::string& file,
+                     size_t line,
+                     const std::string& func,
+                     size_t expected,
+                     size_t received) :
+        InvalidRow(file, line, func) {
+        std::string msg = "expected = " + std::to_string(expected);
+        msg += " received = " + std::to_string(received);
+
+        addMessage(msg);
+    }
+};
+
 class RowIndexOutOfRange : public IndexOutOfRange {
 public:
     using IndexOutOfRange::IndexOutOfRange;
@@ -206,13 +221,18 @@ independent column and a set of dependent columns. The type of the independent
 column can be configured using ETX (template param). The type of the dependent 
 columns, which together form a matrix, can be configured using ETY (template 
 param). Independent and Dependent columns can contain metadata. DataTable_ as a 
-whole can contain metadata.                                                   */
+whole can contain metadata.
+
+Storage for rows grows geometrically, so appending rows one at a time takes 
+amortized constant time. Use reserve() when the number of rows is known in 
+advance and appendRows() to append a block of rows at once.                   */
 template<typename ETX = double, typename ETY = SimTK::Real>
 class DataTable_ : public AbstractDataTable {
 public:
     using RowVector     = SimTK::RowVector_<ETY>;
     using RowVectorView = SimTK::RowVectorView_<ETY>;
     using VectorView    = SimTK::VectorView_<ETY>;
+    using MatrixView    = SimTK::MatrixView_<ETY>;
 
     DataTable_()                             = default;
     DataTable_(const DataTable_&)            = default;
@@ -230,26 +250,73 @@ public:
     \throws IncorrectNumCoilumns If the row added is invalid. Validity of the 
     row added is decided by the derived class.                                */
     void appendRow(const ETX& indRow, const RowVector& depRow) {
+        validateNumColumns(static_cast<size_t>(depRow.ncol()));
         validateRow(_indData.size(), indRow, depRow);
 
         _indData.push_back(indRow);
+        growDependentColumns(depRow.ncol());
+
+        _depData.updRow(static_cast<int>(_indData.size()) - 1) = depRow;
+    }
+
+    /** Append a block of rows to the DataTable_. Row i of depRows 
+    corresponds to entry i of indRows. Either all of the rows are appended or,
+    if one of them is invalid, none of them are.
+
+    \throws IncorrectNumRows If the number of rows in depRows is not equal
+                             to the number of entries in indRows.
+    \throws IncorrectNumColumns If the number of columns in depRows does not
+                                match the table.
+    \throws InvalidRow If any of the rows is invalid. Validity of the rows 
+                       is decided by the derived class.                       */
+    void appendRows(const std::vector<ETX>& indRows,
+                    const SimTK::Matrix_<ETY>& depRows) {
+        OPENSIM_THROW_IF(indRows.size() != static_cast<size_t>(depRows.nrow()),
+                         IncorrectNumRows, 
+                         indRows.size(), 
+                         static_cast<size_t>(depRows.nrow()));
+        if(indRows.empty())
+            return;
+        validateNumColumns(static_cast<size_t>(depRows.ncol()));
+
+        const size_t oldNumRows{_indData.size()};
+        reserve(oldNumRows + indRows.size());
+        try {
+            // Rows are validated against the rows before them, so they are 
+            // added to the independent column one at a time.
+            for(size_t r = 0; r < indRows.size(); ++r) {
+                validateRow(_indData.size(), indRows[r], 
+                            RowVector(depRows.row(static_cast<int>(r))));
+                _indData.push_back(indRows[r]);
+            }
+        } catch(...) {
+            _indData.resize(oldNumRows);
+            throw;
+        }
 
-        if(_depData.nrow() == 0 || _depData.ncol() == 0) {
+        growDependentColumns(depRows.ncol());
+        _depData.updBlock(static_cast<int>(oldNumRows), 0, 
+                          depRows.nrow(), depRows.ncol()) = depRows;
+    }
+
+    /** Allocate storage for at least the given number of rows so that rows 
+    can be appended without reallocating. This does not change the number of
+    rows in the table.                                                        */
+    void reserve(size_t numRows) {
+        _indData.reserve(numRows);
+
+        int numColumns{_depData.ncol()};
+        if(_indData.empty()) {
+            // The number of columns is known once "labels" are set; 
+            // otherwise storage is allocated when the first row is appended.
             try {
-                auto& labels = 
-                    _dependentsMetaData.getValueArrayForKey("labels");
-                OPENSIM_THROW_IF(depRow.ncol() != labels.size(),
-                                 IncorrectNumColumns, 
-                                 labels.size(), 
-                                 static_cast<size_t>(depRow.ncol()));
+                numColumns = static_cast<int>(_dependentsMetaData.
+                                        getValueArrayForKey("labels").size());
             } catch(KeyNotFound&) {
-                // No "labels". So no operation.
+                return;
             }
-            _depData.resize(1, depRow.size());
-        } else
-            _depData.resizeKeep(_depData.nrow() + 1, _depData.ncol());
-            
-        _depData.updRow(_depData.nrow() - 1) = depRow;
+        }
+        growDependentColumns(numColumns);
     }
 
     /** Get row at index.                                                     
@@ -266,12 +333,7 @@ public:
     \throws KeyNotFound If the independent column has no entry with given
                         value.                                                */
     RowVectorView getRow(const ETX& ind) const {
-        auto iter = std::find(_indData.cbegin(), _indData.cend(), ind);
-
-        OPENSIM_THROW_IF(iter == _indData.cend(),
-                         KeyNotFound, std::to_string(ind));
-
-        return _depData.row(std::distance(_indData.cbegin(), iter));
+        return _depData.row(static_cast<int>(getRowIndex(ind)));
     }
 
     /** Update row at index.                                                  
@@ -288,12 +350,7 @@ public:
     \throws KeyNotFound If the independent column has no entry with given
                         value.                                                */
     RowVectorView updRow(const ETX& ind) {
-        auto iter = std::find(_indData.cbegin(), _indData.cend(), ind);
-
-        OPENSIM_THROW_IF(iter == _indData.cend(),
-                         KeyNotFound, std::to_string(ind));
-
-        return _depData.updRow(std::distance(_indData.cbegin(), iter));
+        return _depData.updRow(static_cast<int>(getRowIndex(ind)));
     }
 
     /** Get independent column.                                               */
@@ -308,7 +365,24 @@ public:
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(index),
                          ColumnIndexOutOfRange, index, 0,
                          static_cast<size_t>(_depData.ncol()));
-        return _depData.col(index);
+        return _depData.block(0, static_cast<int>(index), 
+                              static_cast<int>(_indData.size()), 1).col(0);
+    }
+
+    /** Get the dependent columns as a matrix with a row for every entry in the
+    independent column. The matrix is a view of the table's storage, not a
+    copy; it is invalidated when the table reallocates its storage (see
+    reserve()).                                                               */
+    MatrixView getMatrix() const {
+        return _depData.block(0, 0, static_cast<int>(_indData.size()), 
+                              _depData.ncol());
+    }
+
+    /** Update the dependent columns through a writable view, as returned by
+    getMatrix(). Values written through the view are not validated.           */
+    MatrixView updMatrix() {
+        return _depData.updBlock(0, 0, static_cast<int>(_indData.size()), 
+                                 _depData.ncol());
     }
 
     /** Set independent column at index.                                      
@@ -332,9 +406,10 @@ protected:
         return index >= static_cast<size_t>(_depData.ncol());
     }
 
-    /** Get number of rows.                                                   */
+    /** Get number of rows. The dependent columns may have storage for more
+    rows than this (see reserve()).                                           */
     size_t implementGetNumRows() const override {
-        return _depData.nrow();
+        return _indData.size();
     }
 
     /** Get number of columns.                                                */
@@ -387,6 +462,58 @@ protected:
         }
     }
 
+    /** Get the index of the row corresponding to the given entry in the 
+    independent column. Derived classes can implement this function to use a
+    faster search when the independent column is sorted.
+
+    \throws KeyNotFound If the independent column has no entry with given
+                        value.                                                */
+    virtual size_t getRowIndex(const ETX& ind) const {
+        auto iter = std::find(_indData.cbegin(), _indData.cend(), ind);
+
+        OPENSIM_THROW_IF(iter == _indData.cend(),
+                         KeyNotFound, std::to_string(ind));
+
+        return std::distance(_indData.cbegin(), iter);
+    }
+
+    /** Check that rows to be appended have the same number of columns as the
+    table or, if the table is empty, as the "labels" of the dependent columns.
+
+    \throws IncorrectNumColumns If the number of columns does not match.    */
+    void validateNumColumns(size_t numColumns) const {
+        if(_indData.empty()) {
+            try {
+                auto& labels = 
+                    _dependentsMetaData.getValueArrayForKey("labels");
+                OPENSIM_THROW_IF(numColumns != labels.size(),
+                                 IncorrectNumColumns, 
+                                 labels.size(), 
+                                 numColumns);
+            } catch(KeyNotFound&) {
+                // No "labels". So no operation.
+            }
+        } else {
+            OPENSIM_THROW_IF(numColumns != 
+                             static_cast<size_t>(_depData.ncol()),
+                             IncorrectNumColumns,
+                             static_cast<size_t>(_depData.ncol()),
+                             numColumns);
+        }
+    }
+
+    /** Make sure the dependent columns have a row for every entry the 
+    independent column has capacity for. The capacity of the independent
+    column grows geometrically, so the dependent columns do as well.          */
+    void growDependentColumns(int numColumns) {
+        const int capacity{static_cast<int>(_indData.capacity())};
+        if(_depData.ncol() != numColumns) {
+            // Only possible while the table has no rows.
+            _depData.resize(capacity, numColumns);
+        } else if(_depData.nrow() < capacity)
+            _depData.resizeKeep(capacity, numColumns);
+    }
+
     /** Derived classes optionally can implement this function to validate
     append/update operations.                                                 
 
@@ -35,6 +35,7 @@
 #include "PropertyDblArray.h"
 #include "gcvspl.h"
 #include "XYFunctionInterface.h"
+#include <atomic>
 
 
 
@@ -48,6 +49,9 @@ using SimTK::Vec;
 //=============================================================================
 // STATICS
 //=============================================================================
+// Source of the identifiers of spline fits. Splines may be fit on several
+// threads at once (see GCVSplineSet).
+static std::atomic<int> LastFitId(0);
 
 
 //=============================================================================
@@ -72,7 +76,8 @@ GCVSpline() :
     _weights(_propWeights.getValueDblArray()),
     _coefficients(_propCoefficients.getValueDblArray()),
     _y(_propY.getValueDblArray()),
-    _workDeriv(1)
+    _workDeriv(1),
+    _fitId(0)
 {
     setNull();
 }
@@ -86,7 +91,8 @@ GCVSpline(int aDegree,int aN,const double *aX,const double *aF,
     _weights(_propWeights.getValueDblArray()),
     _coefficients(_propCoefficients.getValueDblArray()),
     _y(_propY.getValueDblArray()),
-    _workDeriv(1)
+    _workDeriv(1),
+    _fitId(0)
 
 {
     setNull();
@@ -146,7 +152,8 @@ GCVSpline(const GCVSpline &aSpline) :
     _weights(_propWeights.getValueDblArray()),
     _coefficients(_propCoefficients.getValueDblArray()),
     _y(_propY.getValueDblArray()),
-    _workDeriv(1)
+    _workDeriv(1),
+    _fitId(0)
 
 {
     setEqual(aSpline);
@@ -343,6 +350,7 @@ operator=(const GCVSpline &aSpline)
 
     // DATA
     setEqual(aSpline);
+    resetFunction();
 
     return(*this);
 }
@@ -375,6 +383,7 @@ setDegree(int aDegree)
         printf("\tSetting degree = 7 (heptic spline.)\n");
         _halfOrder = 4;
     }
+    resetFunction();
 }
 //_____________________________________________________________________________
 int GCVSpline::
@@ -600,6 +609,12 @@ SimTK::Function* GCVSpline::createSimTKFunction() const {
      int sz = _coefficients.getSize();
     for (int i = 0; i < sz; ++i)
         _coefficients[i] = spline->getControlPointValues()[i];
+    _fitId = ++LastFitId;
     return spline;
 }
 
+void GCVSpline::fit() {
+    if (_function == NULL)
+        _function = createSimTKFunction();
+}
+
@@ -107,6 +107,9 @@ protected:
     Array<double> &_y;
     /** A workspace used when calculating derivatives of the spline. */
     mutable std::vector<int> _workDeriv;
+    /** Identifier of the most recent fit of the spline; 0 if it has not
+    been fit. */
+    mutable int _fitId;
 
 //=============================================================================
 // METHODS
@@ -228,6 +231,22 @@ public:
     virtual bool deletePoints(const Array<int>& indices);
     virtual int addPoint(double aX, double aY);
     SimTK::Function* createSimTKFunction() const override;
+    /**
+     * Fit the spline to its data points now, if it has not been fit since
+     * they last changed, rather than when it is first evaluated. The
+     * coefficients returned by getCoefficients() are those of the most
+     * recent fit.
+     */
+    void fit();
+    /**
+     * Get an identifier of the most recent fit of the spline. Each fit gets
+     * a new identifier, so a change in the identifier means that the data
+     * points, and so the coefficients, may have changed.
+     *
+     * @return Identifier of the fit, or 0 if the spline has not been fit
+     * since its data points last changed.
+     */
+    int getFitId() const { return _function!=NULL ? _fitId : 0; }
 
     //--------------------------------------------------------------------------
     // EVALUATION
@@ -28,6 +28,8 @@
 
 // INCLUDES
 #include "GCVSplineSet.h"
+#include "gcvspl.h"
+#include <algorithm>
 
 
 //=============================================================================
@@ -64,6 +66,7 @@ GCVSplineSet(const char *aFileName) :
     FunctionSet(aFileName)
 {
     setNull();
+    prepare();
 }
 //_____________________________________________________________________________
 /**
@@ -84,11 +87,15 @@ GCVSplineSet(const char *aFileName) :
  * the error variance assumed for each column in the Storage.  If different
  * variances should be set for the various columns, you will need to
  * construct each GCVSpline individually.
+ * @param aNumThreads Number of threads on which to fit the splines. If
+ * negative, large storages are fit on as many threads as there are
+ * processors.
  * @see Storage
  * @see GCVSpline
  */
 GCVSplineSet::
-GCVSplineSet(int aDegree,const Storage *aStore,double aErrorVariance)
+GCVSplineSet(int aDegree,const Storage *aStore,double aErrorVariance,
+    int aNumThreads)
 {
     setNull();
     if(aStore==NULL) return;
@@ -100,7 +107,7 @@ GCVSplineSet(int aDegree,const Storage *aStore,double aErrorVariance)
     ensureCapacity(2*vec->getSize());
 
     // CONSTRUCT
-    construct(aDegree,aStore,aErrorVariance);
+    construct(aDegree,aStore,aErrorVariance,aNumThreads);
 }
 
 
@@ -114,18 +121,52 @@ GCVSplineSet(int aDegree,const Storage *aStore,double aErrorVariance)
 void GCVSplineSet::
 setNull()
 {
+    _sharedHalfOrder = 0;
 }
 //_____________________________________________________________________________
+/**
+ * Fits each of a number of splines. Errors are recorded per spline and
+ * reported on the calling thread.
+ */
+class FitSplinesTask : public SimTK::ParallelExecutor::Task {
+public:
+    explicit FitSplinesTask(const std::vector<GCVSpline*>& splines) :
+        _splines(splines), _errors(splines.size()) {}
+    void execute(int index) override {
+        try {
+            _splines[index]->fit();
+        }
+        catch (const std::exception& e) {
+            _errors[index] = e.what();
+        }
+    }
+    void throwIfFailed() const {
+        for (size_t i = 0; i < _errors.size(); ++i)
+            if (!_errors[i].empty())
+                throw Exception("GCVSplineSet: failed to fit spline " +
+                    _splines[i]->getName() + ": " + _errors[i],
+                    __FILE__, __LINE__);
+    }
+private:
+    const std::vector<GCVSpline*>& _splines;
+    std::vector<std::string> _errors;
+};
+//_____________________________________________________________________________
 /**
  * Construct a set of generalized cross-validated splines based on the states
  * stored in an Storage object.
  *
+ * The splines are created in column order and then fit in parallel; each
+ * spline is only used by one thread while it is fit.
+ *
  * @param aDegree Degree of the constructed splines (1, 3, 5, or 7).
  * @param aStore Storage object.
  * @param aErrorVariance Error variance for the data.
+ * @param aNumThreads Number of threads on which to fit the splines.
  */
 void GCVSplineSet::
-construct(int aDegree,const Storage *aStore,double aErrorVariance)
+construct(int aDegree,const Storage *aStore,double aErrorVariance,
+    int aNumThreads)
 {
     if(aStore==NULL) return;
 
@@ -140,7 +181,7 @@ construct(int aDegree,const Storage *aStore,double aErrorVariance)
     // LOOP THROUGH THE STATES
     int nTime=1,nData=1;
     double *times=NULL,*data=NULL;
-    GCVSpline *spline;
+    std::vector<GCVSpline*> splines;
     //printf("GCVSplineSet.construct:  constructing splines...\n");
     for(int i=0;nData>0;i++) {
 
@@ -167,9 +208,8 @@ construct(int aDegree,const Storage *aStore,double aErrorVariance)
 
         // CONSTRUCT SPLINE
         //printf("%s\t",name);
-        spline = new GCVSpline(aDegree,nData,times,data,name,aErrorVariance);
-        SimTK::Function* fp = spline->createSimTKFunction();
-        delete fp;  
+        GCVSpline *spline = new GCVSpline(aDegree,nData,times,data,name,aErrorVariance);
+        splines.push_back(spline);
 
         // ADD SPLINE
         adoptAndAppend(spline);
@@ -179,6 +219,25 @@ construct(int aDegree,const Storage *aStore,double aErrorVariance)
     // CLEANUP
     if(times!=NULL) delete[] times;
     if(data!=NULL) delete[] data;
+
+    // FIT THE SPLINES
+    int numSplines = (int)splines.size();
+    if(numSplines==0) return;
+    int numThreads = aNumThreads;
+    if(numThreads<0) {
+        numThreads = (double)numSplines*splines[0]->getSize() < 10000.0 ?
+            1 : SimTK::ParallelExecutor::getNumProcessors();
+    }
+    numThreads = std::max(1, std::min(numThreads, numSplines));
+    if(numThreads==1) {
+        for(GCVSpline *spline : splines) spline->fit();
+    } else {
+        FitSplinesTask task(splines);
+        SimTK::ParallelExecutor executor(numThreads);
+        executor.execute(task, numSplines);
+        task.throwIfFailed();
+    }
+    prepare();
 }
 
 
@@ -273,16 +332,11 @@ constructStorage(int aDerivOrder,double aDX)
     }
     store->setColumnLabels(labels);
 
-    // SET STATES
-    Array<double> y(0.0,n);
-
-    // LOOP THROUGH THE DATA
+    // INDEPENDENT VARIABLE
+    Array<double> x;
     // constant increments
     if(aDX>0.0) {
-        for(double x=getMinX(); x<=getMaxX(); x+=aDX) {
-            evaluate(y,aDerivOrder,x);
-            store->append(x,n,&y[0]);
-        }
+        for(double xi=getMinX(); xi<=getMaxX(); xi+=aDX) x.append(xi);
 
     // original independent variable increments
     } else {
@@ -294,11 +348,17 @@ constructStorage(int aDerivOrder,double aDX)
             if(xOrig[ix]<getMinX()) continue;
             if(xOrig[ix]>getMaxX()) break;
 
-            evaluate(y,aDerivOrder,xOrig[ix]);
-            store->append(xOrig[ix],n,&y[0]);
+            x.append(xOrig[ix]);
         }
     }
 
+    // EVALUATE ALL THE FUNCTIONS AT ONCE
+    int nx = x.getSize();
+    if(nx==0) return(store);
+    std::vector<double> y((size_t)nx*n);
+    evaluateAll(aDerivOrder,nx,&x[0],y.data());
+    for(int ix=0;ix<nx;ix++) store->append(x[ix],n,&y[(size_t)ix*n]);
+
     return(store);
 }
 
@@ -327,3 +387,275 @@ double GCVSplineSet::getMaxX() const
 
     return max;
 }
+
+
+//=============================================================================
+// EVALUATION
+//=============================================================================
+//_____________________________________________________________________________
+/**
+ * Compute the derivative of order ider at t of each of ns splines of half
+ * order m that share the n knots x, as splder() in gcvspl.c computes it for
+ * one spline. The knot interval l containing t must already have been found
+ * with search(). The tableau of splder() is kept for all of the splines,
+ * with element i of the tableau of spline s at q[(i-1)*ns + s], so that each
+ * of its steps is a loop over the splines.
+ *
+ * @param c Coefficients of each of the splines.
+ * @param q Workspace of 2*m*ns values.
+ * @param d The derivative of each of the splines.
+ */
+static void
+splderAll(int ider,int m,int n,double t,const double *x,int l,
+    int ns,const double *const *c,double *q,double *d)
+{
+    int i,ii,ir,i1,j,jl,jj,ju,jm,j1,j2,jin,k,ki,k1,lk,lk1,lk1i,lk1i1,
+        ml,mi,m2,mp1,m2m1,nk,npm,nki,nki1,s;
+    double *a,*b;
+
+    // Q(i) of splder() is the row of the tableau starting at q[(i-1)*ns].
+    auto Q = [&](int row) { return(q + (size_t)(row-1)*ns); };
+
+    // DERIVATIVES OF ORDER 2*m OR HIGHER ARE ZERO
+    m2 = 2*m;
+    k = m2-ider;
+    if(k<1) {
+        for(s=0;s<ns;s++) d[s] = 0.0;
+        return;
+    }
+
+    // INITIALIZE THE FIRST ROW OF THE B-SPLINE COEFFICIENTS TABLEAU
+    mp1  = m+1;
+    npm  = n+m;
+    m2m1 = m2-1;
+    k1   = k-1;
+    nk   = n-k;
+    lk   = l-k;
+    lk1  = lk+1;
+    jl   = l+1;
+    ju   = l+m2;
+    ii   = n-m2;
+    ml   = -l;
+    for(j=jl;j<=ju;j++) {
+        a = Q(j+ml);
+        if((j>=mp1) && (j<=npm)) {
+            for(s=0;s<ns;s++) a[s] = c[s][j-m-1];
+        } else {
+            for(s=0;s<ns;s++) a[s] = 0.0;
+        }
+    }
+
+    // DIFFERENCES OF THE B-SPLINE COEFFICIENTS FOR DERIVATIVES
+    if(ider>0) {
+        jl -= m2;
+        ml += m2;
+        for(i=1;i<=ider;i++) {
+            jl++;
+            ii++;
+            j1 = std::max(1,jl);
+            j2 = std::min(l,ii);
+            mi = m2-i;
+            j  = j2+1;
+            for(jin=j1;jin<=j2;jin++) {
+                j--;
+                jm = ml+j;
+                const double h = x[j+mi-1]-x[j-1];
+                a = Q(jm);
+                b = Q(jm-1);
+                for(s=0;s<ns;s++) a[s] = (a[s]-b[s])/h;
+            }
+            if(jl<1) {
+                i1 = i+1;
+                j  = ml+1;
+                for(jin=i1;jin<=ml;jin++) {
+                    j--;
+                    a = Q(j);
+                    b = Q(j-1);
+                    for(s=0;s<ns;s++) a[s] = -b[s];
+                }
+            }
+        }
+        for(j=1;j<=k;j++) std::copy(Q(j+ider),Q(j+ider)+ns,Q(j));
+    }
+
+    // LOWER HALF OF THE EVALUATION TABLEAU
+    for(i=1;i<=k1;i++) {
+        nki = nk+i;
+        ir = k;
+        jj = l;
+        ki = k-i;
+        nki1 = nki+1;
+
+        // RIGHT HAND B-SPLINES
+        for(j=nki1;j<=l;j++) {
+            const double dt = t-x[jj-1];
+            a = Q(ir);
+            b = Q(ir-1);
+            for(s=0;s<ns;s++) a[s] = b[s] + dt*a[s];
+            jj--;
+            ir--;
+        }
+
+        // MIDDLE B-SPLINES
+        lk1i = lk1+i;
+        j1 = std::max(1,lk1i);
+        j2 = std::min(l,nki);
+        for(j=j1;j<=j2;j++) {
+            const double xjki = x[jj+ki-1];
+            const double num = xjki-t;
+            const double den = xjki-x[jj-1];
+            a = Q(ir);
+            b = Q(ir-1);
+            for(s=0;s<ns;s++) a[s] = a[s] + num*(b[s]-a[s])/den;
+            ir--;
+            jj--;
+        }
+
+        // LEFT HAND B-SPLINES
+        if(lk1i<=0) {
+            jj = ki;
+            lk1i1 = 1-lk1i;
+            for(j=1;j<=lk1i1;j++) {
+                const double dt = x[jj-1]-t;
+                a = Q(ir);
+                b = Q(ir-1);
+                for(s=0;s<ns;s++) a[s] = a[s] + dt*b[s];
+                jj--;
+                ir--;
+            }
+        }
+    }
+
+    // MULTIPLY BY THE FACTORIAL OF ider
+    a = Q(k);
+    for(s=0;s<ns;s++) {
+        double z = a[s];
+        for(j=k;j<=m2m1;j++) z *= j;
+        d[s] = z;
+    }
+}
+
+//_____________________________________________________________________________
+/**
+ * Fit the GCVSplines of the set and find those that share the knots and
+ * half order of the first of them, so that they can be evaluated together.
+ */
+void GCVSplineSet::
+prepare()
+{
+    int n = getSize();
+    _checkedSplines.assign(n, CheckedSpline{NULL, 0, false});
+    _sharedKnots.clear();
+    _sharedHalfOrder = 0;
+
+    for(int i=0;i<n;i++) {
+        GCVSpline *spline = dynamic_cast<GCVSpline*>(&get(i));
+        if(spline==NULL || spline->getSize()<spline->getOrder()) continue;
+        spline->fit();
+        const Array<double> &x = spline->getX();
+        if(_sharedKnots.empty()) {
+            _sharedKnots.assign(&x[0],&x[0]+x.getSize());
+            _sharedHalfOrder = spline->getHalfOrder();
+        }
+        CheckedSpline &checked = _checkedSplines[i];
+        checked.spline = spline;
+        checked.fitId = spline->getFitId();
+        checked.hasSharedKnots = 
+            spline->getHalfOrder()==_sharedHalfOrder &&
+            x.getSize()==(int)_sharedKnots.size() &&
+            std::equal(_sharedKnots.begin(),_sharedKnots.end(),&x[0]);
+    }
+}
+
+//_____________________________________________________________________________
+/**
+ * Evaluate a derivative of all the functions of the set at each of a number
+ * of values of the independent variable.
+ *
+ * @param aDerivOrder Derivative order; 0 evaluates the functions.
+ * @param aNumX Number of values of the independent variable.
+ * @param aX The values of the independent variable.
+ * @param rValues The derivative of function j at aX[i] is stored at
+ * [i*getSize()+j].
+ */
+void GCVSplineSet::
+evaluateAll(int aDerivOrder,int aNumX,const double *aX,double *rValues) const
+{
+    int n = getSize();
+    if(n==0 || aNumX<=0) return;
+
+    // SPLINES EVALUATED TOGETHER
+    // Those found by prepare() that are still in place and have not been
+    // refit or changed since.
+    std::vector<int> shared, others;
+    std::vector<const double*> coefs;
+    for(int j=0;j<n;j++) {
+        const CheckedSpline *checked = 
+            j<(int)_checkedSplines.size() ? &_checkedSplines[j] : NULL;
+        if(checked!=NULL && checked->hasSharedKnots &&
+            static_cast<const Function*>(checked->spline)==&get(j) &&
+            checked->fitId==checked->spline->getFitId()) {
+            shared.push_back(j);
+            coefs.push_back(&checked->spline->getCoefficients()[0]);
+        } else {
+            others.push_back(j);
+        }
+    }
+    int ns = (int)shared.size();
+    int nKnots = (int)_sharedKnots.size();
+    std::vector<double> q((size_t)2*_sharedHalfOrder*ns), d(ns);
+
+    int l = 0;
+    for(int i=0;i<aNumX;i++) {
+        double *values = rValues + (size_t)i*n;
+        if(ns>0) {
+            search(nKnots,const_cast<double*>(_sharedKnots.data()),aX[i],&l);
+            splderAll(aDerivOrder,_sharedHalfOrder,nKnots,aX[i],
+                _sharedKnots.data(),l,ns,coefs.data(),q.data(),d.data());
+            for(int s=0;s<ns;s++) values[shared[s]] = d[s];
+        }
+        for(int j : others) values[j] = evaluate(j,aDerivOrder,aX[i]);
+    }
+}
+
+//_____________________________________________________________________________
+/**
+ * Evaluate all the functions of the set, and their first and second
+ * derivatives, at aX.
+ */
+void GCVSplineSet::
+evaluateAll(double aX,double *rValues,double *rFirstDerivs,
+    double *rSecondDerivs) const
+{
+    if(rValues!=NULL) evaluateAll(0,1,&aX,rValues);
+    if(rFirstDerivs!=NULL) evaluateAll(1,1,&aX,rFirstDerivs);
+    if(rSecondDerivs!=NULL) evaluateAll(2,1,&aX,rSecondDerivs);
+}
+//_____________________________________________________________________________
+/**
+ * Evaluate all the functions of the set, and their first and second
+ * derivatives, at each of the values in aX.
+ */
+void GCVSplineSet::
+evaluateAll(const Array<double> &aX,Array<double> &rValues,
+    Array<double> *rFirstDerivs,Array<double> *rSecondDerivs) const
+{
+    int nx = aX.getSize();
+    int size = nx*getSize();
+    if(size==0) {
+        rValues.setSize(0);
+        if(rFirstDerivs!=NULL) rFirstDerivs->setSize(0);
+        if(rSecondDerivs!=NULL) rSecondDerivs->setSize(0);
+        return;
+    }
+    rValues.setSize(size);
+    evaluateAll(0,nx,&aX[0],&rValues[0]);
+    if(rFirstDerivs!=NULL) {
+        rFirstDerivs->setSize(size);
+        evaluateAll(1,nx,&aX[0],&(*rFirstDerivs)[0]);
+    }
+    if(rSecondDerivs!=NULL) {
+        rSecondDerivs->setSize(size);
+        evaluateAll(2,nx,&aX[0],&(*rSecondDerivs)[0]);
+    }
+}
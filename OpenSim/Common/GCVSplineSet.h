@@ -33,6 +33,7 @@
 #include "FunctionSet.h"
 #include "GCVSpline.h"
 #include "Storage.h"
+#include <vector>
 
 
 //=============================================================================
@@ -52,6 +53,19 @@ OpenSim_DECLARE_CONCRETE_OBJECT(GCVSplineSet, FunctionSet);
 // DATA
 //=============================================================================
 protected:
+    /** A spline of the set as found by prepare(). */
+    struct CheckedSpline {
+        const GCVSpline *spline;
+        int fitId;
+        bool hasSharedKnots;
+    };
+    /** Knots shared by the splines evaluated together by evaluateAll(). */
+    std::vector<double> _sharedKnots;
+    /** Half order of the splines evaluated together by evaluateAll(). */
+    int _sharedHalfOrder;
+    /** Whether each function of the set has the shared knots, as of the
+    given fit of the given spline. */
+    std::vector<CheckedSpline> _checkedSplines;
 
 //=============================================================================
 // METHODS
@@ -62,12 +76,14 @@ public:
     //--------------------------------------------------------------------------
     GCVSplineSet();
     GCVSplineSet(const char *aFileName);
-    GCVSplineSet(int aDegree,const Storage *aStore,double aErrorVariance=0.0);
+    GCVSplineSet(int aDegree,const Storage *aStore,double aErrorVariance=0.0,
+        int aNumThreads=-1);
     virtual ~GCVSplineSet();
 
 private:
     void setNull();
-    void construct(int aDegree,const Storage *aStore,double aErrorVariance);
+    void construct(int aDegree,const Storage *aStore,double aErrorVariance,
+        int aNumThreads);
 
     //--------------------------------------------------------------------------
     // SET AND GET
@@ -81,6 +97,48 @@ public:
     // UTILITY
     //--------------------------------------------------------------------------
     Storage* constructStorage(int aDerivOrder,double aDX=-1);
+    /**
+     * Fit the splines of the set and find those that share their knots and
+     * degree, so that evaluateAll() can evaluate them together. This is
+     * done on construction; call it again after changing the set or its
+     * splines; until then, the functions that changed are evaluated one at
+     * a time.
+     */
+    void prepare();
+
+    //--------------------------------------------------------------------------
+    // EVALUATION
+    //--------------------------------------------------------------------------
+    /**
+     * Evaluate all the functions of the set, and their first and second
+     * derivatives, at aX. Splines that share their knots and degree, such
+     * as those constructed from the columns of a Storage, are evaluated
+     * together: the knot interval containing aX is found once, and each
+     * step of the evaluation is done for all of the splines at a time.
+     * Other functions, and splines changed since prepare(), are evaluated
+     * one at a time. The set itself is not modified, so the splines found
+     * by prepare() can be evaluated on several threads at once.
+     *
+     * @param aX Value of the independent variable.
+     * @param rValues Values of the getSize() functions.
+     * @param rFirstDerivs First derivatives of the functions, or NULL.
+     * @param rSecondDerivs Second derivatives of the functions, or NULL.
+     */
+    void evaluateAll(double aX,double *rValues,
+        double *rFirstDerivs=NULL,double *rSecondDerivs=NULL) const;
+    /**
+     * Evaluate all the functions of the set, and their first and second
+     * derivatives, at each of the values in aX. The results for aX[i] are
+     * stored at [i*getSize()], [i*getSize()+1], ... of the output arrays,
+     * which are resized as needed.
+     */
+    void evaluateAll(const Array<double> &aX,Array<double> &rValues,
+        Array<double> *rFirstDerivs=NULL,
+        Array<double> *rSecondDerivs=NULL) const;
+
+private:
+    void evaluateAll(int aDerivOrder,int aNumX,const double *aX,
+        double *rValues) const;
 
 //=============================================================================
 };  // END class GCVSplineSet
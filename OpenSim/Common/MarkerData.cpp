@@ -26,6 +26,10 @@
 //=============================================================================
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 #include <math.h>
 #include <float.h>
 #include "MarkerData.h"
@@ -112,10 +116,6 @@ MarkerData::~MarkerData()
 void MarkerData::readTRCFile(const string& aFileName, MarkerData& aSMD)
 {
    ifstream in;
-   string line, buffer;
-   int frameNum, coordsRead;
-   double time;
-    SimTK::Vec3 coords;
 
     if (aFileName.empty())
         throw Exception("MarkerData.readTRCFile: ERROR- Marker file name is empty",__FILE__,__LINE__);
@@ -131,125 +131,131 @@ void MarkerData::readTRCFile(const string& aFileName, MarkerData& aSMD)
 
    readTRCFileHeader(in, aFileName, aSMD);
 
-   /* read frame data */
-   while (getline(in, line))
+   /* read the rest of the file, which holds the frames, in one go */
+   string data;
+   streampos dataStart = in.tellg();
+   if (dataStart != streampos(-1))
    {
-      /* skip over any blank lines */
-      if (findFirstNonWhiteSpace(line) == -1)
-         continue;
+      in.seekg(0, ios::end);
+      streamoff dataSize = in.tellg() - dataStart;
+      in.seekg(dataStart);
+      data.resize((size_t)dataSize);
+      in.read(&data[0], dataSize);
+      data.resize((size_t)in.gcount());
+   }
+   in.close();
 
-        if (aSMD._frames.getSize() == aSMD._numFrames)
+   readTRCFileData(data, aSMD);
+}
+
+//_____________________________________________________________________________
+/**
+ * Read the frames of a TRC file. The text is parsed in place, and the marker
+ * locations of all the frames are stored in one array sized from the number
+ * of frames in the header.
+ *
+ * Each row holds the frame number, the time and the XYZ coordinates of the
+ * markers, separated by tabs. A coordinate that is "NaN" or whose field is
+ * empty (e.g., the three consecutive tabs of a missing marker) is NaN, as are
+ * the coordinates missing at the end of a row. Extra coordinates at the end
+ * of a row and frames beyond the number in the header are ignored.
+ *
+ * @param aData text following the header of the file.
+ * @param aSMD MarkerData object to hold the file contents
+ */
+void MarkerData::readTRCFileData(const string& aData, MarkerData& aSMD)
+{
+    const int numMarkers = aSMD._numMarkers;
+    const int numCoords = 3*numMarkers;
+
+    aSMD._frameTimes.clear();
+    aSMD._frameNumbers.clear();
+    aSMD._markerLocations.clear();
+    if (aSMD._numFrames > 0)
+    {
+        aSMD._frameTimes.reserve(aSMD._numFrames);
+        aSMD._frameNumbers.reserve(aSMD._numFrames);
+        aSMD._markerLocations.reserve((size_t)aSMD._numFrames*numMarkers);
+    }
+
+    // aData is null terminated, so strtod() and strtol() stop at its end.
+    const char* p = aData.c_str();
+    const char* end = p + aData.size();
+    while (p < end && (int)aSMD._frameTimes.size() < aSMD._numFrames)
+    {
+        const char* lineEnd = (const char*)memchr(p, '\n', end - p);
+        if (lineEnd == NULL)
+            lineEnd = end;
+        const char* c = p;
+        p = (lineEnd < end) ? lineEnd + 1 : end;
+
+        /* skip over any blank lines */
+        while (c < lineEnd && isspace((unsigned char)*c))
+            c++;
+        if (c == lineEnd)
+            continue;
+
+        /* frame number and time */
+        char* numEnd;
+        int frameNum = (int)strtol(c, &numEnd, 10);
+        if (numEnd == c)
+            frameNum = (int)aSMD._frameTimes.size() + 1;
+        c = numEnd;
+        double time = strtod(c, &numEnd);
+        c = numEnd;
+
+        /* marker coordinates */
+        size_t first = aSMD._markerLocations.size();
+        aSMD._markerLocations.resize(first + numMarkers, Vec3(SimTK::NaN));
+        int coordsRead = 0;
+        bool fieldHasValue = true;
+        while (c < lineEnd && coordsRead < numCoords)
         {
-#if 0
-            if (gUseGlobalMessages)
+            if (*c == '\t')
             {
-                gErrorBuffer += "Extra data found at end of tracked marker file. ";
-                gErrorBuffer += "Header declared only " + intToString(trc->header.numFrames) + " frames.\n";
+                /* an empty field leaves its coordinate NaN */
+                if (!fieldHasValue)
+                    coordsRead++;
+                fieldHasValue = false;
+                c++;
+            }
+            else if (isspace((unsigned char)*c))
+                c++;
+            else
+            {
+                double value = strtod(c, &numEnd);
+                if (numEnd == c)
+                {
+                    /* not a number, skip it */
+                    while (c < lineEnd && !isspace((unsigned char)*c))
+                        c++;
+                    continue;
+                }
+                aSMD._markerLocations[first + coordsRead/3][coordsRead%3] = value;
+                coordsRead++;
+                fieldHasValue = true;
+                c = numEnd;
             }
-            rc = smFileWarning;
-#endif
-            break;
         }
 
-      if (!readIntegerFromString(line, &frameNum))
-      {
-#if 0
-         if (gUseGlobalMessages)
-            gErrorBuffer += "Could not read frame number in tracked marker file.\n";
-         rc = smFileError;
-         goto cleanup;
-#endif
-      }
-
-      if (!readDoubleFromString(line, &time))
-      {
-#if 0
-         if (gUseGlobalMessages)
-            gErrorBuffer += "Could not read time in tracked marker file.\n";
-         rc = smFileError;
-         goto cleanup;
-#endif
-      }
-
-        MarkerFrame *frame = new MarkerFrame(aSMD._numMarkers, frameNum, time, aSMD._units);
-
-      /* keep reading sets of coordinates until the end of the line is
-       * reached. If more coordinates were read than there are markers,
-       * return an error.
-       */
-      coordsRead = 0;
-      bool allowNaNs = true;
-      while (readCoordinatesFromString(line, &coords[0], allowNaNs))
-      {
-         if (coordsRead >= aSMD._numMarkers)
-         {
-            break;
-
-#if 0  // Don't return an error because many TRC files have extra data at the ends of rows
-            if (gUseGlobalMessages)
-               gErrorBuffer += "Extra data found in frame number " + intToString(frameNum) +
-                               " in tracked marker file.\n";
-            rc = smFileError;
-            // delete the current markerCoordList because framesRead has not been incremented yet.
-            delete [] f->markerCoordList;
-            goto cleanup;
-#endif
-         }
-         if (coordsRead < aSMD._numMarkers)
-                frame->addMarker(coords);
-         coordsRead++;
-      }
-
-      if (coordsRead < aSMD._numMarkers)
-      {
-#if 0
-         if (gUseGlobalMessages)
-            gErrorBuffer += " Missing data in frame number " + intToString(frameNum) +
-                            " in tracked marker file.\n";
-         rc = smFileError;
-         // delete the current markerCoordList because framesRead has not been incremented yet.
-         delete [] f->markerCoordList;
-         goto cleanup;
-#endif
-      }
-        aSMD._frames.append(frame);
-   }
+        aSMD._frameTimes.push_back(time);
+        aSMD._frameNumbers.push_back(frameNum);
+    }
 
-   if (aSMD._frames.getSize() < aSMD._numFrames)
-   {
-#if 0
-      if (gUseGlobalMessages)
-         gErrorBuffer += "Missing data in tracked marker file. Only " + intToString(framesRead) + " of " +
-                         intToString(trc->header.numFrames) + " frames found.\n";
-      rc = smFileError;
-      goto cleanup;
-#endif
-        aSMD._numFrames = aSMD._frames.getSize();
-   }
+   if ((int)aSMD._frameTimes.size() < aSMD._numFrames)
+        aSMD._numFrames = (int)aSMD._frameTimes.size();
 
    /* If the user-defined frame numbers are not contiguous from the first frame to the
     * last, reset them to a contiguous array. This is necessary because the user-defined
     * numbers are used to index the array of frames.
     */
-    if (aSMD._frames[aSMD._numFrames-1]->getFrameNumber() - aSMD._frames[0]->getFrameNumber() !=
-         aSMD._numFrames - 1)
+    if (aSMD._numFrames > 0 &&
+        aSMD._frameNumbers[aSMD._numFrames-1] - aSMD._frameNumbers[0] != aSMD._numFrames - 1)
    {
-        int firstIndex = aSMD._frames[0]->getFrameNumber();
+        int firstIndex = aSMD._frameNumbers[0];
       for (int i = 1; i < aSMD._numFrames; i++)
-            aSMD._frames[i]->setFrameNumber(firstIndex + i);
-   }
-
-#if 0
-   if (gUseGlobalMessages)
-   {
-      gMessage += "TRC file " + actualFileName + "\n\t" + intToString(trc->header.numFrames)
-                  + " frames\n\t" + intToString(trc->header.numMarkers) + " markers/frame\n";
-      gMessage += "Read " + intToString(framesRead) + " frames.\n";
+            aSMD._frameNumbers[i] = firstIndex + i;
    }
-#endif
-
-//cleanup:
-   in.close();
 }
 
 //_____________________________________________________________________________
@@ -512,20 +518,21 @@ void MarkerData::readStoFile(const string& aFileName)
     _fileName = aFileName;
     _units = Units(Units::Meters);
 
-    double time;
     int sz = store.getSize();
+    _frameTimes.resize(sz);
+    _frameNumbers.resize(sz);
+    _markerLocations.resize((size_t)sz*_numMarkers);
     for (int i=0; i < sz; i++){
         StateVector* nextRow = store.getStateVector(i);
-        time = nextRow->getTime();
-        int frameNum = i+1;
-        MarkerFrame *frame = new MarkerFrame(_numMarkers, frameNum, time, _units);
+        _frameTimes[i] = nextRow->getTime();
+        _frameNumbers[i] = i+1;
         const Array<double>& rowData = nextRow->getData();
         // Cycle through map and add Marker coordinates to the frame. Same order as header.
+        Vec3* frame = &_markerLocations[(size_t)i*_numMarkers];
         for (iter = markerIndices.begin(); iter != markerIndices.end(); iter++) {
             int startIndex = iter->first; // startIndex includes time but data doesn't!
-            frame->addMarker(SimTK::Vec3(rowData[startIndex-1], rowData[startIndex], rowData[startIndex+1]));
+            *frame++ = SimTK::Vec3(rowData[startIndex-1], rowData[startIndex], rowData[startIndex+1]);
         }
-        _frames.append(frame);
    }
    
 }
@@ -561,7 +568,8 @@ void MarkerData::buildMarkerMap(const Storage& storageToReadFrom, std::map<int,
 //_____________________________________________________________________________
 /**
  * Find the range of frames that is between start time and end time
- * (inclusive).
+ * (inclusive). The frame times are assumed to be increasing, so the
+ * frames are found by bisection.
  *
  * @param aStartTime start time.
  * @param aEndTime end time.
@@ -570,8 +578,6 @@ void MarkerData::buildMarkerMap(const Storage& storageToReadFrom, std::map<int,
  */
 void MarkerData::findFrameRange(double aStartTime, double aEndTime, int& rStartFrame, int& rEndFrame) const
 {
-    int i;
-
     rStartFrame = 0;
     rEndFrame = _numFrames - 1;
 
@@ -580,23 +586,17 @@ void MarkerData::findFrameRange(double aStartTime, double aEndTime, int& rStartF
         throw Exception("MarkerData: findFrameRange start time is past end time.");
     }
 
-    for (i = _numFrames - 1; i >= 0 ; i--)
-    {
-        if (_frames[i]->getFrameTime() <= aStartTime)
-        {
-            rStartFrame = i;
-            break;
-        }
-    }
-
-    for (i = rStartFrame; i < _numFrames; i++)
-    {
-        if (_frames[i]->getFrameTime() >= aEndTime - SimTK::Zero)
-        {
-            rEndFrame = i;
-            break;
-        }
-    }
+    /* last frame at or before the start time */
+    std::vector<double>::const_iterator begin = _frameTimes.begin();
+    std::vector<double>::const_iterator it =
+        std::upper_bound(begin, _frameTimes.end(), aStartTime);
+    if (it != begin)
+        rStartFrame = (int)(it - begin) - 1;
+
+    /* first frame from there at or after the end time */
+    it = std::lower_bound(begin + rStartFrame, _frameTimes.end(), aEndTime - SimTK::Zero);
+    if (it != _frameTimes.end())
+        rEndFrame = (int)(it - begin);
 }
 //_____________________________________________________________________________
 /**
@@ -610,7 +610,7 @@ double MarkerData::getStartFrameTime() const
     if (_numFrames<=0)
         return SimTK::NaN;
 
-    return(_frames[0]->getFrameTime());
+    return(_frameTimes[0]);
 
 }
 /**
@@ -623,7 +623,7 @@ double MarkerData::getLastFrameTime() const
     if (_numFrames<=0)
         return SimTK::NaN;
 
-    return(_frames[_numFrames-1]->getFrameTime());
+    return(_frameTimes[_numFrames-1]);
 }
 
 //_____________________________________________________________________________
@@ -650,7 +650,7 @@ void MarkerData::averageFrames(double aThreshold, double aStartTime, double aEnd
     double *minX = NULL, *minY = NULL, *minZ = NULL, *maxX = NULL, *maxY = NULL, *maxZ = NULL;
 
     findFrameRange(aStartTime, aEndTime, startIndex, endIndex);
-    MarkerFrame *averagedFrame = new MarkerFrame(*_frames[startIndex]);
+    std::vector<Vec3> averagedFrame(_numMarkers);
 
     /* If aThreshold is greater than zero, then calculate
      * the movement of each marker so you can check if it
@@ -679,15 +679,15 @@ void MarkerData::averageFrames(double aThreshold, double aStartTime, double aEnd
     for (int i = 0; i < _numMarkers; i++)
     {
         int numFrames = 0;
-        Vec3& avePt = averagedFrame->updMarker(i);
+        Vec3& avePt = averagedFrame[i];
         avePt = Vec3(0);
 
         for (int j = startIndex; j <= endIndex; j++)
         {
-            Vec3& pt = _frames[j]->updMarker(i);
+            const Vec3& pt = getMarker(j, i);
             if (!pt.isNaN())
             {
-                Vec3& coords = pt; //.get();
+                const Vec3& coords = pt; //.get();
                 avePt += coords;
                 numFrames++;
                 if (aThreshold > 0.0)
@@ -718,20 +718,22 @@ void MarkerData::averageFrames(double aThreshold, double aStartTime, double aEnd
     /* Store the indices from the file of the first frame and
      * last frame that were averaged, so you can report them later.
      */
-    int startUserIndex = _frames[startIndex]->getFrameNumber();
-    int endUserIndex = _frames[endIndex]->getFrameNumber();
+    int startUserIndex = _frameNumbers[startIndex];
+    int endUserIndex = _frameNumbers[endIndex];
+    double startTime = _frameTimes[startIndex];
 
     /* Now delete all the existing frames and insert the averaged one. */
-    _frames.clearAndDestroy();
-    _frames.append(averagedFrame);
+    _markerLocations.swap(averagedFrame);
+    _frameTimes.assign(1, startTime);
+    _frameNumbers.assign(1, startUserIndex);
     _numFrames = 1;
-    _firstFrameNumber = _frames[0]->getFrameNumber();
+    _firstFrameNumber = startUserIndex;
 
     if (aThreshold > 0.0)
     {
         for (int i = 0; i < _numMarkers; i++)
         {
-            Vec3& pt = _frames[0]->updMarker(i);
+            const Vec3& pt = getMarker(0, i);
 
             if (pt.isNaN())
             {
@@ -798,11 +800,11 @@ void MarkerData::makeRdStorage(Storage& rStorage)
     {
         for (int j = 0, index = 0; j < _numMarkers; j++)
         {
-            SimTK::Vec3& marker = _frames[i]->updMarker(j);
+            const SimTK::Vec3& marker = getMarker(i, j);
             for (int k = 0; k < 3; k++)
                 row[index++] = marker[k];
         }
-        rStorage.append(_frames[i]->getFrameTime(), numColumns, row);
+        rStorage.append(_frameTimes[i], numColumns, row);
     }
 
     delete [] row;
@@ -823,8 +825,8 @@ void MarkerData::convertToUnits(const Units& aUnits)
     if (!SimTK::isNaN(scaleFactor))
     {
         /* Scale all marker locations by the conversion factor. */
-        for (int i = 0; i < _frames.getSize(); i++)
-            _frames[i]->scale(scaleFactor);
+        for (size_t i = 0; i < _markerLocations.size(); i++)
+            _markerLocations[i] *= scaleFactor;
 
         /* Change the units for this object to the new ones. */
         _units = aUnits;
@@ -838,17 +840,38 @@ void MarkerData::convertToUnits(const Units& aUnits)
 //=============================================================================
 //_____________________________________________________________________________
 /**
- * Get a frame of marker data.
+ * Get a copy of a frame of marker data.
  *
  * @param aIndex index of the row to get.
- * @return Pointer to the frame of data.
+ * @return The frame of data.
  */
-const MarkerFrame& MarkerData::getFrame(int aIndex) const
+MarkerFrame MarkerData::getFrame(int aIndex) const
 {
     if (aIndex < 0 || aIndex >= _numFrames)
         throw Exception("MarkerData::getFrame() invalid frame index.");
 
-    return *_frames[aIndex];
+    MarkerFrame frame(_numMarkers, _frameNumbers[aIndex], _frameTimes[aIndex], _units);
+    for (int i = 0; i < _numMarkers; i++)
+        frame.addMarker(getMarker(aIndex, i));
+    return frame;
+}
+
+//_____________________________________________________________________________
+/**
+ * Get the locations of all the markers in a frame, without copying them.
+ *
+ * @param aFrameIndex index of the frame.
+ * @return View of the marker locations, in the order of the marker names.
+ */
+SimTK::ArrayViewConst_<Vec3> MarkerData::getMarkers(int aFrameIndex) const
+{
+    if (aFrameIndex < 0 || aFrameIndex >= _numFrames)
+        throw Exception("MarkerData::getMarkers() invalid frame index.");
+
+    if (_numMarkers == 0)
+        return SimTK::ArrayViewConst_<Vec3>();
+    const Vec3* first = &_markerLocations[(size_t)aFrameIndex*_numMarkers];
+    return SimTK::ArrayViewConst_<Vec3>(first, first + _numMarkers);
 }
 
 //_____________________________________________________________________________
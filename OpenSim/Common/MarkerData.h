@@ -33,6 +33,7 @@
 #include "ArrayPtrs.h"
 #include "MarkerFrame.h"
 #include "Units.h"
+#include <vector>
 
 namespace OpenSim {
 
@@ -41,6 +42,11 @@ namespace OpenSim {
 /**
  * A class implementing a sequence of marker frames from a TRC/TRB file.
  *
+ * The marker locations of all frames are kept in one contiguous array, frame
+ * after frame, with the markers of a frame stored next to each other in the
+ * order of getMarkerNames(). getMarker() and getMarkers() read them in place;
+ * getFrame() copies a frame into a MarkerFrame.
+ *
  * @author Peter Loan
  * @version 1.0
  */
@@ -62,7 +68,11 @@ private:
     std::string _fileName;
     Units _units;
     Array<std::string> _markerNames;
-    ArrayPtrs<MarkerFrame> _frames;
+    // Time and (user-defined) number of each frame.
+    std::vector<double> _frameTimes;
+    std::vector<int> _frameNumbers;
+    // Location of marker j in frame i is at [i*_numMarkers + j].
+    std::vector<SimTK::Vec3> _markerLocations;
 
 //=============================================================================
 // METHODS
@@ -79,7 +89,18 @@ public:
     void averageFrames(double aThreshold = -1.0, double aStartTime = -SimTK::Infinity, double aEndTime = SimTK::Infinity);
     const std::string& getFileName() const { return _fileName; }
     void makeRdStorage(Storage& rStorage);
-    const MarkerFrame& getFrame(int aIndex) const;
+    MarkerFrame getFrame(int aIndex) const;
+    /** Location of marker aMarkerIndex in frame aFrameIndex. */
+    const SimTK::Vec3& getMarker(int aFrameIndex, int aMarkerIndex) const
+    {   return _markerLocations[aFrameIndex*_numMarkers + aMarkerIndex]; }
+#ifndef SWIG
+    /** Locations of all the markers in frame aFrameIndex, without copying. */
+    SimTK::ArrayViewConst_<SimTK::Vec3> getMarkers(int aFrameIndex) const;
+#endif
+    double getFrameTime(int aFrameIndex) const
+    {   return _frameTimes[aFrameIndex]; }
+    int getFrameNumber(int aFrameIndex) const
+    {   return _frameNumbers[aFrameIndex]; }
     int getMarkerIndex(const std::string& aName) const;
     const Units& getUnits() const { return _units; }
     void convertToUnits(const Units& aUnits);
@@ -94,6 +115,7 @@ public:
 private:
     void readTRCFile(const std::string& aFileName, MarkerData& aSMD);
     void readTRCFileHeader(std::ifstream &in, const std::string& aFileName, MarkerData& aSMD);
+    void readTRCFileData(const std::string& aData, MarkerData& aSMD);
     void readTRBFile(const std::string& aFileName, MarkerData& aSMD);
     void readStoFile(const std::string& aFileName);
     void buildMarkerMap(const Storage& storageToReadFrom, std::map<int, std::string>& markerNames);
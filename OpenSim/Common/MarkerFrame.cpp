@@ -56,7 +56,7 @@ MarkerFrame::MarkerFrame() :
  * @param aTime the time of the frame
  * @param aUnits the units of the XYZ marker coordinates
  */
-MarkerFrame::MarkerFrame(int aNumMarkers, int aFrameNumber, double aTime, Units& aUnits) :
+MarkerFrame::MarkerFrame(int aNumMarkers, int aFrameNumber, double aTime, const Units& aUnits) :
     _numMarkers(aNumMarkers),
     _frameNumber(aFrameNumber),
     _frameTime(aTime),
@@ -63,7 +63,7 @@ private:
     //--------------------------------------------------------------------------
 public:
     MarkerFrame();
-    MarkerFrame(int aNumMarkers, int aFrameNumber, double aTime, Units& aUnits);
+    MarkerFrame(int aNumMarkers, int aFrameNumber, double aTime, const Units& aUnits);
     MarkerFrame(const MarkerFrame& aFrame);
     virtual ~MarkerFrame();
 
@@ -38,12 +38,15 @@
 #include "PropertyDblVec.h"
 #include "PropertyTransform.h"
 #include "IO.h"
+#include "BinaryIO.h"
 
 #include "Simbody.h"
 
 #include <fstream>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <cctype>
 #include <algorithm>
 
 using namespace OpenSim;
@@ -663,32 +666,28 @@ getRegisteredTypenames(Array<std::string>& rTypeNames)
 //-----------------------------------------------------------------------------
 template<class T> static void 
 UpdateFromXMLNodeSimpleProperty(Property_Deprecated* aProperty, 
-                                SimTK::Xml::Element& aNode, 
-                                const string&        aName)
+                                SimTK::Xml::Element  aElement)
 {
     aProperty->setValueIsDefault(true);
 
-    SimTK::Xml::element_iterator iter = aNode.element_begin(aName);
-    if (iter == aNode.element_end()) return;    // Not found
+    if (!aElement.isValid()) return;    // Not found
 
     T value;
-    iter->getValueAs(value); // fails for Nan, infinity, -infinity, true/false
+    aElement.getValueAs(value); // fails for Nan, infinity, -infinity, true/false
     aProperty->setValue(value);
     aProperty->setValueIsDefault(false);
 }
 
 template<class T> static void 
 UpdateFromXMLNodeArrayProperty(Property_Deprecated* aProperty, 
-                               SimTK::Xml::Element& aNode, 
-                               const string&        aName)
+                               SimTK::Xml::Element  aElement)
 {
     aProperty->setValueIsDefault(true);
 
-    SimTK::Xml::element_iterator iter = aNode.element_begin(aName);
-    if (iter == aNode.element_end()) return;    // Not found
+    if (!aElement.isValid()) return;    // Not found
 
     SimTK::Array_<T> value;
-    iter->getValueAs(value);
+    aElement.getValueAs(value);
 
     OpenSim::Array<T> osimValue;
     osimValue.setSize(value.size());
@@ -697,6 +696,29 @@ UpdateFromXMLNodeArrayProperty(Property_Deprecated* aProperty,
     aProperty->setValueIsDefault(false);
 }
 
+// If aText is one of the special double values that getValueAs<double>()
+// cannot read (infinity, inf, nan, in any case, and -infinity, -inf), set
+// aValue to it and return true. Only text that does not start like a number
+// is lower-cased and compared.
+static bool
+ReadSpecialDoubleValue(const SimTK::String& aText, double& aValue)
+{
+    const size_t first = (!aText.empty() && aText[0] == '-') ? 1 : 0;
+    if (first >= aText.size() || !isalpha((unsigned char)aText[first]))
+        return false;
+
+    const SimTK::String lowerCaseText = aText.toLower();
+    if (lowerCaseText=="infinity" || lowerCaseText=="inf")
+        aValue = SimTK::Infinity;
+    else if (lowerCaseText=="-infinity" || lowerCaseText=="-inf")
+        aValue = -SimTK::Infinity;
+    else if (lowerCaseText=="nan")
+        aValue = SimTK::NaN;
+    else
+        return false;
+    return true;
+}
+
 //------------------------------------------------------------------------------
 // OBJECT XML METHODS
 //------------------------------------------------------------------------------
@@ -816,10 +838,26 @@ try {
     // UPDATE DEFAULT OBJECTS
     updateDefaultObjectsFromXMLNode(); // May need to pass in aNode
 
+    // INDEX THE CHILD ELEMENTS
+    // Walk the child elements once, keeping the first element with each tag,
+    // so each property below finds its element by name without scanning
+    // the children again.
+    std::unordered_map<std::string, SimTK::Xml::Element> elements;
+    for (SimTK::Xml::element_iterator iter = aNode.element_begin();
+            iter != aNode.element_end(); ++iter)
+        elements.emplace(iter->getElementTag(), *iter);
+    const SimTK::Xml::Element notFound;
+    auto findElement = [&](const std::string& tag) {
+        auto found = elements.find(tag);
+        return found == elements.end() ? notFound : found->second;
+    };
+
     // LOOP THROUGH PROPERTIES
     for(int i=0; i < _propertyTable.getNumProperties(); ++i) {
         AbstractProperty& prop = _propertyTable.updAbstractPropertyByIndex(i);
-        prop.readFromXMLParentElement(aNode, versionNumber);
+        prop.readFromXMLParentElement(aNode,
+            prop.isUnnamedProperty() ? notFound : findElement(prop.getName()),
+            versionNumber);
     }
 
     // LOOP THROUGH DEPRECATED PROPERTIES
@@ -835,7 +873,8 @@ try {
         string name = property->getName();
         SimTK::String valueString;
         SimTK::String lowerCaseValueString;
-        SimTK::Xml::element_iterator iter;
+        SimTK::Xml::Element elt;
+        double dblValue;
         SimTK::Array_<SimTK::String> value;
         OpenSim::Array<bool> osimValue;
         // VALUE
@@ -844,9 +883,9 @@ try {
         // Bool
         case(Property_Deprecated::Bool) : 
             property->setValueIsDefault(true);
-            iter= aNode.element_begin(name);
-            if (iter == aNode.element_end()) break; // Not found
-            iter->getValueAs(valueString); // true/false
+            elt = findElement(name);
+            if (!elt.isValid()) break; // Not found
+            elt.getValueAs(valueString); // true/false
             lowerCaseValueString = valueString.toLower();
             property->setValue(lowerCaseValueString=="true"?true:false);
             //UpdateFromXMLNodeSimpleProperty<bool>(property, aNode, name);
@@ -854,36 +893,31 @@ try {
             break;
         // Int
         case(Property_Deprecated::Int) :
-            UpdateFromXMLNodeSimpleProperty<int>(property, aNode, name);
+            UpdateFromXMLNodeSimpleProperty<int>(property, findElement(name));
             break;
         // Double
         case(Property_Deprecated::Dbl) :
             property->setValueIsDefault(true);
-            iter= aNode.element_begin(name);
-            if (iter == aNode.element_end()) continue;  // Not found
-            iter->getValueAs(valueString); // special values
-            lowerCaseValueString = valueString.toLower();
-            if (lowerCaseValueString=="infinity" || lowerCaseValueString=="inf")
-                property->setValue(SimTK::Infinity);
-            else if (lowerCaseValueString=="-infinity" || lowerCaseValueString=="-inf")
-                property->setValue(-SimTK::Infinity);
-            else if (lowerCaseValueString=="nan")
-                property->setValue(SimTK::NaN);
+            elt = findElement(name);
+            if (!elt.isValid()) continue;  // Not found
+            elt.getValueAs(valueString); // special values
+            if (ReadSpecialDoubleValue(valueString, dblValue))
+                property->setValue(dblValue);
             else
-                UpdateFromXMLNodeSimpleProperty<double>(property, aNode, name);
+                UpdateFromXMLNodeSimpleProperty<double>(property, elt);
             property->setValueIsDefault(false);
             break;
         // Str
         case(Property_Deprecated::Str) : 
-            UpdateFromXMLNodeSimpleProperty<string>(property, aNode, name);
+            UpdateFromXMLNodeSimpleProperty<string>(property, findElement(name));
             break;
         // BoolArray
         case(Property_Deprecated::BoolArray) : 
             // Parse as a String array then map true/false to boolean values
             property->setValueIsDefault(true);
-            iter = aNode.element_begin(name);
-            if (iter == aNode.element_end()) continue;  // Not found
-            iter->getValueAs(value);
+            elt = findElement(name);
+            if (!elt.isValid()) continue;  // Not found
+            elt.getValueAs(value);
             //cout << value << endl;
             osimValue.setSize(value.size());
             for(unsigned i=0; i< value.size(); i++) osimValue[i]=(value[i]=="true");
@@ -892,32 +926,32 @@ try {
             break;
         // IntArray
         case(Property_Deprecated::IntArray) :
-            UpdateFromXMLNodeArrayProperty<int>(property,aNode,name);
+            UpdateFromXMLNodeArrayProperty<int>(property,findElement(name));
             break;
         // DblArray
         case(Property_Deprecated::DblArray) :
         case(Property_Deprecated::DblVec) :
         case(Property_Deprecated::Transform) :
-            UpdateFromXMLNodeArrayProperty<double>(property,aNode,name);
+            UpdateFromXMLNodeArrayProperty<double>(property,findElement(name));
             break;
         // StrArray
         case(Property_Deprecated::StrArray) :
-            UpdateFromXMLNodeArrayProperty<string>(property,aNode,name);
+            UpdateFromXMLNodeArrayProperty<string>(property,findElement(name));
             break;
 
         // Obj
         case(Property_Deprecated::Obj) : {
             property->setValueIsDefault(true);
             Object &object = property->getValueObj();
-            SimTK::Xml::element_iterator iter = 
-                aNode.element_begin(object.getConcreteClassName());
-            if (iter == aNode.element_end()) 
-                continue;   // No element of this object type found.
 
             // If matchName is set, search through elements of this type to find
             // one that has a "name" attribute that matches the name of this
             // object.
             if (property->getMatchName()) {
+                SimTK::Xml::element_iterator iter = 
+                    aNode.element_begin(object.getConcreteClassName());
+                if (iter == aNode.element_end()) 
+                    continue;   // No element of this object type found.
                 while(object.getName() != 
                         iter->getOptionalAttributeValueAs<std::string>("name", dName) 
                       && iter != aNode.element_end()) 
@@ -929,7 +963,10 @@ try {
                     property->setValueIsDefault(false);
                 }
             else {
-                object.readObjectFromXMLNodeOrFile(*iter, versionNumber);
+                elt = findElement(object.getConcreteClassName());
+                if (!elt.isValid()) 
+                    continue;   // No element of this object type found.
+                object.readObjectFromXMLNodeOrFile(elt, versionNumber);
                 property->setValueIsDefault(false);
             }
             break; 
@@ -941,8 +978,8 @@ try {
             property->setValueIsDefault(true);
 
             // FIND THE PROPERTY ELEMENT (in aNode)
-            const SimTK::Xml::element_iterator propElementIter = aNode.element_begin(name);
-            if (propElementIter==aNode.element_end()) 
+            SimTK::Xml::Element propElement = findElement(name);
+            if (!propElement.isValid()) 
                 break;
 
             if(type==Property_Deprecated::ObjArray) {
@@ -959,8 +996,8 @@ try {
             // by the element's tag.
             Object *object =NULL;
             int objectsFound = 0;
-            SimTK::Xml::element_iterator iter = propElementIter->element_begin();
-            while(iter != propElementIter->element_end()){
+            SimTK::Xml::element_iterator iter = propElement.element_begin();
+            while(iter != propElement.element_end()){
                 // Create an Object of the element tag's type.
                 object = newInstanceOfType(iter->getElementTag());
                 if (!object) { 
@@ -1350,6 +1387,260 @@ setAllPropertiesUseDefault(bool aUseDefault)
     }
 }
 
+//=============================================================================
+// BINARY
+//=============================================================================
+//-----------------------------------------------------------------------------
+// LOCAL STATIC UTILITY FUNCTIONS
+//-----------------------------------------------------------------------------
+// Deprecated properties hold their values in type-specific ways, so they are
+// written and read here rather than by the properties themselves.
+template<class T> static void 
+WriteBinaryArrayProperty(const Property_Deprecated* aProperty, ostream& out)
+{
+    const Array<T>& value = aProperty->getValueArray<T>();
+    BinaryIO::write(out, value.getSize());
+    for (int i=0; i < value.getSize(); ++i)
+        BinaryIO::write(out, value[i]);
+}
+
+template<class T> static void 
+ReadBinaryArrayProperty(Property_Deprecated* aProperty, istream& in)
+{
+    int n;
+    BinaryIO::read(in, n);
+    if (n < 0)
+        throw Exception("Object: corrupt array size in binary data for "
+            "property " + aProperty->getName() + ".", __FILE__, __LINE__);
+    Array<T> value;
+    value.setSize(n);
+    for (int i=0; i < n; ++i) {
+        T element;
+        BinaryIO::read(in, element);
+        value[i] = element;
+    }
+    aProperty->setValue(value);
+}
+
+static void 
+WriteBinaryDeprecatedProperty(const Property_Deprecated* prop, ostream& out)
+{
+    switch(prop->getType()) {
+    case(Property_Deprecated::Bool) :
+        BinaryIO::write(out, prop->getValueBool());
+        break;
+    case(Property_Deprecated::Int) :
+        BinaryIO::write(out, prop->getValueInt());
+        break;
+    case(Property_Deprecated::Dbl) :
+        BinaryIO::write(out, prop->getValueDbl());
+        break;
+    case(Property_Deprecated::Str) :
+        BinaryIO::write(out, prop->getValueStr());
+        break;
+    case(Property_Deprecated::BoolArray) :
+        WriteBinaryArrayProperty<bool>(prop, out);
+        break;
+    case(Property_Deprecated::IntArray) :
+        WriteBinaryArrayProperty<int>(prop, out);
+        break;
+    case(Property_Deprecated::DblArray) :
+    case(Property_Deprecated::DblVec) :
+        WriteBinaryArrayProperty<double>(prop, out);
+        break;
+    case(Property_Deprecated::StrArray) :
+        WriteBinaryArrayProperty<string>(prop, out);
+        break;
+    case(Property_Deprecated::Transform) :
+        BinaryIO::write(out, 
+            ((const PropertyTransform*)prop)->getValueTransform());
+        break;
+    case(Property_Deprecated::Obj) :
+        prop->getValueObj().writeBinary(out);
+        break;
+    case(Property_Deprecated::ObjArray) :
+        BinaryIO::write(out, prop->getArraySize());
+        for (int j=0; j < prop->getArraySize(); ++j)
+            prop->getValueObjPtr(j)->writeBinary(out);
+        break;
+    case(Property_Deprecated::ObjPtr) : {
+        const Object* object = prop->getValueObjPtr();
+        BinaryIO::write(out, object != nullptr);
+        if (object) object->writeBinary(out);
+        break; }
+    default :
+        throw Exception("Object: cannot write property " + prop->getName() 
+            + " of type " + prop->getTypeName() + " in binary.",
+            __FILE__, __LINE__);
+    }
+}
+
+static void 
+ReadBinaryDeprecatedProperty(Property_Deprecated* prop, istream& in)
+{
+    switch(prop->getType()) {
+    case(Property_Deprecated::Bool) : {
+        bool value;
+        BinaryIO::read(in, value);
+        prop->setValue(value);
+        break; }
+    case(Property_Deprecated::Int) : {
+        int value;
+        BinaryIO::read(in, value);
+        prop->setValue(value);
+        break; }
+    case(Property_Deprecated::Dbl) : {
+        double value;
+        BinaryIO::read(in, value);
+        prop->setValue(value);
+        break; }
+    case(Property_Deprecated::Str) : {
+        string value;
+        BinaryIO::read(in, value);
+        prop->setValue(value);
+        break; }
+    case(Property_Deprecated::BoolArray) :
+        ReadBinaryArrayProperty<bool>(prop, in);
+        break;
+    case(Property_Deprecated::IntArray) :
+        ReadBinaryArrayProperty<int>(prop, in);
+        break;
+    case(Property_Deprecated::DblArray) :
+    case(Property_Deprecated::DblVec) :
+        ReadBinaryArrayProperty<double>(prop, in);
+        break;
+    case(Property_Deprecated::StrArray) :
+        ReadBinaryArrayProperty<string>(prop, in);
+        break;
+    case(Property_Deprecated::Transform) : {
+        SimTK::Transform value;
+        BinaryIO::read(in, value);
+        ((PropertyTransform*)prop)->setValue(value);
+        break; }
+    case(Property_Deprecated::Obj) :
+        prop->getValueObj().readBinary(in);
+        break;
+    case(Property_Deprecated::ObjArray) : {
+        int n;
+        BinaryIO::read(in, n);
+        prop->clearObjArray();
+        for (int j=0; j < n; ++j)
+            prop->appendValue(Object::newInstanceFromBinary(in));
+        break; }
+    case(Property_Deprecated::ObjPtr) : {
+        bool hasObject;
+        BinaryIO::read(in, hasObject);
+        prop->setValue(hasObject ? Object::newInstanceFromBinary(in) : nullptr);
+        break; }
+    default :
+        throw Exception("Object: cannot read property " + prop->getName() 
+            + " of type " + prop->getTypeName() + " in binary.",
+            __FILE__, __LINE__);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// OBJECT BINARY METHODS
+//-----------------------------------------------------------------------------
+// The name is followed by the new-style properties and then the deprecated
+// ones. Each property is written with its name, so that it is found by name
+// when read, and with its use-default flag, so that printing the object read
+// back writes the same XML.
+void Object::
+writeBinary(ostream& out) const
+{
+    BinaryIO::write(out, getConcreteClassName());
+    BinaryIO::write(out, getName());
+
+    BinaryIO::write(out, _propertyTable.getNumProperties());
+    for (int i=0; i < _propertyTable.getNumProperties(); ++i) {
+        const AbstractProperty& prop = 
+            _propertyTable.getAbstractPropertyByIndex(i);
+        BinaryIO::write(out, prop.getName());
+        BinaryIO::write(out, prop.getValueIsDefault());
+        prop.writeToBinary(out);
+    }
+
+    BinaryIO::write(out, _propertySet.getSize());
+    for (int i=0; i < _propertySet.getSize(); ++i) {
+        const Property_Deprecated* prop = _propertySet.get(i);
+        BinaryIO::write(out, prop->getName());
+        BinaryIO::write(out, prop->getValueIsDefault());
+        WriteBinaryDeprecatedProperty(prop, out);
+    }
+}
+
+void Object::
+readBinary(istream& in)
+{
+    string className;
+    BinaryIO::read(in, className);
+    if (className != getConcreteClassName())
+        throw Exception("Object::readBinary(): expected an object of type " 
+            + getConcreteClassName() + " but found " + className + ".",
+            __FILE__, __LINE__);
+    updateFromBinary(in);
+}
+
+Object* Object::
+newInstanceFromBinary(istream& in)
+{
+    string className;
+    BinaryIO::read(in, className);
+    Object* object = newInstanceOfType(className);
+    if (!object)
+        throw Exception("Object::newInstanceFromBinary(): object type " 
+            + className + " is not registered.", __FILE__, __LINE__);
+    try {
+        object->updateFromBinary(in);
+    } catch (...) {
+        delete object;
+        throw;
+    }
+    return object;
+}
+
+void Object::
+updateFromBinary(istream& in)
+{
+    string name;
+    BinaryIO::read(in, name);
+    setName(name);
+
+    int n;
+    BinaryIO::read(in, n);
+    for (int i=0; i < n; ++i) {
+        string propName;
+        bool isDefault;
+        BinaryIO::read(in, propName);
+        BinaryIO::read(in, isDefault);
+        // An unnamed property is named by its object type tag.
+        const int index = _propertyTable.findPropertyIndex(propName);
+        if (index < 0)
+            throw Exception("Object::updateFromBinary(): " 
+                + getConcreteClassName() + " has no property " + propName 
+                + ".", __FILE__, __LINE__);
+        AbstractProperty& prop = _propertyTable.updAbstractPropertyByIndex(index);
+        prop.readFromBinary(in);
+        prop.setValueIsDefault(isDefault);
+    }
+
+    BinaryIO::read(in, n);
+    for (int i=0; i < n; ++i) {
+        string propName;
+        bool isDefault;
+        BinaryIO::read(in, propName);
+        BinaryIO::read(in, isDefault);
+        Property_Deprecated* prop = _propertySet.contains(propName);
+        if (!prop)
+            throw Exception("Object::updateFromBinary(): " 
+                + getConcreteClassName() + " has no property " + propName 
+                + ".", __FILE__, __LINE__);
+        ReadBinaryDeprecatedProperty(prop, in);
+        prop->setValueIsDefault(isDefault);
+    }
+}
+
 //=============================================================================
 // IO
 //=============================================================================
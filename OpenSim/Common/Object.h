@@ -573,6 +573,38 @@ public:
     Mainly intended for debugging and for use by the XML browser in the GUI. **/
     std::string dump(bool dumpName=false); 
     /**@}**/
+
+    //--------------------------------------------------------------------------
+    // BINARY
+    //--------------------------------------------------------------------------
+    /** @name                 Binary reading and writing
+    These methods write the same information as the XML methods -- the
+    concrete class name, the name and the property values of this %Object and
+    of all the objects it contains -- in a compact binary form that can be
+    read back much faster than XML, because no text needs to be parsed. The
+    binary form is tied to the version of %OpenSim and the kind of machine
+    that wrote it (see BinaryIO), so it is meant for caching objects that
+    were read from XML, not for exchanging them. **/
+    /**@{**/
+    /** Write the concrete class name of this %Object, followed by its name
+    and properties, to a binary stream. **/
+    void writeBinary(std::ostream& out) const;
+
+    /** Read an %Object written by writeBinary() into this %Object, which
+    must have the same concrete class. **/
+    void readBinary(std::istream& in);
+
+    /** Create a new %Object of the concrete class written by writeBinary()
+    and read it from the stream. The caller owns the returned %Object. **/
+    static Object* newInstanceFromBinary(std::istream& in);
+
+    /** Read the name and properties of this %Object from a binary stream;
+    the concrete class name has already been read. Like updateFromXMLNode(),
+    override this if your %Object computes data members from its properties
+    when it is read; call the base class method first. **/
+    virtual void updateFromBinary(std::istream& in);
+    /**@}**/
+
     //--------------------------------------------------------------------------
     // ADVANCED/OBSCURE/QUESTIONABLE/BUGGY
     //--------------------------------------------------------------------------
@@ -1265,6 +1297,36 @@ ObjectProperty<T>::writeToXMLElement
         (objects[i])->updateXMLNode(propertyElement);
 }
 
+// The number of objects followed by each object, which starts with its
+// concrete class name.
+template <class T> inline void 
+ObjectProperty<T>::writeToBinary(std::ostream& out) const 
+{
+    BinaryIO::write(out, (int)objects.size());
+    for (int i=0; i < objects.size(); ++i)
+        (objects[i])->writeBinary(out);
+}
+
+template <class T> inline void 
+ObjectProperty<T>::readFromBinary(std::istream& in) 
+{
+    clearValues();
+    int n;
+    BinaryIO::read(in, n);
+    for (int i=0; i < n; ++i) {
+        Object* object = Object::newInstanceFromBinary(in);
+        T* objectT = dynamic_cast<T*>(object);
+        if (!objectT) {
+            const std::string type = object->getConcreteClassName();
+            delete object;
+            throw OpenSim::Exception("ObjectProperty<T>::readFromBinary(): "
+                "object type " + type + " is wrong for " + objectClassName 
+                + " property " + this->getName() + ".");
+        }
+        adoptAndAppendValueVirtual(objectT); // don't copy
+    }
+}
+
 
 template <class T> inline void 
 ObjectProperty<T>::setValueAsObject(const Object& obj, int index) {
@@ -314,6 +314,12 @@ void PiecewiseLinearFunction::updateFromXMLNode(SimTK::Xml::Element& aNode, int
     calcCoefficients();
 }   
 
+void PiecewiseLinearFunction::updateFromBinary(std::istream& in)
+{
+    Function::updateFromBinary(in);
+    calcCoefficients();
+}
+
 double PiecewiseLinearFunction::getX(int aIndex) const
 {
     if (aIndex >= 0 && aIndex < _x.getSize())
@@ -124,6 +124,7 @@ public:
     SimTK::Function* createSimTKFunction() const override;
 
     void updateFromXMLNode(SimTK::Xml::Element& aNode, int versionNumber=-1) override;
+    void updateFromBinary(std::istream& in) override;
 
 private:
    void calcCoefficients();
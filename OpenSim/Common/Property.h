@@ -25,6 +25,7 @@
 
 // INCLUDES
 #include "AbstractProperty.h"
+#include "BinaryIO.h"
 #include "Exception.h"
 
 namespace OpenSim {
@@ -777,6 +778,24 @@ public:
         propertyElement.setValue(valstream.str()); 
     } 
 
+    // The number of values followed by the values.
+    void writeToBinary(std::ostream& out) const override final {
+        BinaryIO::write(out, (int)values.size());
+        for (int i=0; i < values.size(); ++i)
+            BinaryIO::write(out, values[i]);
+    }
+
+    void readFromBinary(std::istream& in) override final {
+        int n;
+        BinaryIO::read(in, n);
+        if (n < 0 || n > this->getMaxListSize())
+            throw OpenSim::Exception("SimpleProperty<T>::readFromBinary(): "
+                "bad number of values for property " + this->getName() + ".");
+        values.resize(n);
+        for (int i=0; i < n; ++i)
+            BinaryIO::read(in, values[i]);
+    }
+
 
     const Object& getValueAsObject(int index=-1) const override final {
         throw OpenSim::Exception(
@@ -968,6 +987,8 @@ public:
         int                  versionNumber) override final;
     void writeToXMLElement
        (SimTK::Xml::Element& propertyElement) const override final;
+    void writeToBinary(std::ostream& out) const override final;
+    void readFromBinary(std::istream& in) override final;
     void setValueAsObject(const Object& obj, int index=-1) override final;
 
     bool isUnnamedProperty() const override final {return isUnnamed;}
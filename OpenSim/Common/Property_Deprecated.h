@@ -153,6 +153,12 @@ public:
        (SimTK::Xml::Element& propertyElement) const override
     {assert(!"Property_Deprecated::writeToXMLElement not implemented");}
 
+    // Deprecated properties are also written and read by Object.
+    void writeToBinary(std::ostream& out) const override
+    {assert(!"Property_Deprecated::writeToBinary not implemented");}
+    void readFromBinary(std::istream& in) override
+    {assert(!"Property_Deprecated::readFromBinary not implemented");}
+
     // Override for array types.
     int getNumValues() const override {return 1;}
     void clearValues() override {assert(!"implemented");}
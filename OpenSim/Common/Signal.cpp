@@ -27,8 +27,11 @@
 
 
 // INCLUDES
+#include <algorithm>
+#include <functional>
 #include <iostream>
 #include <string>
+#include <vector>
 #include <math.h>
 #include "Signal.h"
 #include "Array.h"
@@ -140,32 +143,15 @@ SmoothSpline(int degree,double T,double fc,int N,double *times,double *sig,doubl
 //-----------------------------------------------------------------------------
 //_____________________________________________________________________________
 /**
- * 3rd ORDER LOWPASS IIR BUTTERWORTH DIGITAL FILTER
- *
- * It is assumed that enough memory is allocated at sigf.
- * Note also that the first and last three data points are not filtered.
- *
- *  @param T Sample interval in seconds.
- *  @param fc Cutoff frequency in Hz.
- *  @param N Number of data points in the signal.
- *  @param sig The sampled signal.
- *  @param sigf The filtered signal.
- *
- * @return 0 on success, and -1 on failure.
+ * Coefficients of the 3rd order lowpass IIR Butterworth filter, shared by the
+ * single- and multi-signal filters so that both filter identically.
+ * The cutoff frequency is lowered if it is not below half the sample
+ * frequency.
  */
-int Signal::
-LowpassIIR(double T,double fc,int N,double *sig,double *sigf)
+static void
+calcLowpassIIRCoefficients(double T,double fc,double a[4],double b[4])
 {
-int i,j;
-double fs,ws,wc,wa,wa2,wa3;
-double a[4],b[4],denom;
-double *sigr;
-
-    // ERROR CHECK
-    if(T==0) return(-1);
-    if(N==0) return(-1);
-    if(sig==NULL) return(-1);
-    if(sigf==NULL) return(-1);
+double fs,wc,wa,wa2,wa3,denom;
 
     // CHECK THAT THE CUTOFF FREQUENCY IS LESS THAN HALF THE SAMPLE FREQUENCY
     fs = 1 / T;
@@ -177,7 +163,6 @@ double *sigr;
     }
 
     // INITIALIZE SOME VARIABLES
-    ws = 2*SimTK_PI*fs;
     wc = 2*SimTK_PI*fc;
 
     // CALCULATE THE FREQUENCY WARPING
@@ -195,6 +180,37 @@ double *sigr;
     b[1] = (3*wa3 + 2*wa2 - 2*wa - 3) / denom; 
     b[2] = (3*wa3 - 2*wa2 - 2*wa + 3) / denom; 
     b[3] = (wa - 1) * (wa2 - wa + 1) / denom;
+}
+//_____________________________________________________________________________
+/**
+ * 3rd ORDER LOWPASS IIR BUTTERWORTH DIGITAL FILTER
+ *
+ * It is assumed that enough memory is allocated at sigf.
+ * Note also that the first and last three data points are not filtered.
+ *
+ *  @param T Sample interval in seconds.
+ *  @param fc Cutoff frequency in Hz.
+ *  @param N Number of data points in the signal.
+ *  @param sig The sampled signal.
+ *  @param sigf The filtered signal.
+ *
+ * @return 0 on success, and -1 on failure.
+ */
+int Signal::
+LowpassIIR(double T,double fc,int N,double *sig,double *sigf)
+{
+int i,j;
+double a[4],b[4];
+double *sigr;
+
+    // ERROR CHECK
+    if(T==0) return(-1);
+    if(N==0) return(-1);
+    if(sig==NULL) return(-1);
+    if(sigf==NULL) return(-1);
+
+    // GET COEFFICIENTS FOR THE FILTER
+    calcLowpassIIRCoefficients(T,fc,a,b);
 
     // ALLOCATE MEMORY FOR sigr[]
     sigr = new double[N];
@@ -391,6 +407,198 @@ double *s;
   return(0);
 }
 
+//=============================================================================
+// MULTI-SIGNAL FILTERS
+//=============================================================================
+namespace {
+// Number of signals filtered together by the block filters. Each sample of a
+// block is stored as ColumnBlockSize consecutive values, one per signal, so
+// the loops over the signals of a block vectorize.
+const int ColumnBlockSize = 8;
+
+// Calls the function for each index from 0 to n-1, on up to numThreads
+// threads.
+class ForEachTask : public SimTK::ParallelExecutor::Task {
+public:
+    explicit ForEachTask(const std::function<void(int)>& f) : _f(f) {}
+    void execute(int index) override { _f(index); }
+private:
+    const std::function<void(int)>& _f;
+};
+
+void forEach(int n, int numThreads, const std::function<void(int)>& f)
+{
+    numThreads = std::min(numThreads, n);
+    if (numThreads <= 1) {
+        for (int i = 0; i < n; ++i) f(i);
+        return;
+    }
+    ForEachTask task(f);
+    SimTK::ParallelExecutor executor(numThreads);
+    executor.execute(task, n);
+}
+
+// Copy sample i of signal c of a block into s[(offset+i)*B + c].
+void gatherBlock(int N, int numSignals, const double *sig, int offset,
+                 double *s)
+{
+    const int B = ColumnBlockSize;
+    for (int c = 0; c < numSignals; ++c) {
+        const double *sigc = sig + (size_t)c*N;
+        for (int i = 0; i < N; ++i) s[(size_t)(offset+i)*B + c] = sigc[i];
+    }
+}
+} // anonymous namespace
+
+//_____________________________________________________________________________
+/**
+ * Smooth spline each of the signals, as SmoothSpline() does one signal.
+ */
+int Signal::
+SmoothSpline(int degree,double T,double fc,int N,int numSignals,
+    const double *times,const double *sig,double *sigf,int numThreads)
+{
+    // Each signal is copied before it is smoothed, so sig may be sigf.
+    std::vector<int> status(numSignals, 0);
+    forEach(numSignals, numThreads, [&](int j) {
+        status[j] = SmoothSpline(degree, T, fc, N, const_cast<double*>(times),
+                        const_cast<double*>(sig + (size_t)j*N),
+                        sigf + (size_t)j*N);
+    });
+    for (int j = 0; j < numSignals; ++j)
+        if (status[j] != 0) return(-1);
+    return(0);
+}
+
+//_____________________________________________________________________________
+/**
+ * 3rd order lowpass IIR Butterworth filter applied forward and backward to
+ * each of the signals, as LowpassIIR() does one signal. The signals are
+ * filtered in blocks of ColumnBlockSize, performing the operations of
+ * LowpassIIR() in the same order for each signal of the block.
+ */
+int Signal::
+LowpassIIR(double T,double fc,int N,int numSignals,const double *sig,
+    double *sigf,int numThreads)
+{
+    // ERROR CHECK
+    if(T==0) return(-1);
+    if(N<4) return(-1);
+    if(sig==NULL) return(-1);
+    if(sigf==NULL) return(-1);
+
+    double a[4],b[4];
+    calcLowpassIIRCoefficients(T,fc,a,b);
+
+    const int B = ColumnBlockSize;
+    const int numBlocks = (numSignals + B - 1) / B;
+    forEach(numBlocks, numThreads, [&](int block) {
+        const int first = block*B;
+        const int nb = std::min(B, numSignals - first);
+        std::vector<double> x((size_t)N*B, 0.0), y((size_t)N*B);
+        gatherBlock(N, nb, sig + (size_t)first*N, 0, &x[0]);
+
+        for (int pass = 0; pass < 2; ++pass) {
+            // FILL THE 1ST THREE TERMS OF y
+            for (int k = 0; k < 4*B; ++k) y[k] = x[k];
+
+            // IMPLEMENT THE FORMULA
+            for (int i = 3; i < N; ++i) {
+                const double *xi = &x[(size_t)i*B];
+                double *yi = &y[(size_t)i*B];
+                for (int c = 0; c < B; ++c)
+                    yi[c] = a[0]*xi[c] + a[1]*xi[c-B] + a[2]*xi[c-2*B] 
+                          + a[3]*xi[c-3*B]
+                          - b[1]*yi[c-B] - b[2]*yi[c-2*B] - b[3]*yi[c-3*B];
+            }
+
+            // REVERSE THE FILTERED SAMPLES
+            if (pass == 0) {
+                for (int i = 0; i < N; ++i)
+                    std::copy(&y[(size_t)(N-1-i)*B], &y[(size_t)(N-i)*B], 
+                              &x[(size_t)i*B]);
+            }
+        }
+
+        // REVERSE THE FILTERED SAMPLES AGAIN, INTO sigf
+        for (int c = 0; c < nb; ++c) {
+            double *sigfc = sigf + (size_t)(first+c)*N;
+            for (int i = 0; i < N; ++i) sigfc[i] = y[(size_t)(N-1-i)*B + c];
+        }
+    });
+
+    return(0);
+}
+
+//_____________________________________________________________________________
+/**
+ * Lowpass FIR filter each of the signals, as LowpassFIR() does one signal.
+ * The filter coefficients are computed once, and blocks of ColumnBlockSize
+ * signals are padded and filtered together, accumulating the terms of each
+ * signal in the same order as LowpassFIR().
+ */
+int Signal::
+LowpassFIR(int M,double T,double f,int N,int numSignals,const double *sig,
+    double *sigf,int numThreads)
+{
+    // CHECK THAT M IS NOT TOO LARGE RELATIVE TO N
+    if((M+M)>N) {
+        printf("rdSingal.lowpassFIR:  ERROR- The number of data points (%d)",N);
+        printf(" should be at least twice the order of the filter (%d).\n",M);
+        return(-1);
+    }
+    if(M<=0) return(-1);
+
+    // CALCULATE THE ANGULAR CUTOFF FREQUENCY
+    double w = 2.0*SimTK_PI*f;
+
+    // FILTER COEFFICIENTS
+    std::vector<double> coefs(2*M+1);
+    double sum_coef = 0.0;
+    for(int k=-M;k<=M;k++) {
+        double x = (double)k*w*T;
+        coefs[k+M] = (sinc(x)*T*w/SimTK_PI)*hamming(k,M);
+        sum_coef = sum_coef + coefs[k+M];
+    }
+
+    const int B = ColumnBlockSize;
+    const int numBlocks = (numSignals + B - 1) / B;
+    forEach(numBlocks, numThreads, [&](int block) {
+        const int first = block*B;
+        const int nb = std::min(B, numSignals - first);
+        const double *sigBlock = sig + (size_t)first*N;
+
+        // PAD THE SIGNALS SO FILTERING CAN BEGIN AT THE FIRST DATA POINT
+        std::vector<double> s((size_t)(N+2*M)*B, 0.0);
+        gatherBlock(N, nb, sigBlock, M, &s[0]);
+        for (int c = 0; c < nb; ++c) {
+            const double *sigc = sigBlock + (size_t)c*N;
+            for(int i=0,j=M;i<M;i++,j--)  
+                s[(size_t)i*B + c] = 2.0*sigc[0] - sigc[j];
+            for(int i=M+N,j=N-2;i<M+M+N;i++,j--)  
+                s[(size_t)i*B + c] = 2.0*sigc[N-1] - sigc[j];
+        }
+
+        // FILTER THE DATA
+        double acc[ColumnBlockSize];
+        for(int n=0;n<N;n++) {
+            for (int c = 0; c < B; ++c) acc[c] = 0.0;
+            for(int k=-M;k<=M;k++) {   
+                const double coef = coefs[k+M];
+                const double *sk = &s[(size_t)(M+n-k)*B];
+                for (int c = 0; c < B; ++c) acc[c] = acc[c] + coef*sk[c];
+            }
+            for (int c = 0; c < nb; ++c) 
+                sigf[(size_t)(first+c)*N + n] = acc[c] / sum_coef;
+        }
+    });
+
+    return(0);
+}
+
+//=============================================================================
+// PADDING
+//=============================================================================
 //_____________________________________________________________________________
 /**
  * Pad a signal with a specified number of data points.
@@ -491,6 +699,48 @@ Pad(int aPad,Array<double> &rSignal)
     // ALTER SIGNAL
     rSignal = s;
 }
+//_____________________________________________________________________________
+/**
+ * Pad each of a number of signals with a specified number of data points.
+ *
+ * PARAMETERS
+ *  @param aPad Size of the pad-- number of points to prepend and append.
+ *  @param aN Number of data points in each signal.
+ *  @param aNumSignals Number of signals.
+ *  @param aSignals The signals, one after the other.
+ *  @param rPaddedSignals The padded signals, one after the other, each of
+ *  size aN + 2*aPad.
+ */
+void Signal::
+Pad(int aPad,int aN,int aNumSignals,const double *aSignals,
+    double *rPaddedSignals)
+{
+    int size = aN + 2*(aPad>0 ? aPad : 0);
+    for(int c=0;c<aNumSignals;c++) {
+        const double *sig = aSignals + (size_t)c*aN;
+        double *s = rPaddedSignals + (size_t)c*size;
+
+        // HANDLE NO PAD AND PAD GREATER THAN SIZE
+        if(aPad<=0 || aPad>=aN) {
+            Array<double> signal(0.0,aN);
+            for(int i=0;i<aN;i++)  signal[i] = sig[i];
+            Pad(aPad,signal);
+            for(int i=0;i<size;i++)  s[i] = signal[i];
+            continue;
+        }
+
+        // PREPEND
+        int i,j;
+        for(i=0,j=aPad;i<aPad;i++,j--)  s[i] = 2.0*sig[0] - sig[j];
+
+        // SIGNAL
+        for(i=aPad,j=0;i<aPad+aN;i++,j++)  s[i] = sig[j];
+
+        // APPEND
+        for(i=aPad+aN,j=aN-2;i<aPad+aPad+aN;i++,j--)  
+            s[i] = 2.0*sig[aN-1] - sig[j];
+    }
+}
 
 
 //-----------------------------------------------------------------------------
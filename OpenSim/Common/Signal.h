@@ -72,6 +72,33 @@ public:
         double aLowFrequency,double aHighFrequency,
         int aN,double *aSignal,double *aFilteredSignal);
 
+    //--------------------------------------------------------------------------
+    // MULTI-SIGNAL FILTERS
+    //--------------------------------------------------------------------------
+    /** @name Filtering many signals at once
+    These filter aNumSignals signals of aN samples each, stored one signal
+    after the other: sample i of signal j is at [j*aN+i]. The result for each
+    signal is identical to that of the single-signal filter. LowpassIIR and
+    LowpassFIR filter blocks of signals together, so that the arithmetic is
+    done for several signals at a time, and the blocks are divided among
+    aNumThreads threads; SmoothSpline divides the signals among the threads.
+    rFilteredSignals may be the same array as aSignals.
+    @return 0 on success, and -1 on failure. */
+    /**@{**/
+    static int
+        SmoothSpline(int aDegree,double aDeltaT,double aCutOffFrequency,
+        int aN,int aNumSignals,const double *aTimes,const double *aSignals,
+        double *rFilteredSignals,int aNumThreads=1);
+    static int
+        LowpassIIR(double aDeltaT,double aCutOffFrequency,
+        int aN,int aNumSignals,const double *aSignals,
+        double *rFilteredSignals,int aNumThreads=1);
+    static int
+        LowpassFIR(int aOrder,double aDeltaT,double aCutoffFrequency,
+        int aN,int aNumSignals,const double *aSignals,
+        double *rFilteredSignals,int aNumThreads=1);
+    /**@}**/
+
     //--------------------------------------------------------------------------
     // PADDING
     //--------------------------------------------------------------------------
@@ -79,6 +106,13 @@ public:
         Pad(int aPad,int aN,const double aSignal[]);
     static void
         Pad(int aPad,OpenSim::Array<double> &aSignal);
+    /** Pad aNumSignals signals of aN samples each, stored one after the
+    other, as Pad(int,Array<double>&) pads each of them. The padded signals,
+    of aN + 2*aPad samples each, are stored one after the other in
+    rPaddedSignals. */
+    static void
+        Pad(int aPad,int aN,int aNumSignals,const double *aSignals,
+        double *rPaddedSignals);
 
     //--------------------------------------------------------------------------
     // POINT REDUCTION
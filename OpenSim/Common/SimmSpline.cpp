@@ -318,6 +318,12 @@ void SimmSpline::updateFromXMLNode(SimTK::Xml::Element& aNode, int versionNumber
     calcCoefficients();
 }   
 
+void SimmSpline::updateFromBinary(std::istream& in)
+{
+    Function::updateFromBinary(in);
+    calcCoefficients();
+}
+
 //=============================================================================
 // EVALUATION
 //=============================================================================
@@ -24,6 +24,8 @@
 // INCLUDES
 //=============================================================================
 #include "SmoothSegmentedFunction.h"
+#include "Property.h"
+#include <algorithm>
 
 //=============================================================================
 // STATICS
@@ -37,6 +39,12 @@ static double UTOL = (double)SimTK::Eps*1e2;
 static double INTTOL = (double)SimTK::Eps*1e2;
 static int MAXITER = 20;
 static int NUM_SAMPLE_PTS = 100;
+//Degree of the polynomials used by the fast evaluator
+static const int FAST_DEGREE = 9;
+//Number of points between the nodes at which the error of the fit is checked
+static const int FAST_CHECK_PTS = 4*FAST_DEGREE;
+//Maximum number of times an interval of the fast evaluator is halved
+static const int FAST_MAX_DEPTH = 10;
 //=============================================================================
 // UTILITY FUNCTIONS
 //=============================================================================
@@ -93,7 +101,8 @@ SmoothSegmentedFunction::
           double x0, double x1, double y0, double y1,double dydx0, double dydx1,
           bool computeIntegral, bool intx0x1, const std::string& name):
 _x0(x0),_x1(x1),_y0(y0),_y1(y1),_dydx0(dydx0),_dydx1(dydx1),
-     _computeIntegral(computeIntegral),_intx0x1(intx0x1),_name(name)
+     _computeIntegral(computeIntegral),_intx0x1(intx0x1),_name(name),
+     _fastMaxOrder(-1)
 {
     
 
@@ -164,7 +173,8 @@ _x0(x0),_x1(x1),_y0(y0),_y1(y1),_dydx0(dydx0),_dydx1(dydx1),
  SmoothSegmentedFunction::SmoothSegmentedFunction():
  _x0(SimTK::NaN),_x1(SimTK::NaN),_y0(SimTK::NaN)
      ,_y1(SimTK::NaN),_dydx0(SimTK::NaN),_dydx1(SimTK::NaN),
-     _computeIntegral(false),_intx0x1(false),_name("NOT_YET_SET")
+     _computeIntegral(false),_intx0x1(false),_name("NOT_YET_SET"),
+     _fastMaxOrder(-1)
  {
         _arraySplineUX.resize(0);        
         _mXVec.resize(0);
@@ -200,11 +210,11 @@ double SmoothSegmentedFunction::calcValue(double x) const
     double yVal = 0;
     if(x >= _x0 && x <= _x1 )
     {
-        int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
-        double u = SegmentedQuinticBezierToolkit::
-                 calcU(x,_mXVec[idx], _arraySplineUX[idx], UTOL,MAXITER);
-        yVal = SegmentedQuinticBezierToolkit::
-                 calcQuinticBezierCurveVal(u,_mYVec[idx]);
+        if(_fastMaxOrder >= 0){
+            yVal = calcFastDerivative(x,0);
+        }else{
+            yVal = calcBezierDerivative(x,0);
+        }
     }else{
         if(x < _x0){
             yVal = _y0 + _dydx0*(x-_x0);            
@@ -268,16 +278,11 @@ double SmoothSegmentedFunction::calcDerivative(double x, int order) const
                 yVal = calcValue(x);
     }else{
             if(x >= _x0 && x <= _x1){        
-                int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
-                double u = SegmentedQuinticBezierToolkit::
-                                calcU(x,_mXVec[idx], _arraySplineUX[idx], 
-                                UTOL,MAXITER);
-                yVal = SegmentedQuinticBezierToolkit::
-                            calcQuinticBezierCurveDerivDYDX(u, _mXVec[idx], 
-                            _mYVec[idx], order);
-/*
-                            std::cout << _mX(3, idx) << std::endl;
-                            std::cout << _mX(idx) << std::endl;*/
+                if(order <= _fastMaxOrder){
+                    yVal = calcFastDerivative(x,order);
+                }else{
+                    yVal = calcBezierDerivative(x,order);
+                }
             }else{
                     if(order == 1){
                         if(x < _x0){
@@ -294,6 +299,255 @@ double SmoothSegmentedFunction::calcDerivative(double x, int order) const
 
 
 
+void SmoothSegmentedFunction::calcValues(const double* x, double* y, 
+                                         int n) const
+{
+    if(_fastMaxOrder < 0){
+        for(int i=0; i < n; i++){
+            y[i] = calcValue(x[i]);
+        }
+        return;
+    }
+
+    for(int i=0; i < n; i++){
+        const double xi = x[i];
+        if(xi >= _x0 && xi <= _x1){
+            y[i] = calcFastDerivative(xi,0);
+        }else if(xi < _x0){
+            y[i] = _y0 + _dydx0*(xi-_x0);
+        }else{
+            y[i] = _y1 + _dydx1*(xi-_x1);
+        }
+    }
+}
+
+double SmoothSegmentedFunction::calcBezierDerivative(double x, int order) const
+{
+    int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
+    double u = SegmentedQuinticBezierToolkit::
+                    calcU(x,_mXVec[idx], _arraySplineUX[idx], UTOL,MAXITER);
+    if(order == 0){
+        return SegmentedQuinticBezierToolkit::
+                    calcQuinticBezierCurveVal(u,_mYVec[idx]);
+    }
+    return SegmentedQuinticBezierToolkit::
+                calcQuinticBezierCurveDerivDYDX(u, _mXVec[idx], 
+                _mYVec[idx], order);
+}
+
+/*Detailed Computational Costs
+________________________________________________________________________
+If x is in the curve domain and the fast evaluator is available
+                        Name     Comp.   Div.    Mult.   Add.    Assign.
+_______________________________________________________________________
+                interval search  log2(m)                          
+            Horner (degree 9)                     10      10      10
+                          total  ~5              11      12      ~14
+________________________________________________________________________
+ */
+double SmoothSegmentedFunction::calcFastDerivative(double x, int order) const
+{
+    //Find the interval: the first break point greater than x, excluding the
+    //first and last ones so that x at the domain end points is included.
+    const int numIntervals = (int)_fastBreaks.size()-1;
+    const int k = (int)(std::upper_bound(_fastBreaks.begin()+1, 
+                        _fastBreaks.begin()+numIntervals, x)
+                        - (_fastBreaks.begin()+1));
+
+    const double* p = &_fastCoefs[k*(FAST_DEGREE+3)];
+    const double invHalfWidth = p[1];
+    const double t = (x - p[0])*invHalfWidth;
+    const double* a = p+2;
+
+    double y = 0;
+    if(order == 0){
+        y = a[FAST_DEGREE];
+        for(int j=FAST_DEGREE-1; j >= 0; j--){
+            y = y*t + a[j];
+        }
+    }else if(order == 1){
+        y = FAST_DEGREE*a[FAST_DEGREE];
+        for(int j=FAST_DEGREE-1; j >= 1; j--){
+            y = y*t + j*a[j];
+        }
+        y *= invHalfWidth;
+    }else{
+        y = FAST_DEGREE*(FAST_DEGREE-1)*a[FAST_DEGREE];
+        for(int j=FAST_DEGREE-1; j >= 2; j--){
+            y = y*t + j*(j-1)*a[j];
+        }
+        y *= invHalfWidth*invHalfWidth;
+    }
+    return y;
+}
+
+void SmoothSegmentedFunction::buildFastEvaluator(double tolerance)
+{
+    SimTK_ERRCHK1_ALWAYS(tolerance > 0,
+        "SmoothSegmentedFunction::buildFastEvaluator",
+        "%s: tolerance must be greater than 0",_name.c_str());
+
+    clearFastEvaluator();
+    _fastMaxOrder = 2;
+    for(int s=0; s < _numBezierSections; s++){
+        const double xa = _mXVec[s](0);
+        const double xb = _mXVec[s](5);
+        if(xb > xa){
+            fitFastInterval(s,xa,xb,tolerance,0);
+        }
+    }
+    if(_fastBreaks.empty() || _fastMaxOrder < 0){
+        clearFastEvaluator();
+        return;
+    }
+    _fastBreaks.push_back(_mXVec[_numBezierSections-1](5));
+}
+
+/*
+ The polynomial interpolates the curve at the Chebyshev nodes of the interval.
+ Its Chebyshev coefficients are computed from the samples and then converted
+ to coefficients of powers of t, which are evaluated with Horner's method.
+*/
+void SmoothSegmentedFunction::fitFastInterval(int s, double xa, double xb, 
+                                              double tolerance, int depth)
+{
+    const int n = FAST_DEGREE+1;
+    const double mid = 0.5*(xa+xb);
+    const double halfWidth = 0.5*(xb-xa);
+
+    //Sample the curve at the Chebyshev nodes
+    double f[FAST_DEGREE+1];
+    double nodes[FAST_DEGREE+1];
+    for(int j=0; j < n; j++){
+        nodes[j] = cos(SimTK::Pi*(j+0.5)/n);
+        double u = SegmentedQuinticBezierToolkit::calcU(mid+halfWidth*nodes[j],
+                            _mXVec[s], _arraySplineUX[s], UTOL, MAXITER);
+        f[j] = SegmentedQuinticBezierToolkit::
+                            calcQuinticBezierCurveVal(u,_mYVec[s]);
+    }
+
+    //Chebyshev coefficients, and the polynomial in t that they represent
+    double a[FAST_DEGREE+1] = {0};
+    double tPrev[FAST_DEGREE+1] = {0};  //T_(k-1) in powers of t
+    double tCur[FAST_DEGREE+1] = {0};   //T_k in powers of t
+    tCur[0] = 1;
+    for(int k=0; k < n; k++){
+        double ck = 0;
+        for(int j=0; j < n; j++){
+            ck += f[j]*cos(SimTK::Pi*k*(j+0.5)/n);
+        }
+        ck *= (k == 0) ? 1.0/n : 2.0/n;
+        for(int j=0; j <= k; j++){
+            a[j] += ck*tCur[j];
+        }
+        //T_(k+1) = 2 t T_k - T_(k-1)
+        double tNext[FAST_DEGREE+1] = {0};
+        for(int j=0; j < n; j++){
+            tNext[j] = -tPrev[j] + ((j > 0) ? 2*tCur[j-1] : 0);
+        }
+        std::copy(tCur, tCur+n, tPrev);
+        std::copy(tNext, tNext+n, tCur);
+    }
+
+    //Check the fit of every derivative order that calcFastDerivative
+    //serves, including at the end points of the interval. Once the interval
+    //can no longer be split, all of the errors are needed.
+    double err[3] = {0,0,0};
+    bool withinTolerance = true;
+    for(int i=0; i <= FAST_CHECK_PTS 
+                 && (withinTolerance || depth == FAST_MAX_DEPTH); i++){
+        const double t = -1.0 + 2.0*i/FAST_CHECK_PTS;
+        double y = a[FAST_DEGREE];
+        double dy = FAST_DEGREE*a[FAST_DEGREE];
+        double ddy = FAST_DEGREE*(FAST_DEGREE-1)*a[FAST_DEGREE];
+        for(int j=FAST_DEGREE-1; j >= 0; j--){
+            y = y*t + a[j];
+            if(j >= 1) dy = dy*t + j*a[j];
+            if(j >= 2) ddy = ddy*t + j*(j-1)*a[j];
+        }
+        dy /= halfWidth;
+        ddy /= halfWidth*halfWidth;
+
+        double u = SegmentedQuinticBezierToolkit::calcU(mid+halfWidth*t,
+                            _mXVec[s], _arraySplineUX[s], UTOL, MAXITER);
+        double yExact = SegmentedQuinticBezierToolkit::
+                            calcQuinticBezierCurveVal(u,_mYVec[s]);
+        double dyExact = SegmentedQuinticBezierToolkit::
+                            calcQuinticBezierCurveDerivDYDX(u,_mXVec[s],
+                            _mYVec[s],1);
+        double ddyExact = SegmentedQuinticBezierToolkit::
+                            calcQuinticBezierCurveDerivDYDX(u,_mXVec[s],
+                            _mYVec[s],2);
+        err[0] = std::max(err[0], std::abs(y-yExact));
+        err[1] = std::max(err[1], std::abs(dy-dyExact)/(1+std::abs(dyExact)));
+        err[2] = std::max(err[2], 
+                          std::abs(ddy-ddyExact)/(1+std::abs(ddyExact)));
+        withinTolerance = err[0] <= tolerance && err[1] <= tolerance 
+                          && err[2] <= tolerance;
+    }
+
+    if(!withinTolerance && depth < FAST_MAX_DEPTH){
+        fitFastInterval(s, xa, mid, tolerance, depth+1);
+        fitFastInterval(s, mid, xb, tolerance, depth+1);
+        return;
+    }
+
+    //Derivative orders that are not within tolerance, and all higher ones,
+    //are evaluated with the Bezier curve instead
+    int maxOrder = -1;
+    while(maxOrder < 2 && err[maxOrder+1] <= tolerance){
+        maxOrder++;
+    }
+    _fastMaxOrder = std::min(_fastMaxOrder, maxOrder);
+
+    _fastBreaks.push_back(xa);
+    _fastCoefs.push_back(mid);
+    _fastCoefs.push_back(1.0/halfWidth);
+    _fastCoefs.insert(_fastCoefs.end(), a, a+n);
+}
+
+void SmoothSegmentedFunction::clearFastEvaluator()
+{
+    _fastBreaks.clear();
+    _fastCoefs.clear();
+    _fastMaxOrder = -1;
+}
+
+void SmoothSegmentedFunction::setFastEvaluatorTolerance(
+        Property<double>& toleranceProperty, double tolerance)
+{
+    SimTK_ERRCHK1_ALWAYS(tolerance >= 0,
+        "SmoothSegmentedFunction::setFastEvaluatorTolerance",
+        "%s: the tolerance of the fast evaluator must not be negative",
+        toleranceProperty.getName().c_str());
+    if(tolerance > 0){
+        toleranceProperty.setValue(tolerance);
+    }else{
+        toleranceProperty.clear();
+    }
+}
+
+double SmoothSegmentedFunction::getFastEvaluatorTolerance(
+        const Property<double>& toleranceProperty)
+{
+    return toleranceProperty.empty() ? 0 : toleranceProperty.getValue();
+}
+
+bool SmoothSegmentedFunction::isFastEvaluatorAvailable() const
+{
+    return _fastMaxOrder >= 0;
+}
+
+int SmoothSegmentedFunction::getFastEvaluatorMaxOrder() const
+{
+    return _fastMaxOrder;
+}
+
+int SmoothSegmentedFunction::getNumFastEvaluatorIntervals() const
+{
+    return _fastBreaks.empty() ? 0 : (int)_fastBreaks.size()-1;
+}
+
 double SmoothSegmentedFunction::
     calcDerivative(const SimTK::Array_<int>& derivComponents,
                  const SimTK::Vector& ax) const
@@ -26,9 +26,12 @@
 
 //#include "SmoothSegmentedFunctionFactory.h"
 #include "SegmentedQuinticBezierToolkit.h"
+#include <vector>
 
 namespace OpenSim { 
 
+    template <class T> class Property;
+
     /**
     This class contains the quintic Bezier curves, x(u) and y(u), that have been
     created by SmoothSegmentedFunctionFactory to follow a physiologically meaningful 
@@ -36,6 +39,12 @@ namespace OpenSim {
     you must use SmoothSegmentedFunctionFactory to create the muscle curve of 
     interest.
 
+    Evaluating the curve requires finding u for a given x by iteration. If the
+    curve will be evaluated many times, buildFastEvaluator() can be called to
+    fit piecewise polynomials in x to the curve, after which calcValue() and
+    calcDerivative() (up to the 2nd derivative) evaluate these polynomials 
+    instead.
+
     <B>Future Upgrades</B>
     1. Add a hint object to keep the last u that corresponded to the location of
        interest to prevent unnecessary redundant evaluations of u. This hint 
@@ -124,6 +133,76 @@ namespace OpenSim {
        */
        double calcDerivative(double x, int order) const;       
 
+#ifndef SWIG
+       /**Calculates the value of the curve at each of a set of points. This
+       gives the same result as calling calcValue(double x) for each point, 
+       but is faster when the fast evaluator is available.
+
+       @param x Array of n domain points of interest
+       @param y Array of n values that is filled with the values of the curve
+       @param n The number of points
+       */
+       void calcValues(const double* x, double* y, int n) const;
+#endif
+
+       /**Fits piecewise polynomials in x to the curve so that calcValue and 
+       calcDerivative (for orders 1 and 2) no longer need to solve for u. Each
+       Bezier section is split into as many intervals as are needed for the 
+       error of the value, and of the first and second derivatives of the
+       polynomial (relative to 1 + |dy/dx| and 1 + |d2y/dx2|), to be within
+       tolerance. If an error is still not within tolerance after the
+       intervals have been halved 10 times, that derivative order (and any
+       higher one) is evaluated with the Bezier curve instead; see 
+       getFastEvaluatorMaxOrder().
+
+       @param tolerance The largest acceptable error of the approximation. 
+                        Tolerances close to the precision of the Bezier
+                        evaluation itself (~1e-13) may not be met.
+       @throws OpenSim::Exception
+        -If tolerance is not greater than 0
+
+       <B>Computational Costs</B>
+       \verbatim
+            Building             : ~25 Bezier evaluations per interval
+            x in curve domain    : ~40 flops
+       \endverbatim
+       */
+       void buildFastEvaluator(double tolerance);
+
+       /**Discards the polynomials built by buildFastEvaluator(), so that the 
+       Bezier curves are evaluated again.*/
+       void clearFastEvaluator();
+
+       /**@return true if buildFastEvaluator() has been called.*/
+       bool isFastEvaluatorAvailable() const;
+
+       /**@return The highest derivative order (at most 2) that is evaluated
+       with the fast evaluator, or -1 if it is not available.*/
+       int getFastEvaluatorMaxOrder() const;
+
+       /**@return The number of polynomial intervals used by the fast 
+       evaluator, or 0 if it is not available.*/
+       int getNumFastEvaluatorIntervals() const;
+
+       /**Stores the tolerance of a curve's fast evaluator in its optional
+       fast_evaluator_tolerance property, as the muscle curves in 
+       OpenSim/Actuators do. A tolerance of 0 empties the property, which 
+       turns the fast evaluator off.
+
+       @param toleranceProperty The curve's fast_evaluator_tolerance property.
+       @param tolerance The largest acceptable error of the approximation;
+                        see buildFastEvaluator().
+       @throws SimTK::Exception
+        -If tolerance is negative
+       */
+       static void setFastEvaluatorTolerance(
+               Property<double>& toleranceProperty, double tolerance);
+
+       /**@return The tolerance held by a curve's fast_evaluator_tolerance 
+       property, or 0 if the property is empty.*/
+       static double getFastEvaluatorTolerance(
+               const Property<double>& toleranceProperty);
+
        
 
      
@@ -338,6 +417,29 @@ namespace OpenSim {
         bool _intx0x1;
         /**The name of the function**/
         std::string _name;
+
+        /**The boundaries, in x, of the intervals of the fast evaluator. This
+        is empty if the fast evaluator has not been built.*/
+        std::vector<double> _fastBreaks;
+        /**For each interval of the fast evaluator: its midpoint, the inverse
+        of its half width, and the coefficients (lowest order first) of the 
+        polynomial in t = (x - midpoint)*inverse half width*/
+        std::vector<double> _fastCoefs;
+        /**The highest derivative order whose error was within the tolerance
+        of the fast evaluator in every interval, or -1 if the fast evaluator
+        has not been built.*/
+        int _fastMaxOrder;
+
+        /**Evaluates the Bezier curve (or its derivative) at x, which must be
+        within the curve domain.*/
+        double calcBezierDerivative(double x, int order) const;
+        /**Evaluates the fast evaluator (or its derivative up to order 2) at x,
+        which must be within the curve domain.*/
+        double calcFastDerivative(double x, int order) const;
+        /**Fits a polynomial to Bezier section s between xa and xb, splitting
+        the interval in two while the fit is not within tolerance.*/
+        void fitFastInterval(int s, double xa, double xb, double tolerance,
+                             int depth);
             
         /**No human should be constructing a SmoothSegmentedFunction, so the
         constructor is made private so that mere mortals cannot look at it. 
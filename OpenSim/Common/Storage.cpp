@@ -30,6 +30,7 @@
 #include "osimCommonDLL.h"
 #include <sstream>
 #include <iostream>
+#include <algorithm>
 #include "IO.h"
 #include "Signal.h"
 #include "Storage.h"
@@ -150,7 +151,9 @@ Storage::Storage(const string &aFileName, bool readHeadersOnly) :
             << _columnLabels.getSize() << " were found" << std::endl;
     }
     // CAPACITY
-    _storage.ensureCapacity(nr);
+    // Array grows when an append fills its capacity, so reserve one extra
+    // element to avoid copying every row when the last one is read.
+    _storage.ensureCapacity(nr+1);
     _storage.setCapacityIncrement(-1);
 
     // There are situations where we don't want to read the whole file in advance just header
@@ -312,7 +315,8 @@ setNull()
     _writeSIMMHeader = false;
     setHeaderToken(DEFAULT_HEADER_TOKEN);
     _stepInterval = 1;
-    _lastI = 0;
+    _columnDataNumStates = 0;
+    _columnDataIsValid = false;
     _fp = 0;
     _inDegrees = false;
 }
@@ -338,6 +342,7 @@ copyData(const Storage &aStorage)
 
     // COPY
     //rdPtrArray::reset();
+    invalidateColumnData();
     _storage.setSize(0);
     for(int i=0;i<aStorage._storage.getSize();i++) {
         _storage.append(aStorage._storage[i]);
@@ -630,11 +635,15 @@ getSmallestNumberOfStates() const
 /**
  * Get the last states stored.
  *
+ * The column data, if any, is discarded, since the returned statevector
+ * can be modified.
+ *
  * @return Statevector.  If no state vector is stored, NULL is returned.
  */
 StateVector* Storage::
 getLastStateVector() const
 {
+    invalidateColumnData();
     StateVector *vec = NULL;
     try {
         vec = &_storage.updLast();
@@ -650,11 +659,13 @@ getLastStateVector() const
  * @param aTimeIndex Time index at which to get the state vector:
  * 0 <= aTimeIndex < _storage.getSize().
  * @return Statevector. If no valid statevector exists at aTimeIndex, NULL
- * is returned.
+ * is returned.  The column data, if any, is discarded, since the returned
+ * statevector can be modified.
  */
 StateVector* Storage::
 getStateVector(int aTimeIndex) const
 {
+    invalidateColumnData();
     return(&_storage.updElt(aTimeIndex));
 }
 
@@ -767,7 +778,7 @@ getTimeColumn(double *&rTimes,int aStateIndex) const
     int i,nTimes;
     StateVector *vec;
     for(i=nTimes=0;i<_storage.getSize();i++) {
-        vec = getStateVector(i);
+        vec = &_storage[i];
         if(vec==NULL) continue;
         if(aStateIndex >= vec->getSize()) continue;
         rTimes[nTimes] = vec->getTime();
@@ -786,7 +797,7 @@ getTimeColumn(Array<double> &rTimes,int aStateIndex) const
     // LOOP THROUGH STATEVECTORS
     int i,nTimes;
     for(i=nTimes=0;i<_storage.getSize();i++) {
-        StateVector *vec = getStateVector(i);
+        StateVector *vec = &_storage[i];
         if(vec==NULL) continue;
         if(aStateIndex >= vec->getSize()) continue;
         rTimes[nTimes] = vec->getTime();
@@ -835,7 +846,7 @@ getData(int aTimeIndex,int aStateIndex,double &rValue) const
     if(aTimeIndex>=_storage.getSize()) return(0);
 
     // ASSIGNMENT
-    StateVector *vec = getStateVector(aTimeIndex);
+    StateVector *vec = &_storage[aTimeIndex];
     if(vec==NULL) return(0);
     return( vec->getDataValue(aStateIndex,rValue) );
 }
@@ -852,7 +863,7 @@ getData(int aTimeIndex,int aStateIndex,int aN,double **rData) const
     if(aTimeIndex>=_storage.getSize()) return(0);
 
     // GET STATEVECTOR
-    StateVector *vec = getStateVector(aTimeIndex);
+    StateVector *vec = &_storage[aTimeIndex];
     if(vec==NULL) return(0);
     if(vec->getSize()<=0) return(0);
 
@@ -981,9 +992,52 @@ getData(int aTimeIndex,int aN,SimTK::Vector& v) const
 int Storage::
 getDataAtTime(double aT,int aN,double **rData) const
 {
-
-    // FIND THE CORRECT INTERVAL FOR aT
-    int i = findIndex(_lastI,aT);
+    return(interpolateData(findIndex(aT),aT,aN,rData));
+}
+//_____________________________________________________________________________
+/**
+ * Get the first aN states at a specified time, starting the search for the
+ * time at the interval found by the previous lookup with the same cursor.
+ * This is efficient when the times of successive lookups are close to each
+ * other, e.g., during a simulation.
+ *
+ * @param aCursor Cursor that is used to start the search and is updated to
+ * the interval that contains aT.
+ * @param aT Time at which to get the states.
+ * @param aN Number of states to get.
+ * @param rData Array where the returned data will be set.  The
+ * size of rData is assumed to be at least aN.
+ * @return Number of states that were set.
+ */
+int Storage::
+getDataAtTime(InterpolationCursor& aCursor,double aT,int aN,double *rData) const
+{
+    if(rData==NULL) return(0);
+    return(interpolateData(findIndex(aCursor,aT),aT,aN,&rData));
+}
+int Storage::
+getDataAtTime(InterpolationCursor& aCursor,double aT,int aN,
+              Array<double> &rData) const
+{
+    double *data=&rData[0];
+    return(interpolateData(findIndex(aCursor,aT),aT,aN,&data));
+}
+//_____________________________________________________________________________
+/**
+ * Linearly interpolate the first aN states at time aT between statevector
+ * aIndex and the one that follows it.
+ *
+ * @param aIndex Index preceding or at time aT, as returned by findIndex().
+ * @param aT Time at which to get the states.
+ * @param aN Number of states to get.
+ * @param rData Pointer to an array where the returned data will be set.  If
+ * rData comes in as NULL, memory is allocated.
+ * @return Number of states that were set.
+ */
+int Storage::
+interpolateData(int aIndex,double aT,int aN,double **rData) const
+{
+    int i = aIndex;
     if((i<0)||(_storage.getSize()<=0)) {
         *rData = NULL;
         return(0);
@@ -998,14 +1052,14 @@ getDataAtTime(double aT,int aN,double **rData) const
     }
 
     // STATES AT FIRST INDEX
-    int n1 = getStateVector(i1)->getSize();
-    double t1 = getStateVector(i1)->getTime();
-    Array<double> &y1 = getStateVector(i1)->getData();
+    int n1 = _storage[i1].getSize();
+    double t1 = _storage[i1].getTime();
+    Array<double> &y1 = _storage[i1].getData();
 
     // STATES AT NEXT INDEX
-    int n2 = getStateVector(i2)->getSize();
-    double t2 = getStateVector(i2)->getTime();
-    Array<double> &y2 = getStateVector(i2)->getData();
+    int n2 = _storage[i2].getSize();
+    double t2 = _storage[i2].getTime();
+    Array<double> &y2 = _storage[i2].getData();
 
     // GET THE SMALLEST N TO PREVENT MEMORY OVER-RUNS
     int ns = (n1<n2) ? n1 : n2;
@@ -1104,7 +1158,7 @@ getDataColumn(int aStateIndex,double *&rData) const
     // ASSIGNMENT
     int i,nData;
     for(i=nData=0;i<n;i++) {
-        StateVector *vec = getStateVector(i);
+        StateVector *vec = &_storage[i];
         if(vec==NULL) continue;
         if(vec->getDataValue(aStateIndex,rData[nData])) nData++;
     }
@@ -1122,7 +1176,7 @@ getDataColumn(int aStateIndex,Array<double> &rData) const
     // ASSIGNMENT
     int i,nData;
     for(i=nData=0;i<n;i++) {
-        StateVector *vec = getStateVector(i);
+        StateVector *vec = &_storage[i];
         if(vec==NULL) continue;
         if(vec->getDataValue(aStateIndex,rData[nData])) nData++;
     }
@@ -1164,6 +1218,7 @@ getDataColumn(const std::string& columnName, Array<double>& rData, double aStart
 void Storage::
 setDataColumn(int aStateIndex,const Array<double> &aData)
 {
+    invalidateColumnData();
     int n = _storage.getSize();
     if(n!=aData.getSize()) {
         cout<<"Storage.setDataColumn: ERR- sizes don't match." << endl;
@@ -1172,7 +1227,7 @@ setDataColumn(int aStateIndex,const Array<double> &aData)
 
     // ASSIGNMENT
     for(int i=0;i<n;i++) {
-        StateVector *vec = getStateVector(i);
+        StateVector *vec = &_storage[i];
         if(vec==NULL) continue;
         vec->setDataValue(aStateIndex,aData[i]);
     }
@@ -1181,6 +1236,7 @@ setDataColumn(int aStateIndex,const Array<double> &aData)
  * set values in the column specified by columnName to newValue
  */
 void Storage::setDataColumnToFixedValue(const std::string& columnName, double newValue) {
+    invalidateColumnData();
     int n = _storage.getSize();
     int aStateIndex = getStateIndex(columnName);
     if(aStateIndex==-1) {
@@ -1190,7 +1246,7 @@ void Storage::setDataColumnToFixedValue(const std::string& columnName, double ne
 
     // ASSIGNMENT
     for(int i=0;i<n;i++) {
-        StateVector *vec = getStateVector(i);
+        StateVector *vec = &_storage[i];
         if(vec==NULL) continue;
         vec->setDataValue(aStateIndex,newValue);
     }
@@ -1223,6 +1279,101 @@ getDataColumn(const std::string& aColumnName,double *&rData) const
         return getDataColumn(getStateIndex(aColumnName), rData);
 }
 
+//_____________________________________________________________________________
+/**
+ * Get the times of all statevectors as a contiguous, read-only view.
+ * updateColumnData() must have been called since this storage was last
+ * modified.
+ *
+ * @return View of getSize() times.  It remains valid until this storage is
+ * modified.
+ */
+Storage::ColumnSpan Storage::
+getTimeSpan() const
+{
+    if(!_columnDataIsValid) {
+        throw Exception("Storage.getTimeSpan: column data is not available;"
+            " call updateColumnData() first.",__FILE__,__LINE__);
+    }
+    if(_columnDataTimes.empty()) return(ColumnSpan());
+    return(ColumnSpan(&_columnDataTimes[0],(int)_columnDataTimes.size()));
+}
+//_____________________________________________________________________________
+/**
+ * Get the data corresponding to a specified state as a contiguous, read-only
+ * view.  This is equivalent to getDataColumn() without copying the data.
+ * updateColumnData() must have been called since this storage was last
+ * modified.
+ *
+ * @param aStateIndex Index of the state (column) for which to get the data.
+ * @return View of getSize() values.  The view is empty if the state is not
+ * present in every statevector.  It remains valid until this storage is
+ * modified.
+ */
+Storage::ColumnSpan Storage::
+getDataColumnSpan(int aStateIndex) const
+{
+    if(!_columnDataIsValid) {
+        throw Exception("Storage.getDataColumnSpan: column data is not"
+            " available; call updateColumnData() first.",__FILE__,__LINE__);
+    }
+    if(aStateIndex<0 || aStateIndex>=_columnDataNumStates) return(ColumnSpan());
+    int n = _storage.getSize();
+    return(ColumnSpan(&_columnData[(size_t)aStateIndex*n],n));
+}
+//_____________________________________________________________________________
+/**
+ * Get the data corresponding to a state specified by name as a contiguous,
+ * read-only view.
+ *
+ * @param aColumnName Name in header of the column for which to get the data.
+ * @return View of getSize() values; empty if the column is not found.
+ */
+Storage::ColumnSpan Storage::
+getDataColumnSpan(const std::string& aColumnName) const
+{
+    return(getDataColumnSpan(getStateIndex(aColumnName)));
+}
+//_____________________________________________________________________________
+/**
+ * Build the contiguous column-major copy of the states that are present in
+ * every statevector.  The statevectors are always read, so any changes made
+ * to them through StateVector pointers are picked up.
+ */
+void Storage::
+updateColumnData()
+{
+    int n = _storage.getSize();
+    int nc = getSmallestNumberOfStates();
+    _columnDataTimes.resize(n);
+    _columnData.resize((size_t)n*nc);
+    for(int i=0;i<n;i++) {
+        const StateVector &vec = _storage[i];
+        _columnDataTimes[i] = vec.getTime();
+        const Array<double> &y = vec.getData();
+        for(int j=0;j<nc;j++) _columnData[(size_t)j*n+i] = y[j];
+    }
+    _columnDataNumStates = nc;
+    _columnDataIsValid = true;
+}
+//_____________________________________________________________________________
+/**
+ * Copy the contiguous column data back into the statevectors.  This is used
+ * by operations that process the columns in place; afterwards the column
+ * data and the statevectors agree.
+ */
+void Storage::
+writeColumnDataToStateVectors()
+{
+    int n = _storage.getSize();
+    int nc = _columnDataNumStates;
+    for(int i=0;i<n;i++) {
+        Array<double> &y = _storage[i].getData();
+        for(int j=0;j<nc;j++) y[j] = _columnData[(size_t)j*n+i];
+    }
+    _columnDataIsValid = true;
+}
+
 /** It is desirable to access the block as a single entity provided an identifier that is common 
     to all components (such as prefix in the column label).
      @param identifier  string identifying a single block of data 
@@ -1238,7 +1389,7 @@ void Storage::getDataForIdentifier(const std::string& identifier, Array<Array<do
     }
     /* a row of "data" can be shorter than number of columns if time is the first column, since 
        that is not considered a state by storage. Need to fix this! -aseth */
-    int nd = getLastStateVector()->getSize();
+    int nd = _storage.getLast().getSize();
     int off = _columnLabels.getSize()-nd;
 
 
@@ -1290,6 +1441,7 @@ reset(int aIndex)
 {
     if(aIndex>=_storage.getSize()) return(_storage.getSize());
     if(aIndex<0) aIndex = 0;
+    invalidateColumnData();
     _storage.setSize(aIndex);
 
     return(_storage.getSize());
@@ -1336,6 +1488,7 @@ crop(const double newStartTime, const double newFinalTime)
             _storage[i]=_storage[startindex+i];
     }
     _storage.setSize(numRowsToKeep);
+    invalidateColumnData();
 }
 
 //=============================================================================
@@ -1351,6 +1504,7 @@ crop(const double newStartTime, const double newFinalTime)
 int Storage::
 append(const StateVector &aStateVector,bool aCheckForDuplicateTime)
 {
+    invalidateColumnData();
     // TODO: use some tolerance when checking for duplicate time?
     if(aCheckForDuplicateTime && _storage.getSize() && _storage.getLast().getTime()==aStateVector.getTime())
         _storage.updLast() = aStateVector;
@@ -1376,6 +1530,7 @@ append(const StateVector &aStateVector,bool aCheckForDuplicateTime)
 int Storage::
 append(const Array<StateVector> &aStorage)
 {
+    invalidateColumnData();
     for(int i=0; i<aStorage.getSize(); i++)
         _storage.append(aStorage[i]);
     return(_storage.getSize());
@@ -1396,15 +1551,20 @@ append(double aT,int aN,const double *aY,bool aCheckForDuplicateTime)
     if(aN<0) return(_storage.getSize());
 
     // APPEND
-    StateVector vec(aT,aN,aY);
-    append(vec,aCheckForDuplicateTime);
+    // The data are copied directly into the new (or duplicate-time) row so
+    // that no temporary StateVector has to be allocated and copied.
+    invalidateColumnData();
     // TODO: use some tolerance when checking for duplicate time?
-    /*
-    if(aCheckForDuplicateTime && _storage.getSize() && _storage.getLast().getTime()==vec.getTime())
-        _storage.getLast() = vec;
-    else
-        _storage.append(vec);
-    */
+    if(!(aCheckForDuplicateTime && _storage.getSize() && _storage.getLast().getTime()==aT)) {
+        if(!_storage.setSize(_storage.getSize()+1)) return(_storage.getSize());
+    }
+    StateVector &vec = _storage.updLast();
+    vec.setStates(aT,aN,aY);
+
+    if (_fp!=0){
+        vec.print(_fp);
+        fflush(_fp);
+    }
     return(_storage.getSize());
 }
 //_____________________________________________________________________________
@@ -1435,6 +1595,29 @@ append(double aT,const Array<double>& aY,bool aCheckForDuplicateTime)
     // APPEND
     return( append ( aT, aY.getSize(), &aY[0], aCheckForDuplicateTime ));
 }
+//_____________________________________________________________________________
+/**
+ * Append a block of rows at once. The capacity of the storage is increased
+ * once for the whole block rather than as the rows are appended.
+ *
+ * @param aNumRows Number of rows to append.
+ * @param aT Time stamps of the rows.
+ * @param aN Number of values in each row.
+ * @param aY Values of the rows, stored row after row (aNumRows*aN values).
+ * @return Index of the first empty storage element.
+ */
+int Storage::
+appendRows(int aNumRows,const double *aT,int aN,const double *aY,
+           bool aCheckForDuplicateTime)
+{
+    if(aT==NULL || aY==NULL) return(_storage.getSize());
+    if(aNumRows<=0 || aN<0) return(_storage.getSize());
+
+    _storage.ensureCapacity(_storage.getSize()+aNumRows);
+    for(int i=0; i<aNumRows; i++)
+        append(aT[i],aN,aY+(size_t)i*aN,aCheckForDuplicateTime);
+    return(_storage.getSize());
+}
 
 //_____________________________________________________________________________
 //_____________________________________________________________________________
@@ -1475,6 +1658,7 @@ store(int aStep,double aT,int aN,const double *aY)
 void Storage::
 shiftTime(double aValue)
 {
+    invalidateColumnData();
     for(int i=0;i<_storage.getSize();i++) {
         _storage[i].shiftTime(aValue);
     }
@@ -1488,6 +1672,7 @@ shiftTime(double aValue)
 void Storage::
 scaleTime(double aValue)
 {
+    invalidateColumnData();
     for(int i=0;i<_storage.getSize();i++) {
         _storage[i].scaleTime(aValue);
     }
@@ -1506,6 +1691,7 @@ scaleTime(double aValue)
 void Storage::
 add(double aValue)
 {
+    invalidateColumnData();
     for(int i=0;i<_storage.getSize();i++) {
         _storage[i].add(aValue);
     }
@@ -1521,6 +1707,7 @@ add(double aValue)
 void Storage::
 add(int aN, double aValue)
 {
+    invalidateColumnData();
     for(int i=0;i<_storage.getSize();i++) {
         _storage[i].add(aN,aValue);
     }
@@ -1538,6 +1725,7 @@ add(int aN, double aValue)
 void Storage::
 add(int aN,double aY[])
 {
+    invalidateColumnData();
     for(int i=0;i<_storage.getSize();i++) {
         _storage[i].add(aN,aY);
     }
@@ -1552,6 +1740,7 @@ add(int aN,double aY[])
 void Storage::
 add(StateVector *aStateVector)
 {
+    invalidateColumnData();
     for(int i=0;i<_storage.getSize();i++) {
         _storage[i].add(aStateVector);
     }
@@ -1569,6 +1758,7 @@ s */
 void Storage::
 add(Storage *aStorage)
 {
+    invalidateColumnData();
     if(aStorage==NULL) return;
 
     int n,N=0,nN;
@@ -1576,8 +1766,8 @@ add(Storage *aStorage)
     for(int i=0;i<_storage.getSize();i++) {
 
         // GET INFO ON THIS STORAGE INSTANCE
-        n = getStateVector(i)->getSize();
-        t = getStateVector(i)->getTime();
+        n = _storage[i].getSize();
+        t = _storage[i].getTime();
 
         // GET DATA FROM ARGUMENT
         N = aStorage->getDataAtTime(t,N,&Y);
@@ -1606,6 +1796,7 @@ add(Storage *aStorage)
 void Storage::
 subtract(double aValue)
 {
+    invalidateColumnData();
     for(int i=0;i<_storage.getSize();i++) {
         _storage[i].subtract(aValue);
     }
@@ -1623,6 +1814,7 @@ subtract(double aValue)
 void Storage::
 subtract(int aN,double aY[])
 {
+    invalidateColumnData();
     for(int i=0;i<_storage.getSize();i++) {
         _storage[i].subtract(aN,aY);
     }
@@ -1637,6 +1829,7 @@ subtract(int aN,double aY[])
 void Storage::
 subtract(StateVector *aStateVector)
 {
+    invalidateColumnData();
     for(int i=0;i<_storage.getSize();i++) {
         _storage[i].subtract(aStateVector);
     }
@@ -1654,6 +1847,7 @@ s */
 void Storage::
 subtract(Storage *aStorage)
 {
+    invalidateColumnData();
     if(aStorage==NULL) return;
 
     int n,N=0,nN;
@@ -1661,8 +1855,8 @@ subtract(Storage *aStorage)
     for(int i=0;i<_storage.getSize();i++) {
 
         // GET INFO ON THIS STORAGE INSTANCE
-        n = getStateVector(i)->getSize();
-        t = getStateVector(i)->getTime();
+        n = _storage[i].getSize();
+        t = _storage[i].getTime();
 
         // GET DATA FROM ARGUMENT
         N = aStorage->getDataAtTime(t,N,&Y);
@@ -1691,6 +1885,7 @@ subtract(Storage *aStorage)
 void Storage::
 multiply(double aValue)
 {
+    invalidateColumnData();
     for(int i=0;i<_storage.getSize();i++) {
         _storage[i].multiply(aValue);
     }
@@ -1708,6 +1903,7 @@ multiply(double aValue)
 void Storage::
 multiply(int aN,double aY[])
 {
+    invalidateColumnData();
     for(int i=0;i<_storage.getSize();i++) {
         _storage[i].multiply(aN,aY);
     }
@@ -1723,6 +1919,7 @@ multiply(int aN,double aY[])
 void Storage::
 multiply(StateVector *aStateVector)
 {
+    invalidateColumnData();
     for(int i=0;i<_storage.getSize();i++) {
         _storage[i].multiply(aStateVector);
     }
@@ -1740,6 +1937,7 @@ s */
 void Storage::
 multiply(Storage *aStorage)
 {
+    invalidateColumnData();
     if(aStorage==NULL) return;
 
     int n,N=0,nN;
@@ -1747,8 +1945,8 @@ multiply(Storage *aStorage)
     for(int i=0;i<_storage.getSize();i++) {
 
         // GET INFO ON THIS STORAGE INSTANCE
-        n = getStateVector(i)->getSize();
-        t = getStateVector(i)->getTime();
+        n = _storage[i].getSize();
+        t = _storage[i].getTime();
 
         // GET DATA FROM ARGUMENT
         N = aStorage->getDataAtTime(t,N,&Y);
@@ -1773,6 +1971,7 @@ multiply(Storage *aStorage)
 void Storage::
 multiplyColumn(int aIndex, double aValue)
 {
+    invalidateColumnData();
     double newValue;
     for(int i=0;i<_storage.getSize();i++) {
         _storage[i].getDataValue(aIndex, newValue);
@@ -1793,6 +1992,7 @@ multiplyColumn(int aIndex, double aValue)
 void Storage::
 divide(double aValue)
 {
+    invalidateColumnData();
     for(int i=0;i<_storage.getSize();i++) {
         _storage[i].divide(aValue);
     }
@@ -1809,6 +2009,7 @@ divide(double aValue)
 void Storage::
 divide(int aN,double aY[])
 {
+    invalidateColumnData();
     for(int i=0;i<_storage.getSize();i++) {
         _storage[i].divide(aN,aY);
     }
@@ -1822,6 +2023,7 @@ divide(int aN,double aY[])
 void Storage::
 divide(StateVector *aStateVector)
 {
+    invalidateColumnData();
     for(int i=0;i<_storage.getSize();i++) {
         _storage[i].divide(aStateVector);
     }
@@ -1839,6 +2041,7 @@ s */
 void Storage::
 divide(Storage *aStorage)
 {
+    invalidateColumnData();
     if(aStorage==NULL) return;
 
     int i;
@@ -1847,8 +2050,8 @@ divide(Storage *aStorage)
     for(i=0;i<_storage.getSize();i++) {
 
         // GET INFO ON THIS STORAGE INSTANCE
-        n = getStateVector(i)->getSize();
-        t = getStateVector(i)->getTime();
+        n = _storage[i].getSize();
+        t = _storage[i].getTime();
 
         // GET DATA FROM ARGUMENT
         N = aStorage->getDataAtTime(t,N,&Y);
@@ -1979,7 +2182,7 @@ integrate(int aI1,int aI2,int aN,double *rArea,Storage *rStorage) const
 
     // RECORD FIRST STATE
     if(rStorage) {
-        ti = getStateVector(aI1)->getTime();
+        ti = _storage[aI1].getTime();
         rStorage->append(ti,n,rArea);
     }
 
@@ -1987,12 +2190,12 @@ integrate(int aI1,int aI2,int aN,double *rArea,Storage *rStorage) const
     for(int I=aI1;I<aI2;I++) {
 
         // INITIAL
-        ti = getStateVector(I)->getTime();
-        yi = getStateVector(I)->getData().get();
+        ti = _storage[I].getTime();
+        yi = _storage[I].getData().get();
 
         // FINAL
-        tf = getStateVector(I+1)->getTime();
-        yf = getStateVector(I+1)->getData().get();
+        tf = _storage[I+1].getTime();
+        yf = _storage[I+1].getData().get();
 
         // AREA
         for(int i=0;i<n;i++) {
@@ -2085,8 +2288,8 @@ integrate(double aTI,double aTF,int aN,double *rArea,Storage *rStorage) const
 
         // FIRST SLICE
         getDataAtTime(aTI,n,&yI);
-        tf = getStateVector(II)->getTime();
-        yf = getStateVector(II)->getData().get();
+        tf = _storage[II].getTime();
+        yf = _storage[II].getData().get();
         for(int i=0;i<n;i++) {
             rArea[i] += 0.5*(yf[i]+yI[i])*(tf-aTI);
         }
@@ -2094,10 +2297,10 @@ integrate(double aTI,double aTF,int aN,double *rArea,Storage *rStorage) const
 
         // INTERVALS
         for(int I=II;I<FF;I++) {
-            ti = getStateVector(I)->getTime();
-            yi = getStateVector(I)->getData().get();
-            tf = getStateVector(I+1)->getTime();
-            yf = getStateVector(I+1)->getData().get();
+            ti = _storage[I].getTime();
+            yi = _storage[I].getData().get();
+            tf = _storage[I+1].getTime();
+            yf = _storage[I+1].getData().get();
             for(int i=0;i<n;i++) {
                 rArea[i] += 0.5*(yf[i]+yi[i])*(tf-ti);
             }
@@ -2105,8 +2308,8 @@ integrate(double aTI,double aTF,int aN,double *rArea,Storage *rStorage) const
         }
 
         // LAST SLICE
-        ti = getStateVector(FF)->getTime();
-        yi = getStateVector(FF)->getData().get();
+        ti = _storage[FF].getTime();
+        yi = _storage[FF].getData().get();
         getDataAtTime(aTF,n,&yF);
         for(int i=0;i<n;i++) {
             rArea[i] += 0.5*(yF[i]+yi[i])*(aTF-ti);
@@ -2231,6 +2434,18 @@ integrate(double aTI,double aTF) const
     } else return integStore;
 }
 
+//_____________________________________________________________________________
+/**
+ * Number of threads with which to filter nc columns of n values each. Small
+ * storages are filtered on the calling thread, where starting threads would
+ * cost more than it saves.
+ */
+static int
+NumFilterThreads(int nc,int n)
+{
+    if((double)nc*n < 100000.0) return(1);
+    return(std::max(1,std::min(SimTK::ParallelExecutor::getNumProcessors(),nc)));
+}
 //_____________________________________________________________________________
 /**
  * Pad each of the columns in a statevector by a specified amount.
@@ -2248,27 +2463,26 @@ pad(int aPadSize)
     Signal::Pad(aPadSize,paddedTime);
     int newSize = paddedTime.getSize();
 
-    // PAD EACH COLUMN
-    int nc = getSmallestNumberOfStates();
-    Array<double> paddedSignal(0.0,size);
-    StateVector *vecs = new StateVector[newSize];
+    // PAD ALL THE COLUMNS AT ONCE
+    updateColumnData();
+    int nc = _columnDataNumStates;
+    std::vector<double> paddedColumns((size_t)newSize*nc);
+    Signal::Pad(aPadSize,size,nc,_columnData.data(),paddedColumns.data());
+
+    // REPLACE THE STATEVECTORS
+    _storage.setSize(newSize);
     for(int j=0;j<newSize;j++) {
-        vecs[j].getData().setSize(nc);
-        vecs[j].setTime(paddedTime[j]);
+        StateVector &vec = _storage[j];
+        vec.setTime(paddedTime[j]);
+        Array<double> &y = vec.getData();
+        y.setSize(nc);
+        for(int i=0;i<nc;i++) y[i] = paddedColumns[(size_t)i*newSize+j];
     }
-    for(int i=0;i<nc;i++) {
-        getDataColumn(i,paddedSignal);
-        Signal::Pad(aPadSize,paddedSignal);
-        for(int j=0;j<newSize;j++)
-            vecs[j].setDataValue(i,paddedSignal[j]);
-    }
-
-    // APPEND THE STATEVECTORS
-    _storage.setSize(0);
-    for(int i=0;i<newSize;i++) _storage.append(vecs[i]);
 
-    // CLEANUP
-    delete[] vecs;
+    // The padded columns are the new column data.
+    _columnData.swap(paddedColumns);
+    _columnDataTimes.assign(&paddedTime[0], &paddedTime[0]+newSize);
+    _columnDataIsValid = true;
 }
 
 //_____________________________________________________________________________
@@ -2298,21 +2512,15 @@ smoothSpline(int aOrder,double aCutoffFrequency)
         return;
     }
 
-    // LOOP OVER COLUMNS
-    double *times=NULL;
-    int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
-    Array<double> filt(0.0,size);
-    getTimeColumn(times,0);
-    for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::SmoothSpline(aOrder,dtmin,aCutoffFrequency,size,times,signal,&filt[0]);
-        setDataColumn(i,filt);
-    }
-
-    // CLEANUP
-    delete[] times;
-    delete[] signal;
+    // FILTER THE COLUMNS
+    // The contiguous column data is filtered in place and written back to
+    // the statevectors in a single pass at the end.
+    updateColumnData();
+    int nc = _columnDataNumStates;
+    Signal::SmoothSpline(aOrder,dtmin,aCutoffFrequency,size,nc,
+        _columnDataTimes.data(),_columnData.data(),_columnData.data(),
+        NumFilterThreads(nc,size));
+    writeColumnDataToStateVectors();
 }
 
 
@@ -2343,18 +2551,14 @@ lowpassIIR(double aCutoffFrequency)
         return;
     }
 
-    // LOOP OVER COLUMNS
-    int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
-    Array<double> filt(0.0,size);
-    for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::LowpassIIR(dtmin,aCutoffFrequency,size,signal,&filt[0]);
-        setDataColumn(i,filt);
-    }
-
-    // CLEANUP
-    delete[] signal;
+    // FILTER THE COLUMNS
+    // The contiguous column data is filtered in place and written back to
+    // the statevectors in a single pass at the end.
+    updateColumnData();
+    int nc = _columnDataNumStates;
+    Signal::LowpassIIR(dtmin,aCutoffFrequency,size,nc,
+        _columnData.data(),_columnData.data(),NumFilterThreads(nc,size));
+    writeColumnDataToStateVectors();
 }
 
 
@@ -2385,18 +2589,14 @@ lowpassFIR(int aOrder,double aCutoffFrequency)
         return;
     }
 
-    // LOOP OVER COLUMNS
-    int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
-    Array<double> filt(0.0,size);
-    for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::LowpassFIR(aOrder,dtmin,aCutoffFrequency,size,signal,&filt[0]);
-        setDataColumn(i,filt);
-    }
-
-    // CLEANUP
-    delete[] signal;
+    // FILTER THE COLUMNS
+    // The contiguous column data is filtered in place and written back to
+    // the statevectors in a single pass at the end.
+    updateColumnData();
+    int nc = _columnDataNumStates;
+    Signal::LowpassFIR(aOrder,dtmin,aCutoffFrequency,size,nc,
+        _columnData.data(),_columnData.data(),NumFilterThreads(nc,size));
+    writeColumnDataToStateVectors();
 }
 
 
@@ -2408,10 +2608,10 @@ lowpassFIR(int aOrder,double aCutoffFrequency)
  * Find the index of the storage element that occurred immediately before
  * or at time aT ( aT <= getTime(index) ).
  *
- * This method can be much more efficient than findIndex(aT) if a good guess
- * is made for aI.
- * If aI corresponds to a state which occurred later than aT, an exhaustive
- * search is performed by calling findIndex(aT).
+ * This method can be more efficient than findIndex(aT) if a good guess
+ * is made for aI: aI and the element after it are checked first.
+ * If aI corresponds to a state which occurred later than aT, all
+ * statevectors are searched.
  *
  * @param aI Index at which to start searching.
  * @param aT Time.
@@ -2422,27 +2622,24 @@ int Storage::
 findIndex(int aI,double aT) const
 {
     // MAKE SURE aI IS VALID
-    if(_storage.getSize()<=0) return(-1);
-    if((aI>=_storage.getSize())||(aI<0)) aI=0;
-    if(getStateVector(aI)->getTime()>aT) aI=0;
+    int n = _storage.getSize();
+    if(n<=0) return(-1);
+    if((aI>=n)||(aI<0)) aI=0;
+    if(_storage[aI].getTime()>aT) return(findIndex(aT));
 
-    // SEARCH
-    //cout << "Storage.findIndex: starting at " << aI << endl;
-    int i;
-    for(i=aI;i<_storage.getSize();i++) {
-        if(aT<getStateVector(i)->getTime()) break;
-    }
-    _lastI = i-1;
-    if(_lastI<0) _lastI=0;
-    return(_lastI);
+    // CHECK THE INTERVAL AT aI AND THE ONE AFTER IT
+    if((aI+1==n)||(aT<_storage[aI+1].getTime())) return(aI);
+    if((aI+2==n)||(aT<_storage[aI+2].getTime())) return(aI+1);
+
+    // SEARCH THE REST
+    return(findIndexAfter(aI+2,aT)-1);
 }
 //_____________________________________________________________________________
 /**
  * Find the index of the storage element that occurred immediately before
  * or at a specified time ( getTime(index) <= aT ).
  *
- * This method is not very efficient because it always starts its search
- * with the first stored state.
+ * A binary search over all statevectors is performed.
  *
  * @param aT Time.
  * @return Index preceding or at time aT.  If aT is less than the earliest
@@ -2452,13 +2649,50 @@ int Storage::
 findIndex(double aT) const
 {
     if(_storage.getSize()<=0) return(-1);
-    int i;
-    for(i=0;i<_storage.getSize();i++) {
-        if(aT<getStateVector(i)->getTime()) break;
+    int i = findIndexAfter(0,aT)-1;
+    if(i<0) i=0;
+    return(i);
+}
+//_____________________________________________________________________________
+/**
+ * Find the index of the storage element that occurred immediately before
+ * or at a specified time, starting at the index found by the previous
+ * search with the same cursor (see findIndex(int,double)).  The cursor is
+ * updated to the index that is returned.
+ *
+ * @param aCursor Cursor from which to start searching.
+ * @param aT Time.
+ * @return Index preceding or at time aT.  If aT is less than the earliest
+ * time, 0 is returned.
+ */
+int Storage::
+findIndex(InterpolationCursor& aCursor,double aT) const
+{
+    int i = findIndex(aCursor._index,aT);
+    if(i>=0) aCursor._index = i;
+    return(i);
+}
+//_____________________________________________________________________________
+/**
+ * Binary search for the first storage element at or after aBegin whose time
+ * is greater than aT.
+ *
+ * @param aBegin Index at which to start searching.
+ * @param aT Time.
+ * @return Index of the first statevector later than aT, or getSize() if
+ * there is none.
+ */
+int Storage::
+findIndexAfter(int aBegin,double aT) const
+{
+    int lo = aBegin;
+    int hi = _storage.getSize();
+    while(lo<hi) {
+        int mid = lo + (hi-lo)/2;
+        if(aT<_storage[mid].getTime()) hi = mid;
+        else lo = mid+1;
     }
-    _lastI = i-1;
-    if(_lastI<0) _lastI=0;
-    return(_lastI);
+    return(lo);
 }
 //_____________________________________________________________________________
 /** 
@@ -2503,6 +2737,7 @@ resample(double aDT, int aDegree)
 
     Array<std::string> saveLabels = getColumnLabels();
     // Free up memory used by Storage
+    invalidateColumnData();
     _storage.setSize(0);
     // For every column, collect data and fit spline to originalTimes, dataColumn.
     Storage *newStorage = splineSet->constructStorage(0,aDT);
@@ -2594,6 +2829,7 @@ void Storage::interpolateAt(const Array<double> &targetTimes)
         vec.setStates(t,ny,y);
 
         _storage.insert(tIndex+1, vec);
+        invalidateColumnData();
     }
 }
 //=============================================================================
@@ -2685,7 +2921,7 @@ print(const string &aFileName,const string &aMode, const string& aComment) const
 
     // VECTORS
     for(int i=0;i<_storage.getSize();i++) {
-        n = getStateVector(i)->print(fp);
+        n = _storage[i].print(fp);
         if(n<0) {
             cout << "Storage.print(const string&,const string&): error printing to " << aFileName;
             return(false);
@@ -2948,7 +3184,7 @@ void Storage::addToRdStorage(Storage& rStorage, double aStartTime, double aEndTi
         for (j = 0; j < getSize(); j++)
         {
             /* Assume that the first column is 'time'. */
-            time = getStateVector(j)->getTime();
+            time = _storage[j].getTime();
             if (EQUAL_WITHIN_TOLERANCE(time, stateTime, 0.0001))
             {
                 Array<double>& states = rStorage.getStateVector(i)->getData();
@@ -2956,7 +3192,7 @@ void Storage::addToRdStorage(Storage& rStorage, double aStartTime, double aEndTi
                 {
                     if (_columnLabels[k] != "Unassigned")
                     {
-                        states.append(getStateVector(j)->getData().get(k-1));
+                        states.append(_storage[j].getData().get(k-1));
                         addedData = true;
                     }
                 }
@@ -3128,9 +3364,10 @@ bool Storage::parseHeaders(std::ifstream& aStream, int& rNumRows, int& rNumColum
 void Storage::
 exchangeTimeColumnWith(int aColumnIndex)
 {
+    invalidateColumnData();
     StateVector* vec;
     for(int i=0; i< _storage.getSize(); i++){
-        vec = getStateVector(i);
+        vec = &_storage[i];
         double swap = vec->getData().get(aColumnIndex);
         double time=vec->getTime();
         vec->setDataValue(aColumnIndex, time);
@@ -33,6 +33,7 @@
 #include "Units.h"
 #include "SimTKcommon.h"
 #include "StorageInterface.h"
+#include <vector>
 
 const int Storage_DEFAULT_CAPACITY = 256;
 //=============================================================================
@@ -49,7 +50,14 @@ typedef std::map<std::string, std::string, std::less<std::string> > MapKeysToVal
  * Generally, it is used to store the time histories of the states during
  * an integration, but may be used for a variety of applications.  Note that
  * it is assumed by several methods in this class that the time stamps of
- * stored statevectors are monotonically increasing.
+ * stored statevectors are monotonically increasing.  Lookups by time use a
+ * binary search; callers that query nearby times repeatedly can keep an
+ * InterpolationCursor so that a lookup usually costs O(1).  Lookups by
+ * time and the other const methods that return data by value do not
+ * modify the Storage, so several threads may make them on the same Storage
+ * concurrently (each with its own cursor) as long as no thread modifies
+ * it.  getStateVector() and getLastStateVector() are const but return
+ * modifiable statevectors; calling them counts as a modification.
  *
  * When stored as a file, the statevectors are stored in rows.  This first
  * value in a row is the time stamp at which the states occurred.  The
@@ -60,6 +68,16 @@ typedef std::map<std::string, std::string, std::less<std::string> > MapKeysToVal
  * TimeIndex, and a particular state (or column) is indexed by the
  * StateIndex.
  *
+ * For column-oriented processing, Storage can also hold a contiguous,
+ * column-major copy of the states that are present in every statevector.
+ * The statevectors remain the stored data: the copy is made by
+ * updateColumnData(), is read through getTimeSpan() and getDataColumnSpan(),
+ * which return read-only views of it rather than copies, and is discarded
+ * by every Storage method that modifies the data, including
+ * getStateVector() and getLastStateVector(), which hand out pointers
+ * through which the data can be modified.  Call updateColumnData() again
+ * after editing statevectors through such pointers.
+ *
  * @version 1.0
  * @author Frank C. Anderson
  */
@@ -87,8 +105,17 @@ protected:
     /** Step interval at which states in a simulation are stored. See
     store(). */
     int _stepInterval;
-    /** Last index at which a search was started. */
-    mutable int _lastI;
+    /** Contiguous column-major copy of the states present in every
+    statevector: state j of statevector i is at [j*getSize()+i]. */
+    std::vector<double> _columnData;
+    /** Times of the statevectors, in the same order as _columnData. */
+    std::vector<double> _columnDataTimes;
+    /** Number of states (columns) held in _columnData. */
+    int _columnDataNumStates;
+    /** Whether _columnData has been built by updateColumnData() and not
+    discarded since. Mutable so that getStateVector(), which is const but
+    returns a modifiable statevector, can discard it. */
+    mutable bool _columnDataIsValid;
     /** Flag for whether or not to insert a SIMM style header. */
     bool _writeSIMMHeader;
     /** Units in which the data is represented. */
@@ -125,6 +152,41 @@ public:
     Storage& operator=(const Storage &aStorage);
 #endif
 
+#ifndef SWIG
+    /** A read-only view of a contiguous sequence of values held by a
+    Storage, such as a column of data. It does not own the values and is
+    invalidated by any subsequent modification of the Storage. */
+    class ColumnSpan {
+    public:
+        ColumnSpan() : _data(NULL), _size(0) {}
+        ColumnSpan(const double* aData, int aSize) : _data(aData), _size(aSize) {}
+        const double* data() const { return _data; }
+        int size() const { return _size; }
+        bool empty() const { return _size==0; }
+        const double& operator[](int aIndex) const { return _data[aIndex]; }
+        const double* begin() const { return _data; }
+        const double* end() const { return _data + _size; }
+    private:
+        const double* _data;
+        int _size;
+    };
+
+    /** Remembers the interval found by the previous lookup by time so that
+    the next lookup can start there. A cursor belongs to a single caller
+    (or thread); it can be used with any Storage, and an out-of-date cursor
+    only makes the next lookup slower. */
+    class InterpolationCursor {
+    public:
+        InterpolationCursor() : _index(0) {}
+        /** Index found by the most recent lookup. */
+        int getIndex() const { return _index; }
+        void reset() { _index = 0; }
+    private:
+        friend class Storage;
+        int _index;
+    };
+#endif
+
     const std::string& getName() const { return _name; };
     const std::string& getDescription() const { return _description; };
     void setName(const std::string& aName) { _name = aName; };
@@ -146,6 +208,8 @@ private:
     bool isSimmReservedToken(const std::string& aToken);
     void postProcessSIMMMotion();
     void exchangeTimeColumnWith(int aColumnIndex);
+    void invalidateColumnData() const { _columnDataIsValid = false; }
+    void writeColumnDataToStateVectors();
 public:
 
     //--------------------------------------------------------------------------
@@ -185,6 +249,12 @@ public:
     int getDataAtTime(double aTime,int aN,double *rData) const;
     int getDataAtTime(double aTime,int aN,Array<double> &rData) const override;
     int getDataAtTime(double aTime,int aN,SimTK::Vector& v) const;
+#ifndef SWIG
+    int getDataAtTime(InterpolationCursor& aCursor,double aTime,int aN,
+        double *rData) const;
+    int getDataAtTime(InterpolationCursor& aCursor,double aTime,int aN,
+        Array<double> &rData) const;
+#endif
     int getDataColumn(int aStateIndex,double *&rData) const;
     int getDataColumn(int aStateIndex,Array<double> &rData) const;
     // Set entries in a column of the storage to a fixed value, 
@@ -192,6 +262,29 @@ public:
     void setDataColumn(int aStateIndex,const Array<double> &aData);
     int getDataColumn(const std::string& columnName,double *&rData) const;
     void getDataColumn(const std::string& columnName, Array<double>& data, double startTime=0.0) override;
+    /** Copy the states present in every statevector (see
+    getSmallestNumberOfStates()) and the times into the contiguous column
+    data read by getTimeSpan() and getDataColumnSpan(). The copy is rebuilt
+    on every call, so call it again after modifying statevectors through
+    the pointers returned by getStateVector(). */
+    void updateColumnData();
+    /** Whether the column data is available, i.e., updateColumnData() has
+    been called and neither a modifying method nor getStateVector() or
+    getLastStateVector() has been called since. */
+    bool hasColumnData() const { return _columnDataIsValid; }
+#ifndef SWIG
+    /** Get the times of all statevectors as a contiguous, read-only view.
+    The view remains valid until this Storage is modified. An exception is
+    thrown if hasColumnData() is false. */
+    ColumnSpan getTimeSpan() const;
+    /** Get the values of a state (column) as a contiguous, read-only view
+    with one value per statevector. Only states present in every statevector
+    (see getSmallestNumberOfStates()) are available; an empty view is
+    returned otherwise. The view remains valid until this Storage is
+    modified. An exception is thrown if hasColumnData() is false. */
+    ColumnSpan getDataColumnSpan(int aStateIndex) const;
+    ColumnSpan getDataColumnSpan(const std::string& aColumnName) const;
+#endif
 #ifndef SWIG
     /** A data block, like a vector for a force, point, etc... will span multiple "columns"
         It is desirable to access the block as a single entity provided an identifier that is common 
@@ -226,7 +319,7 @@ public:
     //--------------------------------------------------------------------------
     int reset(int aIndex=0);
     int reset(double aTime);
-    void purge() { _storage.setSize(0); };  // Similar to reset but doesn't try to keep history
+    void purge() { _storage.setSize(0); invalidateColumnData(); };  // Similar to reset but doesn't try to keep history
     void crop(const double newStartTime, const double newFinalTime);
     //--------------------------------------------------------------------------
     // STORAGE
@@ -236,6 +329,8 @@ public:
     int append(double aT,int aN,const double *aY, bool aCheckForDuplicateTime=true) override;
     int append(double aT,const SimTK::Vector& aY, bool aCheckForDuplicateTime=true) override;
     virtual int append(double aT,const Array<double>& aY, bool aCheckForDuplicateTime=true);
+    int appendRows(int aNumRows,const double *aT,int aN,const double *aY,
+                   bool aCheckForDuplicateTime=true);
     int append(double aT, const SimTK::Vec3& aY,bool aCheckForDuplicateTime=true) override {
         return append(aT, 3, &aY[0], aCheckForDuplicateTime);
     }
@@ -281,6 +376,9 @@ public:
     //--------------------------------------------------------------------------
     int findIndex(double aT) const override;
     int findIndex(int aI,double aT) const override;
+#ifndef SWIG
+    int findIndex(InterpolationCursor& aCursor,double aT) const;
+#endif
     void findFrameRange(double aStartTime, double aEndTime, int& oStartFrame, int& oEndFrame) const;
     double resample(double aDT, int aDegree);
     double resampleLinear(double aDT);
@@ -310,6 +408,8 @@ private:
     int writeColumnLabels(FILE *rFP) const;
     int integrate(double aTI,double aTF,int aN,double *rArea,Storage *rStorage) const;
     int integrate(int aI1,int aI2,int aN,double *rArea,Storage *rStorage) const;
+    int interpolateData(int aIndex,double aT,int aN,double **rData) const;
+    int findIndexAfter(int aBegin,double aT) const;
 
 //=============================================================================
 };  // END of class Storage
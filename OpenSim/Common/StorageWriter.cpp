@@ -0,0 +1,204 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  StorageWriter.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2016 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+//=============================================================================
+// INCLUDES
+//=============================================================================
+#include "StorageWriter.h"
+#include "Exception.h"
+#include "IO.h"
+#include "StateVector.h"
+#include "Storage.h"
+#include "SimTKcommon.h"
+#include <iostream>
+
+using namespace OpenSim;
+using namespace std;
+
+// Width of the row count in the header, so that it can be rewritten in place
+// as rows are written.
+static const int NumRowsFieldWidth = 10;
+
+//=============================================================================
+// WRITER TASK
+//=============================================================================
+// Writes one block of rows on the writer thread. The queue deletes the task
+// once it has been executed.
+class StorageWriter::WriteBlockTask : public SimTK::ParallelWorkQueue::Task {
+public:
+    WriteBlockTask(StorageWriter& writer, Block& block) : _writer(writer) {
+        _block.values.swap(block.values);
+        _block.rowSizes.swap(block.rowSizes);
+    }
+    void execute() override {
+        try {
+            _writer.writeBlock(_block);
+        }
+        catch (const std::exception& e) {
+            if (_writer._error.empty())
+                _writer._error = e.what();
+        }
+    }
+private:
+    StorageWriter& _writer;
+    Block _block;
+};
+
+//=============================================================================
+// CONSTRUCTOR(S) AND DESTRUCTOR
+//=============================================================================
+StorageWriter::StorageWriter(const string& fileName, const string& name,
+        const Array<string>& columnLabels, bool inDegrees,
+        int flushInterval, int maxQueuedBlocks) :
+    _fileName(fileName),
+    _flushInterval(flushInterval > 0 ? flushInterval : 1)
+{
+    _fp = IO::OpenFile(fileName, "w");
+    if (_fp == NULL)
+        throw Exception("StorageWriter: could not open file " + fileName,
+                        __FILE__, __LINE__);
+
+    // HEADER
+    // Same header as Storage::print(), except that the number of rows is
+    // padded so that it can be updated as rows are written.
+    fprintf(_fp, "%s\n", name.c_str());
+    fprintf(_fp, "version=%d\n", Storage::getLatestVersion());
+    fprintf(_fp, "nRows=");
+    _numRowsOffset = ftell(_fp);
+    fprintf(_fp, "%-*d\n", NumRowsFieldWidth, 0);
+    fprintf(_fp, "nColumns=%d\n", columnLabels.getSize());
+    fprintf(_fp, "inDegrees=%s\n", (inDegrees ? "yes" : "no"));
+    fprintf(_fp, "%s\n", Storage::DEFAULT_HEADER_TOKEN);
+
+    // COLUMN LABELS
+    for (int i = 0; i < columnLabels.getSize(); ++i)
+        fprintf(_fp, (i == 0 ? "%s" : "\t%s"), columnLabels[i].c_str());
+    fprintf(_fp, "\n");
+    fflush(_fp);
+
+    _numColumns = columnLabels.getSize();
+    _pending.values.reserve(_flushInterval*_numColumns);
+    _pending.rowSizes.reserve(_flushInterval);
+    _queue.reset(new SimTK::ParallelWorkQueue(
+            maxQueuedBlocks > 0 ? maxQueuedBlocks : 1, 1));
+}
+
+StorageWriter::~StorageWriter()
+{
+    try {
+        close();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+    }
+}
+
+//=============================================================================
+// WRITING
+//=============================================================================
+void StorageWriter::append(double t, int n, const double* y)
+{
+    if (_fp == nullptr)
+        throw Exception("StorageWriter: file " + _fileName + " is closed.",
+                        __FILE__, __LINE__);
+    _pending.values.push_back(t);
+    _pending.values.insert(_pending.values.end(), y, y + n);
+    _pending.rowSizes.push_back(n + 1);
+    ++_numRowsAppended;
+
+    if ((int)_pending.rowSizes.size() >= _flushInterval)
+        submitPendingBlock();
+}
+
+void StorageWriter::append(const StateVector& aStateVector)
+{
+    const Array<double>& data = aStateVector.getData();
+    append(aStateVector.getTime(), data.getSize(),
+           data.getSize() ? &data[0] : nullptr);
+}
+
+void StorageWriter::submitPendingBlock()
+{
+    if (_pending.rowSizes.empty()) return;
+    // addTask() blocks while the queue is full.
+    _queue->addTask(new WriteBlockTask(*this, _pending));
+    // The task took the pending buffers, so make room for the next block.
+    _pending.values.reserve(_flushInterval*_numColumns);
+    _pending.rowSizes.reserve(_flushInterval);
+}
+
+void StorageWriter::flush()
+{
+    if (_fp == nullptr) return;
+    submitPendingBlock();
+    _queue->flush();
+    if (!_error.empty())
+        throw Exception("StorageWriter: failed to write " + _fileName +
+                        ": " + _error, __FILE__, __LINE__);
+}
+
+void StorageWriter::close()
+{
+    if (_fp == nullptr) return;
+    submitPendingBlock();
+    _queue->flush();
+    _queue.reset();
+    fclose(_fp);
+    _fp = nullptr;
+    if (!_error.empty())
+        throw Exception("StorageWriter: failed to write " + _fileName +
+                        ": " + _error, __FILE__, __LINE__);
+}
+
+//_____________________________________________________________________________
+// Called on the writer thread.
+void StorageWriter::writeBlock(const Block& block)
+{
+    char format[IO_STRLEN];
+    sprintf(format, "%s", IO::GetDoubleOutputFormat());
+    char dataFormat[IO_STRLEN];
+    sprintf(dataFormat, "\t%s", IO::GetDoubleOutputFormat());
+
+    const double* value = block.values.data();
+    for (int size : block.rowSizes) {
+        if (fprintf(_fp, format, value[0]) < 0)
+            throw Exception("error writing to file.");
+        for (int i = 1; i < size; ++i)
+            fprintf(_fp, dataFormat, value[i]);
+        if (fprintf(_fp, "\n") < 0)
+            throw Exception("error writing to file.");
+        value += size;
+    }
+    _numRowsWritten += (int)block.rowSizes.size();
+    updateNumRowsInHeader();
+}
+
+void StorageWriter::updateNumRowsInHeader()
+{
+    // Make the rows written so far part of the file before counting them.
+    fflush(_fp);
+    fseek(_fp, _numRowsOffset, SEEK_SET);
+    fprintf(_fp, "%-*d", NumRowsFieldWidth, _numRowsWritten);
+    fseek(_fp, 0, SEEK_END);
+    if (fflush(_fp) != 0)
+        throw Exception("error flushing file.");
+}
@@ -0,0 +1,138 @@
+#ifndef OPENSIM_STORAGE_WRITER_H_
+#define OPENSIM_STORAGE_WRITER_H_
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  StorageWriter.h                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2016 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+#include "Array.h"
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace SimTK {
+class ParallelWorkQueue;
+}
+
+namespace OpenSim {
+
+class StateVector;
+
+//=============================================================================
+//=============================================================================
+/**
+ * A class that writes rows of data to a storage (.sto) file as they are
+ * produced, rather than collecting them in a Storage and printing it at the
+ * end. The rows are formatted and written by a background thread, so the
+ * caller only pays for copying the values.
+ *
+ * Rows are handed to the writer thread in blocks of flushInterval rows. After
+ * each block has been written, the file is flushed and the number of rows in
+ * its header is updated, so the file is always a valid storage file holding
+ * all the rows of the blocks written so far, even if the program does not
+ * finish. At most maxQueuedBlocks blocks are waiting to be written at a time;
+ * append() blocks when the writer thread falls behind, which bounds the
+ * memory used however many rows are written.
+ *
+ * The numerical format of the rows is that of StateVector::print(), as
+ * specified by IO.
+ *
+ * @see Storage
+ */
+class OSIMCOMMON_API StorageWriter
+{
+//=============================================================================
+// METHODS
+//=============================================================================
+public:
+    /** Open fileName for writing and write the header.
+    @param fileName         the storage file to be written
+    @param name             the name of the storage written in the header
+    @param columnLabels     column labels, starting with "time"
+    @param inDegrees        whether angles are reported in degrees
+    @param flushInterval    number of rows written between flushes
+    @param maxQueuedBlocks  number of blocks of rows that may wait to be
+                            written before append() blocks. */
+    StorageWriter(const std::string& fileName, const std::string& name,
+                  const Array<std::string>& columnLabels,
+                  bool inDegrees = false, int flushInterval = 100,
+                  int maxQueuedBlocks = 10);
+    /** Write any remaining rows and close the file. */
+    ~StorageWriter();
+
+    StorageWriter(const StorageWriter&) = delete;
+    StorageWriter& operator=(const StorageWriter&) = delete;
+
+    /** Append a row with time t and the n values in y. */
+    void append(double t, int n, const double* y);
+    /** Append a row with the time and data of aStateVector. */
+    void append(const StateVector& aStateVector);
+
+    /** Wait until all the rows appended so far are written and flushed to
+    the file. Throws if any row could not be written. */
+    void flush();
+    /** Flush and close the file. Nothing can be appended afterwards. */
+    void close();
+
+    /** The name of the file being written. */
+    const std::string& getFileName() const { return _fileName; }
+    /** The number of rows appended so far. */
+    int getNumRowsAppended() const { return _numRowsAppended; }
+    /** Whether the file is still open. */
+    bool isOpen() const { return _fp != nullptr; }
+
+private:
+    // Rows that are written to the file as one unit.
+    struct Block {
+        std::vector<double> values; // time followed by the data, per row
+        std::vector<int>    rowSizes; // number of values in each row
+    };
+    class WriteBlockTask;
+
+    // Hand the pending block to the writer thread.
+    void submitPendingBlock();
+    // Called on the writer thread.
+    void writeBlock(const Block& block);
+    void updateNumRowsInHeader();
+
+    std::string _fileName;
+    FILE* _fp = nullptr;
+    long _numRowsOffset = 0;
+    int _flushInterval;
+    int _numColumns = 0;
+
+    Block _pending;
+    int _numRowsAppended = 0;
+    std::unique_ptr<SimTK::ParallelWorkQueue> _queue;
+
+    // Only accessed by the writer thread while rows are queued.
+    int _numRowsWritten = 0;
+    std::string _error;
+
+//=============================================================================
+};  // END of class StorageWriter
+
+}; //namespace
+//=============================================================================
+//=============================================================================
+
+#endif // OPENSIM_STORAGE_WRITER_H_
@@ -20,6 +20,7 @@
  * See the License for the specific language governing permissions and        *
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
+#include <ctime>  // clock(), clock_t, CLOCKS_PER_SEC
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Common/Component.h>
 
@@ -137,6 +138,7 @@ public:
         constructInfrastructure();
         m_ctr = 0;
         m_mutableCtr = 0;
+        m_cachedCtr = 0;
     }
 
     double getSomething(const SimTK::State& state) const {
@@ -154,6 +156,13 @@ public:
         return SimTK::Vec3(t, t*t, sqrt(t));
     }
 
+    // Output whose value is kept in the State's cache; counts evaluations.
+    double calcCachedTime(const SimTK::State& state) const {
+        m_cachedCtr++;
+        return state.getTime();
+    }
+    int getNumCachedTimeEvaluations() const { return m_cachedCtr; }
+
     SimTK::SpatialVec calcSpatialAcc(const SimTK::State& state) const {
         const_cast<Foo *>(this)->m_ctr++;
         m_mutableCtr++;
@@ -195,6 +204,7 @@ protected:
 private:
     int m_ctr;
     mutable int m_mutableCtr;
+    mutable int m_cachedCtr;
 
     void constructProperties() override {
         constructProperty_mass(1.0);
@@ -218,6 +228,9 @@ private:
         constructOutput<SimTK::Vec3>("Output2", &Foo::calcSomething,
                 SimTK::Stage::Time);
 
+        constructOutput<double>("CachedTime", &Foo::calcCachedTime,
+                SimTK::Stage::Time, true);
+
         double a = 10;
         constructOutput<Vector>("Qs",
             std::bind([=](const SimTK::State& s)->Vector{return s.getQ(); }, std::placeholders::_1),
@@ -249,6 +262,11 @@ public:
         return spring.calcPotentialEnergyContribution(state);
     }
 
+    // Access the cache variable allocated by Bar by its handle.
+    const CacheVariableHandle<double>& getLengthCacheHandle() const {
+        return lengthCV;
+    }
+
 protected:
     /** Component Interface */
     void extendConnect(Component& root) override{
@@ -291,11 +309,15 @@ protected:
         // variables do not have a corresponding Output.
         bool hidden = true;
         addStateVariable("hiddenStateVar", SimTK::Stage::Dynamics, hidden);
+
+        // Access some variables through handles instead of by name.
+        activationSV = getStateVariableHandle("activation");
+        lengthCV = addCacheVariable("length", 0.0, SimTK::Stage::Velocity);
     }
 
     void computeStateVariableDerivatives(const SimTK::State& state) const override {
         setStateVariableDerivativeValue(state, "fiberLength", 2.0);
-        setStateVariableDerivativeValue(state, "activation", 3.0 * state.getTime());
+        setStateVariableDerivativeValue(state, activationSV, 3.0 * state.getTime());
         setStateVariableDerivativeValue(state, "hiddenStateVar", 
                                           exp(-0.5 * state.getTime()));
     }
@@ -318,6 +340,9 @@ private:
     mutable ForceIndex fix;
     ReferencePtr<TheWorld> world;
 
+    mutable StateVariableHandle activationSV;
+    mutable CacheVariableHandle<double> lengthCV;
+
 }; // End of class Bar
 
 // Create 2nd level derived class to verify that Component interface
@@ -376,6 +401,92 @@ private:
 SimTK_NICETYPENAME_LITERAL(Foo);
 SimTK_NICETYPENAME_LITERAL(Bar);
 
+// Verify that accessing state and cache variables by handle is equivalent to
+// accessing them by name and compare the cost of both.
+void testVariableHandles(const Bar& bar, SimTK::State& s)
+{
+    const int nAccess = 100000;
+    const StateVariableHandle fiberLengthSV =
+        bar.getStateVariableHandle("fiberLength");
+    const CacheVariableHandle<double>& lengthCV = bar.getLengthCacheHandle();
+
+    bar.setStateVariableValue(s, fiberLengthSV, 2.5);
+    ASSERT_EQUAL(2.5, bar.getStateVariableValue(s, "fiberLength"), 1e-15);
+    ASSERT_EQUAL(2.5, bar.getStateVariableValue(s, fiberLengthSV), 1e-15);
+
+    bar.setCacheVariableValue(s, lengthCV, 0.25);
+    ASSERT(bar.isCacheVariableValid(s, "length"));
+    ASSERT_EQUAL(0.25, bar.getCacheVariableValue<double>(s, "length"), 1e-15);
+    bar.markCacheVariableInvalid(s, lengthCV);
+    ASSERT(!bar.isCacheVariableValid(s, "length"));
+
+    // An unknown state variable is only detected when the handle is used.
+    const StateVariableHandle unknownSV = bar.getStateVariableHandle("unknown");
+    ASSERT_THROW(OpenSim::Exception, bar.getStateVariableValue(s, unknownSV));
+
+    double sum = 0;
+    clock_t startTime = clock();
+    for (int i = 0; i < nAccess; ++i) {
+        sum += bar.getStateVariableValue(s, "fiberLength");
+        bar.setCacheVariableValue<double>(s, "length", sum);
+        sum -= bar.getCacheVariableValue<double>(s, "length");
+    }
+    double byName = 1.e3*(clock() - startTime) / CLOCKS_PER_SEC;
+
+    startTime = clock();
+    for (int i = 0; i < nAccess; ++i) {
+        sum += bar.getStateVariableValue(s, fiberLengthSV);
+        bar.setCacheVariableValue(s, lengthCV, sum);
+        sum -= bar.getCacheVariableValue(s, lengthCV);
+    }
+    double byHandle = 1.e3*(clock() - startTime) / CLOCKS_PER_SEC;
+
+    ASSERT_EQUAL(0.0, sum, 1e-10);
+    cout << nAccess << " variable accesses by name: " << byName << "ms, by handle: "
+         << byHandle << "ms" << endl;
+}
+
+void testCachedOutputs(const Foo& foo, const MultibodySystem& system,
+                       SimTK::State& s)
+{
+    const Output<double>& cached =
+        Output<double>::downcast(foo.getOutput("CachedTime"));
+    const Output<double>& uncached =
+        Output<double>::downcast(foo.getOutput("Output1"));
+    ASSERT(cached.isValueCached() && !uncached.isValueCached());
+
+    s.setTime(2.0);
+    system.realize(s, Stage::Time);
+    const int numEvaluations = foo.getNumCachedTimeEvaluations();
+    // Repeated reads within a realization are computed once.
+    for (int i = 0; i < 10; ++i)
+        ASSERT_EQUAL(2.0, cached.getValue(s), 1e-15);
+    ASSERT(foo.getNumCachedTimeEvaluations() == numEvaluations + 1);
+
+    // Each State has its own cached value.
+    State s2 = s;
+    s2.setTime(3.0);
+    system.realize(s2, Stage::Time);
+    ASSERT_EQUAL(3.0, cached.getValue(s2), 1e-15);
+    ASSERT_EQUAL(2.0, cached.getValue(s), 1e-15);
+
+    // Changing the State invalidates the cached value.
+    s.setTime(4.0);
+    ASSERT_THROW(SimTK::Exception::StageTooLow, cached.getValue(s));
+    system.realize(s, Stage::Time);
+    ASSERT_EQUAL(4.0, cached.getValue(s), 1e-15);
+
+    // Fetch several outputs at once.
+    SimTK::Array_<const Output<double>*> outputs;
+    outputs.push_back(&cached);
+    outputs.push_back(&uncached);
+    SimTK::Array_<double> values;
+    Output<double>::getValues(s, outputs, values);
+    ASSERT(values.size() == 2);
+    ASSERT_EQUAL(4.0, values[0], 1e-15);
+    ASSERT_EQUAL(4.0, values[1], 1e-15);
+}
+
 int main() {
 
     //Register new types for testing deserialization
@@ -596,6 +707,9 @@ int main() {
         ASSERT_EQUAL(3.5, foo.getInputValue<double>(s, "fiberLength"), 1e-10);
         ASSERT_EQUAL(1.5, foo.getInputValue<double>(s, "activation"), 1e-10);
 
+        testVariableHandles(bar, s);
+        testCachedOutputs(foo, system3, s);
+
         theWorld.print("Doubled" + modelFile);
     }
     catch (const std::exception& e) {
@@ -23,6 +23,9 @@
 
 #include <OpenSim/Common/TimeSeriesTable.h>
 
+#include <ctime>
+#include <iostream>
+
 int main() {
     using namespace SimTK;
     using namespace OpenSim;
@@ -130,5 +133,122 @@ int main() {
                 "(\"Filename\").getValue<std::string>() != std::string"
                 "{\"/path/to/file\"}"};
 
+    // Append a block of rows, with and without reserving space first.
+    {
+        std::vector<double> times{};
+        SimTK::Matrix_<double> block{10, 5};
+        for(int i = 0; i < 10; ++i) {
+            times.push_back(2 + 0.25 * i);
+            for(int j = 0; j < 5; ++j)
+                block(i, j) = 10 * i + j;
+        }
+
+        TimeSeriesTable table2{};
+        table2.setDependentsMetaData(dep_metadata);
+        table2.reserve(20);
+        table2.appendRows(times, block);
+        table2.appendRow(10, row);
+        table.appendRows(times, block);
+        table.appendRow(10, row);
+
+        for(TimeSeriesTable* tab : {&table, &table2}) {
+            const size_t offset{tab->getNumRows() - 11};
+            for(int i = 0; i < 10; ++i) {
+                const auto r = tab->getRow(times[i]);
+                const auto c = tab->getRowAtIndex(offset + i);
+                for(int j = 0; j < 5; ++j)
+                    if(r[j] != block(i, j) || c[j] != block(i, j))
+                        throw Exception{"Test failed: appendRows"};
+            }
+            if(tab->getDependentColumnAtIndex(0).size() !=
+               static_cast<int>(tab->getNumRows()))
+                throw Exception{"Test failed: getDependentColumnAtIndex"
+                        "(0).size() != getNumRows()"};
+        }
+        if(table.getNumRows() != 16 || table2.getNumRows() != 11)
+            throw Exception{"Test failed: number of rows after appendRows"};
+
+        // A block with a time that is not increasing is rejected as a whole.
+        times[5] = times[4];
+        try {
+            table2.appendRows(times, block);
+            throw Exception{"Test failed: appendRows accepted a block with "
+                    "decreasing time"};
+        } catch(InvalidTimestamp&) {}
+        if(table2.getNumRows() != 11)
+            throw Exception{"Test failed: appendRows modified the table"};
+
+        try {
+            table2.appendRow(11, SimTK::RowVector_<double>{3, double{0}});
+            throw Exception{"Test failed: appendRow accepted a row with the "
+                    "wrong number of columns"};
+        } catch(IncorrectNumColumns&) {}
+
+        try {
+            table2.getRow(2.1);
+            throw Exception{"Test failed: getRow found a missing time"};
+        } catch(KeyNotFound&) {}
+    }
+
+    // getMatrix() and updMatrix() are views of the rows in the table.
+    {
+        TimeSeriesTable viewTable{};
+        viewTable.reserve(100);
+        for(int i = 0; i < 7; ++i)
+            viewTable.appendRow(0.1 * i, SimTK::RowVector_<double>{3, 
+                                                             double(i)});
+        const auto matrix = viewTable.getMatrix();
+        if(matrix.nrow() != 7 || matrix.ncol() != 3)
+            throw Exception{"Test failed: getMatrix() has the wrong size"};
+        for(int i = 0; i < 7; ++i)
+            for(int j = 0; j < 3; ++j)
+                if(matrix(i, j) != viewTable.getRowAtIndex(i)[j])
+                    throw Exception{"Test failed: getMatrix() values"};
+
+        viewTable.updMatrix()(4, 2) = -1;
+        if(viewTable.getRowAtIndex(4)[2] != -1 || matrix(4, 2) != -1)
+            throw Exception{"Test failed: updMatrix() is not a view of the "
+                    "table"};
+    }
+
+    // Benchmarks: append rows one at a time and look up rows by time.
+    {
+        const int numRows{1000000};
+        SimTK::RowVector_<double> benchRow{5, double{1}};
+
+        std::clock_t start = std::clock();
+        TimeSeriesTable benchTable{};
+        for(int i = 0; i < numRows; ++i)
+            benchTable.appendRow(0.001 * i, benchRow);
+        const double appendTime = double(std::clock() - start) / 
+                                  CLOCKS_PER_SEC;
+
+        start = std::clock();
+        TimeSeriesTable reservedTable{};
+        reservedTable.reserve(numRows);
+        for(int i = 0; i < numRows; ++i)
+            reservedTable.appendRow(0.001 * i, benchRow);
+        const double reservedTime = double(std::clock() - start) /
+                                    CLOCKS_PER_SEC;
+
+        const int numLookups{100000};
+        SimTK::Random::Uniform randomIndex{0, numRows - 1};
+        randomIndex.setSeed(0);
+        const auto& benchTimes = benchTable.getIndependentColumn();
+        double sum{0};
+        start = std::clock();
+        for(int k = 0; k < numLookups; ++k)
+            sum += benchTable.getRow(benchTimes[randomIndex.getIntValue()])[0];
+        const double lookupTime = double(std::clock() - start) /
+                                  CLOCKS_PER_SEC;
+        if(sum != numLookups)
+            throw Exception{"Test failed: sum of looked up rows"};
+
+        std::cout << "TimeSeriesTable: append " << numRows << " rows "
+                  << appendTime << "s (" << reservedTime << "s reserved), "
+                  << numLookups << " random lookups by time " << lookupTime
+                  << "s" << std::endl;
+    }
+
     return 0;
 }
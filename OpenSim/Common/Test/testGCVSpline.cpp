@@ -21,11 +21,16 @@
  * -------------------------------------------------------------------------- */
 
 #include <OpenSim/Common/GCVSpline.h>
+#include <OpenSim/Common/GCVSplineSet.h>
+#include <OpenSim/Common/Constant.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
 using namespace OpenSim;
 using namespace std;
 
+void testGCVSplineSet();
+void benchmarkGCVSplineSet(int numRows, int numColumns);
+
 int main() {
     try {
         const int size = 100;
@@ -38,6 +43,9 @@ int main() {
         for (int i = 0; i < 10*(size-1); ++i) {
             ASSERT_EQUAL(sin(0.01*i), spline.calcValue(SimTK::Vector(1, 0.01*i)), 1e-4, __FILE__, __LINE__);
         }
+
+        testGCVSplineSet();
+        benchmarkGCVSplineSet(50000, 100);
     }
     catch(const Exception& e) {
         e.print(cerr);
@@ -46,3 +54,142 @@ int main() {
     cout << "Done" << endl;
     return 0;
 }
+
+// Build a storage whose column j at time t is (j+1)*sin((j+1)*t) + j.
+Storage createStorage(int numRows, int numColumns)
+{
+    Storage sto(numRows);
+    Array<string> labels;
+    labels.append("time");
+    for (int j = 0; j < numColumns; ++j)
+        labels.append("c" + to_string(j));
+    sto.setColumnLabels(labels);
+    Array<double> row(0.0, numColumns);
+    for (int i = 0; i < numRows; ++i) {
+        double t = 0.01*i;
+        for (int j = 0; j < numColumns; ++j)
+            row[j] = (j+1)*sin((j+1)*t) + j;
+        sto.append(t, row);
+    }
+    return sto;
+}
+
+// Check evaluateAll() against evaluating each function of the set.
+void checkEvaluateAll(const GCVSplineSet& set, const Array<double>& x)
+{
+    int n = set.getSize();
+    Array<double> values, firstDerivs, secondDerivs;
+    set.evaluateAll(x, values, &firstDerivs, &secondDerivs);
+    ASSERT(values.getSize() == x.getSize()*n);
+    ASSERT(secondDerivs.getSize() == x.getSize()*n);
+    vector<double> atX(3*n);
+    for (int i = 0; i < x.getSize(); ++i) {
+        set.evaluateAll(x[i], &atX[0], &atX[n], &atX[2*n]);
+        for (int j = 0; j < n; ++j) {
+            double value = set.evaluate(j, 0, x[i]);
+            double first = set.evaluate(j, 1, x[i]);
+            double second = set.evaluate(j, 2, x[i]);
+            ASSERT_EQUAL(value, values[i*n+j], 1e-10*(1+fabs(value)));
+            ASSERT_EQUAL(first, firstDerivs[i*n+j], 1e-9*(1+fabs(first)));
+            ASSERT_EQUAL(second, secondDerivs[i*n+j], 
+                         1e-8*(1+fabs(second)));
+            ASSERT(atX[j] == values[i*n+j]);
+            ASSERT(atX[n+j] == firstDerivs[i*n+j]);
+            ASSERT(atX[2*n+j] == secondDerivs[i*n+j]);
+        }
+    }
+}
+
+void testGCVSplineSet()
+{
+    Storage sto = createStorage(300, 13);
+
+    // Fitting on several threads gives the same splines.
+    GCVSplineSet serial(5, &sto, 0.0, 1);
+    GCVSplineSet parallel(5, &sto, 0.0, 4);
+    ASSERT(serial.getSize() == 13 && parallel.getSize() == 13);
+    for (int j = 0; j < 13; ++j) {
+        const Array<double>& c = serial.getGCVSpline(j)->getCoefficients();
+        const Array<double>& pc =
+            parallel.getGCVSpline(j)->getCoefficients();
+        ASSERT(c.getSize() == pc.getSize());
+        for (int k = 0; k < c.getSize(); ++k)
+            ASSERT(c[k] == pc[k]);
+    }
+
+    // Between, at, and beyond the knots.
+    Array<double> x;
+    for (int i = -5; i < 310; ++i) x.append(0.01*i + 0.003*(i%3));
+    checkEvaluateAll(parallel, x);
+
+    // Functions that are not splines with the shared knots are evaluated
+    // one at a time.
+    double t[] = {0.0, 0.5, 1.0, 1.5, 2.0, 2.5, 3.0};
+    double y[] = {0.0, 1.0, 0.5, 0.0, 1.0, 2.0, 1.0};
+    parallel.adoptAndAppend(new GCVSpline(3, 7, t, y, "other"));
+    parallel.adoptAndAppend(new Constant(2.0));
+    parallel.insert(0, new GCVSpline(*serial.getGCVSpline(5)));
+    checkEvaluateAll(parallel, x);
+    parallel.prepare();
+    checkEvaluateAll(parallel, x);
+
+    // Changes to a spline are seen by the next evaluation, before and after
+    // the set is prepared again.
+    parallel.getGCVSpline(3)->setY(100, 10.0);
+    checkEvaluateAll(parallel, x);
+    parallel.remove(1);
+    parallel.getGCVSpline(2)->setX(0, -1.0);
+    checkEvaluateAll(parallel, x);
+    parallel.prepare();
+    checkEvaluateAll(parallel, x);
+
+    // Derivatives of resampled storages are those of the splines.
+    Storage* velocities = serial.constructStorage(1);
+    ASSERT(velocities->getSize() == sto.getSize());
+    double v;
+    velocities->getData(150, 4, v);
+    double t150 = velocities->getStateVector(150)->getTime();
+    ASSERT_EQUAL(serial.evaluate(4, 1, t150), v, 1e-10);
+    ASSERT_EQUAL(25*cos(5*t150), v, 1e-3);
+    delete velocities;
+
+    cout << "testGCVSplineSet passed" << endl;
+}
+
+void benchmarkGCVSplineSet(int numRows, int numColumns)
+{
+    Storage sto = createStorage(numRows, numColumns);
+
+    double start = SimTK::realTime();
+    GCVSplineSet serial(5, &sto, 0.0, 1);
+    double serialFitTime = SimTK::realTime() - start;
+    start = SimTK::realTime();
+    GCVSplineSet parallel(5, &sto);
+    double parallelFitTime = SimTK::realTime() - start;
+
+    // Evaluate values and first and second derivatives at every knot.
+    Array<double> x;
+    sto.getTimeColumn(x);
+    start = SimTK::realTime();
+    double sum = 0;
+    for (int i = 0; i < x.getSize(); ++i)
+        for (int j = 0; j < numColumns; ++j)
+            for (int d = 0; d < 3; ++d)
+                sum += serial.evaluate(j, d, x[i]);
+    double oneAtATimeTime = SimTK::realTime() - start;
+
+    start = SimTK::realTime();
+    Array<double> values, firstDerivs, secondDerivs;
+    parallel.evaluateAll(x, values, &firstDerivs, &secondDerivs);
+    double allTime = SimTK::realTime() - start;
+    double allSum = 0;
+    for (int k = 0; k < values.getSize(); ++k)
+        allSum += values[k] + firstDerivs[k] + secondDerivs[k];
+    ASSERT_EQUAL(sum, allSum, 1e-8*fabs(sum));
+
+    cout << "GCVSplineSet " << numRows << "x" << numColumns << ": fit "
+         << serialFitTime << "s on 1 thread, " << parallelFitTime << "s on "
+         << SimTK::ParallelExecutor::getNumProcessors() << " threads; "
+         << "evaluate one at a time " << oneAtATimeTime << "s, all at once "
+         << allTime << "s" << endl;
+}
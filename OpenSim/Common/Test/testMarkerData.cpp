@@ -21,6 +21,7 @@
  * -------------------------------------------------------------------------- */
 
 #include <fstream>
+#include <ctime>
 #include <OpenSim/Common/Storage.h>
 #include <OpenSim/Common/MarkerData.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
@@ -28,6 +29,78 @@
 using namespace OpenSim;
 using namespace std;
 
+// Write a large TRC file, with one marker missing in every tenth frame, and
+// time how long it takes to load it.
+void testLargeTRCFile()
+{
+    const int numMarkers = 80;
+    const int numFrames = 24000; // 100 s at 240 Hz
+    const string fileName = "testLargeTRCFile.trc";
+    {
+        ofstream out(fileName.c_str());
+        out.precision(16);
+        out << "PathFileType\t4\t(X/Y/Z)\t" << fileName << "\n";
+        out << "DataRate\tCameraRate\tNumFrames\tNumMarkers\tUnits\t"
+            << "OrigDataRate\tOrigDataStartFrame\tOrigNumFrames\n";
+        out << "240\t240\t" << numFrames << "\t" << numMarkers << "\tmm\t240\t1\t"
+            << numFrames << "\n";
+        out << "Frame#\tTime";
+        for (int j = 0; j < numMarkers; ++j)
+            out << "\tM" << j << "\t\t";
+        out << "\n\t";
+        for (int j = 1; j <= numMarkers; ++j)
+            out << "\tX" << j << "\tY" << j << "\tZ" << j;
+        out << "\n\n";
+        for (int i = 0; i < numFrames; ++i) {
+            out << i+1 << "\t" << i/240.;
+            for (int j = 0; j < numMarkers; ++j) {
+                if (i%10 == 0 && j == i%numMarkers)
+                    out << "\t\t\t";
+                else
+                    out << "\t" << i + 0.25 << "\t" << j << "\t" << -j - 0.5;
+            }
+            out << "\n";
+        }
+    }
+
+    std::clock_t startTime = std::clock();
+    MarkerData md(fileName);
+    double loadTime = 1.e3*(std::clock() - startTime)/CLOCKS_PER_SEC;
+    cout << "Loaded " << numFrames << " frames of " << numMarkers
+         << " markers in " << loadTime << " ms." << endl;
+
+    ASSERT(md.getNumFrames() == numFrames, __FILE__, __LINE__);
+    ASSERT(md.getNumMarkers() == numMarkers, __FILE__, __LINE__);
+    ASSERT(md.getMarkerNames()[numMarkers-1] == "M79", __FILE__, __LINE__);
+    for (int i = 0; i < numFrames; i += 7) {
+        ASSERT_EQUAL(i/240., md.getFrameTime(i), 1e-12);
+        ASSERT(md.getFrameNumber(i) == i+1, __FILE__, __LINE__);
+        SimTK::ArrayViewConst_<SimTK::Vec3> markers = md.getMarkers(i);
+        ASSERT((int)markers.size() == numMarkers, __FILE__, __LINE__);
+        for (int j = 0; j < numMarkers; ++j) {
+            if (i%10 == 0 && j == i%numMarkers) {
+                ASSERT(markers[j].isNaN(), __FILE__, __LINE__);
+                continue;
+            }
+            SimTK::Vec3 expected(i + 0.25, j, -j - 0.5);
+            ASSERT((markers[j] - expected).norm() < 1e-12, __FILE__, __LINE__);
+            ASSERT(md.getMarker(i, j) == markers[j], __FILE__, __LINE__);
+        }
+    }
+
+    // Frames are found by bisection.
+    int startFrame = -1, endFrame = -1;
+    md.findFrameRange(10.0, 20.0, startFrame, endFrame);
+    ASSERT(startFrame == 2400, __FILE__, __LINE__);
+    ASSERT(endFrame == 4800, __FILE__, __LINE__);
+
+    // A frame copy holds the same data.
+    MarkerFrame frame = md.getFrame(numFrames-1);
+    ASSERT(frame.getFrameNumber() == numFrames, __FILE__, __LINE__);
+    ASSERT((int)frame.getMarkers().size() == numMarkers, __FILE__, __LINE__);
+    ASSERT(frame.getMarker(3) == md.getMarker(numFrames-1, 3), __FILE__, __LINE__);
+}
+
 int main() {
     // Create a storage from a std file "std_storage.sto"
     try {
@@ -81,6 +154,8 @@ int main() {
         const SimTK::Vec3& m31 = markers3[1];    
         SimTK::Vec3 diff3 = (markers3[1]-SimTK::Vec3(expectedData3));
         ASSERT(diff.norm() < 1e-7, __FILE__, __LINE__);
+
+        testLargeTRCFile();
     }
     catch(const Exception& e) {
         e.print(cerr);
@@ -1131,6 +1131,84 @@ void testMonotonicity(SimTK::Matrix mcfSample)
     cout << endl;
 }
 
+/*
+ 5. The fast evaluator will be compared against the Bezier curves for 
+    accuracy and speed.
+*/
+void testFastEvaluator(SmoothSegmentedFunction mcf, double tol)
+{
+    cout << "   TEST: Fast evaluator " << endl;
+
+    SmoothSegmentedFunction fast = mcf;
+    fast.buildFastEvaluator(tol);
+    SimTK_TEST(fast.isFastEvaluatorAvailable());
+    SimTK_TEST(!mcf.isFastEvaluatorAvailable());
+
+    //Sample the curve and 10% of its linear extrapolation on either side
+    SimTK::Vec2 domain = mcf.getCurveDomain();
+    double range = domain(1) - domain(0);
+    int n = 100000;
+    SimTK::Vector x(n);
+    for(int i=0; i<n; i++){
+        x(i) = domain(0) - 0.1*range + (1.2*range*i)/(n-1);
+    }
+
+    double errY = 0, errDY = 0, errD2Y = 0;
+    for(int i=0; i<n; i+=10){
+        errY = std::max(errY, 
+                        abs(fast.calcValue(x(i)) - mcf.calcValue(x(i))));
+        double dy = mcf.calcDerivative(x(i),1);
+        errDY = std::max(errDY, 
+                    abs(fast.calcDerivative(x(i),1) - dy)/(1+abs(dy)));
+        double d2y = mcf.calcDerivative(x(i),2);
+        errD2Y = std::max(errD2Y,
+                    abs(fast.calcDerivative(x(i),2) - d2y)/(1+abs(d2y)));
+    }
+    //The fit is checked at a finite set of points, so allow some slack.
+    //Orders above getFastEvaluatorMaxOrder() are evaluated exactly.
+    SimTK_TEST(fast.getFastEvaluatorMaxOrder() >= 1);
+    SimTK_TEST(errY < 10*tol);
+    SimTK_TEST(errDY < 10*tol);
+    SimTK_TEST(errD2Y < 10*tol || fast.getFastEvaluatorMaxOrder() < 2);
+
+    //The batch evaluation gives the same result as point by point evaluation
+    SimTK::Vector y(n), yBatch(n);
+    fast.calcValues(&x[0], &yBatch[0], n);
+    for(int i=0; i<n; i++){
+        SimTK_TEST(yBatch(i) == fast.calcValue(x(i)));
+    }
+
+    SimTK_TEST_MUST_THROW(fast.buildFastEvaluator(0));
+
+    SmoothSegmentedFunction cleared = fast;
+    cleared.clearFastEvaluator();
+    SimTK_TEST(!cleared.isFastEvaluatorAvailable());
+    SimTK_TEST(cleared.getFastEvaluatorMaxOrder() == -1);
+
+    //Speed
+    clock_t start = clock();
+    for(int i=0; i<n; i++){
+        y(i) = mcf.calcValue(x(i));
+    }
+    double bezierTime = double(clock()-start)/CLOCKS_PER_SEC;
+    start = clock();
+    for(int i=0; i<n; i++){
+        y(i) = fast.calcValue(x(i));
+    }
+    double fastTime = double(clock()-start)/CLOCKS_PER_SEC;
+    start = clock();
+    fast.calcValues(&x[0], &yBatch[0], n);
+    double batchTime = double(clock()-start)/CLOCKS_PER_SEC;
+
+    printf("   passed: %i intervals (orders 0-%i), max error y: %e, "
+           "dy/dx: %e, d2y/dx2: %e\n"
+           "           %i evaluations: Bezier %fs, fast %fs, batch %fs\n",
+           fast.getNumFastEvaluatorIntervals(), 
+           fast.getFastEvaluatorMaxOrder(), errY, errDY, errD2Y, 
+           n, bezierTime, fastTime, batchTime);
+    cout << endl;
+}
+
 //______________________________________________________________________________
 /**
  * Create a muscle bench marking system. The bench mark consists of a single muscle 
@@ -1822,6 +1900,16 @@ int main(int argc, char* argv[])
                       shoulderVal, plateauSlope, 1.01,false,"test"));
             cout << "    passed"<<endl;
 
+        ///////////////////////////////////////
+        //FAST EVALUATOR
+        ///////////////////////////////////////
+            cout <<"**************************************************"<<endl;
+            cout <<"FAST EVALUATOR TESTING                            "<<endl;
+            testFastEvaluator(tendonCurve, 1e-10);
+            testFastEvaluator(fiberFLCurve, 1e-10);
+            testFastEvaluator(fiberFVCurve, 1e-10);
+            testFastEvaluator(fiberfalCurve, 1e-10);
+
                     ///////////////////////////////////////
         //FIBER COMPRESSIVE PHI CURVE
         ///////////////////////////////////////
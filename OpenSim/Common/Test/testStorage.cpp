@@ -21,12 +21,24 @@
  * -------------------------------------------------------------------------- */
 
 #include <fstream>
+#include <ctime>
+#include <vector>
 #include <OpenSim/Common/Storage.h>
+#include <OpenSim/Common/Signal.h>
+#include <OpenSim/Common/StorageWriter.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
 using namespace OpenSim;
 using namespace std;
 
+void testColumnSpans();
+void benchmarkColumnAccess(int numRows, int numColumns);
+void testTimeLookup();
+void benchmarkTimeLookup(int numRows, int numLookups);
+void testStorageWriter();
+void testMultiSignalFilters();
+void benchmarkFiltering(int numRows, int numColumns);
+
 int main() {
     try {
         // Create a storage from a std file "std_storage.sto"
@@ -72,6 +84,14 @@ int main() {
         ASSERT(fabs(diff) < 1E-7);
 
         delete st;
+
+        testColumnSpans();
+        benchmarkColumnAccess(20000, 100);
+        testTimeLookup();
+        benchmarkTimeLookup(200000, 100000);
+        testStorageWriter();
+        testMultiSignalFilters();
+        benchmarkFiltering(10000, 300);
     }
     catch (const Exception& e) {
         e.print(cerr);
@@ -80,3 +100,427 @@ int main() {
     cout << "Done" << endl;
     return 0;
 }
+
+// Build a storage whose state j at time t is (j+1)*sin(t) + j.
+Storage createSineStorage(int numRows, int numColumns)
+{
+    Storage sto(numRows);
+    Array<string> labels;
+    labels.append("time");
+    for (int j = 0; j < numColumns; ++j)
+        labels.append("c" + to_string(j));
+    sto.setColumnLabels(labels);
+    Array<double> row(0.0, numColumns);
+    for (int i = 0; i < numRows; ++i) {
+        double t = 0.005*i;
+        for (int j = 0; j < numColumns; ++j)
+            row[j] = (j+1)*sin(t) + j;
+        sto.append(t, row);
+    }
+    return sto;
+}
+
+void testColumnSpans()
+{
+    Storage sto = createSineStorage(200, 5);
+
+    // The column data must be built explicitly.
+    ASSERT(!sto.hasColumnData());
+    ASSERT_THROW(Exception, sto.getTimeSpan());
+    ASSERT_THROW(Exception, sto.getDataColumnSpan(0));
+    sto.updateColumnData();
+    ASSERT(sto.hasColumnData());
+
+    // Spans must agree with the copying accessors.
+    Storage::ColumnSpan times = sto.getTimeSpan();
+    ASSERT(times.size() == sto.getSize());
+    Array<double> timeCol, dataCol;
+    sto.getTimeColumn(timeCol);
+    for (int i = 0; i < sto.getSize(); ++i)
+        ASSERT(times[i] == timeCol[i]);
+    for (int j = 0; j < 5; ++j) {
+        Storage::ColumnSpan col = sto.getDataColumnSpan(j);
+        ASSERT(col.size() == sto.getSize());
+        sto.getDataColumn(j, dataCol);
+        for (int i = 0; i < sto.getSize(); ++i)
+            ASSERT(col[i] == dataCol[i]);
+    }
+    ASSERT(sto.getDataColumnSpan("c3")[10] == sto.getDataColumnSpan(3)[10]);
+    ASSERT(sto.getDataColumnSpan(5).empty());
+    ASSERT(sto.getDataColumnSpan("unknown").empty());
+
+    // Handing out a StateVector pointer discards the column data; the
+    // changes made through it are picked up by the next updateColumnData().
+    sto.getStateVector(10)->setDataValue(2, -1.0);
+    ASSERT(!sto.hasColumnData());
+    ASSERT_THROW(Exception, sto.getDataColumnSpan(2));
+    sto.getDataColumn(2, dataCol);
+    ASSERT(dataCol[10] == -1.0);
+    sto.updateColumnData();
+    ASSERT(sto.getDataColumnSpan(2)[10] == -1.0);
+
+    // Modifications through Storage discard the column data.
+    sto.multiplyColumn(2, 2.0);
+    ASSERT(!sto.hasColumnData());
+    sto.updateColumnData();
+    ASSERT(sto.getDataColumnSpan(2)[10] == -2.0);
+    sto.append(10.0, Array<double>(7.0, 5));
+    ASSERT(!sto.hasColumnData());
+    sto.updateColumnData();
+    ASSERT(sto.getDataColumnSpan(4).size() == 201);
+    ASSERT(sto.getDataColumnSpan(4)[200] == 7.0);
+
+    // Only states present in every row are available as spans.
+    sto.append(11.0, Array<double>(1.0, 3));
+    sto.updateColumnData();
+    ASSERT(sto.getDataColumnSpan(2).size() == 202);
+    ASSERT(sto.getDataColumnSpan(3).empty());
+    sto.getDataColumn(3, dataCol);
+    ASSERT(dataCol.getSize() == 201);
+
+    // Filtering through the column data gives the same result as filtering
+    // a copy of each column.
+    Storage filtered = createSineStorage(400, 3);
+    Storage reference(filtered);
+    filtered.lowpassIIR(6.0);
+    reference.resample(reference.getMinTimeStep(), 5);
+    double dt = reference.getMinTimeStep();
+    int size = reference.getSize();
+    double *signal = NULL;
+    Array<double> filt(0.0, size);
+    for (int j = 0; j < 3; ++j) {
+        reference.getDataColumn(j, signal);
+        Signal::LowpassIIR(dt, 6.0, size, signal, &filt[0]);
+        Storage::ColumnSpan col = filtered.getDataColumnSpan(j);
+        ASSERT(col.size() == size);
+        for (int i = 0; i < size; ++i)
+            ASSERT_EQUAL(filt[i], col[i], 1e-12);
+    }
+    delete[] signal;
+
+    cout << "testColumnSpans passed" << endl;
+}
+
+void benchmarkColumnAccess(int numRows, int numColumns)
+{
+    const string fileName = "testStorage_benchmark.sto";
+    createSineStorage(numRows, numColumns).print(fileName);
+
+    clock_t start = clock();
+    Storage sto(fileName);
+    double loadTime = double(clock()-start)/CLOCKS_PER_SEC;
+    ASSERT(sto.getSize() == numRows);
+
+    // Copy every column out of the rows, one statevector at a time.
+    double sum = 0;
+    start = clock();
+    double *column = NULL;
+    for (int j = 0; j < numColumns; ++j) {
+        sto.getDataColumn(j, column);
+        sum += column[numRows/2];
+    }
+    delete[] column;
+    double rowWalkTime = double(clock()-start)/CLOCKS_PER_SEC;
+
+    // Build the column data once and read every column in place.
+    start = clock();
+    sto.updateColumnData();
+    double spanSum = 0;
+    for (int j = 0; j < numColumns; ++j) {
+        Storage::ColumnSpan col = sto.getDataColumnSpan(j);
+        spanSum += col[numRows/2];
+    }
+    double spanTime = double(clock()-start)/CLOCKS_PER_SEC;
+    ASSERT(sum == spanSum);
+
+    start = clock();
+    sto.resample(0.01, 3);
+    double resampleTime = double(clock()-start)/CLOCKS_PER_SEC;
+
+    cout << "Storage " << numRows << "x" << numColumns 
+         << ": load " << loadTime << "s, column copies " << rowWalkTime
+         << "s, column spans " << spanTime << "s, resample " << resampleTime
+         << "s" << endl;
+}
+
+// The index of the last statevector at or before t, found by a linear scan.
+int linearFindIndex(const Storage& sto, double t)
+{
+    Array<double> times;
+    sto.getTimeColumn(times);
+    int i = 0;
+    while (i < times.getSize() && !(t < times[i])) ++i;
+    return i > 0 ? i-1 : 0;
+}
+
+void testTimeLookup()
+{
+    Storage empty;
+    ASSERT(empty.findIndex(0.5) == -1);
+    Storage::InterpolationCursor emptyCursor;
+    ASSERT(empty.findIndex(emptyCursor, 0.5) == -1);
+
+    // Unevenly spaced times, including a repeated time.
+    Storage sto;
+    Array<string> labels;
+    labels.append("time"); labels.append("a"); labels.append("b");
+    sto.setColumnLabels(labels);
+    double times[] = {0.0, 0.1, 0.15, 0.15, 0.4, 0.41, 1.0, 2.5};
+    int numTimes = sizeof(times)/sizeof(times[0]);
+    Array<double> row(0.0, 2);
+    for (int i = 0; i < numTimes; ++i) {
+        row[0] = 2*times[i]; row[1] = -times[i];
+        sto.append(times[i], row, false);
+    }
+    ASSERT(sto.getSize() == numTimes);
+
+    // Every lookup agrees with a linear scan, whether it starts from
+    // scratch, from an arbitrary hint, or from a cursor.
+    Storage::InterpolationCursor cursor;
+    SimTK::Random::Uniform randomTime(-0.5, 3.0);
+    for (int k = 0; k < 2000; ++k) {
+        double t = (k % 7 == 0) ? times[k % numTimes] : randomTime.getValue();
+        int expected = linearFindIndex(sto, t);
+        ASSERT(sto.findIndex(t) == expected);
+        ASSERT(sto.findIndex(k % (numTimes+2) - 1, t) == expected);
+        ASSERT(sto.findIndex(cursor, t) == expected);
+        ASSERT(cursor.getIndex() == expected);
+
+        double y[2], yCursor[2];
+        ASSERT(sto.getDataAtTime(t, 2, y) == 2);
+        ASSERT(sto.getDataAtTime(cursor, t, 2, yCursor) == 2);
+        ASSERT(y[0] == yCursor[0] && y[1] == yCursor[1]);
+        if (t >= times[0] && t <= times[numTimes-1]) {
+            ASSERT_EQUAL(2*t, y[0], 1e-12);
+            ASSERT_EQUAL(-t, y[1], 1e-12);
+        }
+    }
+
+    cout << "testTimeLookup passed" << endl;
+}
+
+void benchmarkTimeLookup(int numRows, int numLookups)
+{
+    Storage sto = createSineStorage(numRows, 10);
+    double tFinal = sto.getLastTime();
+    SimTK::Random::Uniform randomTime(0, tFinal);
+    vector<double> lookupTimes(numLookups);
+    for (int k = 0; k < numLookups; ++k) lookupTimes[k] = randomTime.getValue();
+
+    double y[10];
+    double sum = 0;
+
+    // Random access, each lookup searching all statevectors.
+    clock_t start = clock();
+    for (int k = 0; k < numLookups; ++k) {
+        sto.getDataAtTime(lookupTimes[k], 10, y);
+        sum += y[0];
+    }
+    double searchTime = double(clock()-start)/CLOCKS_PER_SEC;
+
+    // Random access with the linear scan that was used previously (fewer
+    // lookups, since each one is O(n)).
+    int numLinear = numLookups/100;
+    start = clock();
+    int linearSum = 0;
+    for (int k = 0; k < numLinear; ++k)
+        linearSum += linearFindIndex(sto, lookupTimes[k]);
+    double linearTime = double(clock()-start)/CLOCKS_PER_SEC;
+    ASSERT(linearSum >= 0);
+
+    // Monotonic access with a cursor, as during a simulation.
+    Storage::InterpolationCursor cursor;
+    start = clock();
+    for (int k = 0; k < numLookups; ++k) {
+        sto.getDataAtTime(cursor, k*tFinal/numLookups, 10, y);
+        sum += y[0];
+    }
+    double cursorTime = double(clock()-start)/CLOCKS_PER_SEC;
+    ASSERT(!SimTK::isNaN(sum));
+
+    cout << "Storage " << numRows << " rows: " << numLookups
+         << " random lookups " << searchTime << "s, " << numLinear
+         << " linear-scan lookups " << linearTime << "s, " << numLookups
+         << " cursor lookups " << cursorTime << "s" << endl;
+}
+
+// Rows streamed by a StorageWriter must read back as the same Storage, and
+// the file must be readable while it is still being written.
+void testStorageWriter()
+{
+    const int numRows = 1234;
+    const int numColumns = 5;
+    const string fileName = "testStorageWriter.sto";
+
+    Array<string> labels;
+    labels.append("time");
+    for (int j = 0; j < numColumns; ++j)
+        labels.append("col" + std::to_string(j));
+
+    double row[numColumns];
+    StorageWriter writer(fileName, "streamed", labels, false, 100);
+    for (int i = 0; i < numRows; ++i) {
+        for (int j = 0; j < numColumns; ++j)
+            row[j] = (j + 1)*sin(0.01*i) + j;
+        writer.append(0.01*i, numColumns, row);
+
+        if (i == 500) {
+            // Only whole blocks are in the file until it is flushed.
+            writer.flush();
+            Storage partial(fileName);
+            ASSERT(partial.getSize() == i + 1);
+            ASSERT(partial.getColumnLabels().getSize() == numColumns + 1);
+        }
+    }
+    ASSERT(writer.getNumRowsAppended() == numRows);
+    writer.close();
+    ASSERT(!writer.isOpen());
+    ASSERT_THROW(Exception, writer.append(0.0, numColumns, row));
+
+    Storage streamed(fileName);
+    ASSERT(streamed.getName() == "streamed");
+    ASSERT(streamed.getSize() == numRows);
+    for (int i = 0; i < numRows; ++i) {
+        const StateVector& vec = *streamed.getStateVector(i);
+        ASSERT_EQUAL(0.01*i, vec.getTime(), 1e-6);
+        for (int j = 0; j < numColumns; ++j)
+            ASSERT_EQUAL((j + 1)*sin(0.01*i) + j, vec.getData()[j], 1e-6);
+    }
+}
+
+// The multi-signal filters must give exactly the results of filtering each
+// signal on its own, whether or not the signals fill whole blocks and
+// however many threads are used.
+void testMultiSignalFilters()
+{
+    const int N = 1000;
+    const int numSignals = 13;
+    const double dt = 0.005;
+    vector<double> times(N), signals((size_t)N*numSignals);
+    for (int i = 0; i < N; ++i) times[i] = dt*i;
+    for (int j = 0; j < numSignals; ++j)
+        for (int i = 0; i < N; ++i)
+            signals[(size_t)j*N+i] = (j+1)*sin(times[i]) 
+                                   + 0.1*cos(37.0*times[i]*(j+1)) + j;
+
+    vector<double> expected((size_t)N*numSignals);
+    for (int j = 0; j < numSignals; ++j) {
+        double *sig = &signals[(size_t)j*N];
+        double *sigf = &expected[(size_t)j*N];
+        Signal::LowpassIIR(dt, 6.0, N, sig, sigf);
+    }
+    for (int numThreads : {1, 3}) {
+        vector<double> filtered((size_t)N*numSignals);
+        ASSERT(Signal::LowpassIIR(dt, 6.0, N, numSignals, signals.data(),
+                    filtered.data(), numThreads) == 0);
+        ASSERT(filtered == expected);
+        vector<double> inPlace(signals);
+        Signal::LowpassIIR(dt, 6.0, N, numSignals, inPlace.data(),
+                           inPlace.data(), numThreads);
+        ASSERT(inPlace == expected);
+    }
+
+    for (int j = 0; j < numSignals; ++j) {
+        double *sig = &signals[(size_t)j*N];
+        double *sigf = &expected[(size_t)j*N];
+        Signal::LowpassFIR(50, dt, 6.0, N, sig, sigf);
+    }
+    for (int numThreads : {1, 3}) {
+        vector<double> filtered(signals);
+        ASSERT(Signal::LowpassFIR(50, dt, 6.0, N, numSignals, 
+                    filtered.data(), filtered.data(), numThreads) == 0);
+        ASSERT(filtered == expected);
+    }
+
+    for (int j = 0; j < numSignals; ++j) {
+        double *sig = &signals[(size_t)j*N];
+        double *sigf = &expected[(size_t)j*N];
+        Signal::SmoothSpline(5, dt, 6.0, N, &times[0], sig, sigf);
+    }
+    for (int numThreads : {1, 3}) {
+        vector<double> filtered(signals);
+        ASSERT(Signal::SmoothSpline(5, dt, 6.0, N, numSignals, times.data(),
+                    filtered.data(), filtered.data(), numThreads) == 0);
+        ASSERT(filtered == expected);
+    }
+
+    for (int pad : {0, 20, N+5}) {
+        int size = N + 2*pad;
+        vector<double> padded((size_t)size*numSignals);
+        Signal::Pad(pad, N, numSignals, signals.data(), padded.data());
+        for (int j = 0; j < numSignals; ++j) {
+            Array<double> sig(0.0, N);
+            for (int i = 0; i < N; ++i) sig[i] = signals[(size_t)j*N+i];
+            Signal::Pad(pad, sig);
+            ASSERT(sig.getSize() == size);
+            for (int i = 0; i < size; ++i)
+                ASSERT(padded[(size_t)j*size+i] == sig[i]);
+        }
+    }
+
+    // Storage pads and filters its columns with the multi-signal filters.
+    Storage sto = createSineStorage(N, numSignals);
+    Storage reference(sto);
+    sto.pad(30);
+    sto.lowpassFIR(40, 6.0);
+    reference.pad(30);
+    ASSERT(reference.getSize() == N + 60);
+    double dtmin = reference.resample(reference.getMinTimeStep(), 5);
+    Array<double> column, filt(0.0, reference.getSize());
+    for (int j = 0; j < numSignals; ++j) {
+        reference.getDataColumn(j, column);
+        Signal::LowpassFIR(40, dtmin, 6.0,
+                           column.getSize(), &column[0], &filt[0]);
+        Storage::ColumnSpan col = sto.getDataColumnSpan(j);
+        ASSERT(col.size() == column.getSize());
+        for (int i = 0; i < column.getSize(); ++i)
+            ASSERT(col[i] == filt[i]);
+    }
+
+    cout << "testMultiSignalFilters passed" << endl;
+}
+
+void benchmarkFiltering(int numRows, int numColumns)
+{
+    Storage sto = createSineStorage(numRows, numColumns);
+    sto.updateColumnData();
+    double dt = sto.getMinTimeStep();
+    vector<double> signals((size_t)numRows*numColumns);
+    for (int j = 0; j < numColumns; ++j) {
+        Storage::ColumnSpan col = sto.getDataColumnSpan(j);
+        std::copy(col.begin(), col.end(), &signals[(size_t)j*numRows]);
+    }
+    vector<double> filtered(signals.size());
+
+    // One column at a time, as Storage used to filter.
+    double start = SimTK::realTime();
+    for (int j = 0; j < numColumns; ++j)
+        Signal::LowpassIIR(dt, 6.0, numRows, &signals[(size_t)j*numRows],
+                           &filtered[(size_t)j*numRows]);
+    double iirScalarTime = SimTK::realTime() - start;
+    start = SimTK::realTime();
+    for (int j = 0; j < numColumns; ++j)
+        Signal::LowpassFIR(50, dt, 6.0, numRows, &signals[(size_t)j*numRows],
+                           &filtered[(size_t)j*numRows]);
+    double firScalarTime = SimTK::realTime() - start;
+
+    const int numThreads = SimTK::ParallelExecutor::getNumProcessors();
+    double iirTime[2], firTime[2];
+    for (int t = 0; t < 2; ++t) {
+        start = SimTK::realTime();
+        Signal::LowpassIIR(dt, 6.0, numRows, numColumns, signals.data(),
+                           filtered.data(), t == 0 ? 1 : numThreads);
+        iirTime[t] = SimTK::realTime() - start;
+        start = SimTK::realTime();
+        Signal::LowpassFIR(50, dt, 6.0, numRows, numColumns, signals.data(),
+                           filtered.data(), t == 0 ? 1 : numThreads);
+        firTime[t] = SimTK::realTime() - start;
+    }
+
+    cout << "Filtering " << numRows << "x" << numColumns 
+         << ": IIR one column at a time " << iirScalarTime << "s, in blocks "
+         << iirTime[0] << "s, on " << numThreads << " threads " << iirTime[1]
+         << "s; FIR(50) one column at a time " << firScalarTime 
+         << "s, in blocks " << firTime[0] << "s, on " << numThreads 
+         << " threads " << firTime[1] << "s" << endl;
+}
@@ -124,6 +124,22 @@ public:
     }
 
 protected:
+    /** Get the index of the row with the given time. The time column is
+    strictly increasing, so a binary search is used.
+
+    \throws KeyNotFound If the time column has no entry with given value.    */
+    size_t getRowIndex(const double& time) const override {
+        using DT = DataTable_<double, ETY>;
+
+        auto iter = std::lower_bound(DT::_indData.cbegin(), 
+                                     DT::_indData.cend(), time);
+
+        OPENSIM_THROW_IF(iter == DT::_indData.cend() || *iter != time,
+                         KeyNotFound, std::to_string(time));
+
+        return std::distance(DT::_indData.cbegin(), iter);
+    }
+
     /** Validate the given row. 
 
     \throws InvalidRow If the timestamp for the row breaks strictly increasing
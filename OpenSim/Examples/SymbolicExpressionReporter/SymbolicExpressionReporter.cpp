@@ -30,6 +30,7 @@
 #include "SymbolicExpressionReporter.h"
 #include <iostream>
 #include <string>
+#include <algorithm>
 
 using namespace OpenSim;
 using namespace std;
@@ -221,15 +222,9 @@ record(const SimTK::State& s)
 
     // MAKE SURE ALL QUANTITIES ARE VALID
     _model->getMultibodySystem().realize(s, SimTK::Stage::Velocity );
-    // Get state variable names and values in same order and use that to update map
-    Array<std::string> stateNames = _model->getStateVariableNames();
-    SimTK::Vector rStateValues = _model->getStateVariableValues(s);
-
-    // update map between names and values, then pass it to expression evaluator
-    for(int i=0; i<stateNames.getSize(); i++){
-        _variables.find(stateNames[i])->second = rStateValues[i];
-    }
-    double value = Lepton::Parser::parse(_expressionStr).evaluate(_variables);
+    // State variable values are in the order the expression was bound to
+    _model->getStateVariableValues(s, _stateValues);
+    double value = _expression.evaluate(&_stateValues[0]);
     StateVector nextRow = StateVector(s.getTime());
      nextRow.getData().append(value);
     _resultStore.append(nextRow);
@@ -259,11 +254,20 @@ begin( SimTK::State& s)
     constructColumnLabels();
     // RESET STORAGE
     _resultStore.reset(s.getTime());
-    // Populate list of names, initial values from s
+    // Compile the expression once and bind the state variables to its slots
     Array<std::string> stateNames = _model->getStateVariableNames();
+    std::vector<std::string> names(stateNames.getSize());
     for(int i=0; i< stateNames.getSize(); i++){
-        _variables.insert(pair<string, double>(stateNames[i], 0.0));
+        names[i] = stateNames[i];
+    }
+    _expression =
+        Lepton::Parser::parse(_expressionStr).createCompiledExpression();
+    for (const std::string& var : _expression.getVariables()) {
+        if (std::find(names.begin(), names.end(), var) == names.end())
+            throw Exception("SymbolicExpressionReporter: " + var +
+                " is not a state variable of the model.", __FILE__, __LINE__);
     }
+    _expression.bindVariables(names);
     // RECORD
     int status = 0;
     if(_resultStore.getSize()<=0) {
@@ -27,8 +27,8 @@
 //=============================================================================
 // INCLUDES
 //=============================================================================
-#include <map>
 #include "OpenSim/OpenSim.h"
+#include "Lepton.h"
 #include "osimExpPluginDLL.h"
 
 
@@ -56,7 +56,10 @@ OpenSim_DECLARE_CONCRETE_OBJECT(SymbolicExpressionReporter, Analysis);
 // DATA
 //=============================================================================
 private:
-    std::map<std::string, double> _variables;
+    /** Expression compiled in begin(), with the state variables bound to
+    slots in the order returned by Model::getStateVariableNames(). */
+    Lepton::CompiledExpression _expression;
+    SimTK::Vector _stateValues;
 
 
 protected:
@@ -435,6 +435,19 @@ getControlValue(ArrayPtrs<ControlLinearNode> &aNodes,double aT)
     _searchNode.setTime(aT);
     int i = aNodes.searchBinary(_searchNode);
 
+    return(getControlValue(aNodes,aT,i));
+}
+//_____________________________________________________________________________
+/**
+ * Get the value of the control curve at aT, given the index aIndex of the
+ * last node of aNodes at or before aT (-1 if aT is before the first node).
+ */
+double ControlLinear::
+getControlValue(ArrayPtrs<ControlLinearNode> &aNodes,double aT,int aIndex)
+{
+    int size = aNodes.getSize();
+    int i = aIndex;
+
     // BEFORE FIRST
     double value;
     if(i<0) {
@@ -536,6 +549,41 @@ getControlValue(double aT)
 }
 //_____________________________________________________________________________
 double ControlLinear::
+getControlValue(double aT,int &rIndex)
+{
+    int size = _xNodes.getSize();
+    // CMC expects NaN's to be returned if the Control set size is zero
+    if(size<=0) return(SimTK::NaN);
+
+    // CHECK THE GUESS AND THE FOLLOWING INTERVAL
+    // The index is only taken if it is the one a search would find: aT must
+    // lie in the node interval, and if aT is at the time of the node, the
+    // node before it must be earlier (a search could otherwise return either
+    // of two nodes with the same time).
+    int i = -2;
+    for(int guess=rIndex;guess<=rIndex+1 && i==-2;guess++) {
+        if(guess<-1 || guess>=size) continue;
+        if(guess>=0) {
+            double tNode = _xNodes[guess]->getTime();
+            if(aT<tNode) continue;
+            if(aT==tNode && guess>0 && _xNodes[guess-1]->getTime()>=tNode)
+                continue;
+        }
+        if(guess+1<size && !(aT<_xNodes[guess+1]->getTime())) continue;
+        i = guess;
+    }
+
+    // SEARCH ALL THE NODES
+    if(i==-2) {
+        _searchNode.setTime(aT);
+        i = _xNodes.searchBinary(_searchNode);
+    }
+
+    rIndex = i;
+    return(getControlValue(_xNodes,aT,i));
+}
+//_____________________________________________________________________________
+double ControlLinear::
 extrapolateBefore(double aT) const
 {
     return extrapolateBefore(_xNodes,aT);
@@ -286,6 +286,19 @@ public:
      */
     void setControlValue(double aT,double aX) override;
     double getControlValue(double aT) override;
+    /**
+     * Get the value of the control curve at aT, as getControlValue(aT)
+     * does, starting the search for the control nodes around aT from
+     * rIndex. Where consecutive calls are for nearby times, or for controls
+     * that share the times of their nodes, passing the index returned by
+     * the previous call avoids searching all of the nodes.
+     *
+     * @param aT Time at which to get the value of the control curve.
+     * @param rIndex On entry, a guess of the index of the last control node
+     * at or before aT, or -1 if aT is before the first node. On return, that
+     * index.
+     */
+    double getControlValue(double aT,int &rIndex);
     double getControlValueMin(double aT=0.0) override;
     /**
      * This method adds a set of control parameters at the specified time unless
@@ -385,6 +398,8 @@ public:
 private:
     void setControlValue(ArrayPtrs<ControlLinearNode> &aNodes,double aT,double aX);
     double getControlValue(ArrayPtrs<ControlLinearNode> &aNodes,double aT);
+    double getControlValue(ArrayPtrs<ControlLinearNode> &aNodes,double aT,
+        int aIndex);
     double extrapolateBefore(const ArrayPtrs<ControlLinearNode> &aNodes,double aT) const;
     double extrapolateAfter(ArrayPtrs<ControlLinearNode> &aNodes,double aT) const;
 
@@ -145,6 +145,7 @@ setNull()
     setupProperties();
     _ptcMap.setSize(0);
     _ptpMap.setSize(0);
+    _nodeIndex = -1;
 }
 //_____________________________________________________________________________
 /**
@@ -336,6 +337,12 @@ setControlValues(double aT,const Array<double> &aX,
  *  This is the bread-and-butter method of the controls class; it is called
  * repeatedly throughout an integration.
  *
+ * The linear controls share one cursor into their nodes: the index of the
+ * node at or before aT found for one control is where the search starts for
+ * the next, and for the next call.  Controls constructed from the columns of
+ * a Storage have nodes at the same times, so the nodes are usually only
+ * searched when aT moves beyond the next node.  No memory is allocated.
+ *
  * @param aT Time at which to get the values of the control curves.
  * @param rX Array of control curve values.
  * @param aForModelControls If true, only model controls are
@@ -352,7 +359,12 @@ getControlValues(double aT,double rX[],
         Control& control = get(i);
         if(aForModelControls) if(!control.getIsModelControl()) continue;
     
-        rX[n] = control.getControlValue(aT);
+        ControlLinear *linear = dynamic_cast<ControlLinear*>(&control);
+        if(linear!=NULL) {
+            rX[n] = linear->getControlValue(aT,_nodeIndex);
+        } else {
+            rX[n] = control.getControlValue(aT);
+        }
         n++;
     }
 }
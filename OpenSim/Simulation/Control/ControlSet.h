@@ -59,6 +59,10 @@ protected:
     Array<int> _ptcMap;
     /** Map from set parameters to control parameters. */
     Array<int> _ptpMap;
+    /** Index of the node at or before the time of the last call to
+    getControlValues(), where the search for the nodes of the next call
+    starts. */
+    mutable int _nodeIndex;
 
 
 //=============================================================================
@@ -90,6 +90,8 @@ void ControlSetController::setNull()
 
     _model = NULL;
     _controlSet = NULL;
+    _indexedControlSet = NULL;
+    _actuatorControls.resize(1);
 
 
 }
@@ -161,26 +163,52 @@ void ControlSetController::computeControls(const SimTK::State& s, SimTK::Vector&
 {
     SimTK_ASSERT( _controlSet , "ControlSetController::computeControls controlSet is NULL");
 
-    std::string actName = "";
-    int index = -1;
+    int na = getActuatorSet().getSize();
+
+    // The controls are normally found when the controller is connected to
+    // the model; find them again if the actuators or controls have changed.
+    if(_indexedControlSet != _controlSet || 
+            (int)_actuatorControlIndices.size() != na ||
+            (int)_controlValues.size() != _controlSet->getSize(false))
+        indexActuatorControls();
+
+    if(_controlValues.empty()) return;
+    _controlSet->getControlValues(s.getTime(), &_controlValues[0], false);
+
+    for(int i=0; i< na; ++i){
+        int index = _actuatorControlIndices[i];
+        if(index >= 0){
+            _actuatorControls[0] = _controlValues[index];
+            getActuatorSet()[i].addInControls(_actuatorControls, controls);
+        }
+    }
+}
 
+void ControlSetController::indexActuatorControls() const
+{
+    _indexedControlSet = _controlSet;
     int na = getActuatorSet().getSize();
+    _actuatorControlIndices.assign(na, -1);
+    _controlValues.assign(_controlSet ? _controlSet->getSize(false) : 0, 0.0);
+    if(_controlSet == NULL) return;
 
     for(int i=0; i< na; ++i){
-        actName = getActuatorSet()[i].getName();
-        index = _controlSet->getIndex(actName);
+        std::string actName = getActuatorSet()[i].getName();
+        int index = _controlSet->getIndex(actName);
         if(index < 0){
             actName = actName + ".excitation";
             index = _controlSet->getIndex(actName);
         }
-
-        if(index >= 0){
-            SimTK::Vector actControls(1, _controlSet->get(index).getControlValue(s.getTime()));
-            getActuatorSet()[i].addInControls(actControls, controls);
-        }
+        _actuatorControlIndices[i] = index;
     }
 }
 
+void ControlSetController::extendConnectToModel(Model& model)
+{
+    Super::extendConnectToModel(model);
+    indexActuatorControls();
+}
+
 double ControlSetController::getFirstTime() const {
     Array<int> controlList;
    SimTK_ASSERT( _controlSet , "ControlSetController::getFirstTime controlSet is NULL");
@@ -63,6 +63,17 @@ protected:
     PropertyStr _controlsFileNameProp;
     std::string &_controlsFileName;
 
+private:
+    /** Index in _controlSet of the control of each actuator, or -1 if the
+    actuator has no control. */
+    mutable std::vector<int> _actuatorControlIndices;
+    /** The control set for which _actuatorControlIndices was found. */
+    mutable const ControlSet* _indexedControlSet;
+    /** Values of all the controls in _controlSet, in the order of the set. */
+    mutable std::vector<double> _controlValues;
+    /** The control of one actuator, as passed to addInControls(). */
+    mutable SimTK::Vector _actuatorControls;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -98,6 +109,8 @@ private:
     // and not even by subclasses of this class.
 
     void setNull();
+    // Find the control of each actuator in the control set.
+    void indexActuatorControls() const;
 
 protected:
 
@@ -116,6 +129,8 @@ protected:
 
     // for any post XML deserialization initialization
     void extendFinalizeFromProperties() override;
+    // find the control of each actuator once the actuators are known
+    void extendConnectToModel(Model& model) override;
 
     //--------------------------------------------------------------------------
     // OPERATORS
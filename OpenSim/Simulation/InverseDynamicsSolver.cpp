@@ -24,6 +24,7 @@
 #include "InverseDynamicsSolver.h"
 #include "Model/Model.h"
 #include <OpenSim/Common/FunctionSet.h>
+#include <OpenSim/Common/GCVSplineSet.h>
 
 using namespace std;
 using namespace SimTK;
@@ -113,10 +114,25 @@ Vector InverseDynamicsSolver::solve(SimTK::State &s, const FunctionSet &Qs, doub
     Vector &u = s.updU();
     Vector &udot = s.updUDot();
 
-    for(int i=0; i<nq; i++){
-        q[i] = Qs.evaluate(i, 0, time);
-        u[i] = Qs.evaluate(i, 1, time);
-        udot[i] = Qs.evaluate(i, 2, time);
+    // Splines of the coordinates are evaluated all at once. evaluateAll()
+    // fills a value for every function of the set.
+    const GCVSplineSet* splines = dynamic_cast<const GCVSplineSet*>(&Qs);
+    if(splines && nq>0){
+        const int n = splines->getSize();
+        std::vector<double> values(3*n);
+        splines->evaluateAll(time, &values[0], &values[n], &values[2*n]);
+        for(int i=0; i<nq; i++){
+            q[i] = values[i];
+            u[i] = values[n+i];
+            udot[i] = values[2*n+i];
+        }
+    }
+    else{
+        for(int i=0; i<nq; i++){
+            q[i] = Qs.evaluate(i, 0, time);
+            u[i] = Qs.evaluate(i, 1, time);
+            udot[i] = Qs.evaluate(i, 2, time);
+        }
     }
 
     // Perform general inverse dynamics
@@ -33,6 +33,7 @@
 #include <OpenSim/Simulation/Control/Controller.h>
 #include <OpenSim/Simulation/Model/ControllerSet.h>
 #include <OpenSim/Common/Array.h>
+#include <OpenSim/Common/StorageWriter.h>
 
 
 
@@ -138,6 +139,7 @@ setNull()
     _tArray.setSize(0);
     _system = 0;
     _dtArray.setSize(0);
+    _streamingFlushInterval = 100;
 }
 //_____________________________________________________________________________
 /**
@@ -675,6 +677,114 @@ hasStateStorage() const
     return (_stateStore != NULL);
 }
 
+//-----------------------------------------------------------------------------
+// STREAMING
+//-----------------------------------------------------------------------------
+//_____________________________________________________________________________
+/**
+ * Stream the states, controls and analysis results to files in directory.
+ */
+void Manager::
+setStreamingOutput(const std::string& directory, const std::string& prefix,
+                   int flushInterval)
+{
+    if (prefix.empty())
+        throw Exception("Manager::setStreamingOutput(): prefix is empty.",
+                        __FILE__, __LINE__);
+    clearStreamingOutput();
+    _streamingDirectory = directory.empty() ? "." : directory;
+    _streamingPrefix = prefix;
+    _streamingFlushInterval = flushInterval > 0 ? flushInterval : 1;
+}
+//_____________________________________________________________________________
+/**
+ * Close the streamed files and stop streaming.
+ */
+void Manager::
+clearStreamingOutput()
+{
+    // Closing throws if rows could not be written; close all files first.
+    std::string error;
+    for (StreamedStorage& streamed : _streamedStorages) {
+        try {
+            if (streamed.writer) streamed.writer->close();
+        }
+        catch (const std::exception& e) {
+            if (error.empty()) error = e.what();
+        }
+    }
+    _streamedStorages.clear();
+    _streamingPrefix = "";
+    if (!error.empty())
+        throw Exception(error, __FILE__, __LINE__);
+}
+//_____________________________________________________________________________
+/**
+ * Stream the rows of storage to <prefix>_<name>.sto, unless it is streamed
+ * already.
+ */
+void Manager::
+addStreamedStorage(Storage* storage, const std::string& name)
+{
+    if (storage == NULL) return;
+    for (const StreamedStorage& streamed : _streamedStorages)
+        if (streamed.storage == storage) return;
+
+    StreamedStorage streamed;
+    streamed.storage = storage;
+    streamed.fileName = _streamingDirectory + "/" + _streamingPrefix + "_"
+                        + name + ".sto";
+    // Rows recorded before streaming started are written too.
+    streamed.numRowsWritten = 0;
+    _streamedStorages.push_back(std::move(streamed));
+}
+//_____________________________________________________________________________
+/**
+ * Hand the rows recorded since the last call to the writers. Unless 
+ * finalizing, this is done in blocks of the flush interval, all rows but the
+ * last are dropped from the Storage, and the last row, which an analysis may
+ * still replace, is written later.
+ */
+void Manager::
+streamRecordedRows(bool finalize)
+{
+    for (StreamedStorage& streamed : _streamedStorages) {
+        Storage& storage = *streamed.storage;
+        const int size = storage.getSize();
+        const int end = finalize ? size : size - 1;
+        if (end <= streamed.numRowsWritten) continue;
+        if (!finalize && end - streamed.numRowsWritten < _streamingFlushInterval)
+            continue;
+
+        if (!streamed.writer) {
+            // The column labels are known once the first rows are recorded.
+            const Array<std::string>& labels = storage.getColumnLabels();
+            if (labels.getSize() == 0) {
+                throw Exception("Manager: cannot stream Storage '"
+                    + storage.getName() + "' to " + streamed.fileName
+                    + " because it has no column labels.", __FILE__, __LINE__);
+            }
+            streamed.writer.reset(new StorageWriter(streamed.fileName,
+                storage.getName(), labels, storage.isInDegrees(),
+                _streamingFlushInterval));
+        }
+        for (int i = streamed.numRowsWritten; i < end; ++i)
+            streamed.writer->append(*storage.getStateVector(i));
+
+        if (finalize) {
+            streamed.numRowsWritten = end;
+            streamed.writer->flush();
+        }
+        else {
+            // Keep only the last row, which has not been written yet.
+            StateVector last = *storage.getLastStateVector();
+            storage.reset(1);
+            *storage.getStateVector(0) = last;
+            streamed.numRowsWritten = 0;
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 // INTEGRATION
 //-----------------------------------------------------------------------------
@@ -765,6 +875,9 @@ bool Manager::doIntegration(SimTK::State& s, int step, double dtFirst ) {
         sys.realize(s, SimTK::Stage::Velocity); // this is multibody system 
     initialize(s, dt);  
 
+    // Reused for the states recorded at every step.
+    SimTK::Vector stateValues;
+
     if( fixedStep){
         s.updTime() = time;
         sys.realize(s, SimTK::Stage::Acceleration);
@@ -772,13 +885,12 @@ bool Manager::doIntegration(SimTK::State& s, int step, double dtFirst ) {
         if(_performAnalyses)_model->updAnalysisSet().step(s, step);
         tReal = s.getTime();
         if( _writeToStorage ) {
-            SimTK::Vector stateValues = _model->getStateVariableValues(s);
-            StateVector vec;
-            vec.setStates(tReal, stateValues.size(), &stateValues[0]);
-            getStateStorage().append(vec);
+            _model->getStateVariableValues(s, stateValues);
+            getStateStorage().append(tReal, stateValues);
             if(_model->isControlled())
                 _controllerSet->storeControls(s,step);
         }
+        if(!_streamedStorages.empty()) streamRecordedRows(false);
     }
 
     double stepToTime = _tf;
@@ -803,13 +915,12 @@ bool Manager::doIntegration(SimTK::State& s, int step, double dtFirst ) {
             if(_performAnalyses)_model->updAnalysisSet().step(s,step);
             tReal = s.getTime();
             if( _writeToStorage) {
-                SimTK::Vector stateValues = _model->getStateVariableValues(s);
-                StateVector vec;
-                vec.setStates(tReal, stateValues.size(), &stateValues[0]);
-                getStateStorage().append(vec);
+                _model->getStateVariableValues(s, stateValues);
+                getStateStorage().append(tReal, stateValues);
                 if(_model->isControlled())
                     _controllerSet->storeControls(s, step);
             }
+            if(!_streamedStorages.empty()) streamRecordedRows(false);
             step++;
         }
         else
@@ -875,6 +986,24 @@ void Manager::initialize(SimTK::State& s, double dt )
         // ANALYSES 
         AnalysisSet& analysisSet = _model->updAnalysisSet();
         analysisSet.begin(s);
+
+        // STREAMED STORAGES
+        // The analyses have set up their Storages in begin().
+        if (isStreamingOutput()) {
+            if (hasStateStorage())
+                addStreamedStorage(&getStateStorage(), "states");
+            if (_model->isControlled())
+                addStreamedStorage(_controllerSet->updControlStorage(),
+                                   "controls");
+            for (int i = 0; i < analysisSet.getSize(); ++i) {
+                Analysis& analysis = analysisSet.get(i);
+                if (!analysis.getOn()) continue;
+                ArrayPtrs<Storage>& storages = analysis.getStorageList();
+                for (int j = 0; j < storages.getSize(); ++j)
+                    addStreamedStorage(storages.get(j), analysis.getName()
+                        + "_" + storages.get(j)->getName());
+            }
+        }
     }
 
     return;
@@ -893,6 +1022,9 @@ void Manager::finalize(SimTK::State& s )
         analysisSet.end(s);
     }
 
+    // Write the remaining rows so the streamed files are complete.
+    if (!_streamedStorages.empty()) streamRecordedRows(true);
+
     return;
 }
 //=============================================================================
@@ -32,12 +32,15 @@
 #include <OpenSim/Common/Object.h>
 #include <OpenSim/Simulation/osimSimulationDLL.h>
 #include "SimTKsimbody.h"
+#include <memory>
+#include <vector>
 
 
 namespace OpenSim { 
 
 class Model;
 class Storage;
+class StorageWriter;
 class ControllerSet;
 
 //=============================================================================
@@ -112,6 +115,22 @@ private:
     /** system of equations to be integrated */
     const SimTK::System* _system;
 
+    /** A Storage whose rows are streamed to a file, and how many of its
+    leading rows have been written. */
+    struct StreamedStorage {
+        Storage* storage;
+        std::string fileName;
+        int numRowsWritten;
+        std::unique_ptr<StorageWriter> writer;
+    };
+    /** Directory, file name prefix and flush interval for streaming the
+    results. Streaming is off if the prefix is empty. */
+    std::string _streamingDirectory;
+    std::string _streamingPrefix;
+    int _streamingFlushInterval;
+    /** The Storages being streamed. */
+    std::vector<StreamedStorage> _streamedStorages;
+
 
 //=============================================================================
 // METHODS
@@ -123,11 +142,17 @@ public:
     Manager(Model& aModel) ;
     /** A Constructor that does not take a model or controllerSet */
     Manager();  
+    /** A Manager owns the writers of the Storages it streams, so it cannot
+    be copied. */
+    Manager(const Manager&) = delete;
+    Manager& operator=(const Manager&) = delete;
 
 private:
     void setNull();
     bool constructStates();
     bool constructStorage();
+    void addStreamedStorage(Storage* storage, const std::string& name);
+    void streamRecordedRows(bool finalize);
     //--------------------------------------------------------------------------
     // GET AND SET
     //--------------------------------------------------------------------------
@@ -191,6 +216,29 @@ public:
     void setStateStorage(Storage& aStorage);
     Storage& getStateStorage() const;
 
+    // STREAMING
+    /** Write the states, the controls and the rows recorded by the model's
+    analyses to storage files in directory while integrating, rather than
+    only collecting them in memory. The files are named 
+    <prefix>_states.sto, <prefix>_controls.sto and 
+    <prefix>_<analysis>_<storage>.sto, and are written by background threads
+    in blocks of flushInterval rows. Each file is a valid storage file with 
+    all the rows of the blocks written so far, even if the simulation does 
+    not finish.
+    
+    To bound the memory used, the in-memory Storages (getStateStorage(), the
+    ControllerSet's controls and the analyses' Storages) keep only their 
+    rows that have not been handed to the writers yet, and at least their 
+    last row. Printing these Storages afterwards therefore gives only the 
+    final rows; the complete results are in the streamed files, which are
+    complete once integrate() returns. */
+    void setStreamingOutput(const std::string& directory,
+                            const std::string& prefix,
+                            int flushInterval = 100);
+    /** Close the streamed files and stop streaming. */
+    void clearStreamingOutput();
+    bool isStreamingOutput() const { return !_streamingPrefix.empty(); }
+
    //--------------------------------------------------------------------------
    //  INTERRUPT
    //--------------------------------------------------------------------------
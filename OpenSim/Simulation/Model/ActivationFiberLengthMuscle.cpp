@@ -88,6 +88,9 @@ void ActivationFiberLengthMuscle::constructProperties()
     // also wipe out the muscle path, which we do not want to 
     // reevaluate over and over.
     addStateVariable(STATE_FIBER_LENGTH_NAME);//, SimTK::Stage::Velocity);
+
+    _activationSV = getStateVariableHandle(STATE_ACTIVATION_NAME);
+    _fiberLengthSV = getStateVariableHandle(STATE_FIBER_LENGTH_NAME);
  }
 
  void ActivationFiberLengthMuscle::extendInitStateFromProperties( SimTK::State& s) const
@@ -102,8 +105,8 @@ void ActivationFiberLengthMuscle::extendSetPropertiesFromState(const SimTK::Stat
 {
     Super::extendSetPropertiesFromState(state);    // invoke superclass implementation
 
-    setDefaultActivation(getStateVariableValue(state, STATE_ACTIVATION_NAME));
-    setDefaultFiberLength(getStateVariableValue(state, STATE_FIBER_LENGTH_NAME));
+    setDefaultActivation(getStateVariableValue(state, _activationSV));
+    setDefaultFiberLength(getStateVariableValue(state, _fiberLengthSV));
 }
 
 void ActivationFiberLengthMuscle::extendConnectToModel(Model& aModel)
@@ -140,8 +143,8 @@ void ActivationFiberLengthMuscle::
         ldot = getFiberVelocity(s);
     }
 
-    setStateVariableDerivativeValue(s, STATE_ACTIVATION_NAME, adot);
-    setStateVariableDerivativeValue(s, STATE_FIBER_LENGTH_NAME, ldot);
+    setStateVariableDerivativeValue(s, _activationSV, adot);
+    setStateVariableDerivativeValue(s, _fiberLengthSV, ldot);
 }
 //==============================================================================
 // GET
@@ -152,19 +155,19 @@ void ActivationFiberLengthMuscle::
 
 void ActivationFiberLengthMuscle::setActivation(SimTK::State& s, double activation) const
 {
-    setStateVariableValue(s, STATE_ACTIVATION_NAME, activation);
+    setStateVariableValue(s, _activationSV, activation);
 }
 
 void ActivationFiberLengthMuscle::setFiberLength(SimTK::State& s, double fiberLength) const
 {
-    setStateVariableValue(s, STATE_FIBER_LENGTH_NAME, fiberLength);
+    setStateVariableValue(s, _fiberLengthSV, fiberLength);
     // NOTE: This is a temporary measure since we were forced to allocate
     // fiber length as a Dynamics stage dependent state variable.
     // In order to force the recalculation of the length cache we have to 
     // invalidate the length info whenever fiber length is set.
-    markCacheVariableInvalid(s,"lengthInfo");
-    markCacheVariableInvalid(s,"velInfo");
-    markCacheVariableInvalid(s,"dynamicsInfo");
+    markCacheVariableInvalid(s, _lengthInfoCV);
+    markCacheVariableInvalid(s, _velInfoCV);
+    markCacheVariableInvalid(s, _dynamicsInfoCV);
 }
 
 double ActivationFiberLengthMuscle::getActivationRate(const SimTK::State& s) const
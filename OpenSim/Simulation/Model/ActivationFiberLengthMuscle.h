@@ -125,6 +125,11 @@ protected:
     static const std::string STATE_ACTIVATION_NAME;
     static const std::string STATE_FIBER_LENGTH_NAME;   
 
+    /** Handles to the activation and fiber length state variables, for
+        derived muscles to access their values without a search by name. */
+    mutable StateVariableHandle _activationSV;
+    mutable StateVariableHandle _fiberLengthSV;
+
 private:
     void constructProperties();
 
@@ -352,6 +352,30 @@ ArrayPtrs<Storage>& Analysis::getStorageList()
     return _storageList;
 }
 
+//_____________________________________________________________________________
+/**
+ * Append the results of another analysis to those of this analysis.
+ */
+void Analysis::appendResults(Analysis& aAnalysis)
+{
+    ArrayPtrs<Storage>& storages = getStorageList();
+    ArrayPtrs<Storage>& otherStorages = aAnalysis.getStorageList();
+    if(storages.getSize() != otherStorages.getSize()) {
+        string msg = "Analysis.appendResults: ERROR- analysis " +
+            aAnalysis.getName() + " does not have the same storages as " +
+            getName() + ".";
+        throw Exception(msg,__FILE__,__LINE__);
+    }
+
+    for(int i=0;i<storages.getSize();i++) {
+        Storage* store = storages[i];
+        const Storage* otherStore = otherStorages[i];
+        if(store==NULL || otherStore==NULL) continue;
+        for(int j=0;j<otherStore->getSize();j++)
+            store->append(*otherStore->getStateVector(j));
+    }
+}
+
 // GET AND SET
 //=============================================================================
 //_____________________________________________________________________________
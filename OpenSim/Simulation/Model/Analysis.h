@@ -213,6 +213,35 @@ public:
     void setPrintResultFiles(bool aToWrite) { _printResultFiles = aToWrite; }
     bool getPrintResultFiles() const { return _printResultFiles; }
 
+    //--------------------------------------------------------------------------
+    // FRAME-WISE ANALYSIS
+    //--------------------------------------------------------------------------
+    /**
+     * Whether the results recorded for a state depend only on that state
+     * (and on the analysis settings), and not on the states that were
+     * recorded before it. For such an analysis, begin(), step() and end()
+     * each record the state they are given in the same way, so a sequence
+     * of states may be split into contiguous chunks, each analyzed by a copy
+     * of the analysis on a copy of the model, and the results of the chunks
+     * concatenated with appendResults(). AnalyzeTool uses this to analyze
+     * frames in parallel.
+     *
+     * The default is false. Analyses that carry information from one state
+     * to the next (e.g., a warm start) must not override it.
+     */
+    virtual bool isFrameIndependent() const { return false; }
+
+    /**
+     * Append the results recorded by another analysis of the same type and
+     * settings to the results of this analysis. The default implementation
+     * appends the rows of each storage in aAnalysis.getStorageList() to the
+     * storage of this analysis with the same index in getStorageList().
+     *
+     * @param aAnalysis Analysis whose results follow the results of this
+     * analysis in time.
+     */
+    virtual void appendResults(Analysis& aAnalysis);
+
     //--------------------------------------------------------------------------
     // RESULTS
     //--------------------------------------------------------------------------
@@ -28,6 +28,7 @@
 //=============================================================================
 #include "Bhargava2004MuscleMetabolicsProbe.h"
 #include <OpenSim/Simulation/Model/Muscle.h>
+#include <algorithm>
 //#define DEBUG_METABOLICS
 
 using namespace std;
@@ -82,6 +83,8 @@ void Bhargava2004MuscleMetabolicsProbe::setNull()
         "A phenomenological model for estimating metabolic energy consumption "
         "in muscle contraction. J Biomech 37, 81-8..");
     _muscleMap.clear();
+    _muscles.clear();
+    _musclesConnected = false;
 }
 
 //_____________________________________________________________________________
@@ -138,6 +141,7 @@ void Bhargava2004MuscleMetabolicsProbe::extendConnectToModel(Model& aModel)
         connectIndividualMetabolicMuscle(aModel, 
             upd_Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameterSet()[i]);
     }
+    gatherMuscles();
 }
 
 
@@ -233,6 +237,43 @@ void Bhargava2004MuscleMetabolicsProbe::connectIndividualMetabolicMuscle(
     mm.setMuscleMass();
 }
 
+//_____________________________________________________________________________
+/**
+ * Gather the muscles of the MetabolicMuscleParameterSet, in its order.
+ */
+void Bhargava2004MuscleMetabolicsProbe::gatherMuscles()
+{
+    _muscles.clear();
+    _musclesConnected = false;
+
+    const Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameterSet& mmSet =
+        get_Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameterSet();
+    for (int i=0; i<mmSet.getSize(); ++i) {
+        if (mmSet[i].getMuscle() == NULL) {
+            _muscles.clear();
+            return;
+        }
+        _muscles.push_back(SimTK::ReferencePtr<const Muscle>(
+            mmSet[i].getMuscle()));
+    }
+    _musclesConnected = true;
+}
+
+//_____________________________________________________________________________
+void Bhargava2004MuscleMetabolicsProbe::MuscleStateArrays::resize(
+    int numMuscles)
+{
+    for (std::vector<double>* values : 
+            {&muscleMass, &maxIsometricForce, &ratioSlowTwitchFibers,
+             &activationConstantSlowTwitch, &activationConstantFastTwitch,
+             &maintenanceConstantSlowTwitch, &maintenanceConstantFastTwitch,
+             &activation, &excitation, &activeFiberForce, &passiveFiberForce,
+             &normFiberLength, &fiberVelocity, &activeForceLengthMultiplier,
+             &slowTwitchExcitation, &fastTwitchExcitation, 
+             &Adot, &Mdot, &Sdot, &Wdot, &Edot})
+        values->resize(numMuscles);
+}
+
 
 
 
@@ -249,8 +290,7 @@ SimTK::Vector Bhargava2004MuscleMetabolicsProbe::
 computeProbeInputs(const State& s) const
 {
     // Initialize metabolic energy rate values
-    double Adot, Mdot, Sdot, Bdot, Wdot;
-    Adot = Mdot = Sdot = Bdot = Wdot = 0;
+    double Bdot = 0;
     Vector EdotOutput(getNumProbeInputs());
     EdotOutput = 0;
 
@@ -271,82 +311,126 @@ computeProbeInputs(const State& s) const
         EdotOutput(1) = Bdot;    // BASAL metabolic power storage
 
 
-    // Loop through each muscle in the MetabolicMuscleParameterSet
     const int nM = 
         get_Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameterSet()
         .getSize();
-    for (int i=0; i<nM; i++)
+    if (!_musclesConnected || (int)_muscles.size() != nM) {
+        throw Exception(getConcreteClassName() + " '" + getName() + 
+            "': the metabolic muscles are not connected to the model.",
+            __FILE__, __LINE__);
+    }
+
+    // The options are the same for all muscles.
+    const double scale = get_muscle_effort_scaling_factor();
+    const bool forbidNegativeTotalPower = get_forbid_negative_total_power();
+    const bool activationRateOn = get_activation_rate_on();
+    const bool maintenanceRateOn = get_maintenance_rate_on();
+    const bool shorteningRateOn = get_shortening_rate_on();
+    const bool workRateOn = get_mechanical_work_rate_on();
+    const bool includeNegativeWork = get_include_negative_mechanical_work();
+
+    MuscleStateArrays& ms = _muscleState;
+    ms.resize(nM);
+
+    // Get the muscle parameters, and the muscle quantities at the current
+    // time state, in one pass, so that the heat rates below are computed
+    // from contiguous arrays.
+    const Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameterSet& mmSet =
+        get_Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameterSet();
+    for (int i=0; i<nM; ++i)
     {
-        // Get the current muscle parameters from the MetabolicMuscleParameterSet
-        // and the corresponding OpenSim::Muscle pointer from the muscleMap.
-        Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameter& mm = 
-            get_Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameterSet()[i];   
-        const Muscle* m = mm.getMuscle();
-
-        // Get important muscle values at the current time state
-        const double max_isometric_force = m->getMaxIsometricForce();
-        const double max_shortening_velocity = m->getMaxContractionVelocity();
-        const double activation = get_muscle_effort_scaling_factor()
-                                  * m->getActivation(s);
-        const double excitation = get_muscle_effort_scaling_factor()
-                                  * m->getControl(s);
-        const double fiber_force_passive = m->getPassiveFiberForce(s);
-        const double fiber_force_active = get_muscle_effort_scaling_factor()
-                                          * m->getActiveFiberForce(s);
-        const double fiber_force_total = fiber_force_active     // Scaled.
-                                         + fiber_force_passive;
-        const double fiber_length_normalized = m->getNormalizedFiberLength(s);
-        const double fiber_velocity = m->getFiberVelocity(s);
-        const double fiber_velocity_normalized = m->getNormalizedFiberVelocity(s);
-        const double slow_twitch_excitation = mm.get_ratio_slow_twitch_fibers() * sin(Pi/2 * excitation);
-        const double fast_twitch_excitation = (1 - mm.get_ratio_slow_twitch_fibers()) * (1 - cos(Pi/2 * excitation));
-        double alpha, fiber_length_dependence;
-
-        // Get the unnormalized total active force, F_iso that 'would' be developed at the current activation
-        // and fiber length under isometric conditions (i.e. Vm=0)
-        const double F_iso = activation * m->getActiveForceLengthMultiplier(s) * max_isometric_force;
+        const Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameter& mm =
+            mmSet[i];
+        const Muscle* m = _muscles[i].get();
+        ms.muscleMass[i] = mm.getMuscleMass();
+        ms.maxIsometricForce[i] = m->getMaxIsometricForce();
+        ms.ratioSlowTwitchFibers[i] = mm.get_ratio_slow_twitch_fibers();
+        ms.activationConstantSlowTwitch[i] = 
+            mm.get_activation_constant_slow_twitch();
+        ms.activationConstantFastTwitch[i] = 
+            mm.get_activation_constant_fast_twitch();
+        ms.maintenanceConstantSlowTwitch[i] = 
+            mm.get_maintenance_constant_slow_twitch();
+        ms.maintenanceConstantFastTwitch[i] = 
+            mm.get_maintenance_constant_fast_twitch();
+
+        ms.activation[i] = scale * m->getActivation(s);
+        ms.excitation[i] = scale * m->getControl(s);
+        ms.activeFiberForce[i] = scale * m->getActiveFiberForce(s);
+        ms.passiveFiberForce[i] = m->getPassiveFiberForce(s);
+        ms.normFiberLength[i] = m->getNormalizedFiberLength(s);
+        ms.fiberVelocity[i] = m->getFiberVelocity(s);
+        ms.activeForceLengthMultiplier[i] = 
+            m->getActiveForceLengthMultiplier(s);
 
         // Warnings
-        if (fiber_length_normalized < 0)
+        if (ms.normFiberLength[i] < 0)
             cout << "WARNING: " << getName() << "  (t = " << s.getTime() 
             << "), muscle '" << m->getName() 
             << "' has negative normalized fiber-length." << endl; 
+    }
 
+    for (int i=0; i<nM; ++i) {
+        const double excitation = ms.excitation[i];
+        ms.slowTwitchExcitation[i] = 
+            ms.ratioSlowTwitchFibers[i] * sin(Pi/2 * excitation);
+        ms.fastTwitchExcitation[i] = 
+            (1 - ms.ratioSlowTwitchFibers[i]) * (1 - cos(Pi/2 * excitation));
+    }
 
 
-        // ACTIVATION HEAT RATE for muscle i (W)
-        // ------------------------------------------
-        if (get_forbid_negative_total_power() || get_activation_rate_on())
-        {
-            const double decay_function_value = 1.0;    // This value is set to 1.0, as used by Anderson & Pandy (1999), however, in
-                                                        // Bhargava et al., (2004) they assume a function here. We will ignore this
-                                                        // function and use 1.0 for now.
-            Adot = mm.getMuscleMass() * decay_function_value * 
-                ( (mm.get_activation_constant_slow_twitch() * slow_twitch_excitation) + (mm.get_activation_constant_fast_twitch() * fast_twitch_excitation) );
-        }
-
-
-
-        // MAINTENANCE HEAT RATE for muscle i (W)
-        // ------------------------------------------
-        if (get_forbid_negative_total_power() || get_maintenance_rate_on())
-        {
-            Vector tmp(1, fiber_length_normalized);
-            fiber_length_dependence = get_normalized_fiber_length_dependence_on_maintenance_rate().calcValue(tmp);
-            
-            Mdot = mm.getMuscleMass() * fiber_length_dependence * 
-                ( (mm.get_maintenance_constant_slow_twitch() * slow_twitch_excitation) + (mm.get_maintenance_constant_fast_twitch() * fast_twitch_excitation) );
+    // ACTIVATION HEAT RATE for each muscle (W)
+    // ------------------------------------------
+    // The decay function value is set to 1.0, as used by Anderson & Pandy
+    // (1999), however, in Bhargava et al., (2004) they assume a function
+    // here. We will ignore this function and use 1.0 for now.
+    if (forbidNegativeTotalPower || activationRateOn) {
+        for (int i=0; i<nM; ++i)
+            ms.Adot[i] = ms.muscleMass[i] * 
+                ( (ms.activationConstantSlowTwitch[i] * ms.slowTwitchExcitation[i]) 
+                + (ms.activationConstantFastTwitch[i] * ms.fastTwitchExcitation[i]) );
+    }
+    else
+        std::fill(ms.Adot.begin(), ms.Adot.end(), 0.0);
+
+
+    // MAINTENANCE HEAT RATE for each muscle (W)
+    // ------------------------------------------
+    if (forbidNegativeTotalPower || maintenanceRateOn) {
+        const OpenSim::Function& fiberLengthDependenceCurve = 
+            get_normalized_fiber_length_dependence_on_maintenance_rate();
+        Vector tmp(1);
+        for (int i=0; i<nM; ++i) {
+            tmp[0] = ms.normFiberLength[i];
+            const double fiber_length_dependence = 
+                fiberLengthDependenceCurve.calcValue(tmp);
+            ms.Mdot[i] = ms.muscleMass[i] * fiber_length_dependence * 
+                ( (ms.maintenanceConstantSlowTwitch[i] * ms.slowTwitchExcitation[i]) 
+                + (ms.maintenanceConstantFastTwitch[i] * ms.fastTwitchExcitation[i]) );
         }
+    }
+    else
+        std::fill(ms.Mdot.begin(), ms.Mdot.end(), 0.0);
 
 
-
-        // SHORTENING HEAT RATE for muscle i (W)
-        // --> note that we define Vm<0 as shortening and Vm>0 as lengthening
-        // -----------------------------------------------------------------------
-        if (get_forbid_negative_total_power() || get_shortening_rate_on())
-        {
-            if (get_use_force_dependent_shortening_prop_constant())
+    // SHORTENING HEAT RATE for each muscle (W)
+    // --> note that we define Vm<0 as shortening and Vm>0 as lengthening
+    // -----------------------------------------------------------------------
+    if (forbidNegativeTotalPower || shorteningRateOn) {
+        const bool forceDependent = 
+            get_use_force_dependent_shortening_prop_constant();
+        for (int i=0; i<nM; ++i) {
+            const double fiber_velocity = ms.fiberVelocity[i];
+            const double fiber_force_total = ms.activeFiberForce[i]  // Scaled.
+                                             + ms.passiveFiberForce[i];
+            double alpha;
+            if (forceDependent)
             {
+                // The unnormalized total active force, F_iso that 'would' be
+                // developed at the current activation and fiber length under
+                // isometric conditions (i.e. Vm=0)
+                const double F_iso = ms.activation[i] 
+                    * ms.activeForceLengthMultiplier[i] * ms.maxIsometricForce[i];
                 if (fiber_velocity <= 0)    // concentric contraction, Vm<0
                     alpha = (0.16 * F_iso) + (0.18 * fiber_force_total);
                 else                        // eccentric contraction, Vm>0
@@ -359,118 +443,115 @@ computeProbeInputs(const State& s) const
                 else                        // eccentric contraction, Vm>0
                     alpha = 0.0;
             }
-            Sdot = -alpha * fiber_velocity;
+            ms.Sdot[i] = -alpha * fiber_velocity;
         }
-        
+    }
+    else
+        std::fill(ms.Sdot.begin(), ms.Sdot.end(), 0.0);
 
 
-        // MECHANICAL WORK RATE for the contractile element of muscle i (W).
-        // --> note that we define Vm<0 as shortening and Vm>0 as lengthening.
-        // -------------------------------------------------------------------
-        if (get_forbid_negative_total_power() || get_mechanical_work_rate_on())
-        {
-            if (get_include_negative_mechanical_work() || fiber_velocity <= 0)
-                Wdot = -fiber_force_active*fiber_velocity;
-            else
-                Wdot = 0;
+    // MECHANICAL WORK RATE for the contractile element of each muscle (W).
+    // --> note that we define Vm<0 as shortening and Vm>0 as lengthening.
+    // -------------------------------------------------------------------
+    if (forbidNegativeTotalPower || workRateOn) {
+        for (int i=0; i<nM; ++i) {
+            const double fiber_velocity = ms.fiberVelocity[i];
+            ms.Wdot[i] = (includeNegativeWork || fiber_velocity <= 0)
+                ? -ms.activeFiberForce[i]*fiber_velocity : 0.0;
         }
+    }
+    else
+        std::fill(ms.Wdot.begin(), ms.Wdot.end(), 0.0);
 
 
-        // NAN CHECKING
-        // ------------------------------------------
-        if (isNaN(Adot))
-            cout << "WARNING::" << getName() << ": Adot (" << m->getName() << ") = NaN!" << endl;
-        if (isNaN(Mdot))
-            cout << "WARNING::" << getName() << ": Mdot (" << m->getName() << ") = NaN!" << endl;
-        if (isNaN(Sdot))
-            cout << "WARNING::" << getName() << ": Sdot (" << m->getName() << ") = NaN!" << endl;
-        if (isNaN(Wdot))
-            cout << "WARNING::" << getName() << ": Wdot (" << m->getName() << ") = NaN!" << endl;
+    // NAN CHECKING
+    // ------------------------------------------
+    for (int i=0; i<nM; ++i) {
+        if (isNaN(ms.Adot[i]))
+            cout << "WARNING::" << getName() << ": Adot (" << _muscles[i]->getName() << ") = NaN!" << endl;
+        if (isNaN(ms.Mdot[i]))
+            cout << "WARNING::" << getName() << ": Mdot (" << _muscles[i]->getName() << ") = NaN!" << endl;
+        if (isNaN(ms.Sdot[i]))
+            cout << "WARNING::" << getName() << ": Sdot (" << _muscles[i]->getName() << ") = NaN!" << endl;
+        if (isNaN(ms.Wdot[i]))
+            cout << "WARNING::" << getName() << ": Wdot (" << _muscles[i]->getName() << ") = NaN!" << endl;
+    }
 
 
-        // If necessary, increase the shortening heat rate so that the total
-        // power is non-negative.
-        if (get_forbid_negative_total_power()) {
-            const double Edot_W_beforeClamp = Adot + Mdot + Sdot + Wdot;
+    // If necessary, increase the shortening heat rate so that the total
+    // power is non-negative.
+    if (forbidNegativeTotalPower) {
+        for (int i=0; i<nM; ++i) {
+            const double Edot_W_beforeClamp = 
+                ms.Adot[i] + ms.Mdot[i] + ms.Sdot[i] + ms.Wdot[i];
             if (Edot_W_beforeClamp < 0)
-                Sdot -= Edot_W_beforeClamp;
-        }
-
-
-        // This check is adapted from Umberger(2003), page 104: the total heat rate 
-        // (i.e., Adot + Mdot + Sdot) for a given muscle cannot fall below 1.0 W/kg.
-        // -----------------------------------------------------------------------
-        double totalHeatRate = Adot + Mdot + Sdot;      // (W)
-
-        if(get_enforce_minimum_heat_rate_per_muscle() && totalHeatRate < 1.0 * mm.getMuscleMass()
-            && get_activation_rate_on() 
-            && get_maintenance_rate_on() 
-            && get_shortening_rate_on()) {
-                //cout << "WARNING: " << getName() 
-                //    << "  (t = " << s.getTime() 
-                //    << "), the muscle '" << mm.getName() 
-                //    << "' has a net metabolic energy rate of less than 1.0 W/kg." << endl; 
-                totalHeatRate = 1.0 * mm.getMuscleMass();           // not allowed to fall below 1.0 W.kg-1
+                ms.Sdot[i] -= Edot_W_beforeClamp;
         }
+    }
 
 
-        // TOTAL METABOLIC ENERGY RATE for muscle i (W)
-        // ------------------------------------------
+    // TOTAL METABOLIC ENERGY RATE for each muscle (W)
+    // ------------------------------------------
+    // This check is adapted from Umberger(2003), page 104: the total heat rate 
+    // (i.e., Adot + Mdot + Sdot) for a given muscle cannot fall below 1.0 W/kg.
+    const bool allHeatRatesOn = 
+        activationRateOn && maintenanceRateOn && shorteningRateOn;
+    const bool enforceMinimumHeatRate = 
+        get_enforce_minimum_heat_rate_per_muscle() && allHeatRatesOn;
+    for (int i=0; i<nM; ++i) {
         double Edot = 0;
-
-        if (get_activation_rate_on() && get_maintenance_rate_on()
-            && get_shortening_rate_on())
-        {
-            Edot += totalHeatRate;      // May have been clamped to 1.0 W/kg.
+        if (allHeatRatesOn) {
+            const double totalHeatRate = ms.Adot[i] + ms.Mdot[i] + ms.Sdot[i];
+            const double minimumHeatRate = 1.0 * ms.muscleMass[i];
+            // May be clamped to 1.0 W/kg.
+            Edot += (enforceMinimumHeatRate && totalHeatRate < minimumHeatRate)
+                    ? minimumHeatRate : totalHeatRate;
         } else {
-            if (get_activation_rate_on())
-                Edot += Adot;
-            if (get_maintenance_rate_on())
-                Edot += Mdot;
-            if (get_shortening_rate_on())
-                Edot += Sdot;
+            if (activationRateOn)
+                Edot += ms.Adot[i];
+            if (maintenanceRateOn)
+                Edot += ms.Mdot[i];
+            if (shorteningRateOn)
+                Edot += ms.Sdot[i];
         }
-        if (get_mechanical_work_rate_on())
-            Edot += Wdot;
-
-        EdotOutput(0) += Edot;       // Add to TOTAL metabolic power storage
-        if (!get_report_total_metabolics_only()) {
-            // Metabolic power storage for muscle i
-            EdotOutput(i+2) = Edot;  
-        }  
+        if (workRateOn)
+            Edot += ms.Wdot[i];
+        ms.Edot[i] = Edot;
+    }
 
+    for (int i=0; i<nM; ++i)
+        EdotOutput(0) += ms.Edot[i];     // Add to TOTAL metabolic power storage
+    if (!get_report_total_metabolics_only()) {
+        // Metabolic power storage for each muscle
+        for (int i=0; i<nM; ++i)
+            EdotOutput(i+2) = ms.Edot[i];
+    }
 
 
 #ifdef DEBUG_METABOLICS
-        cout << "muscle_mass = " << mm.getMuscleMass() << endl;
-        cout << "ratio_slow_twitch_fibers = " << mm.get_ratio_slow_twitch_fibers() << endl;
-        cout << "activation_constant_slow_twitch = " << mm.get_activation_constant_slow_twitch() << endl;
-        cout << "activation_constant_fast_twitch = " << mm.get_activation_constant_fast_twitch() << endl;
-        cout << "maintenance_constant_slow_twitch = " << mm.get_maintenance_constant_slow_twitch() << endl;
-        cout << "maintenance_constant_fast_twitch = " << mm.get_maintenance_constant_fast_twitch() << endl;
-        cout << "bodymass = " << _model->getMatterSubsystem().calcSystemMass(s) << endl;
-        cout << "max_isometric_force = " << max_isometric_force << endl;
-        cout << "activation = " << activation << endl;
-        cout << "excitation = " << excitation << endl;
-        cout << "fiber_force_total = " << fiber_force_total << endl;
-        cout << "fiber_force_active = " << fiber_force_active << endl;
-        cout << "fiber_length_normalized = " << fiber_length_normalized << endl;
-        cout << "fiber_length_dependence = " << fiber_length_dependence << endl;
-        cout << "fiber_velocity = " << fiber_velocity << endl;
-        cout << "fiber_velocity_normalized = " << fiber_velocity_normalized << endl;
-        cout << "slow_twitch_excitation = " << slow_twitch_excitation << endl;
-        cout << "fast_twitch_excitation = " << fast_twitch_excitation << endl;
-        cout << "max shortening velocity = " << max_shortening_velocity << endl;
-        cout << "alpha = " << alpha << endl;
-        cout << "Adot = " << Adot << endl;
-        cout << "Mdot = " << Mdot << endl;
-        cout << "Sdot = " << Sdot << endl;
-        cout << "Bdot = " << Bdot << endl;
-        cout << "Wdot = " << Wdot << endl;
-        cout << "Edot = " << Edot << endl;
-        std::cin.get();
-#endif
+    cout << "bodymass = " << _model->getMatterSubsystem().calcSystemMass(s) << endl;
+    cout << "Bdot = " << Bdot << endl;
+    for (int i=0; i<nM; ++i) {
+        cout << "muscle = " << _muscles[i]->getName() << endl;
+        cout << "muscle_mass = " << ms.muscleMass[i] << endl;
+        cout << "ratio_slow_twitch_fibers = " << ms.ratioSlowTwitchFibers[i] << endl;
+        cout << "max_isometric_force = " << ms.maxIsometricForce[i] << endl;
+        cout << "activation = " << ms.activation[i] << endl;
+        cout << "excitation = " << ms.excitation[i] << endl;
+        cout << "fiber_force_active = " << ms.activeFiberForce[i] << endl;
+        cout << "fiber_force_passive = " << ms.passiveFiberForce[i] << endl;
+        cout << "fiber_length_normalized = " << ms.normFiberLength[i] << endl;
+        cout << "fiber_velocity = " << ms.fiberVelocity[i] << endl;
+        cout << "slow_twitch_excitation = " << ms.slowTwitchExcitation[i] << endl;
+        cout << "fast_twitch_excitation = " << ms.fastTwitchExcitation[i] << endl;
+        cout << "Adot = " << ms.Adot[i] << endl;
+        cout << "Mdot = " << ms.Mdot[i] << endl;
+        cout << "Sdot = " << ms.Sdot[i] << endl;
+        cout << "Wdot = " << ms.Wdot[i] << endl;
+        cout << "Edot = " << ms.Edot[i] << endl;
     }
+    std::cin.get();
+#endif
 
     return EdotOutput;
 }
@@ -617,6 +698,7 @@ void Bhargava2004MuscleMetabolicsProbe::
     }
     upd_Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameterSet()
         .remove(k);
+    gatherMuscles();
 }
 
 
@@ -442,6 +442,43 @@ private:
     //--------------------------------------------------------------------------
     MuscleMap _muscleMap;
 
+    // The muscles of the MetabolicMuscleParameterSet, indexed like the set.
+    // Gathered when the probe is connected to the model and when a muscle
+    // is removed through this interface.
+    std::vector<SimTK::ReferencePtr<const Muscle>> _muscles;
+    // Whether _muscles holds a connected muscle for every parameter.
+    SimTK::ResetOnCopy<bool> _musclesConnected;
+
+    // Muscle parameters and quantities at the state being evaluated, indexed
+    // like _muscles. The parameters are read on each evaluation, so changes
+    // made after connecting are used.
+    struct MuscleStateArrays {
+        std::vector<double> muscleMass;
+        std::vector<double> maxIsometricForce;
+        std::vector<double> ratioSlowTwitchFibers;
+        std::vector<double> activationConstantSlowTwitch;
+        std::vector<double> activationConstantFastTwitch;
+        std::vector<double> maintenanceConstantSlowTwitch;
+        std::vector<double> maintenanceConstantFastTwitch;
+        std::vector<double> activation;
+        std::vector<double> excitation;
+        std::vector<double> activeFiberForce;
+        std::vector<double> passiveFiberForce;
+        std::vector<double> normFiberLength;
+        std::vector<double> fiberVelocity;
+        std::vector<double> activeForceLengthMultiplier;
+        std::vector<double> slowTwitchExcitation;
+        std::vector<double> fastTwitchExcitation;
+        std::vector<double> Adot;
+        std::vector<double> Mdot;
+        std::vector<double> Sdot;
+        std::vector<double> Wdot;
+        std::vector<double> Edot;
+        void resize(int numMuscles);
+    };
+    // Reused by computeProbeInputs() to avoid allocating.
+    mutable MuscleStateArrays _muscleState;
+
 
     //--------------------------------------------------------------------------
     // ModelComponent Interface
@@ -449,6 +486,9 @@ private:
     void extendConnectToModel(Model& aModel) override;
     void connectIndividualMetabolicMuscle(Model& aModel, 
         Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameter& mm);
+    // Gather _muscles from the MetabolicMuscleParameterSet; they are left
+    // empty, and _musclesConnected false, if any muscle is not connected.
+    void gatherMuscles();
 
     void setNull();
     void constructProperties();
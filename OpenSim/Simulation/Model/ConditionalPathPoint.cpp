@@ -185,6 +185,7 @@ void ConditionalPathPoint::setCoordinate(const SimTK::State& s, Coordinate& aCoo
     {
        _coordinate = &aCoordinate;
        _coordinateName = _coordinate->getName();
+       ++_geometryVersion;
     }
 }
 
@@ -199,6 +200,7 @@ void ConditionalPathPoint::setRangeMin(const SimTK::State& s, double aMin)
     if (aMin <= _range[1])
     {
         _range[0] = aMin;
+        ++_geometryVersion;
     }
 }
 
@@ -213,6 +215,7 @@ void ConditionalPathPoint::setRangeMax( const SimTK::State& s, double aMax)
     if (aMax >= _range[0])
     {
         _range[1] = aMax;
+        ++_geometryVersion;
     }
 }
 
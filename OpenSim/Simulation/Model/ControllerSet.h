@@ -83,6 +83,9 @@ public:
     void constructStorage();
     void storeControls( const SimTK::State& s, int step );
     void printControlStorage( const std::string& fileName) const;
+    /** The Storage in which storeControls() records the controls, or NULL if
+    it has not been constructed. */
+    Storage* updControlStorage() { return _controlStore.get(); }
     void setActuators(Set<Actuator>& actuators);
 
     void setDesiredStates( Storage* yStore); 
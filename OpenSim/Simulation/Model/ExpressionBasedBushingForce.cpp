@@ -43,6 +43,28 @@ std::string to_string(T const& value) {
     return sstr.str();
 }
 
+// Compile a stiffness expression with the deflections bound to slots in the
+// order they appear in the Vec6 returned by computeDeflection().
+static Lepton::CompiledExpression
+compileDeflectionExpression(const std::string& expression)
+{
+    static const std::vector<std::string> deflectionNames =
+        { "theta_x", "theta_y", "theta_z", "delta_x", "delta_y", "delta_z" };
+
+    Lepton::CompiledExpression compiled =
+        Lepton::Parser::parse(expression).createCompiledExpression();
+    for (const std::string& var : compiled.getVariables()) {
+        if (std::find(deflectionNames.begin(), deflectionNames.end(), var)
+                == deflectionNames.end()) {
+            throw Exception("ExpressionBasedBushingForce: Invalid variable ("
+                + var + ") in expression '" + expression + "'.",
+                __FILE__, __LINE__);
+        }
+    }
+    compiled.bindVariables(deflectionNames);
+    return compiled;
+}
+
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //=============================================================================
@@ -173,59 +195,59 @@ void ExpressionBasedBushingForce::extendFinalizeFromProperties()
     }
 }
 
-/** Set the expression for the Mx function and create it's lepton program */
+/** Set the expression for the Mx function and compile it */
 void ExpressionBasedBushingForce::setMxExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Mx_expression(expression);
-    MxProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    MxExpr = compileDeflectionExpression(expression);
 }
 
-/** Set the expression for the My function and create it's lepton program */
+/** Set the expression for the My function and compile it */
 void ExpressionBasedBushingForce::setMyExpression(std::string expression) 
 {
     
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_My_expression(expression);
-    MyProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    MyExpr = compileDeflectionExpression(expression);
 }
 
-/** Set the expression for the Mz function and create it's lepton program */
+/** Set the expression for the Mz function and compile it */
 void ExpressionBasedBushingForce::setMzExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Mz_expression(expression);
-    MzProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    MzExpr = compileDeflectionExpression(expression);
 }
 
-/** Set the expression for the Fx function and create it's lepton program */
+/** Set the expression for the Fx function and compile it */
 void ExpressionBasedBushingForce::setFxExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fx_expression(expression);
-    FxProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    FxExpr = compileDeflectionExpression(expression);
 }
 
-/** Set the expression for the Fy function and create it's lepton program */
+/** Set the expression for the Fy function and compile it */
 void ExpressionBasedBushingForce::setFyExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fy_expression(expression);
-    FyProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    FyExpr = compileDeflectionExpression(expression);
 }
 
-/** Set the expression for the Fz function and create it's lepton program */
+/** Set the expression for the Fz function and compile it */
 void ExpressionBasedBushingForce::setFzExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fz_expression(expression);
-    FzProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    FzExpr = compileDeflectionExpression(expression);
 }
 //=============================================================================
 // COMPUTATION
@@ -240,21 +262,15 @@ SimTK::Vec6 ExpressionBasedBushingForce::
 
     Vec6 fk = Vec6(0.0);
 
-    std::map<std::string, double> deflectionVars;
-    deflectionVars["theta_x"] = dq[0];
-    deflectionVars["theta_y"] = dq[1];
-    deflectionVars["theta_z"] = dq[2];
-    deflectionVars["delta_x"] = dq[3];
-    deflectionVars["delta_y"] = dq[4];
-    deflectionVars["delta_z"] = dq[5];
-
-
-    fk[0] = MxProg.evaluate(deflectionVars);
-    fk[1] = MyProg.evaluate(deflectionVars);
-    fk[2] = MzProg.evaluate(deflectionVars);
-    fk[3] = FxProg.evaluate(deflectionVars);
-    fk[4] = FyProg.evaluate(deflectionVars);
-    fk[5] = FzProg.evaluate(deflectionVars);
+    // The deflections are bound to the expressions' slots in dq order.
+    const double* deflectionVars = &dq[0];
+
+    fk[0] = MxExpr.evaluate(deflectionVars);
+    fk[1] = MyExpr.evaluate(deflectionVars);
+    fk[2] = MzExpr.evaluate(deflectionVars);
+    fk[3] = FxExpr.evaluate(deflectionVars);
+    fk[4] = FyExpr.evaluate(deflectionVars);
+    fk[5] = FzExpr.evaluate(deflectionVars);
 
     return -fk;
 }
@@ -28,6 +28,7 @@
 #include <OpenSim/Simulation/osimSimulationDLL.h>
 #include "Force.h"
 #include <OpenSim/Simulation/Model/TwoFrameLinker.h>
+#include <Vendors/lepton/include/Lepton.h>
 
 namespace OpenSim {
 
@@ -241,8 +242,10 @@ private:
 
     SimTK::Mat66 _dampingMatrix{ 0.0 };
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram MxProg, MyProg, MzProg, FxProg, FyProg, FzProg;
+    // compiled expressions with the deflections theta_x, theta_y, theta_z,
+    // delta_x, delta_y, delta_z bound to slots 0-5, in that order
+    mutable Lepton::CompiledExpression MxExpr, MyExpr, MzExpr,
+                                       FxExpr, FyExpr, FzExpr;
 
 //==============================================================================
 };  // END of class ExpressionBasedBushingForce
@@ -95,7 +95,17 @@ void ExpressionBasedCoordinateForce::extendConnectToModel(Model& aModel)
             remove_if(expression.begin(), expression.end(), ::isspace), 
                       expression.end() );
     
-    _forceProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    _forceExpression =
+        Lepton::Parser::parse(expression).createCompiledExpression();
+    for (const std::string& var : _forceExpression.getVariables()) {
+        if (var != "q" && var != "qdot") {
+            errorMessage = "ExpressionBasedCoordinateForce: Invalid variable ("
+                + var + ") in expression of " + getName()
+                + "; only q and qdot are allowed.";
+            throw (Exception(errorMessage.c_str()));
+        }
+    }
+    _forceExpression.bindVariables({"q", "qdot"});
 
     // Look up the coordinate
     if (!_model->updCoordinateSet().contains(coordName)) {
@@ -133,12 +143,9 @@ void ExpressionBasedCoordinateForce::computeForce(const SimTK::State& s,
 double ExpressionBasedCoordinateForce::calcExpressionForce(const SimTK::State& s ) const
 {
     using namespace SimTK;
-    double q = _coord->getValue(s);
-    double qdot = _coord->getSpeedValue(s);
-    std::map<std::string, double> forceVars;
-    forceVars["q"] = q;
-    forceVars["qdot"] = qdot;
-    double forceMag = _forceProg.evaluate(forceVars);
+    const double forceVars[2] = { _coord->getValue(s),
+                                  _coord->getSpeedValue(s) };
+    double forceMag = _forceExpression.evaluate(forceVars);
     setCacheVariableValue<double>(s, "force_magnitude", forceMag);
     return forceMag;
 }
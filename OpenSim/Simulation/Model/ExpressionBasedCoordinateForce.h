@@ -126,8 +126,9 @@ private:
     void setNull();
     void constructProperties();
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram _forceProg;
+    // compiled expression with q and qdot bound to slots 0 and 1, so that
+    // it can be evaluated without looking up the variables by name
+    mutable Lepton::CompiledExpression _forceExpression;
 
     // Corresponding generalized coordinate to which the force
     // is applied.
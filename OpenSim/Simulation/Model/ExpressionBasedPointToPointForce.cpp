@@ -129,7 +129,17 @@ void ExpressionBasedPointToPointForce::extendConnectToModel(Model& model)
             remove_if(expression.begin(), expression.end(), ::isspace), 
                       expression.end() );
     
-    _forceProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    _forceExpression =
+        Lepton::Parser::parse(expression).createCompiledExpression();
+    for (const std::string& var : _forceExpression.getVariables()) {
+        if (var != "d" && var != "ddot") {
+            string errorMessage = "ExpressionBasedPointToPointForce: Invalid "
+                "variable (" + var + ") in expression of " + getName()
+                + "; only d and ddot are allowed.";
+            throw (Exception(errorMessage.c_str()));
+        }
+    }
+    _forceExpression.bindVariables({"d", "ddot"});
 }
 
 //=============================================================================
@@ -179,11 +189,8 @@ void ExpressionBasedPointToPointForce::computeForce(const SimTK::State& s,
     //speed along the line connecting the two bodies
     const double ddot = dot(vRel, r_G)/d;
 
-    std::map<std::string, double> forceVars;
-    forceVars["d"] = d;
-    forceVars["ddot"] = ddot;
-
-    double forceMag = _forceProg.evaluate(forceVars);
+    const double forceVars[2] = { d, ddot };
+    double forceMag = _forceExpression.evaluate(forceVars);
     setCacheVariableValue<double>(s, "force_magnitude", forceMag);
 
     const Vec3 f1_G = (forceMag/d) * r_G;
@@ -165,8 +165,9 @@ private:
     void setNull();
     void constructProperties();
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram _forceProg;
+    // compiled expression with d and ddot bound to slots 0 and 1, so that
+    // it can be evaluated without looking up the variables by name
+    mutable Lepton::CompiledExpression _forceExpression;
 
     // Temporary solution until implemented with Connectors
     SimTK::ReferencePtr<const PhysicalFrame> _body1;
@@ -66,8 +66,15 @@ void Force::extendAddToSystem(SimTK::MultibodySystem& system) const
 {
     Super::extendAddToSystem(system);
 
-    ForceAdapter* adapter = new ForceAdapter(*this);
+    // If the Model computes Forces concurrently, it computes this one and 
+    // this Force's own adapter only provides the potential energy.
+    ParallelForceAdapter* parallelForces = canBeComputedConcurrently() 
+                                            ? _model->_parallelForces.get() 
+                                            : nullptr;
+    ForceAdapter* adapter = new ForceAdapter(*this, parallelForces == nullptr);
     SimTK::Force::Custom force(_model->updForceSubsystem(), adapter);
+    if (parallelForces)
+        parallelForces->addForce(*this);
 
      // Beyond the const Component get the index so we can access the SimTK::Force later
     Force* mutableThis = const_cast<Force *>(this);
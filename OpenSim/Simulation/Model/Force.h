@@ -73,6 +73,20 @@ public:
         return false;
     }
 
+    /**
+    * Whether computeForce() can run concurrently with the computeForce() of
+    * other Forces on the same State, i.e., it only modifies this Force's own
+    * cache variables and members. Such Forces are computed on several
+    * threads when Model::setNumForceThreads() is given more than one thread.
+    * The default is the value of shouldBeParallelized(). A class that returns
+    * true should do so only for its own concrete class, since a subclass may
+    * add state that is not safe to compute concurrently.
+    */
+    virtual bool canBeComputedConcurrently() const
+    {
+        return shouldBeParallelized();
+    }
+
     /** Return if the Force is disabled or not. */
     bool isDisabled(const SimTK::State& s) const;
     /** %Set the Force as disabled (true) or not (false). */
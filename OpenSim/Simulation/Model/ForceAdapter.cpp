@@ -25,6 +25,8 @@
 // INCLUDES
 //=============================================================================
 #include "ForceAdapter.h"
+#include "Model.h"
+#include <algorithm>
 
 //=============================================================================
 // STATICS
@@ -35,7 +37,8 @@ using SimTK::Vec3;
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //=============================================================================
-ForceAdapter::ForceAdapter(const Force& force) : _force(&force)
+ForceAdapter::ForceAdapter(const Force& force, bool computesForce) : 
+    _force(&force), _computesForce(computesForce)
 {
 }
 
@@ -46,7 +49,8 @@ void ForceAdapter::calcForce(const SimTK::State& state,
     SimTK::Vector_<SimTK::SpatialVec>& bodyForces,SimTK::Vector_<SimTK::Vec3>& particleForces,
     SimTK::Vector& mobilityForces) const
 {
-    _force->computeForce(state, bodyForces, mobilityForces);
+    if (_computesForce)
+        _force->computeForce(state, bodyForces, mobilityForces);
 }
 
 SimTK::Real ForceAdapter::calcPotentialEnergy(const SimTK::State& state) const
@@ -55,5 +59,107 @@ SimTK::Real ForceAdapter::calcPotentialEnergy(const SimTK::State& state) const
 }
 
 bool ForceAdapter::shouldBeParallelized() const {
-    return _force->shouldBeParallelized(); 
+    // There is nothing to parallelize if the force is computed elsewhere.
+    return _computesForce && _force->shouldBeParallelized(); 
+}
+
+//=============================================================================
+// PARALLEL FORCE ADAPTER
+//=============================================================================
+namespace {
+// Computes chunk i of the forces into the i-th body and mobility forces.
+class ForceChunkTask : public SimTK::ParallelExecutor::Task {
+public:
+    ForceChunkTask(const SimTK::State& state, 
+                   const std::vector<const Force*>& forces, int numChunks,
+                   std::vector<SimTK::Vector_<SimTK::SpatialVec> >& bodyForces,
+                   std::vector<SimTK::Vector>& mobilityForces,
+                   std::vector<std::string>& errors) :
+        _state(state), _forces(forces), _numChunks(numChunks),
+        _bodyForces(bodyForces), _mobilityForces(mobilityForces), 
+        _errors(errors) {}
+
+    void execute(int index) override {
+        const int numForces = (int)_forces.size();
+        const int first = (index*numForces)/_numChunks;
+        const int last = ((index+1)*numForces)/_numChunks;
+        try {
+            for (int i = first; i < last; ++i)
+                _forces[i]->computeForce(_state, _bodyForces[index], 
+                                         _mobilityForces[index]);
+        }
+        catch (const std::exception& ex) {
+            // Exceptions must not escape a worker thread.
+            _errors[index] = ex.what();
+        }
+    }
+
+private:
+    const SimTK::State& _state;
+    const std::vector<const Force*>& _forces;
+    int _numChunks;
+    std::vector<SimTK::Vector_<SimTK::SpatialVec> >& _bodyForces;
+    std::vector<SimTK::Vector>& _mobilityForces;
+    std::vector<std::string>& _errors;
+};
+} // anonymous namespace
+
+ParallelForceAdapter::ParallelForceAdapter(const Model& model, int numThreads) :
+    _model(&model), _numThreads(numThreads)
+{
+}
+
+void ParallelForceAdapter::addForce(const Force& force)
+{
+    _forces.push_back(&force);
+}
+
+void ParallelForceAdapter::calcForce(const SimTK::State& state,
+    SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+    SimTK::Vector_<SimTK::Vec3>& particleForces,
+    SimTK::Vector& mobilityForces) const
+{
+    // Whether a Force is disabled is looked up through the force subsystem,
+    // which is not safe to do concurrently.
+    _enabledForces.clear();
+    for (size_t i = 0; i < _forces.size(); ++i) {
+        if (!_forces[i]->isDisabled(state))
+            _enabledForces.push_back(_forces[i]);
+    }
+    if (_enabledForces.empty())
+        return;
+
+    // The Model's controls are computed on demand for all Actuators at once,
+    // so make sure that happens before the Forces ask for them.
+    if (_model->getNumControls() > 0)
+        _model->getControls(state);
+
+    const int numChunks = std::min(_numThreads, (int)_enabledForces.size());
+    _chunkBodyForces.resize(numChunks);
+    _chunkMobilityForces.resize(numChunks);
+    _chunkErrors.resize(numChunks);
+    for (int c = 0; c < numChunks; ++c) {
+        _chunkBodyForces[c].resize(bodyForces.size());
+        _chunkBodyForces[c].setToZero();
+        _chunkMobilityForces[c].resize(mobilityForces.size());
+        _chunkMobilityForces[c].setToZero();
+        _chunkErrors[c].clear();
+    }
+
+    if (!_executor)
+        _executor.reset(new SimTK::ParallelExecutor(_numThreads));
+    ForceChunkTask task(state, _enabledForces, numChunks, _chunkBodyForces,
+                        _chunkMobilityForces, _chunkErrors);
+    _executor->execute(task, numChunks);
+
+    for (int c = 0; c < numChunks; ++c) {
+        if (!_chunkErrors[c].empty())
+            throw Exception("ParallelForceAdapter: " + _chunkErrors[c]);
+    }
+
+    // Sum the chunks in a fixed order so that the result is reproducible.
+    for (int c = 0; c < numChunks; ++c) {
+        bodyForces += _chunkBodyForces[c];
+        mobilityForces += _chunkMobilityForces[c];
+    }
 }
\ No newline at end of file
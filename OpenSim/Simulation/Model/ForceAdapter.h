@@ -29,9 +29,13 @@
 #include "Actuator.h"
 
 #include <SimTKsimbody.h>
+#include <memory>
+#include <vector>
 
 namespace OpenSim {
 
+class Model;
+
 //=============================================================================
 //=============================================================================
 /**
@@ -46,13 +50,17 @@ class OSIMSIMULATION_API ForceAdapter : public SimTK::Force::Custom::Implementat
 //=============================================================================
 private:
     const Force* _force;
+    bool _computesForce;
 
 //=============================================================================
 // METHODS
 //=============================================================================
 public:
     // CONSTRUCTION AND DESTRUCTION
-    ForceAdapter(const Force& force);
+    /** If computesForce is false, the force is computed elsewhere (by a 
+    ParallelForceAdapter) and this adapter only provides its potential 
+    energy. **/
+    ForceAdapter(const Force& force, bool computesForce = true);
 
     // CALC FORCES (Called by Simbody)
     void calcForce(const SimTK::State& state,
@@ -69,6 +77,66 @@ public:
     // to OpenSim Force elements.
 };
 
+//=============================================================================
+//=============================================================================
+/**
+ * This computes a group of Forces, which must be safe to compute concurrently
+ * (see Force::canBeComputedConcurrently()), as a single SimTK::Force. The 
+ * enabled Forces are split into as many contiguous chunks as there are 
+ * threads. Each chunk is computed on a thread of a persistent thread pool and
+ * accumulates into its own body and mobility forces, and the chunks are then
+ * summed in order. The result therefore does not depend on the scheduling of 
+ * the threads, only on their number; it may differ in round-off from 
+ * computing the Forces one at a time.
+ *
+ * The Model creates one of these when Model::setNumForceThreads() is given
+ * more than one thread.
+ */
+class OSIMSIMULATION_API ParallelForceAdapter : 
+    public SimTK::Force::Custom::Implementation
+{
+//=============================================================================
+// DATA
+//=============================================================================
+private:
+    const Model* _model;
+    int _numThreads;
+    std::vector<const Force*> _forces;
+
+    // Created on first use, so that no threads are started for a System that
+    // is never realized.
+    mutable std::unique_ptr<SimTK::ParallelExecutor> _executor;
+
+    // Work space reused between calls to calcForce().
+    mutable std::vector<const Force*> _enabledForces;
+    mutable std::vector<SimTK::Vector_<SimTK::SpatialVec> > _chunkBodyForces;
+    mutable std::vector<SimTK::Vector> _chunkMobilityForces;
+    mutable std::vector<std::string> _chunkErrors;
+
+//=============================================================================
+// METHODS
+//=============================================================================
+public:
+    // CONSTRUCTION AND DESTRUCTION
+    ParallelForceAdapter(const Model& model, int numThreads);
+
+    /** Add a Force to the group. The Force's own ForceAdapter must not also
+    compute it. **/
+    void addForce(const Force& force);
+    int getNumForces() const { return (int)_forces.size(); }
+    int getNumThreads() const { return _numThreads; }
+
+    // CALC FORCES (Called by Simbody)
+    void calcForce(const SimTK::State& state,
+        SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+        SimTK::Vector_<SimTK::Vec3>& particleForces,
+        SimTK::Vector& mobilityForces) const override;
+
+    // The potential energy of each Force is provided by its own ForceAdapter.
+    SimTK::Real calcPotentialEnergy(const SimTK::State& state) const override
+    {   return 0; }
+};
+
 } // end of namespace OpenSim
 
 #endif // OPENSIM_FORCE_ADAPTER_H_
@@ -48,6 +48,100 @@ using SimTK::Vec3;
 
 static const Vec3 DefaultDefaultColor(.5,.5,.5); // boring gray 
 
+//_____________________________________________________________________________
+/*
+ * Append the indices of the q's that can change the poses of the given bodies
+ * relative to each other: those of the mobilizers between each body and the
+ * bodies' common ancestor.
+ */
+static void appendRelativePoseQIndices(const SimTK::State& s,
+        const SimbodyMatterSubsystem& matter,
+        const std::vector<MobilizedBodyIndex>& bodies,
+        std::vector<QIndex>& qIndices)
+{
+    if (bodies.empty())
+        return;
+
+    // The mobilized bodies from each body down to Ground.
+    std::vector<std::vector<MobilizedBodyIndex> > chains(bodies.size());
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        MobilizedBodyIndex b = bodies[i];
+        chains[i].push_back(b);
+        while (b != GroundIndex) {
+            b = matter.getMobilizedBody(b).getParentMobilizedBody()
+                      .getMobilizedBodyIndex();
+            chains[i].push_back(b);
+        }
+    }
+
+    // The common ancestor is the first body in one chain that is in all the
+    // others.
+    MobilizedBodyIndex ancestor = GroundIndex;
+    for (size_t k = 0; k < chains[0].size(); ++k) {
+        bool isCommon = true;
+        for (size_t i = 1; i < chains.size() && isCommon; ++i)
+            isCommon = std::find(chains[i].begin(), chains[i].end(), 
+                                 chains[0][k]) != chains[i].end();
+        if (isCommon) {
+            ancestor = chains[0][k];
+            break;
+        }
+    }
+
+    for (size_t i = 0; i < chains.size(); ++i) {
+        for (size_t k = 0; k < chains[i].size(); ++k) {
+            if (chains[i][k] == ancestor)
+                break;
+            const MobilizedBody& mobod = matter.getMobilizedBody(chains[i][k]);
+            const int firstQ = mobod.getFirstQIndex(s);
+            for (int j = 0; j < mobod.getNumQ(s); ++j)
+                qIndices.push_back(QIndex(firstQ + j));
+        }
+    }
+}
+
+//_____________________________________________________________________________
+/*
+ * Append the index of the q of a coordinate, if there is a coordinate.
+ */
+static void appendCoordinateQIndex(const SimTK::State& s,
+        const SimbodyMatterSubsystem& matter, const Coordinate* coordinate,
+        std::vector<QIndex>& qIndices)
+{
+    if (coordinate == NULL)
+        return;
+    const MobilizedBody& mobod = 
+        matter.getMobilizedBody(coordinate->getBodyIndex());
+    qIndices.push_back(QIndex(int(mobod.getFirstQIndex(s)) 
+                              + int(coordinate->getMobilizerQIndex())));
+}
+
+static void sortAndRemoveDuplicates(std::vector<QIndex>& qIndices)
+{
+    std::sort(qIndices.begin(), qIndices.end());
+    qIndices.erase(std::unique(qIndices.begin(), qIndices.end()), 
+                   qIndices.end());
+}
+
+static void storeQValues(const SimTK::State& s, 
+        const std::vector<QIndex>& qIndices, std::vector<double>& q)
+{
+    q.resize(qIndices.size());
+    for (size_t i = 0; i < qIndices.size(); ++i)
+        q[i] = s.getQ()[qIndices[i]];
+}
+
+static bool areQValuesUnchanged(const SimTK::State& s, 
+        const std::vector<QIndex>& qIndices, const std::vector<double>& q)
+{
+    if (q.size() != qIndices.size())
+        return false;
+    for (size_t i = 0; i < qIndices.size(); ++i)
+        if (s.getQ()[qIndices[i]] != q[i])
+            return false;
+    return true;
+}
+
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //=============================================================================
@@ -63,6 +157,17 @@ GeometryPath::GeometryPath() :
     constructProperties();
  }
 
+//_____________________________________________________________________________
+/*
+ * The properties of the path, its points or its wraps may have been edited,
+ * so a path computed earlier is not reused.
+ */
+void GeometryPath::extendFinalizeFromProperties()
+{
+    Super::extendFinalizeFromProperties();
+    _pathMemo.clear();
+}
+
 //_____________________________________________________________________________
 /*
  * Perform set up functions after model has been deserialized or copied.
@@ -77,6 +182,9 @@ void GeometryPath::extendConnectToModel(Model& aModel)
     if (&aModel == NULL)
         return;
 
+    // The path points, wrap objects and bodies may all be different now.
+    _pathMemo.clear();
+
     // Name the path points based on the current path
     // (i.e., the set of currently active points is numbered
     // 1, 2, 3, ...).
@@ -99,29 +207,34 @@ void GeometryPath::extendConnectToModel(Model& aModel)
 {
     Super::extendAddToSystem(system);
 
+    // q indices found for a previous system may not apply to this one.
+    _pathMemo.clear();
+
     // Allocate cache entries to save the current length and speed(=d/dt length)
     // of the path in the cache. Length depends only on q's so will be valid
     // after Position stage, speed requires u's also so valid at Velocity stage.
-    addCacheVariable<double>("length", 0.0, SimTK::Stage::Position);
-    addCacheVariable<double>("speed", 0.0, SimTK::Stage::Velocity);
+    // Keep handles to the cache variables, which are accessed (several times)
+    // on every force evaluation, to avoid looking them up by name.
+    _lengthCV = addCacheVariable<double>("length", 0.0, SimTK::Stage::Position);
+    _speedCV = addCacheVariable<double>("speed", 0.0, SimTK::Stage::Velocity);
     // Cache the set of points currently defining this path.
     Array<PathPoint *> pathPrototype;
-    addCacheVariable<Array<PathPoint *> >
+    _currentPathCV = addCacheVariable<Array<PathPoint *> >
         ("current_path", pathPrototype, SimTK::Stage::Position);
     // When displaying, cache the set of points to be used to draw the path.
-    addCacheVariable<Array<PathPoint *> >
+    _currentDisplayPathCV = addCacheVariable<Array<PathPoint *> >
         ("current_display_path", pathPrototype, SimTK::Stage::Position);
 
     // We consider this cache entry valid any time after it has been created
     // and first marked valid, and we won't ever invalidate it.
-    addCacheVariable<SimTK::Vec3>("color", get_default_color(), 
+    _colorCV = addCacheVariable<SimTK::Vec3>("color", get_default_color(), 
                                   SimTK::Stage::Topology);
 }
 
  void GeometryPath::extendInitStateFromProperties(SimTK::State& s) const
 {
     Super::extendInitStateFromProperties(s);
-    markCacheVariableValid(s, "color"); // it is OK at its default value
+    markCacheVariableValid(s, _colorCV); // it is OK at its default value
 }
 
 //------------------------------------------------------------------------------
@@ -228,7 +341,7 @@ const OpenSim::Array <PathPoint*> & GeometryPath::
 getCurrentPath(const SimTK::State& s)  const
 {
     computePath(s);   // compute checks if path needs to be recomputed
-    return getCacheVariableValue< Array<PathPoint*> >(s, "current_path");
+    return getCacheVariableValue(s, _currentPathCV);
 }
 
 // get the path as PointForceDirections directions 
@@ -411,7 +524,7 @@ getCurrentDisplayPath(const SimTK::State& s) const
 {
     // update the geometry to make sure the current display path is up to date.
     // updateGeometry(s);
-    return getCacheVariableValue<Array <PathPoint*> >(s, "current_display_path" );
+    return getCacheVariableValue(s, _currentDisplayPathCV);
 }
 
 //_____________________________________________________________________________
@@ -428,7 +541,7 @@ void GeometryPath::updateGeometry(const SimTK::State& s) const
     computePath(s);
 
     // If display path is current do not need to recompute it.
-    if (isCacheVariableValid(s, "current_display_path"))
+    if (isCacheVariableValid(s, _currentDisplayPathCV))
         return;
    
     // Updating the display path will also validate the current_display_path 
@@ -451,22 +564,22 @@ void GeometryPath::updateGeometry(const SimTK::State& s) const
 double GeometryPath::getLength( const SimTK::State& s) const
 {
     computePath(s);  // compute checks if path needs to be recomputed
-    return( getCacheVariableValue<double>(s, "length") );
+    return( getCacheVariableValue(s, _lengthCV) );
 }
 
 void GeometryPath::setLength( const SimTK::State& s, double length ) const
 {
-    setCacheVariableValue<double>(s, "length", length); 
+    setCacheVariableValue(s, _lengthCV, length); 
 }
 
 void GeometryPath::setColor(const SimTK::State& s, const SimTK::Vec3& color) const
 {
-    setCacheVariableValue<SimTK::Vec3>(s, "color", color);
+    setCacheVariableValue(s, _colorCV, color);
 }
 
 Vec3 GeometryPath::getColor(const SimTK::State& s) const
 {
-    return getCacheVariableValue<SimTK::Vec3>(s, "color");
+    return getCacheVariableValue(s, _colorCV);
 }
 
 //_____________________________________________________________________________
@@ -478,11 +591,11 @@ Vec3 GeometryPath::getColor(const SimTK::State& s) const
 double GeometryPath::getLengtheningSpeed( const SimTK::State& s) const
 {
     computeLengtheningSpeed(s);
-    return getCacheVariableValue<double>(s, "speed");
+    return getCacheVariableValue(s, _speedCV);
 }
 void GeometryPath::setLengtheningSpeed( const SimTK::State& s, double speed ) const
 {
-    setCacheVariableValue<double>(s, "speed", speed);    
+    setCacheVariableValue(s, _speedCV, speed);    
 }
 
 void GeometryPath::setPreScaleLength( const SimTK::State& s, double length ) {
@@ -810,6 +923,8 @@ void GeometryPath::preScale(const SimTK::State& s, const ScaleSet& aScaleSet)
  */
 void GeometryPath::scale(const SimTK::State& s, const ScaleSet& aScaleSet)
 {
+    _pathMemo.clear();
+
     for (int i = 0; i < get_PathPointSet().getSize(); i++)
     {
         const string& bodyName = get_PathPointSet().get(i).getBodyName();
@@ -835,6 +950,9 @@ void GeometryPath::scale(const SimTK::State& s, const ScaleSet& aScaleSet)
  */
 void GeometryPath::postScale(const SimTK::State& s, const ScaleSet& aScaleSet)
 {
+    // Wrap objects may have been scaled, so the last path cannot be reused.
+    _pathMemo.clear();
+
     // Recalculate the path. This will also update the geometry.
     // Done here since scale is invoked before bodies are scaled
     // so we may not have enough info to update (e.g. wrapping, via points)
@@ -850,18 +968,35 @@ void GeometryPath::postScale(const SimTK::State& s, const ScaleSet& aScaleSet)
 //_____________________________________________________________________________
 /*
  * Calculate the current path.
+ *
+ * The path only changes if one of the q's it depends on changes (see
+ * findPathDependencies()), so if none of them has changed since the path was
+ * last computed, that path and its length are reused. This happens, e.g.,
+ * when coordinates that the path does not cross are perturbed. Otherwise,
+ * applyWrapObjects() still reuses the wrap of each wrap object whose part of
+ * the path is unchanged.
  */
 void GeometryPath::computePath(const SimTK::State& s) const
 {
-    const SimTK::Stage& sg = s.getSystemStage();
-    
-    if (isCacheVariableValid(s, "current_path"))  {
+    if (isCacheVariableValid(s, _currentPathCV))  {
         return;
     }
 
-    // Clear the current path.
     Array<PathPoint*>& currentPath = 
-        updCacheVariableValue<Array<PathPoint*> >(s, "current_path");
+        updCacheVariableValue(s, _currentPathCV);
+
+    PathMemo& memo = _pathMemo;
+    if (!memo.dependenciesAreValid || havePathPointsOrWrapsChanged(false)) {
+        findPathDependencies(s);
+    } else if (memo.pathIsValid && !havePathPointsOrWrapsChanged(true)
+               && areQValuesUnchanged(s, memo.qIndices, memo.q)) {
+        currentPath = memo.path;
+        setLength(s, memo.length);
+        markCacheVariableValid(s, _currentPathCV);
+        return;
+    }
+
+    // Clear the current path.
     currentPath.setSize(0);
 
     // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
@@ -882,9 +1017,217 @@ void GeometryPath::computePath(const SimTK::State& s) const
     // Use the current path so far to check for intersection with wrap objects, 
     // which may add additional points to the path.
     applyWrapObjects(s, currentPath);
-    calcLengthAfterPathComputation(s, currentPath);
+    memo.length = calcLengthAfterPathComputation(s, currentPath);
+
+    // Remember the path for the next time it is computed.
+    memo.path = currentPath;
+    storeQValues(s, memo.qIndices, memo.q);
+    storePathPointsAndWraps();
+    memo.pathIsValid = true;
+
+    markCacheVariableValid(s, _currentPathCV);
+}
+
+//_____________________________________________________________________________
+/*
+ * Check whether the path points or the wrap objects (or their settings) are
+ * different from when storePathPointsAndWraps() was last called. A point or
+ * wrap object whose properties have been handed out for writing (e.g., by
+ * the GUI or a generated upd_ accessor) since it was last connected or 
+ * updated is always treated as changed.
+ *
+ * @param compareLocations Whether to also compare the locations of the path
+ * points in their bodies.
+ */
+bool GeometryPath::havePathPointsOrWrapsChanged(bool compareLocations) const
+{
+    const PathMemo& memo = _pathMemo;
+    const PathPointSet& points = get_PathPointSet();
+    const PathWrapSet& wraps = get_PathWrapSet();
+
+    if (   memo.points.size() != size_t(points.getSize())
+        || memo.wrapObjects.size() != size_t(wraps.getSize()))
+        return true;
+
+    for (int i = 0; i < points.getSize(); ++i) {
+        const PathPoint& point = points.get(i);
+        if (   memo.points[i] != &point 
+            || memo.bodies[i] != &point.getBody()
+            || memo.pointVersions[i] != point.getGeometryVersion()
+            || !point.isObjectUpToDateWithProperties()
+            || (compareLocations && memo.locations[i] != point.getLocation()))
+            return true;
+    }
+
+    for (int i = 0; i < wraps.getSize(); ++i) {
+        const PathWrap& ws = wraps.get(i);
+        const WrapObject* wo = ws.getWrapObject();
+        if (   memo.wrapObjects[i] != wo 
+            || (wo && memo.wrapVersions[i] != wo->getGeometryVersion())
+            || (wo && !wo->isObjectUpToDateWithProperties())
+            || memo.wrapSettings[4*i] != (wo && wo->getActive())
+            || memo.wrapSettings[4*i+1] != int(ws.getMethod())
+            || memo.wrapSettings[4*i+2] != ws.getStartPoint()
+            || memo.wrapSettings[4*i+3] != ws.getEndPoint())
+            return true;
+    }
+    return false;
+}
+
+//_____________________________________________________________________________
+/*
+ * Remember the path points, their locations and the wrap objects.
+ */
+void GeometryPath::storePathPointsAndWraps() const
+{
+    PathMemo& memo = _pathMemo;
+    const PathPointSet& points = get_PathPointSet();
+    const PathWrapSet& wraps = get_PathWrapSet();
+
+    memo.points.resize(points.getSize());
+    memo.bodies.resize(points.getSize());
+    memo.locations.resize(points.getSize());
+    memo.pointVersions.resize(points.getSize());
+    for (int i = 0; i < points.getSize(); ++i) {
+        const PathPoint& point = points.get(i);
+        memo.points[i] = &point;
+        memo.bodies[i] = &point.getBody();
+        memo.locations[i] = point.getLocation();
+        memo.pointVersions[i] = point.getGeometryVersion();
+    }
+
+    memo.wrapObjects.resize(wraps.getSize());
+    memo.wrapVersions.resize(wraps.getSize());
+    memo.wrapSettings.resize(4*wraps.getSize());
+    for (int i = 0; i < wraps.getSize(); ++i) {
+        const PathWrap& ws = wraps.get(i);
+        const WrapObject* wo = ws.getWrapObject();
+        memo.wrapObjects[i] = wo;
+        memo.wrapVersions[i] = (wo ? wo->getGeometryVersion() : 0);
+        memo.wrapSettings[4*i] = (wo && wo->getActive());
+        memo.wrapSettings[4*i+1] = int(ws.getMethod());
+        memo.wrapSettings[4*i+2] = ws.getStartPoint();
+        memo.wrapSettings[4*i+3] = ws.getEndPoint();
+    }
+}
+
+//_____________________________________________________________________________
+/*
+ * Find the q's that the path depends on. The length of the path depends only
+ * on the poses of its bodies (those of its path points and wrap objects)
+ * relative to each other, and on the coordinates of its conditional and
+ * moving path points. The wrap of a wrap object depends on the poses of the
+ * bodies of the path points in its range, its own body, and the bodies of
+ * the other wrap objects (whose wrap points may be in its range).
+ */
+void GeometryPath::findPathDependencies(const SimTK::State& s) const
+{
+    const SimbodyMatterSubsystem& matter = getModel().getMatterSubsystem();
+    const PathPointSet& points = get_PathPointSet();
+    const PathWrapSet& wraps = get_PathWrapSet();
+    PathMemo& memo = _pathMemo;
+
+    std::vector<MobilizedBodyIndex> wrapBodies;
+    for (int i = 0; i < wraps.getSize(); ++i) {
+        const WrapObject* wo = wraps.get(i).getWrapObject();
+        if (wo)
+            wrapBodies.push_back(wo->getBody().getMobilizedBodyIndex());
+    }
+
+    std::vector<MobilizedBodyIndex> bodies = wrapBodies;
+    memo.qIndices.clear();
+    for (int i = 0; i < points.getSize(); ++i) {
+        const PathPoint& point = points.get(i);
+        bodies.push_back(point.getBody().getMobilizedBodyIndex());
+        if (const ConditionalPathPoint* cpp = 
+                dynamic_cast<const ConditionalPathPoint*>(&point)) {
+            appendCoordinateQIndex(s, matter, cpp->getCoordinate(), 
+                                   memo.qIndices);
+        } else if (const MovingPathPoint* mpp = 
+                dynamic_cast<const MovingPathPoint*>(&point)) {
+            appendCoordinateQIndex(s, matter, mpp->getXCoordinate(), 
+                                   memo.qIndices);
+            appendCoordinateQIndex(s, matter, mpp->getYCoordinate(), 
+                                   memo.qIndices);
+            appendCoordinateQIndex(s, matter, mpp->getZCoordinate(), 
+                                   memo.qIndices);
+        }
+    }
+    appendRelativePoseQIndices(s, matter, bodies, memo.qIndices);
+    sortAndRemoveDuplicates(memo.qIndices);
+
+    memo.wraps.assign(wraps.getSize(), WrapMemo());
+    for (int i = 0; i < wraps.getSize(); ++i) {
+        const PathWrap& ws = wraps.get(i);
+        const WrapObject* wo = ws.getWrapObject();
+        if (wo == NULL)
+            continue;
+        // The range of path points is 1-based (see applyWrapObjects()).
+        const int wrapStart = (ws.getStartPoint() < 1 
+                                    ? 0 : ws.getStartPoint() - 1);
+        const int wrapEnd   = (ws.getEndPoint() < 1 
+                                    ? points.getSize() - 1 
+                                    : ws.getEndPoint() - 1);
+        std::vector<MobilizedBodyIndex> wrapRangeBodies = wrapBodies;
+        for (int j = wrapStart; j <= wrapEnd && j < points.getSize(); ++j)
+            wrapRangeBodies.push_back(
+                    points.get(j).getBody().getMobilizedBodyIndex());
+        appendRelativePoseQIndices(s, matter, wrapRangeBodies, 
+                                   memo.wraps[i].qIndices);
+        sortAndRemoveDuplicates(memo.wraps[i].qIndices);
+    }
 
-    markCacheVariableValid(s, "current_path");
+    memo.q.clear();
+    memo.pathIsValid = false;
+    memo.dependenciesAreValid = true;
+    storePathPointsAndWraps();
+}
+
+//_____________________________________________________________________________
+/*
+ * Check whether the part of the path from path[aStart] to path[aEnd], and the
+ * q's the wrap depends on, are the same as when store() was last called.
+ */
+bool GeometryPath::WrapMemo::matches(const SimTK::State& s, 
+        const Array<PathPoint*>& path, int aStart, int aEnd) const
+{
+    if (!isValid || points.size() != size_t(aEnd - aStart + 1))
+        return false;
+    for (int j = aStart; j <= aEnd; ++j) {
+        const PathPoint* point = path.get(j);
+        const size_t k = size_t(j - aStart);
+        if (   points[k] != point 
+            || bodies[k] != &point->getBody()
+            || locations[k] != point->getLocation())
+            return false;
+    }
+    return areQValuesUnchanged(s, qIndices, q);
+}
+
+//_____________________________________________________________________________
+/*
+ * Remember the part of the path from path[aStart] to path[aEnd], and the
+ * wrap that was found for it.
+ */
+void GeometryPath::WrapMemo::store(const SimTK::State& s, 
+        const Array<PathPoint*>& path, int aStart, int aEnd, 
+        const WrapResult& aBestWrap, int aResult)
+{
+    const int n = aEnd - aStart + 1;
+    points.resize(n);
+    bodies.resize(n);
+    locations.resize(n);
+    for (int j = aStart; j <= aEnd; ++j) {
+        const PathPoint* point = path.get(j);
+        points[j - aStart] = point;
+        bodies[j - aStart] = &point->getBody();
+        locations[j - aStart] = point->getLocation();
+    }
+    storeQValues(s, qIndices, q);
+    bestWrap = aBestWrap;
+    start = aStart;
+    result = aResult;
+    isValid = true;
 }
 
 //_____________________________________________________________________________
@@ -893,7 +1236,7 @@ void GeometryPath::computePath(const SimTK::State& s) const
  */
 void GeometryPath::computeLengtheningSpeed(const SimTK::State& s) const
 {
-    if (isCacheVariableValid(s, "speed"))
+    if (isCacheVariableValid(s, _speedCV))
         return;
 
     SimTK::Vec3 posRelative, velRelative;
@@ -1052,13 +1395,28 @@ applyWrapObjects(const SimTK::State& s, Array<PathPoint*>& path) const
                 if (start == -1 || end == -1) // this should never happen
                     return;
 
+                // If neither this range of points nor the q's this wrap 
+                // depends on have changed since the wrap object was last 
+                // applied, the wrap is the same as then.
+                WrapMemo* memo = (order[i] < (int)_pathMemo.wraps.size()
+                                    ? &_pathMemo.wraps[order[i]] : NULL);
+                const bool reuseWrap = memo && memo->matches(s, path, start, end);
+                if (reuseWrap) {
+                    best_wrap = memo->bestWrap;
+                    best_wrap.startPoint += start - memo->start;
+                    best_wrap.endPoint   += start - memo->start;
+                    result[i] = memo->result;
+                    if (best_wrap.wrap_pts.getSize() > 0)
+                        ws.setPreviousWrap(best_wrap);
+                }
+
                 // You now have indices into _currentPath (which is a list of 
                 // all currently active points, including wrap points) that 
                 // represent the used-defined range of points to consider for 
                 // wrapping over this wrap object. Check each path segment in 
                 // this range, choosing the best wrap as the one that changes 
                 // the path segment length the least:
-                for (int pt1 = start; pt1 < end; pt1++)
+                for (int pt1 = start; !reuseWrap && pt1 < end; pt1++)
                 {
                     const int pt2 = pt1 + 1;
 
@@ -1114,6 +1472,9 @@ applyWrapObjects(const SimTK::State& s, Array<PathPoint*>& path) const
                     }
                 }
 
+                if (memo && !reuseWrap)
+                    memo->store(s, path, start, end, best_wrap, result[i]);
+
                 // Deallocate previous wrapping points if necessary.
                 ws.getWrapPoint(1).getWrapPath().setSize(0);
 
@@ -1270,7 +1631,7 @@ computeMomentArm(const SimTK::State& s, const Coordinate& aCoord) const
 void GeometryPath::updateDisplayPath(const SimTK::State& s) const
 {
     Array<PathPoint*>& currentDisplayPath = 
-        updCacheVariableValue<Array<PathPoint*> >(s, "current_display_path");
+        updCacheVariableValue(s, _currentDisplayPathCV);
     // Clear the current display path. Delete all path points
     // that have a NULL path pointer. This means that they were
     // created by an earlier call to updateDisplayPath() and are
@@ -1285,7 +1646,7 @@ void GeometryPath::updateDisplayPath(const SimTK::State& s) const
     currentDisplayPath.setSize(0);
 
     const Array<PathPoint*>& currentPath =  
-        getCacheVariableValue<Array<PathPoint*> >(s, "current_path");
+        getCacheVariableValue(s, _currentPathCV);
     for (int i=0; i<currentPath.getSize(); i++) {
         PathPoint* mp = currentPath.get(i);
         PathWrapPoint* mwp = dynamic_cast<PathWrapPoint*>(mp);
@@ -1307,5 +1668,5 @@ void GeometryPath::updateDisplayPath(const SimTK::State& s) const
         currentDisplayPath.append(mp);
     }
 
-    markCacheVariableValid(s, "current_display_path");
+    markCacheVariableValid(s, _currentDisplayPathCV);
 }
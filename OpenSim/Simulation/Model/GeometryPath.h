@@ -30,6 +30,7 @@
 #include <OpenSim/Common/ScaleSet.h>
 #include "PathPointSet.h"
 #include <OpenSim/Simulation/Wrap/PathWrapSet.h>
+#include <OpenSim/Simulation/Wrap/WrapResult.h>
 #include <OpenSim/Simulation/MomentArmSolver.h>
 
 
@@ -43,7 +44,6 @@
 namespace OpenSim {
 
 class Coordinate;
-class WrapResult;
 class WrapObject;
 class PointForceDirection;
 
@@ -78,6 +78,68 @@ private:
     // but we cannot simply use a unique_ptr because we want the pointer to be
     // cleared on copy.
     SimTK::ResetOnCopy<std::unique_ptr<MomentArmSolver> > _maSolver;
+
+    // What a wrap object's part of the path looked like when the wrap object
+    // was last applied, and the resulting wrap, so that the wrap can be 
+    // reused while neither the points nor the q's it depends on change.
+    struct WrapMemo {
+        WrapMemo() : start(-1), result(0), isValid(false) {}
+        bool matches(const SimTK::State& s, const Array<PathPoint*>& path,
+                     int start, int end) const;
+        void store(const SimTK::State& s, const Array<PathPoint*>& path,
+                   int start, int end, const WrapResult& bestWrap, 
+                   int result);
+
+        std::vector<SimTK::QIndex> qIndices;
+        std::vector<double> q;
+        std::vector<const PathPoint*> points;
+        std::vector<const PhysicalFrame*> bodies;
+        std::vector<SimTK::Vec3> locations;
+        WrapResult bestWrap;
+        int start;
+        int result;
+        bool isValid;
+    };
+
+    // The most recently computed path and what it depended on. Path points 
+    // and wrap points keep their locations in this object rather than in the
+    // State, so this describes the path they currently represent. Changes to
+    // the path points and wrap objects are detected through their geometry
+    // versions. See computePath().
+    struct PathMemo {
+        PathMemo() : length(0.0), dependenciesAreValid(false), 
+                     pathIsValid(false) {}
+        void clear() { dependenciesAreValid = false; pathIsValid = false; }
+
+        // The q's that change the path: those of the mobilizers that move 
+        // the path's bodies relative to each other, and those of the 
+        // coordinates of conditional and moving path points.
+        std::vector<SimTK::QIndex> qIndices;
+        std::vector<double> q;
+        // The path points and wrap objects the dependencies were found for.
+        std::vector<const PathPoint*> points;
+        std::vector<const PhysicalFrame*> bodies;
+        std::vector<SimTK::Vec3> locations;
+        std::vector<int> pointVersions;
+        std::vector<const WrapObject*> wrapObjects;
+        std::vector<int> wrapVersions;
+        // active, method, start and end point
+        std::vector<int> wrapSettings;
+        Array<PathPoint*> path;
+        double length;
+        std::vector<WrapMemo> wraps;
+        bool dependenciesAreValid;
+        bool pathIsValid;
+    };
+    mutable SimTK::ResetOnCopy<PathMemo> _pathMemo;
+
+    // Handles to the cache variables added in extendAddToSystem(); their
+    // cache entries are allocated when the System's topology is realized.
+    mutable CacheVariableHandle<double> _lengthCV;
+    mutable CacheVariableHandle<double> _speedCV;
+    mutable CacheVariableHandle<Array<PathPoint*> > _currentPathCV;
+    mutable CacheVariableHandle<Array<PathPoint*> > _currentDisplayPathCV;
+    mutable CacheVariableHandle<SimTK::Vec3> _colorCV;
     
 //=============================================================================
 // METHODS
@@ -188,6 +250,7 @@ public:
 
 protected:
     // ModelComponent interface.
+    void extendFinalizeFromProperties() override;
     void extendConnectToModel(Model& aModel) override;
     void extendInitStateFromProperties(SimTK::State& s) const override;
     void extendAddToSystem(SimTK::MultibodySystem& system) const override;
@@ -203,6 +266,9 @@ protected:
 private:
 
     void computePath(const SimTK::State& s ) const;
+    bool havePathPointsOrWrapsChanged(bool compareLocations) const;
+    void storePathPointsAndWraps() const;
+    void findPathDependencies(const SimTK::State& s) const;
     void computeLengtheningSpeed(const SimTK::State& s) const;
     void applyWrapObjects(const SimTK::State& s, Array<PathPoint*>& path ) const;
     double calcPathLengthChange(const SimTK::State& s, const WrapObject& wo, 
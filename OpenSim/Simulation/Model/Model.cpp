@@ -28,6 +28,7 @@
 
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/XMLDocument.h>
+#include <OpenSim/Common/BinaryIO.h>
 #include <OpenSim/Common/ScaleSet.h>
 #include <OpenSim/Common/Storage.h>
 #include <OpenSim/Simulation/Control/Controller.h>
@@ -65,6 +66,7 @@
 #include "ProbeSet.h"
 #include "ComponentSet.h"
 #include <iostream>
+#include <fstream>
 #include <string>
 #include <cmath>
 
@@ -91,6 +93,7 @@ Model::Model() :
     _coordinateSet(CoordinateSet()),
     _useVisualizer(false),
     _allControllersEnabled(true),
+    _numForceThreads(1),
     _workingState()
 {
     constructInfrastructure();
@@ -108,6 +111,7 @@ Model::Model(const string &aFileName, const bool finalize) :
     _coordinateSet(CoordinateSet()),
     _useVisualizer(false),
     _allControllersEnabled(true),
+    _numForceThreads(1),
     _workingState()
 {   
     constructInfrastructure();
@@ -190,6 +194,64 @@ void Model::updateFromXMLNode(SimTK::Xml::Element& aNode, int versionNumber)
      setDefaultProperties();
 }
 
+void Model::updateFromBinary(std::istream& in)
+{
+    Super::updateFromBinary(in);
+    setDefaultProperties();
+}
+
+//_____________________________________________________________________________
+// A snapshot starts with a tag identifying the file, the version of the
+// snapshot layout and the XML document version of this build of OpenSim,
+// followed by the model as written by Object::writeBinary().
+static const char SnapshotTag[] = "OSIMSNAP";
+static const int SnapshotFormatVersion = 1;
+
+void Model::printSnapshot(const string& fileName) const
+{
+    ofstream out(fileName.c_str(), ios::out | ios::binary);
+    if (!out)
+        throw Exception("Model::printSnapshot(): could not open " + fileName,
+                        __FILE__, __LINE__);
+    out.write(SnapshotTag, sizeof(SnapshotTag) - 1);
+    BinaryIO::write(out, SnapshotFormatVersion);
+    BinaryIO::write(out, XMLDocument::getLatestVersion());
+    writeBinary(out);
+    if (!out)
+        throw Exception("Model::printSnapshot(): failed to write " + fileName,
+                        __FILE__, __LINE__);
+}
+
+void Model::readSnapshot(const string& fileName)
+{
+    ifstream in(fileName.c_str(), ios::in | ios::binary);
+    if (!in)
+        throw Exception("Model::readSnapshot(): could not open " + fileName,
+                        __FILE__, __LINE__);
+    char tag[sizeof(SnapshotTag) - 1];
+    in.read(tag, sizeof(tag));
+    if (in.gcount() != (streamsize)sizeof(tag) ||
+            string(tag, sizeof(tag)) != string(SnapshotTag, sizeof(tag)))
+        throw Exception("Model::readSnapshot(): " + fileName 
+            + " is not a model snapshot.", __FILE__, __LINE__);
+
+    int formatVersion, documentVersion;
+    BinaryIO::read(in, formatVersion);
+    BinaryIO::read(in, documentVersion);
+    if (formatVersion != SnapshotFormatVersion ||
+            documentVersion != XMLDocument::getLatestVersion())
+        throw Exception("Model::readSnapshot(): " + fileName 
+            + " was written by a different version of OpenSim; "
+            "regenerate it from the .osim file.", __FILE__, __LINE__);
+
+    readBinary(in);
+    finalizeFromProperties();
+
+    _fileName = fileName;
+    cout << "Loaded model " << getName() << " from snapshot " 
+         << getInputFileName() << endl;
+}
+
 
 //=============================================================================
 // CONSTRUCTION METHODS
@@ -202,6 +264,7 @@ void Model::setNull()
 {
     _useVisualizer = false;
     _allControllersEnabled = true;
+    _numForceThreads = 1;
 
     _validationLog="";
 
@@ -302,6 +365,9 @@ SimTK::State& Model::initializeState() {
     // Process the modified modeling option.
     getMultibodySystem().realizeModel(_workingState);
 
+    // The state variables are now allocated, so record where they are in Y.
+    updateStateVariableSystemIndices(_workingState);
+
     // Invoke the ModelComponent interface for initializing the state.
     initStateFromProperties(_workingState);
 
@@ -810,6 +876,28 @@ void Model::extendAddToSystem(SimTK::MultibodySystem& system) const
         Stage::Velocity, Stage::Acceleration);
 
     mutableThis->_modelControlsIndex = modelControls.getSubsystemMeasureIndex();
+
+    // Forces that can be computed concurrently add themselves to this in
+    // Force::extendAddToSystem(), which comes after this.
+    mutableThis->_parallelForces.clear();
+    if (_numForceThreads > 1) {
+        ParallelForceAdapter* parallelForces = 
+            new ParallelForceAdapter(*this, _numForceThreads);
+        SimTK::Force::Custom(mutableThis->updForceSubsystem(), parallelForces);
+        mutableThis->_parallelForces = parallelForces;
+    }
+}
+
+//_____________________________________________________________________________
+/*
+ * Set the number of threads on which to compute concurrent Forces.
+ */
+void Model::setNumForceThreads(int numThreads)
+{
+    if (numThreads < 1)
+        throw Exception("Model::setNumForceThreads: the number of threads "
+                        "must be at least 1.", __FILE__, __LINE__);
+    _numForceThreads = numThreads;
 }
 
 
@@ -2129,15 +2217,17 @@ SimTK::Vec3 Model::calcMassCenterAcceleration(const SimTK::State &s) const
 
 void Model::constructOutputs()
 {
-    //return the position of the center of mass
+   // The center of mass outputs sum over all bodies, so their values are
+   // kept in the State's cache.
+   //return the position of the center of mass
    constructOutput<SimTK::Vec3>("com_position",
-       std::bind(&Model::calcMassCenterPosition,this,std::placeholders::_1), SimTK::Stage::Position);
+       std::bind(&Model::calcMassCenterPosition,this,std::placeholders::_1), SimTK::Stage::Position, true);
    //return the velocity of the center of mass 
    constructOutput<SimTK::Vec3>("com_velocity",
-       std::bind(&Model::calcMassCenterVelocity,this,std::placeholders::_1), SimTK::Stage::Velocity);
+       std::bind(&Model::calcMassCenterVelocity,this,std::placeholders::_1), SimTK::Stage::Velocity, true);
    //return the acceleration of the center of mass
    constructOutput<SimTK::Vec3>("com_acceleration",
-       std::bind(&Model::calcMassCenterAcceleration,this,std::placeholders::_1), SimTK::Stage::Acceleration);
+       std::bind(&Model::calcMassCenterAcceleration,this,std::placeholders::_1), SimTK::Stage::Acceleration, true);
     
 }
 
@@ -77,6 +77,7 @@ class ControllerSet;
 class ModelDisplayHints;
 class ComponentSet;
 class FrameSet;
+class ParallelForceAdapter;
 
 #ifdef SWIG
     #ifdef OSIMSIMULATION_API
@@ -198,6 +199,24 @@ public:
     **/
     explicit Model(const std::string& filename, bool finalize=true) SWIG_DECLARE_EXCEPTION;
 
+    /** Write a binary snapshot of this %Model to a file. The snapshot holds
+    the values of all the properties of the %Model and of its components,
+    including the connectee names of their connectors, and is much faster to
+    read than the model's XML file because no text has to be parsed and no
+    version updates have to be made. Snapshots can only be read by the same
+    version of %OpenSim on the same kind of machine that wrote them; keep the
+    .osim file and regenerate the snapshot from it when that changes.
+    @see readSnapshot() **/
+    void printSnapshot(const std::string& fileName) const;
+
+    /** Replace the properties of this %Model with those read from a snapshot
+    written by printSnapshot(), then finalize the %Model as the constructor
+    from a model file does. The %Model is then equivalent to the one that was
+    written; call initSystem() to build its System and connect it as usual.
+    Throws if the file is not a snapshot or was written by a different
+    version of %OpenSim. **/
+    void readSnapshot(const std::string& fileName) SWIG_DECLARE_EXCEPTION;
+
     /**
      * Perform some set up functions that happen after the
      * object has been deserialized. TODO: this method is
@@ -251,6 +270,18 @@ public:
     take effect at the next call to initSystem() on this %Model. **/
     bool getUseVisualizer() const {return _useVisualizer;}
 
+    /** %Set the number of threads on which to compute the Forces that can be
+    computed concurrently (see Force::canBeComputedConcurrently(), e.g., 
+    PathActuator and Thelen2003Muscle). The other Forces are still computed
+    one at a time. The result is the same every time for a given number of
+    threads, but may differ in round-off from computing all Forces one at a
+    time. The default, 1, computes all Forces one at a time. This takes 
+    effect at the next call to initSystem(). **/
+    void setNumForceThreads(int numThreads);
+    /** Return the number of threads on which Forces are computed.
+    @see setNumForceThreads() **/
+    int getNumForceThreads() const {return _numForceThreads;}
+
     /** Test whether a ModelVisualizer has been created for this Model. Even
     if visualization has been requested there will be no visualizer present
     until initSystem() has been successfully invoked. Use this method prior
@@ -915,6 +946,8 @@ public:
     /** Override of the default implementation to account for versioning. */
     void updateFromXMLNode(SimTK::Xml::Element& aNode, 
                            int versionNumber = -1) override;
+    /** Override to set the units from the properties that were read. */
+    void updateFromBinary(std::istream& in) override;
     /**@}**/
 
     //--------------------------------------------------------------------------
@@ -972,6 +1005,8 @@ private:
 
     // To provide access to private _modelComponents member.
     friend class Component; 
+    // To provide access to private _parallelForces member.
+    friend class Force;
 
 //==============================================================================
 // DATA MEMBERS
@@ -1030,6 +1065,10 @@ private:
     // Global flag used to disable all Controllers.
     bool _allControllersEnabled;
 
+    // If this is greater than 1 when initSystem() is called, Forces that can
+    // be computed concurrently are computed together on this many threads.
+    int _numForceThreads;
+
 
     //                      SIMBODY MULTIBODY SYSTEM
     // We dynamically allocate these because they are not available at
@@ -1048,6 +1087,9 @@ private:
         _forceSubsystem;
     SimTK::ResetOnCopy<std::unique_ptr<SimTK::GeneralContactSubsystem>>
         _contactSubsystem;
+    // Computes the Forces that can be computed concurrently, if more than
+    // one force thread was requested. Owned by the force subsystem.
+    SimTK::ReferencePtr<ParallelForceAdapter> _parallelForces;
 
     // System-dependent objects.
 
@@ -238,6 +238,7 @@ void MovingPathPoint::setXCoordinate( const SimTK::State& s, Coordinate& aCoordi
     if (&aCoordinate != _xCoordinate) {
        _xCoordinate = &aCoordinate;
        _xCoordinateName = _xCoordinate->getName();
+       ++_geometryVersion;
     }
 }
 
@@ -252,6 +253,7 @@ void MovingPathPoint::setYCoordinate( const SimTK::State& s, Coordinate& aCoordi
     if (&aCoordinate != _yCoordinate) {
        _yCoordinate = &aCoordinate;
        _yCoordinateName = _yCoordinate->getName();
+       ++_geometryVersion;
     }
 }
 
@@ -266,6 +268,7 @@ void MovingPathPoint::setZCoordinate( const SimTK::State& s, Coordinate& aCoordi
     if (&aCoordinate != _zCoordinate) {
        _zCoordinate = &aCoordinate;
        _zCoordinateName = _zCoordinate->getName();
+       ++_geometryVersion;
     }
 }
 
@@ -278,7 +281,7 @@ void MovingPathPoint::setZCoordinate( const SimTK::State& s, Coordinate& aCoordi
 void MovingPathPoint::setXFunction( const SimTK::State& s, OpenSim::Function& aFunction)
 {
     _xLocation = &aFunction;
-
+    ++_geometryVersion;
 }
 
 //_____________________________________________________________________________
@@ -290,7 +293,7 @@ void MovingPathPoint::setXFunction( const SimTK::State& s, OpenSim::Function& aF
 void MovingPathPoint::setYFunction( const SimTK::State& s, OpenSim::Function& aFunction)
 {
     _yLocation = &aFunction;
-
+    ++_geometryVersion;
 }
 
 //_____________________________________________________________________________
@@ -302,7 +305,7 @@ void MovingPathPoint::setYFunction( const SimTK::State& s, OpenSim::Function& aF
 void MovingPathPoint::setZFunction( const SimTK::State& s, OpenSim::Function& aFunction)
 {
     _zLocation = &aFunction;
-
+    ++_geometryVersion;
 }
 
 //_____________________________________________________________________________
@@ -781,6 +781,15 @@ protected:
     double _pennationAngleAtOptimal;
     double _tendonSlackLength;
 
+    /** Handles to the cached muscle calculation data structures added in
+        extendAddToSystem(); their cache entries are allocated when the
+        System's topology is realized. */
+    mutable CacheVariableHandle<MuscleLengthInfo> _lengthInfoCV;
+    mutable CacheVariableHandle<FiberVelocityInfo> _velInfoCV;
+    mutable CacheVariableHandle<MuscleDynamicsInfo> _dynamicsInfoCV;
+    mutable CacheVariableHandle<MusclePotentialEnergyInfo> 
+        _potentialEnergyInfoCV;
+
 //=============================================================================
 };  // END of class Muscle
 //=============================================================================
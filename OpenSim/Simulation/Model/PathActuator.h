@@ -99,6 +99,11 @@ public:
                                SimTK::Vector_<SimTK::SpatialVec>& bodyForces, 
                                SimTK::Vector& mobilityForces) const override;
 
+    /** A PathActuator only writes its own cache variables and those of its
+    GeometryPath. Subclasses are not covered and must opt in themselves. */
+    bool canBeComputedConcurrently() const override
+    {   return getConcreteClassName() == "PathActuator"; }
+
     //--------------------------------------------------------------------------
     // COMPUTATIONS
     //--------------------------------------------------------------------------
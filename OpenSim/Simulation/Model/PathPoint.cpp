@@ -116,6 +116,7 @@ void PathPoint::setNull()
 {
     _body = NULL;
     _path = NULL;
+    _geometryVersion = 0;
 }
 
 //_____________________________________________________________________________
@@ -143,6 +144,8 @@ void PathPoint::connectToModelAndPath(const Model& aModel, GeometryPath& aPath)
 {
     _path = &aPath;
     _model  = &aModel;
+    ++_geometryVersion;
+    setObjectIsUpToDateWithProperties();
 
     if (_bodyName == aModel.getGround().getName()){
         _body = &const_cast<Model*>(&aModel)->updGround();
@@ -169,6 +172,8 @@ void PathPoint::updateGeometry()
     Transform position;
     position.setP(_location);
     //updDisplayer()->setTransform(position);
+    ++_geometryVersion;
+    setObjectIsUpToDateWithProperties();
 }
 //=============================================================================
 // OPERATORS
@@ -202,6 +207,7 @@ void PathPoint::setBody(const PhysicalFrame& aBody)
 
     _body = &aBody;
     _bodyName = aBody.getName();
+    ++_geometryVersion;
 }
 
 //_____________________________________________________________________________
@@ -243,6 +249,7 @@ void PathPoint::changeBodyPreserveLocation(const SimTK::State& s, PhysicalFrame&
 void PathPoint::setLocation( const SimTK::State& s, const SimTK::Vec3& aLocation)
 {
     _location = aLocation;
+    ++_geometryVersion;
 }
 
 //_____________________________________________________________________________
@@ -256,6 +263,7 @@ void PathPoint::setLocation( const SimTK::State& s, int aCoordIndex, double aLoc
 {
     if (aCoordIndex >= 0 && aCoordIndex <= 2)
         _location[aCoordIndex] = aLocation;
+    ++_geometryVersion;
 }
 
 //_____________________________________________________________________________
@@ -79,6 +79,9 @@ protected:
 
     GeometryPath* _path; // the path that owns this location point
 
+    // Changed whenever the point is modified through its methods.
+    int _geometryVersion;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -102,7 +105,7 @@ public:
     SimTK::Vec3& getLocation()  { return _location; }
 
     const double& getLocationCoord(int aXYZ) const { assert(aXYZ>=0 && aXYZ<=2); return _location[aXYZ]; }
-    void setLocationCoord(int aXYZ, double aValue) { assert(aXYZ>=0 && aXYZ<=2); _location[aXYZ]=aValue; }
+    void setLocationCoord(int aXYZ, double aValue) { assert(aXYZ>=0 && aXYZ<=2); _location[aXYZ]=aValue; ++_geometryVersion; }
     // A variant that uses basic types for use by GUI
 
     void setLocation( const SimTK::State& s, const SimTK::Vec3& aLocation);
@@ -134,6 +137,15 @@ public:
 
     virtual void updateGeometry();
 
+    /** A number that changes whenever the body, the location or the
+    conditions of this point are changed through its methods, including
+    updateGeometry(); update() does not change it. A GeometryPath uses it to
+    tell whether a path it computed earlier is still valid. Editing a
+    property (e.g., from the GUI) clears isObjectUpToDateWithProperties()
+    instead, and a GeometryPath recomputes its path until updateGeometry()
+    or connectToModelAndPath() is called again. */
+    int getGeometryVersion() const { return _geometryVersion; }
+
     // Utility
     static PathPoint* makePathPointOfType(PathPoint* aPoint, const std::string& aNewTypeName);
     static void deletePathPoint(PathPoint* aPoint) { if (aPoint) delete aPoint; }
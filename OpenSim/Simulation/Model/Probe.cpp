@@ -122,8 +122,9 @@ void Probe::constructProperties(void)
 
 void Probe::constructOutputs()
 {
+    // Cached, since reporters may ask for the outputs several times per step.
     constructOutput<SimTK::Vector>("probe_outputs", &Probe::getProbeOutputs,
-            Stage::Report);
+            Stage::Report, true);
 }
 
 //_____________________________________________________________________________
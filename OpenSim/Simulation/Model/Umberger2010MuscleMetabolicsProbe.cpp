@@ -28,6 +28,7 @@
 //=============================================================================
 #include "Umberger2010MuscleMetabolicsProbe.h"
 #include <OpenSim/Simulation/Model/Muscle.h>
+#include <algorithm>
 //#define DEBUG_METABOLICS
 
 using namespace std;
@@ -79,6 +80,8 @@ void Umberger2010MuscleMetabolicsProbe::setNull()
     setReferences("Umberger, B. R. (2010). Stance and swing phase costs in "
     "human walking. J R Soc Interface 7, 1329-40.");
     _muscleMap.clear();
+    _muscles.clear();
+    _musclesConnected = false;
 }
 
 //_____________________________________________________________________________
@@ -129,6 +132,7 @@ void Umberger2010MuscleMetabolicsProbe::extendConnectToModel(Model& aModel)
         connectIndividualMetabolicMuscle(aModel, 
             upd_Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet()[i]);
     }
+    gatherMuscles();
 }
 
 //_____________________________________________________________________________
@@ -218,6 +222,42 @@ void Umberger2010MuscleMetabolicsProbe::connectIndividualMetabolicMuscle(
     mm.setMuscleMass();
 }
 
+//_____________________________________________________________________________
+/**
+ * Gather the muscles of the MetabolicMuscleParameterSet, in its order.
+ */
+void Umberger2010MuscleMetabolicsProbe::gatherMuscles()
+{
+    _muscles.clear();
+    _musclesConnected = false;
+
+    const Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet& mmSet =
+        get_Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet();
+    for (int i=0; i<mmSet.getSize(); ++i) {
+        if (mmSet[i].getMuscle() == NULL) {
+            _muscles.clear();
+            return;
+        }
+        _muscles.push_back(SimTK::ReferencePtr<const Muscle>(
+            mmSet[i].getMuscle()));
+    }
+    _musclesConnected = true;
+}
+
+//_____________________________________________________________________________
+void Umberger2010MuscleMetabolicsProbe::MuscleStateArrays::resize(
+    int numMuscles)
+{
+    for (std::vector<double>* values : 
+            {&muscleMass, &ratioSlowTwitchFibers, &optimalFiberLength,
+             &alphaShorteningFastTwitch, &alphaShorteningSlowTwitch,
+             &activation, &excitation, &activeFiberForce, &normFiberLength, 
+             &fiberVelocity, &activeForceLengthMultiplier, 
+             &activationDependence, &slowTwitchRatio, 
+             &AMdot, &Sdot, &Wdot, &Edot})
+        values->resize(numMuscles);
+}
+
 
 
 
@@ -233,8 +273,7 @@ void Umberger2010MuscleMetabolicsProbe::connectIndividualMetabolicMuscle(
 SimTK::Vector Umberger2010MuscleMetabolicsProbe::computeProbeInputs(const State& s) const
 {
     // Initialize metabolic energy rate values.
-    double AMdot, Sdot, Bdot, Wdot;
-    AMdot = Sdot = Bdot = Wdot = 0;
+    double Bdot = 0;
     Vector EdotOutput(getNumProbeInputs());
     EdotOutput = 0;
 
@@ -255,242 +294,250 @@ SimTK::Vector Umberger2010MuscleMetabolicsProbe::computeProbeInputs(const State&
         EdotOutput(1) = Bdot;    // BASAL metabolic power storage
     
 
-    // Loop through each muscle in the MetabolicMuscleParameterSet
     const int nM = 
         get_Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet()
         .getSize();
+    if (!_musclesConnected || (int)_muscles.size() != nM) {
+        throw Exception(getConcreteClassName() + " '" + getName() + 
+            "': the metabolic muscles are not connected to the model.",
+            __FILE__, __LINE__);
+    }
+
+    // The options are the same for all muscles.
+    const double scale = get_muscle_effort_scaling_factor();
+    const double aerobicFactor = get_aerobic_factor();
+    const bool forbidNegativeTotalPower = get_forbid_negative_total_power();
+    const bool activationMaintenanceRateOn = 
+        get_activation_maintenance_rate_on();
+    const bool shorteningRateOn = get_shortening_rate_on();
+    const bool workRateOn = get_mechanical_work_rate_on();
+    const bool includeNegativeWork = get_include_negative_mechanical_work();
+
+    MuscleStateArrays& ms = _muscleState;
+    ms.resize(nM);
+
+    // Get the muscle parameters, and the muscle quantities at the current
+    // time state, in one pass, so that the heat rates below are computed
+    // from contiguous arrays.
+    const Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet& mmSet =
+        get_Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet();
     for (int i=0; i<nM; ++i)
     {
-        // Get the current muscle parameters from the MetabolicMuscleParameterSet
-        // and the corresponding OpenSim::Muscle pointer from the muscleMap.
-        Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameter& mm = 
-            get_Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet()[i];
-        const Muscle* m = mm.getMuscle();
-
-        // Get some muscle properties at the current time state
-        //const double max_isometric_force = m->getMaxIsometricForce();
-        const double max_shortening_velocity = m->getMaxContractionVelocity();
-        const double activation = get_muscle_effort_scaling_factor()
-                                  * m->getActivation(s);
-        const double excitation = get_muscle_effort_scaling_factor()
-                                  * m->getControl(s);
-        double fiber_force_active = get_muscle_effort_scaling_factor()
-                                    * m->getActiveFiberForce(s);
-        const double fiber_length_normalized = m->getNormalizedFiberLength(s);
-        const double fiber_velocity = m->getFiberVelocity(s);
-        double A;
-
-        // Umberger defines fiber_velocity_normalized as Vm/LoM, not Vm/Vmax (p101, top left, Umberger(2003))
-        //const double fiber_velocity_normalized = m->getNormalizedFiberVelocity(s);
-        const double fiber_velocity_normalized = fiber_velocity / m->getOptimalFiberLength();
-
-
-        // ---------------------------------------------------------------------------
-        // NOT USED FOR THIS IMPLEMENTATION
-        //const double slow_twitch_excitation = mm.get_ratio_slow_twitch_fibers() * sin(Pi/2 * excitation);
-        //const double fast_twitch_excitation = (1 - mm.get_ratio_slow_twitch_fibers()) * (1 - cos(Pi/2 * excitation));
-
-        // Set normalized hill constants: A_rel and B_rel
-        //const double A_rel = 0.1 + 0.4*(1 - mm.get_ratio_slow_twitch_fibers());
-        //const double B_rel = A_rel * max_shortening_velocity;
-        // ---------------------------------------------------------------------------
-
-
-        // Set activation dependence scaling parameter: A
-        if (excitation > activation)
-            A = excitation;
-        else
-            A = (excitation + activation) / 2;
-
+        const Muscle* m = _muscles[i].get();
+        // Maximum shortening velocities of fast and slow twitch fibers.
+        const double Vmax_fasttwitch = m->getMaxContractionVelocity();
+        const double Vmax_slowtwitch = m->getMaxContractionVelocity() / 2.5;
+        ms.muscleMass[i] = mmSet[i].getMuscleMass();
+        ms.ratioSlowTwitchFibers[i] = mmSet[i].get_ratio_slow_twitch_fibers();
+        ms.optimalFiberLength[i] = m->getOptimalFiberLength();
+        ms.alphaShorteningFastTwitch[i] = 153 / Vmax_fasttwitch;
+        ms.alphaShorteningSlowTwitch[i] = 100 / Vmax_slowtwitch;
+
+        ms.activation[i] = scale * m->getActivation(s);
+        ms.excitation[i] = scale * m->getControl(s);
+        ms.activeFiberForce[i] = scale * m->getActiveFiberForce(s);
+        ms.normFiberLength[i] = m->getNormalizedFiberLength(s);
+        ms.fiberVelocity[i] = m->getFiberVelocity(s);
         // Normalized contractile element force-length curve
-        const double F_iso = m->getActiveForceLengthMultiplier(s);   
+        ms.activeForceLengthMultiplier[i] = 
+            m->getActiveForceLengthMultiplier(s);
 
         // Warnings
-        if (fiber_length_normalized < 0)
+        if (ms.normFiberLength[i] < 0)
             cout << "WARNING: (t = " << s.getTime() 
             << "), muscle '" << m->getName() 
             << "' has negative normalized fiber-length." << endl; 
+    }
 
+    // Set activation dependence scaling parameter: A
+    for (int i=0; i<nM; ++i) {
+        const double excitation = ms.excitation[i];
+        const double activation = ms.activation[i];
+        ms.activationDependence[i] = (excitation > activation) 
+            ? excitation : (excitation + activation) / 2;
+    }
 
-
-        // ACTIVATION & MAINTENANCE HEAT RATE for muscle i (W/kg)
-        // --> depends on the normalized fiber length of the contractile element
-        // -----------------------------------------------------------------------
-        double slowTwitchRatio = mm.get_ratio_slow_twitch_fibers();
-        if (get_use_Bhargava_recruitment_model()) {
-            const double uSlow = slowTwitchRatio * sin(0.5*Pi * excitation);
-            const double uFast = (1 - slowTwitchRatio)
+    // Ratio of slow twitch fibers, which may depend on the excitation.
+    if (get_use_Bhargava_recruitment_model()) {
+        for (int i=0; i<nM; ++i) {
+            const double excitation = ms.excitation[i];
+            const double uSlow = ms.ratioSlowTwitchFibers[i]
+                                 * sin(0.5*Pi * excitation);
+            const double uFast = (1 - ms.ratioSlowTwitchFibers[i])
                                  * (1 - cos(0.5*Pi * excitation));
-            slowTwitchRatio = (excitation == 0) ? 1.0 : uSlow / (uSlow + uFast);
+            ms.slowTwitchRatio[i] = 
+                (excitation == 0) ? 1.0 : uSlow / (uSlow + uFast);
         }
+    }
+    else
+        ms.slowTwitchRatio = ms.ratioSlowTwitchFibers;
 
-        if (get_forbid_negative_total_power() ||
-            get_activation_maintenance_rate_on())
-        {
-            const double unscaledAMdot = 128*(1 - slowTwitchRatio) + 25;
 
-            if (fiber_length_normalized <= 1.0)
-                AMdot = get_aerobic_factor() * std::pow(A, 0.6) * unscaledAMdot;
+    // ACTIVATION & MAINTENANCE HEAT RATE for each muscle (W/kg)
+    // --> depends on the normalized fiber length of the contractile element
+    // -----------------------------------------------------------------------
+    if (forbidNegativeTotalPower || activationMaintenanceRateOn) {
+        for (int i=0; i<nM; ++i) {
+            const double unscaledAMdot = 128*(1 - ms.slowTwitchRatio[i]) + 25;
+            const double scaling = 
+                aerobicFactor * std::pow(ms.activationDependence[i], 0.6);
+            if (ms.normFiberLength[i] <= 1.0)
+                ms.AMdot[i] = scaling * unscaledAMdot;
             else
-                AMdot = get_aerobic_factor() * std::pow(A, 0.6) * ((0.4 * unscaledAMdot) + (0.6 * unscaledAMdot * F_iso));
+                ms.AMdot[i] = scaling * ((0.4 * unscaledAMdot) + 
+                    (0.6 * unscaledAMdot * ms.activeForceLengthMultiplier[i]));
         }
+    }
+    else
+        std::fill(ms.AMdot.begin(), ms.AMdot.end(), 0.0);
 
 
-
-        // SHORTENING HEAT RATE for muscle i (W/kg)
-        // --> depends on the normalized fiber length of the contractile element
-        // --> note that we define Vm<0 as shortening and Vm>0 as lengthening
-        // -----------------------------------------------------------------------
-        if (get_forbid_negative_total_power() || get_shortening_rate_on())
-        {
-            const double Vmax_fasttwitch = max_shortening_velocity;
-            const double Vmax_slowtwitch = max_shortening_velocity / 2.5;
-            const double alpha_shortening_fasttwitch = 153 / Vmax_fasttwitch;
-            const double alpha_shortening_slowtwitch = 100 / Vmax_slowtwitch;
-            double unscaledSdot, tmp_slowTwitch, tmp_fastTwitch;
+    // SHORTENING HEAT RATE for each muscle (W/kg)
+    // --> depends on the normalized fiber length of the contractile element
+    // --> note that we define Vm<0 as shortening and Vm>0 as lengthening
+    // --> Umberger defines fiber_velocity_normalized as Vm/LoM, not Vm/Vmax
+    //     (p101, top left, Umberger(2003))
+    // -----------------------------------------------------------------------
+    if (forbidNegativeTotalPower || shorteningRateOn) {
+        const double maxShorteningRate = 100.0;    // (W/kg)
+        const double eccentricFactor = includeNegativeWork ? 4.0 : 0.3;
+        for (int i=0; i<nM; ++i) {
+            const double fiber_velocity_normalized = 
+                ms.fiberVelocity[i] / ms.optimalFiberLength[i];
+            const double slowTwitchRatio = ms.slowTwitchRatio[i];
+            const double A = ms.activationDependence[i];
+            double Sdot;
 
             if (fiber_velocity_normalized <= 0)    // concentric contraction, Vm<0
             {
-                const double maxShorteningRate = 100.0;    // (W/kg)
-
-                tmp_slowTwitch = -alpha_shortening_slowtwitch * fiber_velocity_normalized;
-
+                double tmp_slowTwitch = 
+                    -ms.alphaShorteningSlowTwitch[i] * fiber_velocity_normalized;
                 // Apply upper limit to the unscaled slow twitch shortening rate.
-                if (tmp_slowTwitch > maxShorteningRate) {
-                    //cout << "WARNING: " << getName() << "  (t = " << s.getTime() << 
-                    //    "Slow twitch shortening heat rate exceeds the max value of " << maxShorteningRate << 
-                    //    " W/kg. Setting to " << maxShorteningRate << " W/kg." << endl; 
+                if (tmp_slowTwitch > maxShorteningRate)
                     tmp_slowTwitch = maxShorteningRate;
-                }
-
-                tmp_fastTwitch = alpha_shortening_fasttwitch * fiber_velocity_normalized * (1-slowTwitchRatio);
-                unscaledSdot = (tmp_slowTwitch * slowTwitchRatio) - tmp_fastTwitch;   // unscaled shortening heat rate: muscle shortening
-                Sdot = get_aerobic_factor() * std::pow(A, 2.0) * unscaledSdot;                      // scaled shortening heat rate: muscle shortening
+                const double tmp_fastTwitch = ms.alphaShorteningFastTwitch[i]
+                    * fiber_velocity_normalized * (1-slowTwitchRatio);
+                // unscaled shortening heat rate: muscle shortening
+                const double unscaledSdot = 
+                    (tmp_slowTwitch * slowTwitchRatio) - tmp_fastTwitch;
+                Sdot = aerobicFactor * std::pow(A, 2.0) * unscaledSdot;
             }
-
             else    // eccentric contraction, Vm>0
             {
-                unscaledSdot =
-                    (get_include_negative_mechanical_work() ? 4.0 : 0.3)
-                    * alpha_shortening_slowtwitch * fiber_velocity_normalized;  // unscaled shortening heat rate: muscle lengthening
-                Sdot = get_aerobic_factor() * A * unscaledSdot;                                // scaled shortening heat rate: muscle lengthening
+                // unscaled shortening heat rate: muscle lengthening
+                const double unscaledSdot = eccentricFactor
+                    * ms.alphaShorteningSlowTwitch[i] * fiber_velocity_normalized;
+                Sdot = aerobicFactor * A * unscaledSdot;
             }
 
-
             // Fiber length dependence on scaled shortening heat rate
             // (for both concentric and eccentric contractions).
-            if (fiber_length_normalized > 1.0)
-                Sdot *= F_iso;  
+            if (ms.normFiberLength[i] > 1.0)
+                Sdot *= ms.activeForceLengthMultiplier[i];
+            ms.Sdot[i] = Sdot;
         }
-        
-
-
-        // Clamp fiber force. THIS SHOULD NEVER HAPPEN...
-        if (fiber_force_active < 0)
-            fiber_force_active = 0.0;
-
-
-
-
-        // MECHANICAL WORK RATE for the contractile element of muscle i (W/kg).
-        // --> note that we define Vm<0 as shortening and Vm>0 as lengthening.
-        // -------------------------------------------------------------------
-        if (get_forbid_negative_total_power() || get_mechanical_work_rate_on())
-        {
-            if (get_include_negative_mechanical_work() || fiber_velocity <= 0)
-                Wdot = -fiber_force_active*fiber_velocity;
-            else
-                Wdot = 0;
-
-            Wdot /= mm.getMuscleMass();
+    }
+    else
+        std::fill(ms.Sdot.begin(), ms.Sdot.end(), 0.0);
+
+
+    // MECHANICAL WORK RATE for the contractile element of each muscle (W/kg).
+    // --> note that we define Vm<0 as shortening and Vm>0 as lengthening.
+    // --> the fiber force is clamped at 0; it should never be negative.
+    // -------------------------------------------------------------------
+    if (forbidNegativeTotalPower || workRateOn) {
+        for (int i=0; i<nM; ++i) {
+            double fiber_force_active = ms.activeFiberForce[i];
+            if (fiber_force_active < 0)
+                fiber_force_active = 0.0;
+            const double fiber_velocity = ms.fiberVelocity[i];
+            const double Wdot = (includeNegativeWork || fiber_velocity <= 0)
+                ? -fiber_force_active*fiber_velocity : 0.0;
+            ms.Wdot[i] = Wdot / ms.muscleMass[i];
         }
+    }
+    else
+        std::fill(ms.Wdot.begin(), ms.Wdot.end(), 0.0);
 
 
-        // If necessary, increase the shortening heat rate so that the total
-        // power is non-negative.
-        if (get_forbid_negative_total_power()) {
-            const double Edot_Wkg_beforeClamp = AMdot + Sdot + Wdot;
+    // If necessary, increase the shortening heat rate so that the total
+    // power is non-negative.
+    if (forbidNegativeTotalPower) {
+        for (int i=0; i<nM; ++i) {
+            const double Edot_Wkg_beforeClamp = 
+                ms.AMdot[i] + ms.Sdot[i] + ms.Wdot[i];
             if (Edot_Wkg_beforeClamp < 0)
-                Sdot -= Edot_Wkg_beforeClamp;
+                ms.Sdot[i] -= Edot_Wkg_beforeClamp;
         }
+    }
 
 
-        // NAN CHECKING
-        // ------------------------------------------
-        if (isNaN(AMdot))
-            cout << "WARNING::" << getName() << ": AMdot (" << m->getName() << ") = NaN!" << endl;
-        if (isNaN(Sdot))
-            cout << "WARNING::" << getName() << ": Sdot (" << m->getName() << ") = NaN!" << endl;
-        if (isNaN(Wdot))
-            cout << "WARNING::" << getName() << ": Wdot (" << m->getName() << ") = NaN!" << endl;
-
-
-        // This check is from Umberger(2003), page 104: the total heat rate 
-        // (i.e., AMdot + Sdot) for a given muscle cannot fall below 1.0 W/kg.
-        // -----------------------------------------------------------------------
-        double totalHeatRate = AMdot + Sdot;
-
-        if(get_enforce_minimum_heat_rate_per_muscle() && totalHeatRate < 1.0 
-            && get_activation_maintenance_rate_on() 
-            && get_shortening_rate_on()) {
-                //cout << "WARNING: " << getName() 
-                //    << "  (t = " << s.getTime() 
-                //    << "), the muscle '" << mm.getName() 
-                //    << "' has a net metabolic energy rate of less than 1.0 W/kg." << endl; 
-                totalHeatRate = 1.0;            // not allowed to fall below 1.0 W.kg-1
-        }
-        
+    // NAN CHECKING
+    // ------------------------------------------
+    for (int i=0; i<nM; ++i) {
+        if (isNaN(ms.AMdot[i]))
+            cout << "WARNING::" << getName() << ": AMdot (" << _muscles[i]->getName() << ") = NaN!" << endl;
+        if (isNaN(ms.Sdot[i]))
+            cout << "WARNING::" << getName() << ": Sdot (" << _muscles[i]->getName() << ") = NaN!" << endl;
+        if (isNaN(ms.Wdot[i]))
+            cout << "WARNING::" << getName() << ": Wdot (" << _muscles[i]->getName() << ") = NaN!" << endl;
+    }
 
-        // TOTAL METABOLIC ENERGY RATE for muscle i
-        // UNITS: W
-        // ------------------------------------------
-        double Edot = 0;
 
-        if (get_activation_maintenance_rate_on() && get_shortening_rate_on())
-            Edot += totalHeatRate;      // May have been clamped to 1.0 W/kg.
-        else {
-            if (get_activation_maintenance_rate_on())
-                Edot += AMdot;
-            if (get_shortening_rate_on())
-                Edot += Sdot;
+    // TOTAL METABOLIC ENERGY RATE for each muscle
+    // UNITS: W
+    // ------------------------------------------
+    // This check is from Umberger(2003), page 104: the total heat rate 
+    // (i.e., AMdot + Sdot) for a given muscle cannot fall below 1.0 W/kg.
+    const bool enforceMinimumHeatRate = 
+        get_enforce_minimum_heat_rate_per_muscle()
+        && activationMaintenanceRateOn && shorteningRateOn;
+    for (int i=0; i<nM; ++i) {
+        double Edot = 0;
+        if (activationMaintenanceRateOn && shorteningRateOn) {
+            const double totalHeatRate = ms.AMdot[i] + ms.Sdot[i];
+            // May be clamped to 1.0 W/kg.
+            Edot += (enforceMinimumHeatRate && totalHeatRate < 1.0) 
+                    ? 1.0 : totalHeatRate;
+        } else {
+            if (activationMaintenanceRateOn)
+                Edot += ms.AMdot[i];
+            if (shorteningRateOn)
+                Edot += ms.Sdot[i];
         }
-        if (get_mechanical_work_rate_on())
-            Edot += Wdot;
-        Edot *= mm.getMuscleMass();
-
-        EdotOutput(0) += Edot;       // Add to TOTAL metabolic power storage
-        if (!get_report_total_metabolics_only()) {
-            // Metabolic power storage for muscle i
-            EdotOutput(i+2) = Edot;  
-        }                          
+        if (workRateOn)
+            Edot += ms.Wdot[i];
+        ms.Edot[i] = Edot * ms.muscleMass[i];
+    }
 
+    for (int i=0; i<nM; ++i)
+        EdotOutput(0) += ms.Edot[i];     // Add to TOTAL metabolic power storage
+    if (!get_report_total_metabolics_only()) {
+        // Metabolic power storage for each muscle
+        for (int i=0; i<nM; ++i)
+            EdotOutput(i+2) = ms.Edot[i];
+    }
 
-        
 
 #ifdef DEBUG_METABOLICS
-        cout << "muscle_mass = " << mm.getMuscleMass() << endl;
-        cout << "ratio_slow_twitch_fibers = " << slowTwitchRatio << endl;
-        cout << "bodymass = " << _model->getMatterSubsystem().calcSystemMass(s) << endl;
-        //cout << "max_isometric_force = " << max_isometric_force << endl;
-        cout << "activation = " << activation << endl;
-        cout << "excitation = " << excitation << endl;
-        //cout << "fiber_force_total = " << fiber_force_total << endl;
-        cout << "fiber_force_active = " << fiber_force_active << endl;
-        cout << "fiber_length_normalized = " << fiber_length_normalized << endl;
-        cout << "fiber_velocity = " << fiber_velocity << endl;
-        //cout << "slow_twitch_excitation = " << slow_twitch_excitation << endl;
-        //cout << "fast_twitch_excitation = " << fast_twitch_excitation << endl;
-        cout << "max shortening velocity = " << max_shortening_velocity << endl;
-        //cout << "A_rel = " << A_rel << endl;
-        //cout << "B_rel = " << B_rel << endl;
-        cout << "AMdot = " << AMdot << endl;
-        cout << "Sdot = " << Sdot << endl;
-        cout << "Bdot = " << Bdot << endl;
-        cout << "Wdot = " << Wdot << endl;
-        cout << "Edot = " << Edot << endl;
-        std::cin.get();
-#endif
+    cout << "bodymass = " << _model->getMatterSubsystem().calcSystemMass(s) << endl;
+    cout << "Bdot = " << Bdot << endl;
+    for (int i=0; i<nM; ++i) {
+        cout << "muscle = " << _muscles[i]->getName() << endl;
+        cout << "muscle_mass = " << ms.muscleMass[i] << endl;
+        cout << "ratio_slow_twitch_fibers = " << ms.slowTwitchRatio[i] << endl;
+        cout << "activation = " << ms.activation[i] << endl;
+        cout << "excitation = " << ms.excitation[i] << endl;
+        cout << "fiber_force_active = " << ms.activeFiberForce[i] << endl;
+        cout << "fiber_length_normalized = " << ms.normFiberLength[i] << endl;
+        cout << "fiber_velocity = " << ms.fiberVelocity[i] << endl;
+        cout << "AMdot = " << ms.AMdot[i] << endl;
+        cout << "Sdot = " << ms.Sdot[i] << endl;
+        cout << "Wdot = " << ms.Wdot[i] << endl;
+        cout << "Edot = " << ms.Edot[i] << endl;
     }
+    std::cin.get();
+#endif
 
     return EdotOutput;
 }
@@ -616,6 +663,7 @@ void Umberger2010MuscleMetabolicsProbe::
     }
     disconnect();
     upd_Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet().remove(k);
+    gatherMuscles();
 }
 
 
@@ -134,6 +134,58 @@ double MomentArmSolver::solve(const State &state, const Coordinate &aCoord,
     return ~_coupling*_generalizedForces;
 }
 
+SimTK::Matrix MomentArmSolver::solveMatrix(const State &state,
+                        const SimTK::Array_<const GeometryPath*>& paths,
+                        const SimTK::Array_<const Coordinate*>& coordinates) const
+{
+    const int np = (int)paths.size();
+    const int nc = (int)coordinates.size();
+
+    //Local modifiable copy of the state
+    State& s_ma = _stateCopy;
+    s_ma.updQ() = state.getQ();
+
+    // The coupling between coordinates due to constraints depends only on
+    // the coordinate, so compute it once per coordinate (one per column).
+    Matrix coupling(s_ma.getNU(), nc);
+    for (int j = 0; j < nc; ++j) {
+        coupling(j) = computeCouplingVector(s_ma, *coordinates[j]);
+    }
+
+    // set speeds to zero
+    s_ma.updU() = 0;
+
+    // The generalized forces due to a unit tension depend only on the path,
+    // so compute them once per path (one per column).
+    Matrix generalizedForces(s_ma.getNU(), np);
+    Vector pathDependentMobilityForces(s_ma.getNU());
+    const SimbodyMatterSubsystem& matter = 
+        getModel().getMultibodySystem().getMatterSubsystem();
+
+    for (int i = 0; i < np; ++i) {
+        // zero out all the forces
+        _bodyForces *= 0;
+        pathDependentMobilityForces = 0;
+
+        // apply a tension of unity to the bodies of the path
+        paths[i]->addInEquivalentForces(s_ma, 1.0, _bodyForces, 
+                                        pathDependentMobilityForces);
+
+        // Convert body spatial forces F to equivalent mobility forces 
+        // f = ~J(q) * F. Applying the Jacobian transpose operator is O(n)
+        // which is cheaper than forming J explicitly to multiply all paths
+        // as a block.
+        matter.multiplyBySystemJacobianTranspose(s_ma, _bodyForces, 
+                                                 _generalizedForces);
+        generalizedForces(i) = _generalizedForces + pathDependentMobilityForces;
+    }
+
+    // Each moment-arm is the effective torque (since tension is 1) at a 
+    // coordinate taking into account the generalized forces also acting on
+    // other coordinates that are coupled via constraint.
+    return ~coupling*generalizedForces;
+}
+
 SimTK::Vector MomentArmSolver::computeCouplingVector(SimTK::State &state, 
         const Coordinate &coordinate) const
 {
@@ -82,6 +82,22 @@ public:
     double solve(const SimTK::State& state, const Coordinate &coordinate, 
         const Array<PointForceDirection *> &pfds) const;
 
+    /** Solve for the effective moment-arms of several GeometryPaths about
+        several coordinates at once. This is equivalent to calling 
+        solve(state, coordinate, path) for every (coordinate, path) pair, but
+        the constraint coupling of each coordinate and the generalized forces
+        of each path are only computed once, which is considerably cheaper
+        when computing moment-arms for many muscles and coordinates.
+    @param  state               current state of the model
+    @param  paths               GeometryPaths for which to calculate moment-arms
+    @param  coordinates         Coordinates about which we want the moment-arms
+    @return ma                  matrix of moment-arms, with a row for each
+                                coordinate and a column for each path
+    */
+    SimTK::Matrix solveMatrix(const SimTK::State& state,
+        const SimTK::Array_<const GeometryPath*>& paths,
+        const SimTK::Array_<const Coordinate*>& coordinates) const;
+
 private:
     // Internal state of the solver initialized as a copy of the default state
     mutable SimTK::State _stateCopy;
@@ -237,14 +237,23 @@ void Coordinate::extendAddToSystem(SimTK::MultibodySystem& system) const
     addStateVariable(ssv);
 }
 
-void Coordinate::extendRealizeInstance(const SimTK::State& state) const
+void Coordinate::
+    extendUpdateStateVariableSystemIndices(const SimTK::State& state)
 {
-    const MobilizedBody& mb
-        = getModel().getMatterSubsystem().getMobilizedBody(_bodyIndex);
+    Super::extendUpdateStateVariableSystemIndices(state);
 
-    int uix = state.getUStart() + mb.getFirstUIndex(state) + _mobilizerQIndex;
+    const SimbodyMatterSubsystem& matter = getModel().getMatterSubsystem();
+    const MobilizedBody& mb = matter.getMobilizedBody(_bodyIndex);
+    const SimTK::SubsystemIndex sbsix = matter.getMySubsystemIndex();
 
-    /* Set the YIndex on the StateVariable */
+    const int qix = state.getQStart() + state.getQStart(sbsix) 
+                    + mb.getFirstQIndex(state) + _mobilizerQIndex;
+    const int uix = state.getUStart() + state.getUStart(sbsix) 
+                    + mb.getFirstUIndex(state) + _mobilizerQIndex;
+
+    /* Set the YIndex on the StateVariables */
+    updStateVariable("value").setSystemYIndex(SimTK::SystemYIndex(qix));
+    updStateVariable("speed").setSystemYIndex(SimTK::SystemYIndex(uix));
 }
 
 void Coordinate::extendInitStateFromProperties(State& s) const
@@ -220,10 +220,11 @@ public:
 protected:
     // Only model should be invoking these ModelComponent interface methods.
     void extendAddToSystem(SimTK::MultibodySystem& system) const override;
-    //State structure is locked and now we can assign names to state variables
+    //State structure is locked and now we can locate the state variables
     //allocated by underlying components after modeling options have been 
     //factored in.
-    void extendRealizeInstance(const SimTK::State& state) const override;
+    void extendUpdateStateVariableSystemIndices(
+        const SimTK::State& state) override;
     void extendInitStateFromProperties(SimTK::State& s) const override;
     void extendSetPropertiesFromState(const SimTK::State& state) override;
 
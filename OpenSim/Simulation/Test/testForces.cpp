@@ -33,14 +33,18 @@
 //      7. ExternalForce
 //      8. PathSpring
 //      9. ExpressionBasedPointToPointForce
+//     10. Forces computed on several threads
+//     11. Evaluation of compiled force expressions
 //      
 //     Add tests here as Forces are added to OpenSim
 //
 //==============================================================================
 #include <ctime>  // clock(), clock_t, CLOCKS_PER_SEC
+#include <chrono>
 #include <OpenSim/Simulation/osimSimulation.h>
 #include <OpenSim/Analyses/osimAnalyses.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <OpenSim/Common/LoadOpenSimLibrary.h>
 
 using namespace OpenSim;
 using namespace std;
@@ -64,6 +68,8 @@ void testCoordinateLimitForce();
 void testCoordinateLimitForceRotational();
 void testExpressionBasedPointToPointForce();
 void testExpressionBasedCoordinateForce();
+void testParallelForces();
+void testExpressionBasedForceEvaluation();
 
 int main()
 {
@@ -140,6 +146,18 @@ int main()
         failures.push_back("testExpressionBasedCoordinateForce");
     }
 
+    try { testParallelForces(); }
+    catch (const std::exception& e){
+        cout << e.what() <<endl; 
+        failures.push_back("testParallelForces");
+    }
+
+    try { testExpressionBasedForceEvaluation(); }
+    catch (const std::exception& e){
+        cout << e.what() <<endl; 
+        failures.push_back("testExpressionBasedForceEvaluation");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -1668,3 +1686,174 @@ void testExternalForce()
             ASSERT_EQUAL(def, val, 10*accuracy);
     }
 }
+
+// Realize the model at a pose with all muscles active and return the total
+// body and mobility forces.
+static void computeTotalForces(Model& model, SimTK::State& s, 
+                               SimTK::Vector_<SimTK::SpatialVec>& bodyForces, 
+                               SimTK::Vector& mobilityForces)
+{
+    s.invalidateAllCacheAtOrAbove(SimTK::Stage::Position);
+    model.getMultibodySystem().realize(s, SimTK::Stage::Dynamics);
+    bodyForces = 
+        model.getMultibodySystem().getRigidBodyForces(s, SimTK::Stage::Dynamics);
+    mobilityForces = 
+        model.getMultibodySystem().getMobilityForces(s, SimTK::Stage::Dynamics);
+}
+
+static SimTK::State& initPerturbedState(Model& model)
+{
+    SimTK::State& s = model.initSystem();
+    const CoordinateSet& coords = model.getCoordinateSet();
+    for (int i = 0; i < coords.getSize(); ++i) {
+        if (!coords[i].getLocked(s))
+            coords[i].setValue(s, coords[i].getValue(s) + 0.1, false);
+    }
+    const Set<Muscle>& muscles = model.getMuscles();
+    for (int j = 0; j < muscles.getSize(); ++j)
+        muscles[j].setActivation(s, 0.2 + 0.6*j/muscles.getSize());
+    model.equilibrateMuscles(s);
+    return s;
+}
+
+void testParallelForces()
+{
+    using namespace SimTK;
+
+    LoadOpenSimLibrary("osimActuators");
+    const string filename = "gait2354_simbody.osim";
+
+    Model serialModel(filename);
+    State& serialState = initPerturbedState(serialModel);
+    Vector_<SpatialVec> serialBodyForces;
+    Vector serialMobilityForces;
+    computeTotalForces(serialModel, serialState, 
+                       serialBodyForces, serialMobilityForces);
+
+    const int numRealizations = 200;
+    double serialTime = 0;
+    for (int numThreads = 1; numThreads <= 8; numThreads *= 2) {
+        Model model(filename);
+        model.setNumForceThreads(numThreads);
+        State& s = initPerturbedState(model);
+        s.updQ() = serialState.getQ();
+        s.updU() = serialState.getU();
+        s.updZ() = serialState.getZ();
+
+        Vector_<SpatialVec> bodyForces;
+        Vector mobilityForces;
+        computeTotalForces(model, s, bodyForces, mobilityForces);
+
+        // Forces computed on several threads must agree with the serial 
+        // forces up to round-off.
+        for (int i = 0; i < bodyForces.size(); ++i) {
+            for (int k = 0; k < 2; ++k) {
+                for (int j = 0; j < 3; ++j)
+                    ASSERT_EQUAL(serialBodyForces[i][k][j], 
+                                 bodyForces[i][k][j], 1e-9);
+            }
+        }
+        for (int i = 0; i < mobilityForces.size(); ++i)
+            ASSERT_EQUAL(serialMobilityForces[i], mobilityForces[i], 1e-9);
+
+        // and must be the same every time for a given number of threads.
+        auto startTime = std::chrono::steady_clock::now();
+        for (int k = 0; k < numRealizations; ++k) {
+            Vector_<SpatialVec> bodyForcesAgain;
+            Vector mobilityForcesAgain;
+            computeTotalForces(model, s, bodyForcesAgain, mobilityForcesAgain);
+            for (int i = 0; i < bodyForces.size(); ++i)
+                ASSERT(bodyForcesAgain[i] == bodyForces[i], __FILE__, __LINE__,
+                    "Body forces changed between realizations.");
+            for (int i = 0; i < mobilityForces.size(); ++i)
+                ASSERT(mobilityForcesAgain[i] == mobilityForces[i], 
+                    __FILE__, __LINE__,
+                    "Mobility forces changed between realizations.");
+        }
+        // Wall-clock time, since clock() adds up the time of all threads.
+        double realizationTime = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - startTime).count()
+            / numRealizations;
+        if (numThreads == 1)
+            serialTime = realizationTime;
+
+        cout << filename << ": " << model.getMuscles().getSize() 
+             << " muscles on " << numThreads << " thread(s), "
+             << realizationTime << "ms per realization, speedup " 
+             << serialTime/realizationTime << endl;
+    }
+}
+
+void testExpressionBasedForceEvaluation()
+{
+    using namespace SimTK;
+
+    const int numBalls = 50;
+    const string expression = "-10*q^3-5*qdot+sin(q)*exp(-qdot^2)";
+
+    Model model;
+    model.setName("ExpressionBasedForceEvaluation");
+    for (int i = 0; i < numBalls; ++i) {
+        const string suffix = "_" + to_string(i);
+        OpenSim::Body* ball = new OpenSim::Body("ball" + suffix, 1.0, Vec3(0),
+            SimTK::Inertia::sphere(0.1));
+        SliderJoint* slider = new SliderJoint("slider" + suffix, 
+            model.getGround(), Vec3(0), Vec3(0), *ball, Vec3(0), Vec3(0));
+        slider->upd_CoordinateSet()[0].setName("h" + suffix);
+        model.addBody(ball);
+        model.addJoint(slider);
+        model.addForce(
+            new ExpressionBasedCoordinateForce("h" + suffix, expression));
+    }
+
+    State& s = model.initSystem();
+    const CoordinateSet& coords = model.getCoordinateSet();
+    for (int i = 0; i < numBalls; ++i) {
+        coords[i].setValue(s, 0.01*(i - numBalls/2), false);
+        coords[i].setSpeedValue(s, 0.02*i);
+    }
+    model.getMultibodySystem().realize(s, Stage::Velocity);
+
+    // The compiled expressions must agree with evaluating the parsed 
+    // expression with the variables looked up by name.
+    Lepton::ExpressionProgram program = 
+        Lepton::Parser::parse(expression).optimize().createProgram();
+    Array<const ExpressionBasedCoordinateForce*> forces;
+    for (int i = 0; i < numBalls; ++i) {
+        forces.append(dynamic_cast<const ExpressionBasedCoordinateForce*>(
+            &model.getForceSet()[i]));
+        std::map<std::string, double> vars;
+        vars["q"] = coords[i].getValue(s);
+        vars["qdot"] = coords[i].getSpeedValue(s);
+        ASSERT_EQUAL(program.evaluate(vars), 
+                     forces[i]->calcExpressionForce(s), 1e-12);
+    }
+
+    // Compare the cost of evaluating the compiled expressions against 
+    // looking up the variables by name on every evaluation.
+    const int numEvaluations = 2000;
+    double sum = 0;
+    std::clock_t startTime = std::clock();
+    for (int k = 0; k < numEvaluations; ++k) {
+        for (int i = 0; i < numBalls; ++i) {
+            std::map<std::string, double> vars;
+            vars["q"] = coords[i].getValue(s);
+            vars["qdot"] = coords[i].getSpeedValue(s);
+            sum += program.evaluate(vars);
+        }
+    }
+    double programTime = 1.e3*(std::clock() - startTime)/CLOCKS_PER_SEC;
+
+    double compiledSum = 0;
+    startTime = std::clock();
+    for (int k = 0; k < numEvaluations; ++k) {
+        for (int i = 0; i < numBalls; ++i)
+            compiledSum += forces[i]->calcExpressionForce(s);
+    }
+    double compiledTime = 1.e3*(std::clock() - startTime)/CLOCKS_PER_SEC;
+
+    ASSERT_EQUAL(sum, compiledSum, 1e-8*(1 + std::abs(sum)));
+    cout << numBalls*numEvaluations << " expression evaluations: " 
+         << programTime << "ms by name, " << compiledTime 
+         << "ms compiled, speedup " << programTime/compiledTime << endl;
+}
@@ -24,6 +24,9 @@
 #include <OpenSim/Simulation/Manager/Manager.h>
 #include <OpenSim/Simulation/Control/ControlSetController.h>
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
+#include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
+#include <OpenSim/Analyses/ForceReporter.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
@@ -42,6 +45,15 @@ void testStates(const string& modelFile);
 // cause the memory footprint of the process to increase significantly.
 //==============================================================================
 void testMemoryUsage(const string& modelFile);
+//==============================================================================
+// testStateVariableValues tests that getting and setting all state variable
+// values at once agrees with doing so by name, and compares the time it takes
+// to record the states of many steps each way.
+//==============================================================================
+void testStateVariableValues(const string& modelFile);
+// Stream the results of a simulation to files and compare them with the
+// results recorded in memory.
+void testStreamingOutput(const string& modelFile);
 
 static const int MAX_N_TRIES = 100;
 
@@ -52,6 +64,8 @@ int main()
         testStates("arm26.osim");
         testMemoryUsage("arm26.osim");
         testMemoryUsage("PushUpToesOnGroundWithMuscles.osim");
+        testStateVariableValues("gait2354_simbody.osim");
+        testStreamingOutput("arm26.osim");
     }
     catch (const Exception& e) {
         cout << "testInitState failed: ";
@@ -224,3 +238,184 @@ void testMemoryUsage(const string& modelFile)
     ASSERT( delta < 1e8, __FILE__, __LINE__, 
         "testMemoryUsage: total estimated memory leaked > 100MB.");
 }
+
+void testStateVariableValues(const string& modelFile)
+{
+    using namespace SimTK;
+
+    Model model(modelFile);
+    State& s = model.initSystem();
+    State s2 = s;
+
+    // Move every state variable away from its default value.
+    const CoordinateSet& coords = model.getCoordinateSet();
+    for (int i = 0; i < coords.getSize(); ++i) {
+        if (!coords[i].getLocked(s)) {
+            coords[i].setValue(s, coords[i].getValue(s) + 0.01*(i+1), false);
+            coords[i].setSpeedValue(s, 0.1*(i+1));
+        }
+    }
+    const Set<Muscle>& muscles = model.getMuscles();
+    for (int j = 0; j < muscles.getSize(); ++j)
+        muscles[j].setActivation(s, 0.05 + 0.9*j/muscles.getSize());
+    model.getMultibodySystem().realize(s, Stage::Velocity);
+
+    const Array<string> names = model.getStateVariableNames();
+    const int nsv = model.getNumStateVariables();
+    ASSERT(names.getSize() == nsv);
+
+    Vector values = model.getStateVariableValues(s);
+    ASSERT(values.size() == nsv);
+    for (int i = 0; i < nsv; ++i) {
+        ASSERT(values[i] == model.getStateVariableValue(s, names[i]), 
+            __FILE__, __LINE__, "Value of " + names[i] + " does not match.");
+    }
+
+    // Setting all values on a default state reproduces them.
+    model.setStateVariableValues(s2, values);
+    model.getMultibodySystem().realize(s2, Stage::Velocity);
+    for (int i = 0; i < nsv; ++i) {
+        ASSERT_EQUAL(values[i], model.getStateVariableValue(s2, names[i]),
+            1e-10, __FILE__, __LINE__, 
+            "Value of " + names[i] + " was not set.");
+    }
+
+    // Record the states of many steps by name, as was done before, and with
+    // a reused Vector.
+    const int nSteps = 10000;
+    Storage byName(nSteps), reused(nSteps);
+
+    clock_t startTime = clock();
+    for (int k = 0; k < nSteps; ++k) {
+        s.updTime() = k*1e-3;
+        const Array<string> stepNames = model.getStateVariableNames();
+        Vector stepValues(nsv);
+        for (int i = 0; i < nsv; ++i)
+            stepValues[i] = model.getStateVariableValue(s, stepNames[i]);
+        byName.append(s.getTime(), stepValues);
+    }
+    double byNameTime = 1.0e3*(clock()-startTime)/CLOCKS_PER_SEC;
+
+    startTime = clock();
+    Vector stepValues;
+    for (int k = 0; k < nSteps; ++k) {
+        s.updTime() = k*1e-3;
+        model.getStateVariableValues(s, stepValues);
+        reused.append(s.getTime(), stepValues);
+    }
+    double reusedTime = 1.0e3*(clock()-startTime)/CLOCKS_PER_SEC;
+
+    ASSERT(byName.getSize() == reused.getSize());
+    for (int k = 0; k < nSteps; k += nSteps/10) {
+        for (int i = 0; i < nsv; ++i)
+            ASSERT(byName.getStateVector(k)->getData()[i] 
+                   == reused.getStateVector(k)->getData()[i]);
+    }
+
+    // The state variables are found anew after the model is finalized and
+    // its System rebuilt.
+    const State moved = s;
+    model.finalizeFromProperties();
+    State& s3 = model.initSystem();
+    s3.updQ() = moved.getQ();
+    s3.updU() = moved.getU();
+    s3.updZ() = moved.getZ();
+    values = model.getStateVariableValues(s3);
+    ASSERT(values.size() == nsv);
+    for (int i = 0; i < nsv; ++i) {
+        ASSERT(values[i] == model.getStateVariableValue(s3, names[i]), 
+            __FILE__, __LINE__, "Value of " + names[i] + " does not match.");
+    }
+
+    // Switching a free joint to quaternions after initSystem() adds a q, 
+    // which moves the following q's and all u's in Y. The Y indices recorded
+    // by initSystem() no longer apply and must not be used.
+    Model floating;
+    OpenSim::Body* trunk = new OpenSim::Body("trunk", 1.0, Vec3(0), Inertia(1));
+    OpenSim::Body* arm = new OpenSim::Body("arm", 1.0, Vec3(0), Inertia(1));
+    floating.addBody(trunk);
+    floating.addBody(arm);
+    floating.addJoint(new FreeJoint("free", floating.getGround(), Vec3(0), 
+                                    Vec3(0), *trunk, Vec3(0), Vec3(0)));
+    floating.addJoint(new PinJoint("pin", *trunk, Vec3(0), Vec3(0), 
+                                   *arm, Vec3(0), Vec3(0)));
+    State& s4 = floating.initSystem();
+    floating.getMatterSubsystem().setUseEulerAngles(s4, false);
+    floating.getMultibodySystem().realizeModel(s4);
+    for (int i = 0; i < s4.getNQ(); ++i) s4.updQ()[i] = 0.1*(i+1);
+    for (int i = 0; i < s4.getNU(); ++i) s4.updU()[i] = -0.1*(i+1);
+    const Array<string> floatingNames = floating.getStateVariableNames();
+    values = floating.getStateVariableValues(s4);
+    ASSERT(values.size() == floatingNames.getSize());
+    for (int i = 0; i < values.size(); ++i) {
+        ASSERT(values[i] == floating.getStateVariableValue(s4, 
+                                                        floatingNames[i]), 
+            __FILE__, __LINE__, 
+            "Value of " + floatingNames[i] + " does not match.");
+    }
+
+    cout << "*******************  testStateVariableValues  *******************" 
+         << endl;
+    cout << "MODEL: " << modelFile << " has " << nsv << " state variables. "
+         << "Recording " << nSteps << " steps by name took " << byNameTime 
+         << "ms, all at once " << reusedTime << "ms." << endl;
+}
+
+void testStreamingOutput(const string& modelFile)
+{
+    using namespace SimTK;
+
+    Storage inMemoryStates, inMemoryControls, inMemoryForces;
+    for (int streaming = 0; streaming < 2; ++streaming) {
+        Model model(modelFile);
+        ControlSetController* controller = new ControlSetController();
+        controller->setControlSetFileName(
+            "arm26_StaticOptimization_controls.xml");
+        model.addController(controller);
+        ForceReporter* reporter = new ForceReporter(&model);
+        reporter->setName("ForceReporter");
+        model.addAnalysis(reporter);
+
+        State& state = model.initSystem();
+        model.equilibrateMuscles(state);
+
+        RungeKuttaMersonIntegrator integrator(model.getMultibodySystem());
+        Manager manager(model, integrator);
+        manager.setInitialTime(0.0);
+        manager.setFinalTime(0.2);
+        if (streaming)
+            manager.setStreamingOutput(".", "testStreaming", 10);
+        manager.integrate(state);
+
+        if (!streaming) {
+            inMemoryStates = manager.getStateStorage();
+            inMemoryControls = *model.updControllerSet().updControlStorage();
+            inMemoryForces = reporter->getForceStorage();
+            continue;
+        }
+        // Only the rows that were not streamed yet are kept in memory.
+        ASSERT(manager.getStateStorage().getSize() <= 11);
+        ASSERT(manager.getStateStorage().getSize() < inMemoryStates.getSize());
+        manager.clearStreamingOutput();
+    }
+
+    const string streamedFiles[] = { "testStreaming_states.sto",
+        "testStreaming_controls.sto",
+        "testStreaming_ForceReporter_" + inMemoryForces.getName() + ".sto" };
+    const Storage* inMemory[] = 
+        { &inMemoryStates, &inMemoryControls, &inMemoryForces };
+    for (int k = 0; k < 3; ++k) {
+        Storage streamed(streamedFiles[k]);
+        ASSERT(streamed.getSize() == inMemory[k]->getSize(), __FILE__, 
+            __LINE__, streamedFiles[k] + " has the wrong number of rows.");
+        ASSERT(streamed.getColumnLabels() == inMemory[k]->getColumnLabels());
+        for (int i = 0; i < streamed.getSize(); ++i) {
+            const StateVector& row = *streamed.getStateVector(i);
+            const StateVector& expected = *inMemory[k]->getStateVector(i);
+            ASSERT_EQUAL(expected.getTime(), row.getTime(), 1e-6);
+            for (int j = 0; j < row.getSize(); ++j)
+                ASSERT_EQUAL(expected.getData()[j], row.getData()[j],
+                    1e-6*(1 + std::abs(expected.getData()[j])));
+        }
+    }
+}
@@ -0,0 +1,134 @@
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  testModelSerialization.cpp                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2016 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Common/LoadOpenSimLibrary.h>
+#include <OpenSim/Common/BinaryIO.h>
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <ctime>
+#include <fstream>
+
+using namespace OpenSim;
+using namespace std;
+
+//==============================================================================
+// testLoadModel reads a model file, reports how long that takes, then prints
+// the model and reads it back, checking that the two models are the same.
+//==============================================================================
+void testLoadModel(const string& modelFile);
+// testSnapshot writes a binary snapshot of a model and checks that reading
+// it gives the same model and System, comparing the time taken to read and
+// initialize the model from its XML file and from the snapshot.
+void testSnapshot(const string& modelFile);
+
+int main()
+{
+    try {
+        LoadOpenSimLibrary("osimActuators");
+        // The largest models in the test tree.
+        testLoadModel("BothLegs22.osim");
+        testLoadModel("PushUpToesOnGroundWithMuscles.osim");
+        testLoadModel("gait2354_simbody.osim");
+
+        testSnapshot("BothLegs22.osim");
+        testSnapshot("PushUpToesOnGroundWithMuscles.osim");
+        testSnapshot("gait2354_simbody.osim");
+    }
+    catch (const Exception& e) {
+        cout << "testModelSerialization failed: ";
+        e.print(cout);
+        return 1;
+    }
+    catch (const std::exception& e) {
+        cout << "testModelSerialization failed: " << e.what() << endl;
+        return 1;
+    }
+    cout << "Done" << endl;
+    return 0;
+}
+
+void testLoadModel(const string& modelFile)
+{
+    std::clock_t start = std::clock();
+    Model model(modelFile);
+    double loadTime = 1.e3*(std::clock() - start)/CLOCKS_PER_SEC;
+    cout << "Read " << modelFile << " in " << loadTime << " ms." << endl;
+
+    const string copyFile = "reserialized_" + modelFile;
+    model.print(copyFile);
+
+    start = std::clock();
+    Model copy(copyFile);
+    loadTime = 1.e3*(std::clock() - start)/CLOCKS_PER_SEC;
+    cout << "Read " << copyFile << " in " << loadTime << " ms." << endl;
+
+    ASSERT(model == copy, __FILE__, __LINE__,
+        "Reading back the printed " + modelFile + " changed the model.");
+}
+
+void testSnapshot(const string& modelFile)
+{
+    std::clock_t start = std::clock();
+    Model model(modelFile);
+    SimTK::State& s = model.initSystem();
+    double xmlTime = 1.e3*(std::clock() - start)/CLOCKS_PER_SEC;
+
+    const string snapshotFile = modelFile + ".snapshot";
+    model.printSnapshot(snapshotFile);
+
+    start = std::clock();
+    Model snapshot;
+    snapshot.readSnapshot(snapshotFile);
+    SimTK::State& snapshotState = snapshot.initSystem();
+    double snapshotTime = 1.e3*(std::clock() - start)/CLOCKS_PER_SEC;
+
+    cout << modelFile << ": load + initSystem took " << xmlTime 
+         << " ms from XML and " << snapshotTime << " ms from the snapshot." 
+         << endl;
+
+    ASSERT(model == snapshot, __FILE__, __LINE__,
+        "Reading the snapshot of " + modelFile + " changed the model.");
+    ASSERT(snapshotState.getNY() == s.getNY(), __FILE__, __LINE__,
+        "The snapshot of " + modelFile + " has a different number of states.");
+    ASSERT(snapshot.getInputFileName() == snapshotFile, __FILE__, __LINE__,
+        "Model::readSnapshot() did not record the snapshot file name.");
+
+    // The default configurations must give the same system quantities.
+    model.getMultibodySystem().realize(s, SimTK::Stage::Velocity);
+    snapshot.getMultibodySystem().realize(snapshotState, 
+                                          SimTK::Stage::Velocity);
+    for (int i = 0; i < s.getNQ(); ++i)
+        ASSERT_EQUAL(s.getQ()[i], snapshotState.getQ()[i], 0.0, 
+            __FILE__, __LINE__, "Default coordinate values differ.");
+    ASSERT((model.calcMassCenterPosition(s) - 
+            snapshot.calcMassCenterPosition(snapshotState)).norm() < 1e-12,
+        __FILE__, __LINE__, "Center of mass differs.");
+
+    // A snapshot written by a different version of OpenSim is rejected.
+    {
+        std::fstream file(snapshotFile.c_str(), 
+                          std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(8); // past the tag, to the snapshot format version
+        BinaryIO::write(file, -1);
+    }
+    Model stale;
+    ASSERT_THROW(OpenSim::Exception, stale.readSnapshot(snapshotFile));
+}
@@ -51,6 +51,12 @@ void testMomentArmDefinitionForModel(const string &filename,
                                      SimTK::Vec2 rom = SimTK::Vec2(-SimTK::Pi/2,0),
                                      double mass = -1.0, string errorMessage = "");
 
+void testMomentArmMatrixForModel(const string &filename);
+
+void testIncrementalPathComputation(const string &filename);
+
+void testPathAfterEditingGeometry(const string &filename);
+
 int main()
 {
     clock_t startTime = clock();
@@ -119,6 +125,22 @@ int main()
 
         testMomentArmDefinitionForModel("CoupledCoordinatesMPPsMomentArmTest.osim", "foot_angle", "vas_int_r", SimTK::Vec2(-2*SimTK::Pi/3, SimTK::Pi/18), -1.0, "Multiple moving path points: FAILED");
         cout << "Multiple moving path points coupled coordinates test: PASSED\n" << endl;
+
+        testMomentArmMatrixForModel("testMomentArmsConstraintB.osim");
+        cout << "Moment-arm matrix with coupled coordinates: PASSED\n" << endl;
+
+        testMomentArmMatrixForModel("gait2354_simbody.osim");
+        cout << "Moment-arm matrix for all muscles and coordinates: PASSED\n" << endl;
+
+        testIncrementalPathComputation("gait2354_simbody.osim");
+        cout << "Incremental path computation: PASSED\n" << endl;
+
+        testIncrementalPathComputation("wrist_mass.osim");
+        cout << "Incremental path computation with wrapping: PASSED\n" << endl;
+
+        testPathAfterEditingGeometry("arm26.osim");
+        cout << "Path after editing wrap objects and path points: PASSED\n" 
+             << endl;
     }
     catch (const Exception& e) {
         e.print(cerr);
@@ -406,3 +428,223 @@ void testMomentArmDefinitionForModel(const string &filename, const string &coord
     // dL/dTheta definition or is at least dynamically consistent, in which dL/dTheta is not
     ASSERT(passesDefinition || passesDynamicConsistency, __FILE__, __LINE__, errorMessage);
 }
+
+//==========================================================================================================
+// The moment-arm matrix for all muscles about all coordinates must agree with
+// the moment-arms solved one (coordinate, muscle) pair at a time.
+//==========================================================================================================
+void testMomentArmMatrixForModel(const string &filename)
+{
+    Model model(filename);
+    SimTK::State& s = model.initSystem();
+
+    const CoordinateSet& coords = model.getCoordinateSet();
+    const Set<Muscle>& muscles = model.getMuscles();
+    const int nc = coords.getSize();
+    const int nm = muscles.getSize();
+
+    SimTK::Array_<const Coordinate*> coordinates(nc);
+    for (int i = 0; i < nc; ++i)
+        coordinates[i] = &coords[i];
+    SimTK::Array_<const GeometryPath*> paths(nm);
+    for (int j = 0; j < nm; ++j)
+        paths[j] = &muscles[j].getGeometryPath();
+
+    // Move away from the default pose so that paths are not trivial
+    for (int i = 0; i < nc; ++i) {
+        if (!coords[i].getLocked(s))
+            coords[i].setValue(s, coords[i].getValue(s) + 0.1, false);
+    }
+    model.assemble(s);
+    model.getMultibodySystem().realize(s, SimTK::Stage::Velocity);
+
+    MomentArmSolver solver(model);
+
+    clock_t startTime = clock();
+    SimTK::Matrix pairwise(nc, nm);
+    for (int i = 0; i < nc; ++i) {
+        for (int j = 0; j < nm; ++j)
+            pairwise(i, j) = paths[j]->computeMomentArm(s, *coordinates[i]);
+    }
+    double pairwiseTime = 1.0e3*(clock()-startTime)/CLOCKS_PER_SEC;
+
+    startTime = clock();
+    SimTK::Matrix matrix = solver.solveMatrix(s, paths, coordinates);
+    double matrixTime = 1.0e3*(clock()-startTime)/CLOCKS_PER_SEC;
+
+    for (int i = 0; i < nc; ++i) {
+        for (int j = 0; j < nm; ++j) {
+            ASSERT_EQUAL(pairwise(i, j), matrix(i, j), 1e-10, __FILE__, __LINE__,
+                "Moment-arm matrix of " + muscles[j].getName() + " about "
+                + coords[i].getName() + " does not match: FAILED");
+        }
+    }
+
+    cout << filename << ": " << nc << " coordinates x " << nm << " muscles, " 
+         << "pairwise " << pairwiseTime << "ms, matrix " << matrixTime 
+         << "ms" << endl;
+}
+
+//==========================================================================================================
+// Path lengths computed while perturbing one coordinate at a time, which lets
+// paths reuse what does not depend on that coordinate, must agree with path
+// lengths computed from scratch at the same pose.
+//==========================================================================================================
+void testIncrementalPathComputation(const string &filename)
+{
+    Model model(filename);
+    SimTK::State& s = model.initSystem();
+    // The reference model is always moved to an unrelated pose before the
+    // pose of interest, so none of its paths can be reused.
+    Model reference(filename);
+    SimTK::State& sRef = reference.initSystem();
+
+    const CoordinateSet& coords = model.getCoordinateSet();
+    const CoordinateSet& refCoords = reference.getCoordinateSet();
+    const Set<Muscle>& muscles = model.getMuscles();
+    const Set<Muscle>& refMuscles = reference.getMuscles();
+    const int nc = coords.getSize();
+    const int nm = muscles.getSize();
+
+    SimTK::Random::Uniform random(-0.1, 0.1);
+    random.setSeed(0);
+
+    double incrementalTime = 0.0;
+    double fromScratchTime = 0.0;
+    int nPoses = 0;
+    for (int i = 0; i < nc; ++i) {
+        if (coords[i].getLocked(s))
+            continue;
+        for (int k = -1; k <= 1; k += 2) {
+            const double value = coords[i].getValue(s);
+            coords[i].setValue(s, value + 0.05*k, false);
+            model.getMultibodySystem().realize(s, SimTK::Stage::Position);
+
+            clock_t startTime = clock();
+            SimTK::Vector lengths(nm);
+            for (int j = 0; j < nm; ++j)
+                lengths[j] = muscles[j].getGeometryPath().getLength(s);
+            incrementalTime += 1.0e3*(clock()-startTime)/CLOCKS_PER_SEC;
+
+            // Scramble the reference pose, then move it to the same pose.
+            for (int c = 0; c < nc; ++c) {
+                if (!refCoords[c].getLocked(sRef))
+                    refCoords[c].setValue(sRef, 
+                        coords[c].getValue(s) + random.getValue(), false);
+            }
+            reference.getMultibodySystem().realize(sRef, SimTK::Stage::Position);
+            for (int j = 0; j < nm; ++j)
+                refMuscles[j].getGeometryPath().getLength(sRef);
+            sRef.updQ() = s.getQ();
+            reference.getMultibodySystem().realize(sRef, SimTK::Stage::Position);
+
+            startTime = clock();
+            for (int j = 0; j < nm; ++j) {
+                ASSERT_EQUAL(refMuscles[j].getGeometryPath().getLength(sRef),
+                    lengths[j], 1e-8, __FILE__, __LINE__,
+                    "Length of " + muscles[j].getName() + " after perturbing "
+                    + coords[i].getName() + " does not match: FAILED");
+            }
+            fromScratchTime += 1.0e3*(clock()-startTime)/CLOCKS_PER_SEC;
+
+            coords[i].setValue(s, value, false);
+            ++nPoses;
+        }
+    }
+
+    cout << filename << ": " << nPoses << " poses x " << nm << " muscles, "
+         << "incremental " << incrementalTime << "ms, from scratch " 
+         << fromScratchTime << "ms" << endl;
+}
+
+//==========================================================================================================
+// Editing wrap objects and path points through their methods, without calling
+// initSystem(), must not leave paths with the lengths computed before.
+//==========================================================================================================
+// Double the radius of every wrap cylinder and move the second path point of
+// the first muscle.
+void editPathGeometry(Model& model, const SimTK::State& s)
+{
+    for (int i = 0; i < model.getBodySet().getSize(); ++i) {
+        WrapObjectSet& wraps = model.updBodySet()[i].upd_WrapObjectSet();
+        for (int w = 0; w < wraps.getSize(); ++w) {
+            if (WrapCylinder* cyl = dynamic_cast<WrapCylinder*>(&wraps[w]))
+                cyl->setRadius(2*cyl->getRadius());
+        }
+    }
+    PathPoint& point = 
+        model.updMuscles()[0].updGeometryPath().updPathPointSet()[1];
+    point.setLocation(s, point.getLocation() + SimTK::Vec3(0.01, 0, 0));
+}
+
+// Halve the radius of every wrap cylinder through its property, as the GUI 
+// does, without calling any of its methods.
+void editWrapPropertiesByName(Model& model)
+{
+    for (int i = 0; i < model.getBodySet().getSize(); ++i) {
+        WrapObjectSet& wraps = model.updBodySet()[i].upd_WrapObjectSet();
+        for (int w = 0; w < wraps.getSize(); ++w) {
+            if (!dynamic_cast<WrapCylinder*>(&wraps[w])) continue;
+            PropertyDbl& radius = 
+                dynamic_cast<PropertyDbl&>(wraps[w].updPropertyByName("radius"));
+            radius.setValue(0.5*radius.getValueDbl());
+        }
+    }
+}
+
+void testPathAfterEditingGeometry(const string &filename)
+{
+    Model model(filename);
+    SimTK::State& s = model.initSystem();
+    const Set<Muscle>& muscles = model.getMuscles();
+    const int nm = muscles.getSize();
+    model.getMultibodySystem().realize(s, SimTK::Stage::Position);
+    SimTK::Vector before(nm);
+    for (int j = 0; j < nm; ++j)
+        before[j] = muscles[j].getGeometryPath().getLength(s);
+
+    editPathGeometry(model, s);
+    s.invalidateAllCacheAtOrAbove(SimTK::Stage::Position);
+    model.getMultibodySystem().realize(s, SimTK::Stage::Position);
+
+    Model reference(filename);
+    SimTK::State& sRef = reference.initSystem();
+    editPathGeometry(reference, sRef);
+    SimTK::State& sEdited = reference.initSystem();
+    sEdited.updQ() = s.getQ();
+    reference.getMultibodySystem().realize(sEdited, SimTK::Stage::Position);
+
+    int numChanged = 0;
+    for (int j = 0; j < nm; ++j) {
+        const double length = muscles[j].getGeometryPath().getLength(s);
+        ASSERT_EQUAL(
+            reference.getMuscles()[j].getGeometryPath().getLength(sEdited),
+            length, 1e-10, __FILE__, __LINE__,
+            "Length of " + muscles[j].getName() + " after editing the path "
+            "geometry does not match: FAILED");
+        if (std::abs(length - before[j]) > 1e-8)
+            ++numChanged;
+    }
+    ASSERT(numChanged > 0, __FILE__, __LINE__,
+           "Editing the path geometry should change the muscle lengths.");
+
+    // Edits made through the properties are picked up as well.
+    editWrapPropertiesByName(model);
+    s.invalidateAllCacheAtOrAbove(SimTK::Stage::Position);
+    model.getMultibodySystem().realize(s, SimTK::Stage::Position);
+
+    editWrapPropertiesByName(reference);
+    SimTK::State& sEditedByName = reference.initSystem();
+    sEditedByName.updQ() = s.getQ();
+    reference.getMultibodySystem().realize(sEditedByName, 
+                                           SimTK::Stage::Position);
+    for (int j = 0; j < nm; ++j) {
+        ASSERT_EQUAL(
+            reference.getMuscles()[j].getGeometryPath()
+                .getLength(sEditedByName),
+            muscles[j].getGeometryPath().getLength(s), 1e-10, 
+            __FILE__, __LINE__,
+            "Length of " + muscles[j].getName() + " after editing the wrap "
+            "properties does not match: FAILED");
+    }
+}
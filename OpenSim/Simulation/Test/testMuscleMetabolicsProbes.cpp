@@ -1378,6 +1378,80 @@ void testProbesUsingMillardMuscleSimulation()
 }
 
 
+//==============================================================================
+//                       BENCHMARK PROBES ON A GAIT MODEL
+//==============================================================================
+// Time the evaluation of Umberger2010 and Bhargava2004 probes that include
+// every muscle of a gait model, and check that the reported muscle rates add
+// up to the reported total.
+void benchmarkProbesOnGaitModel()
+{
+    Model model("gait2354_simbody.osim");
+
+    Umberger2010MuscleMetabolicsProbe* umberger =
+        new Umberger2010MuscleMetabolicsProbe(true, true, true, true);
+    umberger->setName("umberger");
+    umberger->set_report_total_metabolics_only(false);
+    model.addProbe(umberger);
+
+    Bhargava2004MuscleMetabolicsProbe* bhargava =
+        new Bhargava2004MuscleMetabolicsProbe(true, true, true, true, true);
+    bhargava->setName("bhargava");
+    bhargava->set_report_total_metabolics_only(false);
+    model.addProbe(bhargava);
+
+    const Set<Muscle>& muscles = model.getMuscles();
+    const int numMuscles = muscles.getSize();
+    for (int i = 0; i < numMuscles; ++i) {
+        umberger->addMuscle(muscles[i].getName(), 0.5);
+        bhargava->addMuscle(muscles[i].getName(), 0.5, 40, 133, 74, 111);
+    }
+
+    State& s = model.initSystem();
+    // Activate the muscles and move the joints so that every heat rate and
+    // the mechanical work rate contribute.
+    for (int i = 0; i < numMuscles; ++i)
+        muscles[i].setActivation(s, 0.05 + 0.9*i/numMuscles);
+    const CoordinateSet& coordinates = model.getCoordinateSet();
+    for (int i = 0; i < coordinates.getSize(); ++i)
+        coordinates[i].setSpeedValue(s, (i % 2 ? 0.5 : -0.5));
+    model.getMultibodySystem().realize(s, Stage::Dynamics);
+
+    const int numEvaluations = 10000;
+    for (const Probe* probe : {(const Probe*)umberger, (const Probe*)bhargava}) {
+        Vector rates = probe->computeProbeInputs(s);
+        ASSERT(rates.size() == numMuscles + 2, __FILE__, __LINE__,
+            probe->getName() + ": wrong number of probe inputs.");
+        double sum = rates[1];
+        for (int i = 0; i < numMuscles; ++i)
+            sum += rates[i+2];
+        ASSERT_EQUAL(rates[0], sum, 1e-10*std::abs(rates[0]), 
+            __FILE__, __LINE__, 
+            probe->getName() + ": muscle rates do not add up to the total.");
+
+        const double start = SimTK::realTime();
+        for (int k = 0; k < numEvaluations; ++k)
+            rates = probe->computeProbeInputs(s);
+        const double elapsed = SimTK::realTime() - start;
+        cout << probe->getConcreteClassName() << " with " << numMuscles
+             << " muscles: " << 1e6*elapsed/numEvaluations 
+             << " us per evaluation." << endl;
+    }
+
+    // A parameter changed after the probe is connected is used.
+    umberger->set_use_Bhargava_recruitment_model(false);
+    const Vector before = umberger->computeProbeInputs(s);
+    umberger->
+        upd_Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet()[0]
+        .set_ratio_slow_twitch_fibers(0.2);
+    const Vector after = umberger->computeProbeInputs(s);
+    ASSERT(after[2] != before[2], __FILE__, __LINE__,
+        "Changed ratio of slow twitch fibers was ignored.");
+    ASSERT(after[3] == before[3], __FILE__, __LINE__,
+        "Changed ratio of slow twitch fibers affected another muscle.");
+}
+
+
 //==============================================================================
 //                                     MAIN
 //==============================================================================
@@ -1406,6 +1480,16 @@ int main()
         failures.push_back("testProbesUsingMillardMuscleSimulation");
     }
 
+    printf("\n"); horizontalRule();
+    cout << "Timing Umberger2010 and Bhargava2004 probes on a gait model" << endl;
+    horizontalRule();
+    try { benchmarkProbesOnGaitModel();
+        cout << "\nbenchmarkProbesOnGaitModel test passed\n" << endl;
+    } catch (const OpenSim::Exception& e) {
+        e.print(cerr);
+        failures.push_back("benchmarkProbesOnGaitModel");
+    }
+
     printf("\n"); horizontalRule(); horizontalRule();
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
@@ -78,9 +78,9 @@ public:
    void copyData(const WrapCylinder& aWrapCylinder);
 
     double getRadius() const { return _radius; }
-    void setRadius(double aRadius) { _radius = aRadius; }
+    void setRadius(double aRadius) { _radius = aRadius; ++_geometryVersion; }
     double getLength() const { return _length; }
-    void setLength(double aLength) { _length = aLength; }
+    void setLength(double aLength) { _length = aLength; ++_geometryVersion; }
 
     const char* getWrapTypeName() const override;
     std::string getDimensionsString() const override;
@@ -88,9 +88,9 @@ public:
     void copyData(const WrapCylinderObst& aWrapCylinderObst);
 
     double getRadius() const { return _radius; }
-    void setRadius(double aRadius) { _radius = aRadius; }
+    void setRadius(double aRadius) { _radius = aRadius; ++_geometryVersion; }
     double getLength() const { return _length; }
-    void setLength(double aLength) { _length = aLength; }
+    void setLength(double aLength) { _length = aLength; ++_geometryVersion; }
     //WrapDirectionEnum getWrapDirection() const { return _wrapDirection; }
     int getWrapDirection() const { return (int)_wrapDirection; }
 
@@ -112,9 +112,9 @@ public:
     void copyData(const WrapDoubleCylinderObst& aWrapDoubleCylinderObst);
 
     double getRadius() const { return _radiusUcyl; }
-    void setRadius(double aRadius) { _radiusUcyl = aRadius; }
+    void setRadius(double aRadius) { _radiusUcyl = aRadius; ++_geometryVersion; }
     double getLength() const { return _length; }
-    void setLength(double aLength) { _length = aLength; }
+    void setLength(double aLength) { _length = aLength; ++_geometryVersion; }
     //WrapDirectionEnum getWrapDirection() const { return _wrapUcylDirection; }
     int getWrapDirection() const { return (int)_wrapUcylDirection; }
 
@@ -285,6 +285,21 @@ int WrapEllipsoid::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::
     // some vectors (r1, r2, c1) from the previous call.
     aWrapResult.factor = 3.0 / (_dimensions[0] + _dimensions[1] + _dimensions[2]);
 
+    // If this segment of the path wrapped over the ellipsoid in the previous
+    // call, its tangent points are usually close to the new ones and are used
+    // to start the search for them. They were stored in the frame of the
+    // wrap object's body.
+    const bool havePreviousTangentPts =
+        previousWrap.startPoint == aWrapResult.startPoint &&
+        previousWrap.endPoint == aWrapResult.endPoint &&
+        previousWrap.r1.isFinite() && previousWrap.r2.isFinite();
+    SimTK::Vec3 previousR1, previousR2;
+    if (havePreviousTangentPts) {
+        previousR1 = _pose.shiftBaseStationToFrame(previousWrap.r1) * aWrapResult.factor;
+        previousR2 = _pose.shiftBaseStationToFrame(previousWrap.r2) * aWrapResult.factor;
+    }
+    aWrapResult.numIterations = 0;
+
     for (i = 0; i < 3; i++)
     {
         p1[i] = aPoint1[i] * aWrapResult.factor;
@@ -547,16 +562,14 @@ int WrapEllipsoid::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::
     // c1[] was still on the first side. The new way of initializing
     // r1 sets it to c1 so that it will stay on c1's side of the
     // ellipsoid.
-    {
-        bool use_c1_to_find_tangent_pts = true;
+    bool use_c1_to_find_tangent_pts = true;
 
-        if (aPathWrap.getMethod() == PathWrap::axial)
-            use_c1_to_find_tangent_pts = (bool) (t[bestMu] > 0.0 && t[bestMu] < 1.0);
+    if (aPathWrap.getMethod() == PathWrap::axial)
+        use_c1_to_find_tangent_pts = (bool) (t[bestMu] > 0.0 && t[bestMu] < 1.0);
 
-        if (use_c1_to_find_tangent_pts)
-            for (i = 0; i < 3; i++)
-                aWrapResult.r1[i] = aWrapResult.r2[i] = aWrapResult.c1[i];
-    }
+    if (use_c1_to_find_tangent_pts)
+        for (i = 0; i < 3; i++)
+            aWrapResult.r1[i] = aWrapResult.r2[i] = aWrapResult.c1[i];
 
     // if wrapping is constrained to one half of the ellipsoid,
     // check to see if we need to flip c1 to the active side of
@@ -602,8 +615,20 @@ int WrapEllipsoid::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::
     vs4 = - Mtx::DotProduct(3, vs, aWrapResult.c1);
 
     // find r1 & r2 by starting at c1 moving toward p1 & p2
-    calcTangentPoint(p1e, aWrapResult.r1, p1, m, a, vs, vs4);
-    calcTangentPoint(p2e, aWrapResult.r2, p2, m, a, vs, vs4);
+    if (use_c1_to_find_tangent_pts && havePreviousTangentPts)
+    {
+        aWrapResult.numIterations +=
+            calcTangentPointFromPrevious(p1e, previousR1, aWrapResult.r1, p1, m, a, vs, vs4);
+        aWrapResult.numIterations +=
+            calcTangentPointFromPrevious(p2e, previousR2, aWrapResult.r2, p2, m, a, vs, vs4);
+    }
+    else
+    {
+        aWrapResult.numIterations +=
+            std::abs(calcTangentPoint(p1e, aWrapResult.r1, p1, m, a, vs, vs4));
+        aWrapResult.numIterations +=
+            std::abs(calcTangentPoint(p2e, aWrapResult.r2, p2, m, a, vs, vs4));
+    }
 
     // create a series of line segments connecting r1 & r2 along the
     // surface of the ellipsoid.
@@ -672,7 +697,8 @@ calc_wrap_path:
  * @param a Ellipsoid axis
  * @param vs Plane vector
  * @param vs4 Plane coefficient
- * @return '1' if the point was adjusted, '0' otherwise
+ * @return The number of iterations taken to adjust the point, or minus that
+ * number if the point did not converge
  */
 int WrapEllipsoid::calcTangentPoint(double p1e, SimTK::Vec3& r1, SimTK::Vec3& p1, SimTK::Vec3& m,
                                                 SimTK::Vec3& a, SimTK::Vec3& vs, double vs4) const
@@ -855,9 +881,63 @@ int WrapEllipsoid::calcTangentPoint(double p1e, SimTK::Vec3& r1, SimTK::Vec3& p1
             ssq = SQR(ee[0]) + SQR(ee[1]) + SQR(ee[2]) + SQR(ee[3]);
             ssqo = ssq;     
         }
+
+        if (ssq > ELLIPSOID_TINY)
+            return -nit;
+        return nit;
     }   
-    return 1;
+    return 0;
+
+}
+
+//_____________________________________________________________________________
+/**
+ * Find the tangent point for p1 by starting from the tangent point found for
+ * it in the previous call, instead of from c1. There are two tangent points
+ * within the plane (vs, vs4), one on each side of the line from p1 through
+ * the center of the ellipse in which the plane cuts the ellipsoid. Starting
+ * from c1 finds the one on c1's side, so if the search from the previous
+ * tangent point does not converge, or converges to the point on the other
+ * side (the wrap has flipped), the search is repeated starting from c1. All
+ * quantities are normalized.
+ *
+ * @param p1e Ellipsoid parameter for 'p1'?
+ * @param previousR1 The tangent point for p1 found in the previous call
+ * @param r1 c1 on entry; the tangent point on return
+ * @param p1 Point outside of ellipsoid
+ * @param m Ellipsoid origin
+ * @param a Ellipsoid axis
+ * @param vs Plane vector
+ * @param vs4 Plane coefficient
+ * @return The total number of iterations taken
+ */
+int WrapEllipsoid::calcTangentPointFromPrevious(double p1e,
+        const SimTK::Vec3& previousR1, SimTK::Vec3& r1, SimTK::Vec3& p1,
+        SimTK::Vec3& m, SimTK::Vec3& a, SimTK::Vec3& vs, double vs4) const
+{
+    const SimTK::Vec3 c1 = r1;
+
+    r1 = previousR1;
+    const int nit = calcTangentPoint(p1e, r1, p1, m, a, vs, vs4);
+    if (nit >= 0)
+    {
+        // Center of the ellipse: the point of the plane at which the
+        // ellipsoid's quadratic form is smallest.
+        SimTK::Vec3 a2vs;
+        for (int i = 0; i < 3; i++)
+            a2vs[i] = SQR(a[i]) * vs[i];
+        const SimTK::Vec3 center =
+            m - ((SimTK::dot(vs, m) + vs4) / SimTK::dot(vs, a2vs)) * a2vs;
+
+        const SimTK::Vec3 p1center = center - p1;
+        const double r1Side = SimTK::dot(vs, SimTK::cross(r1 - p1, p1center));
+        const double c1Side = SimTK::dot(vs, SimTK::cross(c1 - p1, p1center));
+        if (r1Side * c1Side >= 0.0)
+            return nit;
+    }
 
+    r1 = c1;
+    return std::abs(nit) + std::abs(calcTangentPoint(p1e, r1, p1, m, a, vs, vs4));
 }
 
 //_____________________________________________________________________________
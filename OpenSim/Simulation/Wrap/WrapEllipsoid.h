@@ -99,6 +99,9 @@ private:
     void setNull();
     int calcTangentPoint(double p1e, SimTK::Vec3& r1, SimTK::Vec3& p1, SimTK::Vec3& m,
                                                 SimTK::Vec3& a, SimTK::Vec3& vs, double vs4) const;
+    int calcTangentPointFromPrevious(double p1e, const SimTK::Vec3& previousR1,
+        SimTK::Vec3& r1, SimTK::Vec3& p1, SimTK::Vec3& m,
+        SimTK::Vec3& a, SimTK::Vec3& vs, double vs4) const;
     void CalcDistanceOnEllipsoid(SimTK::Vec3& r1, SimTK::Vec3& r2, SimTK::Vec3& m, SimTK::Vec3& a, 
                                                           SimTK::Vec3& vs, double vs4, bool far_side_wrap,
                                                           WrapResult& aWrapResult) const;
@@ -96,6 +96,7 @@ WrapObject::WrapObject(const WrapObject& aWrapObject) :
 void WrapObject::setNull()
 {
     _quadrant = allQuadrants;
+    _geometryVersion = 0;
 }
 
 //_____________________________________________________________________________
@@ -143,6 +144,8 @@ void WrapObject::connectToModelAndBody(Model& aModel, PhysicalFrame& aBody)
     SimTK::Rotation rot;
     rot.setRotationToBodyFixedXYZ(Vec3(_xyzBodyRotation[0], _xyzBodyRotation[1], _xyzBodyRotation[2]));
     _pose.set(rot, _translation);
+    ++_geometryVersion;
+    setObjectIsUpToDateWithProperties();
 }
 
 //_____________________________________________________________________________
@@ -158,6 +161,7 @@ void WrapObject::scale(const SimTK::Vec3& aScaleFactors)
 {
    for (int i=0; i<3; i++)
       _translation[i] *= aScaleFactors[i];
+   ++_geometryVersion;
 }
 
 //_____________________________________________________________________________
@@ -207,6 +211,7 @@ void WrapObject::setQuadrantName(const string& aName)
     _quadrantName = aName;
 
     setupQuadrant();
+    ++_geometryVersion;
 }
 
 //_____________________________________________________________________________
@@ -105,6 +105,9 @@ protected:
     SimTK::Transform _pose;
     const Model* _model;
 
+    // Changed whenever the wrap object is modified through its methods.
+    int _geometryVersion;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -149,7 +152,17 @@ public:
     virtual int wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::Vec3& aPoint2,
         const PathWrap& aPathWrap, WrapResult& aWrapResult, bool& aFlag) const = 0;
 #endif
-    virtual void updateGeometry() {};
+    virtual void updateGeometry() 
+    {   ++_geometryVersion; setObjectIsUpToDateWithProperties(); };
+
+    /** A number that changes whenever the geometry or settings of this wrap
+    object are changed through its methods, including updateGeometry() and
+    connectToModelAndBody(). A GeometryPath uses it to tell whether a wrap
+    it computed earlier is still valid. Editing a property (e.g., from the
+    GUI) clears isObjectUpToDateWithProperties() instead, and a GeometryPath
+    recomputes its wraps over the object until updateGeometry() or 
+    connectToModelAndBody() is called again. */
+    int getGeometryVersion() const { return _geometryVersion; }
 
 protected:
     void setupProperties();
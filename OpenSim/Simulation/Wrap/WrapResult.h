@@ -57,6 +57,7 @@ public:
     SimTK::Vec3 c1;              // intermediate point used by some wrap objects
     SimTK::Vec3 sv;              // intermediate point used by some wrap objects
     double factor;             // scale factor used to normalize parameters
+    int numIterations;         // iterations taken by the wrap object's solver
 
 //=============================================================================
 // METHODS
@@ -277,7 +277,17 @@ int WrapTorus::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::Vec3
     bool far_side_wrap = false;
     aFlag = true;
 
-    if (findClosestPoint(_outerRadius, &aPoint1[0], &aPoint2[0], &closestPt[0], &closestPt[1], &closestPt[2], _wrapSign, _wrapAxis) == 0)
+    // Start from the closest points found the last time this segment of the
+    // path wrapped over the torus, if it did.
+    const WrapResult& previousWrap = aPathWrap.getPreviousWrap();
+    SimTK::Vec3 solution(-SimTK::Infinity);
+    if (previousWrap.startPoint == aWrapResult.startPoint &&
+        previousWrap.endPoint == aWrapResult.endPoint)
+        solution = previousWrap.sv;
+    int numIterations = 0;
+
+    if (findClosestPoint(_outerRadius, &aPoint1[0], &aPoint2[0], &closestPt[0], &closestPt[1], &closestPt[2],
+                         _wrapSign, _wrapAxis, solution, numIterations) == 0)
         return noWrap;
 
     // Now put a cylinder at closestPt and call the cylinder wrap code.
@@ -308,6 +318,8 @@ int WrapTorus::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::Vec3
     Vec3 p1 = cylinderToTorus.shiftFrameStationToBase(aPoint1);
     Vec3 p2 = cylinderToTorus.shiftFrameStationToBase(aPoint2);
     int return_code = cyl.wrapLine(s, p1, p2, aPathWrap, aWrapResult, aFlag);
+    aWrapResult.sv = solution;
+    aWrapResult.numIterations = numIterations;
    if (aFlag == true && return_code > 0) {
         aWrapResult.r1 = cylinderToTorus.shiftBaseStationToFrame(aWrapResult.r1);
         aWrapResult.r2 = cylinderToTorus.shiftBaseStationToFrame(aWrapResult.r2);
@@ -324,6 +336,14 @@ int WrapTorus::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::Vec3
  * to the line between p1 and p2. This circle represents the inner axis of
  * the torus.
  *
+ * The point on the line is searched for twice, once starting at p1 and once
+ * starting at p2. If the same segment of the path wrapped over the torus in
+ * the previous call, the searches start from the points found then instead,
+ * which are usually close to the new ones. If a search from a previous point
+ * does not converge, or if the better of the two points is not on the same
+ * side as in the previous call (the wrap has flipped), the searches are
+ * repeated from p1 and p2.
+ *
  * @param radius The radius of the circle
  * @param p1 One end of the line
  * @param p2 The other end of the line
@@ -332,29 +352,22 @@ int WrapTorus::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::Vec3
  * @param zc The Z coordinate of the closest point
  * @param wrap_sign If wrap is constrained to a quadrant, the sign of the relevant axis
  * @param wrap_axis If wrap is constrained to a quadrant, the relevant axis
+ * @param solution On entry, the distances along the line of the two points
+ * found in the previous call and the index of the better one, or non-finite
+ * values if there was no previous call; on return, those of this call
+ * @param numIterations Incremented by the number of residual evaluations
  * @return '1' if a closest point was found, '0' if there was an error while trying to constrain the wrap
  */
 int WrapTorus::findClosestPoint(double radius, double p1[], double p2[],
                                           double* xc, double* yc, double* zc,
-                                          int wrap_sign, int wrap_axis) const
+                                          int wrap_sign, int wrap_axis,
+                                          SimTK::Vec3& solution, int& numIterations) const
 {
-   int info;                  // output flag
-   int num_func_calls;        // number of calls to func (nfev)
-   int ldfjac = 1;            // leading dimension of fjac (nres)
-   int numResid = 1;
-   int numQs = 1;
-   double q[2], resid[2], fjac[2];            // m X n array
    CircleCallback cb;
    bool constrained = (bool) (wrap_sign != 0);
-   // solution parameters
-   int mode = 1, nprint = 0, max_iter = 500;
-   double ftol = 1e-4, xtol = 1e-4, gtol = 0.0;
-   double epsfcn = 0.0, step_factor = 0.2;
-   // work arrays
-   int ipvt[2];  
-   double diag[2], qtf[2], wa1[2], wa2[2], wa3[2], wa4[2];
+   bool warmStart = solution.isFinite();
    // Circle variables
-   double u, mag, nx, ny, nz, x, y, z, a1[3], a2[3], distance1, distance2, betterPt = 0;
+   double u1, u2, mag, nx, ny, nz, x, y, z, a1[3], a2[3], distance1, distance2, betterPt = 0;
 
    cb.p1[0] = p1[0];
    cb.p1[1] = p1[1];
@@ -364,14 +377,8 @@ int WrapTorus::findClosestPoint(double radius, double p1[], double p2[],
    cb.p2[2] = p2[2];
    cb.r = radius;
 
-   q[0] = 0.0;
-
-   lmdif_C(calcCircleResids, numResid, numQs, q, resid,
-           ftol, xtol, gtol, max_iter, epsfcn, diag, mode, step_factor,
-           nprint, &info, &num_func_calls, fjac, ldfjac, ipvt, qtf,
-           wa1, wa2, wa3, wa4, (void*)&cb);
-
-   u = q[0];
+   u1 = warmStart ? solution[0] : 0.0;
+   numIterations += findClosestPointOnLine(cb, u1, warmStart);
 
    mag = sqrt((p2[0]-p1[0])*(p2[0]-p1[0]) + (p2[1]-p1[1])*(p2[1]-p1[1]) + (p2[2]-p1[2])*(p2[2]-p1[2]));
 
@@ -379,9 +386,9 @@ int WrapTorus::findClosestPoint(double radius, double p1[], double p2[],
    ny = (p2[1]-p1[1]) / mag;
    nz = (p2[2]-p1[2]) / mag;
 
-   x = p1[0] + u * nx;
-   y = p1[1] + u * ny;
-   z = p1[2] + u * nz;
+   x = p1[0] + u1 * nx;
+   y = p1[1] + u1 * ny;
+   z = p1[2] + u1 * nz;
 
    // Store the result from the first pass.
    a1[0] = x;
@@ -399,24 +406,16 @@ int WrapTorus::findClosestPoint(double radius, double p1[], double p2[],
    cb.p2[2] = p1[2];
    cb.r = radius;
 
-   q[0] = 0.0;
-
-   lmdif_C(calcCircleResids, numResid, numQs, q, resid,
-           ftol, xtol, gtol, max_iter, epsfcn, diag, mode, step_factor,
-           nprint, &info, &num_func_calls, fjac, ldfjac, ipvt, qtf,
-           wa1, wa2, wa3, wa4, (void*)&cb);
-
-   u = q[0];
-
-   mag = sqrt((p2[0]-p1[0])*(p2[0]-p1[0]) + (p2[1]-p1[1])*(p2[1]-p1[1]) + (p2[2]-p1[2])*(p2[2]-p1[2]));
+   u2 = warmStart ? solution[1] : 0.0;
+   numIterations += findClosestPointOnLine(cb, u2, warmStart);
 
    nx = (p1[0]-p2[0]) / mag;
    ny = (p1[1]-p2[1]) / mag;
    nz = (p1[2]-p2[2]) / mag;
 
-   x = p2[0] + u * nx;
-   y = p2[1] + u * ny;
-   z = p2[2] + u * nz;
+   x = p2[0] + u2 * nx;
+   y = p2[1] + u2 * ny;
+   z = p2[2] + u2 * nz;
 
    // Store the result from the second pass.
    a2[0] = x;
@@ -449,7 +448,7 @@ int WrapTorus::findClosestPoint(double radius, double p1[], double p2[],
       else
       {
          // no wrapping should occur
-         return 0;
+         betterPt = -1;
       }
    }
    else
@@ -460,6 +459,21 @@ int WrapTorus::findClosestPoint(double radius, double p1[], double p2[],
          betterPt = 1;
    }
 
+   if (warmStart && betterPt != solution[2])
+   {
+      solution = SimTK::Vec3(-SimTK::Infinity);
+      return findClosestPoint(radius, p1, p2, xc, yc, zc, wrap_sign, wrap_axis,
+                              solution, numIterations);
+   }
+
+   if (betterPt < 0)
+   {
+      solution = SimTK::Vec3(-SimTK::Infinity);
+      return 0;
+   }
+
+   solution = SimTK::Vec3(u1, u2, betterPt);
+
    // a1 and a2 represent the points on the line that are closest to the circle.
    // What you need to find and return is the corresponding point on the circle.
    if (betterPt == 0)
@@ -480,6 +494,59 @@ int WrapTorus::findClosestPoint(double radius, double p1[], double p2[],
    return 1;
 }
 
+//_____________________________________________________________________________
+/**
+ * A utility function used by findClosestPoint. Find the point on the line
+ * from cb.p1 to cb.p2 that is closest to the circle, as its distance u from
+ * cb.p1. If warmStart is true, the search starts at the given value of u and
+ * is repeated from cb.p1 if it does not converge; otherwise it starts at cb.p1.
+ *
+ * @param cb The line and the circle radius
+ * @param u The starting and resulting distance along the line
+ * @param warmStart Whether to start the search at the given value of u
+ * @return The number of residual evaluations
+ */
+int WrapTorus::findClosestPointOnLine(CircleCallback& cb, double& u,
+                                      bool warmStart)
+{
+   int info;                  // output flag
+   int num_func_calls;        // number of calls to func (nfev)
+   int ldfjac = 1;            // leading dimension of fjac (nres)
+   int numResid = 1;
+   int numQs = 1;
+   double q[2], resid[2], fjac[2];            // m X n array
+   // solution parameters
+   int mode = 1, nprint = 0, max_iter = 500;
+   double ftol = 1e-4, xtol = 1e-4, gtol = 0.0;
+   double epsfcn = 0.0, step_factor = 0.2;
+   // work arrays
+   int ipvt[2];  
+   double diag[2], qtf[2], wa1[2], wa2[2], wa3[2], wa4[2];
+
+   q[0] = warmStart ? u : 0.0;
+
+   lmdif_C(calcCircleResids, numResid, numQs, q, resid,
+           ftol, xtol, gtol, max_iter, epsfcn, diag, mode, step_factor,
+           nprint, &info, &num_func_calls, fjac, ldfjac, ipvt, qtf,
+           wa1, wa2, wa3, wa4, (void*)&cb);
+
+   // lmdif converged if info is 1 through 4.
+   if (warmStart && (info < 1 || info > 4))
+   {
+      const int numWarmFuncCalls = num_func_calls;
+      q[0] = 0.0;
+      lmdif_C(calcCircleResids, numResid, numQs, q, resid,
+              ftol, xtol, gtol, max_iter, epsfcn, diag, mode, step_factor,
+              nprint, &info, &num_func_calls, fjac, ldfjac, ipvt, qtf,
+              wa1, wa2, wa3, wa4, (void*)&cb);
+      num_func_calls += numWarmFuncCalls;
+   }
+
+   u = q[0];
+
+   return num_func_calls;
+}
+
 //_____________________________________________________________________________
 /**
  * A utility function used by findClosestPoint. The single residual that it
@@ -99,7 +99,10 @@ private:
     void setNull();
     int findClosestPoint(double radius, double p1[], double p2[],
         double* xc, double* yc, double* zc,
-        int wrap_sign, int wrap_axis) const;
+        int wrap_sign, int wrap_axis,
+        SimTK::Vec3& solution, int& numIterations) const;
+    static int findClosestPointOnLine(CircleCallback& cb, double& u,
+        bool warmStart);
     static void calcCircleResids(int numResid, int numQs, double q[],
         double resid[], int *flag2, void *ptr);
 
@@ -27,6 +27,7 @@
 #include "simbody/internal/CableTrackerSubsystem.h"
 #include "simbody/internal/CablePath.h"
 
+#include <ctime>
 #include <set>
 #include <string>
 #include <iostream>
@@ -51,6 +52,7 @@ void simulateModelWithPassiveMuscles(const string &modelFile, double finalTime);
 void simulateModelWithoutMuscles(const string &modelFile, double finalTime);
 void simulateModelWithLigaments(const string &modelFile, double finalTime);
 void simulateModelWithCables(const string &modelFile, double finalTime);
+void testWarmStartedWrapping(const string &modelFile, int numSteps);
 
 int main()
 {
@@ -62,6 +64,12 @@ int main()
         std::cout << "Exception: " << e.what() << std::endl;
         failures.push_back("TestShoulderModel (multiple wrap)"); }
 
+    try{// ellipsoid and torus wrapping over the range of motion
+        testWarmStartedWrapping("upper_limb.osim", 200);}
+    catch (const std::exception& e) {
+        std::cout << "Exception: " << e.what() << std::endl;
+        failures.push_back("upper_limb (warm-started wrap)"); }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -345,6 +353,68 @@ void simulateModelWithMusclesNoViz(const string &modelFile, double finalTime, do
 
 
 
+// Sweep the coordinates of a model over their ranges of motion and compute
+// the muscle lengths at each step, first with each ellipsoid and torus wrap
+// starting from the tangent points found at the previous step, then again
+// starting from scratch at every step. The lengths must agree.
+void testWarmStartedWrapping(const string &modelFile, int numSteps)
+{
+    Model osimModel(modelFile);
+    SimTK::State& si = osimModel.initSystem();
+
+    const CoordinateSet& coords = osimModel.getCoordinateSet();
+    const Set<Muscle>& muscles = osimModel.getMuscles();
+
+    SimTK::Matrix lengths(numSteps+1, muscles.getSize());
+    for (int pass = 0; pass < 2; ++pass) {
+        const bool warmStart = (pass == 0);
+        int numWraps = 0, numIterations = 0;
+        std::clock_t start = std::clock();
+        for (int k = 0; k <= numSteps; ++k) {
+            for (int i = 0; i < coords.getSize(); ++i) {
+                const Coordinate& c = coords[i];
+                if (c.getLocked(si) || c.isConstrained(si))
+                    continue;
+                c.setValue(si, c.getRangeMin() +
+                    (c.getRangeMax() - c.getRangeMin())*k/numSteps, false);
+            }
+            osimModel.getMultibodySystem().realize(si, Stage::Position);
+
+            for (int j = 0; j < muscles.getSize(); ++j) {
+                const PathWrapSet& wraps =
+                    muscles[j].getGeometryPath().getWrapSet();
+                if (!warmStart)
+                    for (int w = 0; w < wraps.getSize(); ++w)
+                        wraps.get(w).resetPreviousWrap();
+
+                const double length = muscles[j].getLength(si);
+                if (warmStart)
+                    lengths(k, j) = length;
+                else
+                    ASSERT_EQUAL(lengths(k, j), length, 1e-6, __FILE__,
+                        __LINE__, "Warm-started wrapping of " +
+                        muscles[j].getName() + " changed its length.");
+
+                for (int w = 0; w < wraps.getSize(); ++w) {
+                    const string type =
+                        wraps.get(w).getWrapObject()->getWrapTypeName();
+                    const WrapResult& wrap = wraps.get(w).getPreviousWrap();
+                    if ((type == "ellipsoid" || type == "torus") &&
+                            wrap.wrap_pts.getSize() > 0) {
+                        ++numWraps;
+                        numIterations += wrap.numIterations;
+                    }
+                }
+            }
+        }
+        double duration = 1.e3*(std::clock() - start)/CLOCKS_PER_SEC;
+        cout << modelFile << (warmStart ? " warm" : " cold")
+             << "-started wrapping: " << duration/(numSteps+1)
+             << " ms per step, " << (numWraps ? double(numIterations)/numWraps : 0.)
+             << " iterations per ellipsoid/torus wrap." << endl;
+    }
+}
+
 void simulateModelWithPassiveMuscles(const string &modelFile, double finalTime)
 {
     // Create a new OpenSim model
@@ -34,6 +34,8 @@
 #include <OpenSim/Analyses/ProbeReporter.h>
 #include <OpenSim/Simulation/Model/PrescribedForce.h>
 #include <OpenSim/Actuators/Thelen2003Muscle.h>
+#include <algorithm>
+#include <memory>
 
 using namespace OpenSim;
 using namespace std;
@@ -196,6 +198,7 @@ setNull()
 
     _printResultFiles = true;
     _replaceForceSet = false;
+    _numThreads = 1;
 }
 //_____________________________________________________________________________
 /**
@@ -261,6 +264,7 @@ operator=(const AnalyzeTool &aTool)
     _lowpassCutoffFrequency= aTool._lowpassCutoffFrequency;
     _statesStore = aTool._statesStore;
     _printResultFiles = aTool._printResultFiles;
+    _numThreads = aTool._numThreads;
     return(*this);
 }
 
@@ -568,7 +572,7 @@ bool AnalyzeTool::run(bool plotting)
     //}
 
     cout<<"Executing the analyses from "<<ti<<" to "<<tf<<"..."<<endl;
-    run(s, *_model, iInitial, iFinal, *_statesStore, _solveForEquilibriumForAuxiliaryStates);
+    run(s, *_model, iInitial, iFinal, *_statesStore, _solveForEquilibriumForAuxiliaryStates, _numThreads);
     _model->getMultibodySystem().realize(s, SimTK::Stage::Position );
     } catch (const Exception& x) {
         x.print(cout);
@@ -590,7 +594,118 @@ bool AnalyzeTool::run(bool plotting)
 //=============================================================================
 // HELPER
 //=============================================================================
+namespace {
+// Set the state to frame i of the states storage and realize it to Velocity.
+void setStateToFrame(SimTK::State& s, Model& aModel, const Storage& aStatesStore,
+                     int i, SimTK::Vector& stateData, bool aSolveForEquilibrium)
+{
+    aStatesStore.getTime(i,s.updTime()); // time
+    double t = s.getTime();
+    aModel.setAllControllersEnabled(true);
+
+    aStatesStore.getData(i,stateData.size(),&stateData[0]); // states
+    // Get data into local Vector and assign to State using common utility
+    // to handle internal (non-OpenSim) states that may exist
+    const Array<std::string>& stateNames = aStatesStore.getColumnLabels();
+    for (int j=0; j<stateData.size(); ++j){
+        // storage labels included time at index 0 so +1 to skip
+        aModel.setStateVariableValue(s, stateNames[j+1], stateData[j]);
+    }
+
+    // Adjust configuration to match constraints and other goals
+    aModel.assemble(s);
+
+    // equilibrateMuscles before realization as it may affect forces
+    if(aSolveForEquilibrium){
+        try{// might not be able to equilibrate if model is in
+            // a non-physical pose. For example, a pose where the 
+            // muscle length is shorter than the tendon slack-length.
+            // the muscle will throw an Exception in this case.
+            aModel.equilibrateMuscles(s);
+        }
+        catch (const std::exception& e) {
+            cout << "WARNING- AnalyzeTool::run() unable to equilibrate muscles ";
+            cout << "at time = " << t <<"." << endl;
+            cout << "Reason: " << e.what() << endl;
+        }
+    }
+    // Make sure model is at least ready to provide kinematics
+    aModel.getMultibodySystem().realize(s, SimTK::Stage::Velocity);
+}
+
+// Analyze frames iFirst to iLast of the states storage. The analyses begin
+// at the first frame and, if aEnd is true, end at the last one. They step
+// at the other frames.
+void analyzeFrames(SimTK::State& s, Model& aModel,
+                   const std::vector<Analysis*>& aAnalyses,
+                   int iFirst, int iLast, bool aEnd,
+                   const Storage& aStatesStore, bool aSolveForEquilibrium)
+{
+    SimTK::Vector stateData(aStatesStore.getColumnLabels().getSize()-1);
+
+    for(int i=iFirst;i<=iLast;i++) {
+        setStateToFrame(s, aModel, aStatesStore, i, stateData,
+                        aSolveForEquilibrium);
+
+        for(Analysis* analysis : aAnalyses) {
+            if(!analysis->getOn()) continue;
+            if(i==iFirst) {
+                analysis->begin(s);
+            } else if(i==iLast && aEnd) {
+                analysis->end(s);
+            // Step
+            } else {
+                analysis->step(s,i);
+            }
+        }
+    }
+}
+
+// Analyzes one chunk of frames per task index.
+class AnalyzeChunkTask : public SimTK::ParallelExecutor::Task {
+public:
+    AnalyzeChunkTask(const std::vector<Model*>& models,
+                     const std::vector<SimTK::State*>& states,
+                     const std::vector<std::vector<Analysis*> >& analyses,
+                     const std::vector<int>& firstFrames, int iFinal,
+                     const Storage& statesStore, bool solveForEquilibrium,
+                     std::vector<std::string>& errors) :
+        _models(models), _states(states), _analyses(analyses),
+        _firstFrames(firstFrames), _iFinal(iFinal),
+        _statesStore(statesStore),
+        _solveForEquilibrium(solveForEquilibrium), _errors(errors) {}
+
+    void execute(int index) override {
+        const int numChunks = (int)_firstFrames.size();
+        const bool isLast = index == numChunks-1;
+        const int iLast = isLast ? _iFinal : _firstFrames[index+1]-1;
+        try {
+            analyzeFrames(*_states[index], *_models[index], _analyses[index],
+                          _firstFrames[index], iLast, isLast,
+                          _statesStore, _solveForEquilibrium);
+        }
+        catch (const std::exception& e) {
+            _errors[index] = e.what();
+        }
+    }
+private:
+    const std::vector<Model*>& _models;
+    const std::vector<SimTK::State*>& _states;
+    const std::vector<std::vector<Analysis*> >& _analyses;
+    const std::vector<int>& _firstFrames;
+    int _iFinal;
+    const Storage& _statesStore;
+    bool _solveForEquilibrium;
+    std::vector<std::string>& _errors;
+};
+}
+
 void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium)
+{
+    run(s, aModel, iInitial, iFinal, aStatesStore, aSolveForEquilibrium, 1);
+}
+
+void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium, int aNumThreads)
 {
     AnalysisSet& analysisSet = aModel.updAnalysisSet();
 
@@ -601,60 +716,67 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
     // TODO: some sort of filtering or something to make derivatives smoother?
     GCVSplineSet statesSplineSet(5,&aStatesStore);
 
+    // Analyses that record each frame independently of the others analyze
+    // chunks of the frames in parallel. The others see every frame in order.
+    const int numChunks = std::max(1, std::min(aNumThreads, iFinal-iInitial+1));
+    std::vector<Analysis*> serialAnalyses, parallelAnalyses;
+    for(int i=0;i<analysisSet.getSize();i++) {
+        Analysis& analysis = analysisSet.get(i);
+        if(!analysis.getOn()) continue;
+        if(numChunks>1 && analysis.isFrameIndependent()
+                && analysis.getStepInterval()==1)
+            parallelAnalyses.push_back(&analysis);
+        else
+            serialAnalyses.push_back(&analysis);
+    }
+
     // PERFORM THE ANALYSES
-    double tPrev=0.0,t=0.0,dt=0.0;
-    int ny = s.getNY();
-    Array<double> dydt(0.0,ny);
-    Array<double> yFromStorage(0.0,ny);
-
-    const Array<string>& labels =  aStatesStore.getColumnLabels();
-    int numOpenSimStates = labels.getSize()-1;
-
-    SimTK::Vector stateData;
-    stateData.resize(numOpenSimStates);
-
-    for(int i=iInitial;i<=iFinal;i++) {
-        tPrev = t;
-        aStatesStore.getTime(i,s.updTime()); // time
-        t = s.getTime();
-        aModel.setAllControllersEnabled(true);
-
-        aStatesStore.getData(i,numOpenSimStates,&stateData[0]); // states
-        // Get data into local Vector and assign to State using common utility
-        // to handle internal (non-OpenSim) states that may exist
-        Array<std::string> stateNames = aStatesStore.getColumnLabels();
-        for (int j=0; j<stateData.size(); ++j){
-            // storage labels included time at index 0 so +1 to skip
-            aModel.setStateVariableValue(s, stateNames[j+1], stateData[j]);
-        }
-       
-        // Adjust configuration to match constraints and other goals
-        aModel.assemble(s);
-
-        // equilibrateMuscles before realization as it may affect forces
-        if(aSolveForEquilibrium){
-            try{// might not be able to equilibrate if model is in
-                // a non-physical pose. For example, a pose where the 
-                // muscle length is shorter than the tendon slack-length.
-                // the muscle will throw an Exception in this case.
-                aModel.equilibrateMuscles(s);
-            }
-            catch (const std::exception& e) {
-                cout << "WARNING- AnalyzeTool::run() unable to equilibrate muscles ";
-                cout << "at time = " << t <<"." << endl;
-                cout << "Reason: " << e.what() << endl;
-            }
+    if(!serialAnalyses.empty()) {
+        analyzeFrames(s, aModel, serialAnalyses, iInitial, iFinal, true,
+                      aStatesStore, aSolveForEquilibrium);
+    }
+    if(parallelAnalyses.empty()) return;
+
+    // The first chunk is analyzed on aModel. Each of the others is analyzed
+    // by copies of the analyses on a copy of the model.
+    std::vector<std::unique_ptr<Model> > modelCopies(numChunks);
+    std::vector<Model*> models(numChunks, &aModel);
+    std::vector<SimTK::State*> states(numChunks, &s);
+    std::vector<std::vector<Analysis*> > analyses(numChunks, parallelAnalyses);
+    std::vector<int> firstFrames(numChunks);
+    const int numFrames = iFinal-iInitial+1;
+    for(int c=0;c<numChunks;c++) {
+        firstFrames[c] = iInitial + (c*numFrames)/numChunks;
+        if(c==0) continue;
+
+        modelCopies[c].reset(aModel.clone());
+        models[c] = modelCopies[c].get();
+        for(Analysis*& analysis : analyses[c]) {
+            Analysis* copy = analysis->clone();
+            copy->setModel(*models[c]);
+            copy->setStatesStore(aStatesStore);
+            models[c]->addAnalysis(copy);
+            analysis = copy;
         }
-        // Make sure model is at least ready to provide kinematics
-        aModel.getMultibodySystem().realize(s, SimTK::Stage::Velocity);
-
-        if(i==iInitial) {
-            analysisSet.begin(s);
-        } else if(i==iFinal) {
-            analysisSet.end(s);
-        // Step
-        } else {
-            analysisSet.step(s,i);
+        states[c] = &models[c]->initSystem();
+    }
+
+    std::vector<std::string> errors(numChunks);
+    AnalyzeChunkTask task(models, states, analyses, firstFrames, iFinal,
+                          aStatesStore, aSolveForEquilibrium, errors);
+    SimTK::ParallelExecutor executor(numChunks);
+    executor.execute(task, numChunks);
+
+    for(int c=0;c<numChunks;c++) {
+        if(!errors[c].empty()) {
+            string msg = "AnalyzeTool::run: ERROR- " + errors[c];
+            throw Exception(msg,__FILE__,__LINE__);
         }
     }
+
+    // Gather the results of the chunks in time order.
+    for(int c=1;c<numChunks;c++) {
+        for(size_t i=0;i<parallelAnalyses.size();i++)
+            parallelAnalyses[i]->appendResults(*analyses[c][i]);
+    }
 }
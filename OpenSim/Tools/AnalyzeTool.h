@@ -77,6 +77,9 @@ private:
 
     /** Whether the model and states should be loaded from input files */
     bool _loadModelAndInput;
+
+    /** Number of threads used to analyze the states. */
+    int _numThreads;
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -121,6 +124,14 @@ public:
     void setLowpassCutoffFrequency(double aLowpassCutoffFrequency) { _lowpassCutoffFrequency = aLowpassCutoffFrequency; }
     const bool getLoadModelAndInput() const { return _loadModelAndInput; }
     void setLoadModelAndInput(bool b) { _loadModelAndInput = b; }
+    /** %Set the number of threads used to analyze the states. With more than
+    one thread, the frames of the states are split into contiguous chunks
+    that are analyzed in parallel, each by copies of the analyses on a copy
+    of the model, for the analyses that are frame independent (see
+    Analysis::isFrameIndependent()) and record every step. The other
+    analyses see every frame, in order, on the model. The default is 1. */
+    void setNumThreads(int aNumThreads) { _numThreads = aNumThreads; }
+    int getNumThreads() const { return _numThreads; }
 
     //--------------------------------------------------------------------------
     // UTILITIES
@@ -141,6 +152,7 @@ public:
     //--------------------------------------------------------------------------
 #ifndef SWIG
     static void run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium);
+    static void run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium, int aNumThreads);
 #endif
 //=============================================================================
 };  // END of class AnalyzeTool
@@ -63,6 +63,11 @@ protected:
     /** States for the simulation. */
     Storage *_yDesStore;
 
+    /** Where the previous lookup of the desired states left off, so that
+    lookups at nearby times are O(1). It is updated by computeControls(), so
+    a controller must not compute controls on several threads at once. */
+    mutable Storage::InterpolationCursor _desiredStatesCursor;
+
 
 //=============================================================================
 // METHODS
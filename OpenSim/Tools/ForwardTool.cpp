@@ -36,6 +36,9 @@
 #include <OpenSim/Simulation/Model/PrescribedForce.h>
 #include <OpenSim/Simulation/SimbodyEngine/SimbodyEngine.h>
 #include "CorrectionController.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
 
 using namespace std;
 using namespace SimTK;
@@ -368,6 +371,275 @@ void ForwardTool::printResults()
 
 
 
+//=============================================================================
+// BATCH
+//=============================================================================
+namespace {
+// The model, states and initial conditions shared by all the cases simulated
+// on one thread.
+struct ForwardWorker {
+    std::unique_ptr<Model> model;
+    std::unique_ptr<Storage> yStore;
+    SimTK::State defaultState;
+    bool initialized = false;
+};
+
+// The final time and states of a case.
+struct ForwardCaseResult {
+    double time = SimTK::NaN;
+    SimTK::Vector y;
+    std::string errorMessage;
+};
+
+// Set the properties given by a case, each keyed by a component path and a
+// property name, from their values in model file format.
+void setCaseProperties(Model& model, const ForwardCase& aCase)
+{
+    for (const auto& entry : aCase.propertyValues) {
+        const std::string& key = entry.first;
+        const size_t slash = key.rfind('/');
+        Object& owner = (slash == std::string::npos) ? 
+            static_cast<Object&>(model) : 
+            static_cast<Object&>(model.updComponent(key.substr(0, slash)));
+        const std::string propertyName = 
+            (slash == std::string::npos) ? key : key.substr(slash+1);
+        AbstractProperty& prop = owner.updPropertyByName(propertyName);
+
+        SimTK::Xml::Element parent(owner.getConcreteClassName());
+        parent.insertNodeAfter(parent.node_end(), 
+            SimTK::Xml::Element(propertyName, entry.second));
+        prop.readFromXMLParentElement(parent, 
+                                      XMLDocument::getLatestVersion());
+    }
+}
+
+// Simulates the case of each task index on the calling thread's worker.
+class ForwardCaseTask : public SimTK::ParallelExecutor::Task {
+public:
+    ForwardCaseTask(const ForwardTool& tool, 
+                    std::vector<ForwardWorker>& workers,
+                    const std::vector<ForwardCase>& cases,
+                    std::vector<ForwardCaseResult>& results,
+                    const Array<double>& initialStates,
+                    int startIndexForYStore, const Array<double>& timeSteps,
+                    bool combineResults) :
+        _tool(tool), _workers(workers), _cases(cases), _results(results),
+        _initialStates(initialStates), 
+        _startIndexForYStore(startIndexForYStore), _timeSteps(timeSteps),
+        _combineResults(combineResults), _worker(-1), _nextWorker(0) {}
+
+    // Each thread takes the next unused worker before its first case.
+    void initialize() override {
+        _worker.upd() = _nextWorker++;
+    }
+
+    void execute(int index) override {
+        try {
+            simulate(_workers[_worker.get()], _cases[index], _results[index]);
+        }
+        catch (const std::exception& ex) {
+            // Exceptions must not escape a worker thread.
+            _results[index].errorMessage = ex.what();
+        }
+    }
+
+private:
+    void simulate(ForwardWorker& worker, const ForwardCase& aCase,
+                  ForwardCaseResult& result) 
+    {
+        // A case that changes the model is simulated on its own copy of
+        // the worker's model; the others share the worker's model.
+        std::unique_ptr<Model> caseModel;
+        Model* model = worker.model.get();
+        SimTK::State s;
+        if (!aCase.propertyValues.empty() || 
+                !aCase.controlsFileName.empty()) {
+            caseModel.reset(worker.model->clone());
+            model = caseModel.get();
+            setCaseProperties(*model, aCase);
+            if (!aCase.controlsFileName.empty()) {
+                ControlSetController* controller = new ControlSetController();
+                controller->setName(aCase.name + "_controls");
+                controller->setControlSetFileName(aCase.controlsFileName);
+                model->addController(controller);
+            }
+            s = model->initSystem();
+            model->updControllerSet().setDesiredStates(worker.yStore.get());
+        }
+        else {
+            if (!worker.initialized) {
+                worker.defaultState = model->initSystem();
+                model->updControllerSet().setDesiredStates(
+                        worker.yStore.get());
+                worker.initialized = true;
+            }
+            s = worker.defaultState;
+        }
+
+        // SET THE INITIAL STATES
+        s.updTime() = _tool.getInitialTime();
+        if (_startIndexForYStore >= 0) {
+            Array<std::string> stateNames = model->getStateVariableNames();
+            for (int i = 0; i < stateNames.getSize(); ++i)
+                model->setStateVariableValue(s, stateNames[i], 
+                                             _initialStates[i]);
+        }
+        for (const auto& value : aCase.stateValues)
+            model->setStateVariableValue(s, value.first, value.second);
+        if (_tool.getSolveForEquilibrium())
+            model->equilibrateMuscles(s);
+
+        // INTEGRATE
+        SimTK::RungeKuttaMersonIntegrator integrator(
+                model->getMultibodySystem());
+        integrator.setInternalStepLimit(_tool.getMaximumNumberOfSteps());
+        integrator.setMaximumStepSize(_tool.getMaxDT());
+        integrator.setAccuracy(_tool.getErrorTolerance());
+        Manager manager(*model, integrator);
+        manager.setSessionName(_tool.getName() + "_" + aCase.name);
+        manager.setInitialTime(_tool.getInitialTime());
+        manager.setFinalTime(_tool.getFinalTime());
+        manager.setWriteToStorage(!_combineResults);
+        if (_timeSteps.getSize() > 0) {
+            manager.setUseSpecifiedDT(true);
+            manager.setDTArray(_timeSteps.getSize(), &_timeSteps[0], 
+                               worker.yStore->getFirstTime());
+        }
+        manager.integrate(s);
+
+        result.time = s.getTime();
+        result.y = model->getStateVariableValues(s);
+        if (!_combineResults)
+            manager.getStateStorage().print(_tool.getResultsDir() + "/" 
+                + _tool.getName() + "_" + aCase.name + "_states.sto");
+    }
+
+    const ForwardTool& _tool;
+    std::vector<ForwardWorker>& _workers;
+    const std::vector<ForwardCase>& _cases;
+    std::vector<ForwardCaseResult>& _results;
+    const Array<double>& _initialStates;
+    int _startIndexForYStore;
+    const Array<double>& _timeSteps;
+    bool _combineResults;
+    SimTK::ThreadLocal<int> _worker;
+    std::atomic<int> _nextWorker;
+};
+} // anonymous namespace
+
+//_____________________________________________________________________________
+/**
+ * Run a batch of forward simulations.
+ */
+int ForwardTool::runBatch(const std::vector<ForwardCase>& cases, 
+                          int numThreads, bool combineResults)
+{
+    cout<<"Running tool "<<getName()<<" for "<<cases.size()<<" cases."<<endl;
+    // CHECK FOR A MODEL
+    if(_model==NULL) {
+        string msg = "ERROR- A model has not been set.";
+        cout<<endl<<msg<<endl;
+        throw(Exception(msg,__FILE__,__LINE__));
+    }
+    if(cases.empty()) return 0;
+
+    // SET OUTPUT PRECISION
+    IO::SetPrecision(_outputPrecision);
+
+    // The working directory is shared by all threads, so change it once
+    // here rather than per case.
+    string saveWorkingDirectory = IO::getCwd();
+    string directoryOfSetupFile = IO::getParentDirectory(getDocumentFileName());
+    IO::chDir(directoryOfSetupFile);
+
+    int numCompleted = 0;
+    try {
+        createExternalLoads(_externalLoadsFileName, *_model);
+        _model->initSystem();
+
+        delete _yStore;
+        loadStatesStorage(_statesFileName, _yStore);
+        int startIndexForYStore = determineInitialTimeFromStatesStorage(_ti);
+        int numStateVariables = _model->getNumStateVariables();
+        Array<double> initialStates(0.0, numStateVariables);
+        if(startIndexForYStore >= 0)
+            _yStore->getData(startIndexForYStore,numStateVariables,
+                             &initialStates[0]);
+
+        // The time steps of the states file, if the integrators are to
+        // follow them.
+        Array<double> timeSteps;
+        if(_useSpecifiedDt) {
+            if(_yStore && _yStore->getSize() > 1) {
+                Array<double> tArray(0.0,_yStore->getSize());
+                _yStore->getTimeColumn(tArray);
+                timeSteps.setSize(_yStore->getSize()-1);
+                for(int i=0;i<timeSteps.getSize();i++) 
+                    timeSteps[i]=tArray[i+1]-tArray[i];
+            } else {
+                std::cout << "WARNING: Ignoring 'use_specified_dt' property because no initial states file is specified" << std::endl;
+            }
+        }
+
+        // Each thread gets its own copy of the model and the states, which
+        // controllers may track.
+        const int numWorkers = 
+            std::max(1, std::min(numThreads, (int)cases.size()));
+        std::vector<ForwardWorker> workers(numWorkers);
+        for(ForwardWorker& worker : workers) {
+            worker.model.reset(_model->clone());
+            // Only the tool's own copy of the model reports results.
+            worker.model->updAnalysisSet().clearAndDestroy();
+            if(_yStore) worker.yStore.reset(new Storage(*_yStore));
+        }
+        if(!combineResults) IO::makeDir(getResultsDir());
+
+        std::vector<ForwardCaseResult> results(cases.size());
+        ForwardCaseTask task(*this, workers, cases, results, initialStates,
+                             startIndexForYStore, timeSteps, combineResults);
+        SimTK::ParallelExecutor executor(numWorkers);
+        executor.execute(task, (int)cases.size());
+
+        for(size_t i=0; i<cases.size(); ++i) {
+            if(results[i].errorMessage.empty()) {
+                ++numCompleted;
+                continue;
+            }
+            cout << "ForwardTool::runBatch() case " << cases[i].name 
+                 << " failed: " << results[i].errorMessage << endl;
+            results[i].y.resize(numStateVariables);
+            results[i].y = SimTK::NaN;
+        }
+
+        if(combineResults) {
+            Storage finalStates(cases.size(), getName() + "_batch_states");
+            // Cases are numbered in the first column, since they may all end
+            // at the same time.
+            Array<std::string> labels("case", 1);
+            labels.append("final_time");
+            labels.append(_model->getStateVariableNames());
+            finalStates.setColumnLabels(labels);
+            for(size_t i=0; i<results.size(); ++i) {
+                SimTK::Vector row(1 + results[i].y.size());
+                row[0] = results[i].time;
+                row(1, results[i].y.size()) = results[i].y;
+                finalStates.append((double)i, row);
+            }
+            IO::makeDir(getResultsDir());
+            finalStates.print(getResultsDir() + "/" + getName() 
+                              + "_batch_states.sto");
+        }
+    } catch(...) {
+        IO::chDir(saveWorkingDirectory);
+        throw;
+    }
+    IO::chDir(saveWorkingDirectory);
+
+    cout << numCompleted << " of " << cases.size() << " cases completed." 
+         << endl;
+    return numCompleted;
+}
+
 //=============================================================================
 // UTILITY
 //=============================================================================
@@ -35,6 +35,9 @@
 #include <OpenSim/Simulation/Model/AbstractTool.h>
 
 #include "osimToolsDLL.h"
+#include <map>
+#include <string>
+#include <vector>
 
 #ifdef SWIG
     #ifdef OSIMTOOLS_API
@@ -49,6 +52,30 @@ class Body;
 class PrescribedForce;
 class ControlSet;
 
+#ifndef SWIG
+//=============================================================================
+/**
+ * One simulation of a batch run by ForwardTool::runBatch(). A case starts
+ * from the tool's model, initial time and initial states and applies its own
+ * changes to them.
+ */
+struct ForwardCase {
+    /** Identifies the case in the names of its result files. */
+    std::string name;
+    /** Initial values of state variables, by state variable name, replacing
+    those taken from the states file or the model's defaults. */
+    std::map<std::string, double> stateValues;
+    /** Property values, written as they would be in a model file, keyed by
+    the path of the component followed by the property name (e.g.,
+    "TRIlong/max_isometric_force"). A property name alone refers to a
+    property of the model itself. */
+    std::map<std::string, std::string> propertyValues;
+    /** A controls (.xml) file whose controls are applied to the model's
+    actuators, by an additional ControlSetController, in this case. */
+    std::string controlsFileName;
+};
+#endif
+
 
 //=============================================================================
 //=============================================================================
@@ -135,6 +162,24 @@ public:
     //--------------------------------------------------------------------------
     bool run() override SWIG_DECLARE_EXCEPTION;
     void printResults();
+#ifndef SWIG
+    /** Run one forward simulation for each of the cases, distributed over
+    numThreads threads. Each thread simulates its cases on its own copy of
+    the model, with its own state and integrator; a case that changes
+    properties or adds controls is simulated on a fresh copy of its thread's
+    model. The settings of the tool (times, integrator settings, states file,
+    external loads) apply to every case; the tool's analyses are not run.
+
+    If combineResults is false, the states of each case are printed to
+    <results_dir>/<name>_<case name>_states.sto. Otherwise the final states
+    of all the cases are printed to <results_dir>/<name>_batch_states.sto,
+    one row per case. Its first column holds the index of the case and its
+    second the time reached; the states of a case that did not complete are
+    NaN.
+    @returns the number of cases that completed. */
+    int runBatch(const std::vector<ForwardCase>& cases, int numThreads = 1,
+                 bool combineResults = false) SWIG_DECLARE_EXCEPTION;
+#endif
 
     //--------------------------------------------------------------------------
     // UTILITY
@@ -47,6 +47,9 @@
 
 #include "SimTKsimbody.h"
 
+#include <algorithm>
+#include <memory>
+#include <vector>
 
 using namespace OpenSim;
 using namespace std;
@@ -77,7 +80,8 @@ InverseKinematicsTool::InverseKinematicsTool() : Tool(),
     _timeRange(_timeRangeProp.getValueDblArray()),
     _reportErrors(_reportErrorsProp.getValueBool()),
     _outputMotionFileName(_outputMotionFileNameProp.getValueStr()),
-    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool())
+    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
 }
@@ -102,7 +106,8 @@ InverseKinematicsTool::InverseKinematicsTool(const string &aFileName, bool aLoad
     _timeRange(_timeRangeProp.getValueDblArray()),
     _reportErrors(_reportErrorsProp.getValueBool()),
     _outputMotionFileName(_outputMotionFileNameProp.getValueStr()),
-    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool())
+    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
     updateFromXMLDocument();
@@ -130,7 +135,8 @@ InverseKinematicsTool::InverseKinematicsTool(const InverseKinematicsTool &aTool)
     _timeRange(_timeRangeProp.getValueDblArray()),
     _reportErrors(_reportErrorsProp.getValueBool()),
     _outputMotionFileName(_outputMotionFileNameProp.getValueStr()),
-    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool())
+    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
     *this = aTool;
@@ -202,6 +208,13 @@ void InverseKinematicsTool::setupProperties()
     _reportMarkerLocationsProp.setValue(false);
     _propertySet.append(&_reportMarkerLocationsProp);
 
+    _numThreadsProp.setComment("Number of threads used to solve the inverse kinematics problem. "
+        "The time range is split into contiguous chunks of frames that are solved concurrently "
+        "on separate copies of the model. The default of 1 solves all frames serially.");
+    _numThreadsProp.setName("num_threads");
+    _numThreadsProp.setValue(1);
+    _propertySet.append(&_numThreadsProp);
+
 }
 
 //_____________________________________________________________________________
@@ -239,6 +252,7 @@ operator=(const InverseKinematicsTool &aTool)
     _reportErrors = aTool._reportErrors;
     _outputMotionFileName = aTool._outputMotionFileName;
     _reportMarkerLocations = aTool._reportMarkerLocations;
+    _numThreads = aTool._numThreads;
 
     return(*this);
 }
@@ -248,6 +262,76 @@ operator=(const InverseKinematicsTool &aTool)
 //=============================================================================
 
 
+//=============================================================================
+// PARALLEL SOLUTION
+//=============================================================================
+namespace {
+/** Solution of a single frame, kept so that frames solved concurrently can be
+    reported in time order afterwards. */
+struct IKFrameSolution {
+    SimTK::Vector q;
+    SimTK::Vector u;
+    SimTK::Array_<double> squaredMarkerErrors;
+    SimTK::Array_<Vec3> markerLocations;
+};
+
+/** A contiguous range of frames solved on its own copy of the model. */
+struct IKChunk {
+    std::unique_ptr<Model> model;
+    std::unique_ptr<InverseKinematicsSolver> solver;
+    SimTK::Array_<CoordinateReference> coordinateReferences;
+    int firstFrame;
+    int lastFrame;
+    std::string errorMessage;
+};
+
+class IKChunkTask : public SimTK::ParallelExecutor::Task {
+public:
+    IKChunkTask(std::vector<IKChunk>& chunks,
+                std::vector<IKFrameSolution>& solutions,
+                double startTime, double dt, bool reportErrors, 
+                bool reportMarkerLocations) :
+        _chunks(chunks), _solutions(solutions), _startTime(startTime), _dt(dt),
+        _reportErrors(reportErrors), 
+        _reportMarkerLocations(reportMarkerLocations) {}
+
+    void execute(int index) override {
+        IKChunk& chunk = _chunks[index];
+        try {
+            SimTK::State& s = chunk.model->updWorkingState();
+            // Warm start the chunk by assembling at its first frame.
+            s.updTime() = _startTime + chunk.firstFrame*_dt;
+            chunk.solver->assemble(s);
+            for (int i = chunk.firstFrame; i <= chunk.lastFrame; ++i) {
+                s.updTime() = _startTime + i*_dt;
+                chunk.solver->track(s);
+                IKFrameSolution& solution = _solutions[i];
+                solution.q = s.getQ();
+                solution.u = s.getU();
+                if (_reportErrors)
+                    chunk.solver->computeCurrentSquaredMarkerErrors(
+                        solution.squaredMarkerErrors);
+                if (_reportMarkerLocations)
+                    chunk.solver->computeCurrentMarkerLocations(
+                        solution.markerLocations);
+            }
+        }
+        catch (const std::exception& ex) {
+            // Exceptions must not escape a worker thread.
+            chunk.errorMessage = ex.what();
+        }
+    }
+
+private:
+    std::vector<IKChunk>& _chunks;
+    std::vector<IKFrameSolution>& _solutions;
+    double _startTime;
+    double _dt;
+    bool _reportErrors;
+    bool _reportMarkerLocations;
+};
+} // anonymous namespace
+
 //=============================================================================
 // RUN
 //=============================================================================
@@ -373,16 +457,68 @@ bool InverseKinematicsTool::run()
         
         Storage *modelMarkerLocations = _reportMarkerLocations ? new Storage(Nframes, "ModelMarkerLocations") : NULL;
 
+        // Solve contiguous chunks of frames concurrently, each on its own copy
+        // of the model and solver. The solutions are reported below in time
+        // order exactly as if they had been tracked serially.
+        int numThreads = std::min(_numThreads, Nframes);
+        std::vector<IKFrameSolution> frameSolutions;
+        if (numThreads > 1) {
+            cout << "Solving " << Nframes << " frames using " << numThreads 
+                 << " threads." << endl;
+            frameSolutions.resize(Nframes);
+            std::vector<IKChunk> chunks(numThreads);
+            for (int c = 0; c < numThreads; ++c) {
+                IKChunk& chunk = chunks[c];
+                chunk.firstFrame = (c*Nframes)/numThreads;
+                chunk.lastFrame = ((c+1)*Nframes)/numThreads - 1;
+                chunk.model.reset(_model->clone());
+                // Only the tool's own copy of the model reports results.
+                chunk.model->updAnalysisSet().clearAndDestroy();
+                chunk.model->initSystem();
+                chunk.coordinateReferences = coordinateReferences;
+                chunk.solver.reset(new InverseKinematicsSolver(*chunk.model, 
+                    markersReference, chunk.coordinateReferences, 
+                    _constraintWeight));
+                chunk.solver->setAccuracy(_accuracy);
+            }
+
+            IKChunkTask task(chunks, frameSolutions, start_time, dt, 
+                             _reportErrors, _reportMarkerLocations);
+            SimTK::ParallelExecutor executor(numThreads);
+            executor.execute(task, numThreads);
+
+            for (int c = 0; c < numThreads; ++c) {
+                if (!chunks[c].errorMessage.empty())
+                    throw Exception("InverseKinematicsTool: frames " 
+                        + std::to_string(chunks[c].firstFrame) + " to " 
+                        + std::to_string(chunks[c].lastFrame) + " failed: "
+                        + chunks[c].errorMessage);
+            }
+        }
+
         for (int i = 0; i < Nframes; i++) {
             s.updTime() = start_time + i*dt;
-            ikSolver.track(s);
+            if (numThreads > 1) {
+                const IKFrameSolution& solution = frameSolutions[i];
+                s.updQ() = solution.q;
+                s.updU() = solution.u;
+                squaredMarkerErrors = solution.squaredMarkerErrors;
+                markerLocations = solution.markerLocations;
+                _model->getMultibodySystem().realize(s, SimTK::Stage::Position);
+            }
+            else {
+                ikSolver.track(s);
+                if (_reportErrors)
+                    ikSolver.computeCurrentSquaredMarkerErrors(squaredMarkerErrors);
+                if (_reportMarkerLocations)
+                    ikSolver.computeCurrentMarkerLocations(markerLocations);
+            }
             
             if(_reportErrors){
                 double totalSquaredMarkerError = 0.0;
                 double maxSquaredMarkerError = 0.0;
                 int worst = -1;
 
-                ikSolver.computeCurrentSquaredMarkerErrors(squaredMarkerErrors);
                 for(int j=0; j<nm; ++j){
                     totalSquaredMarkerError += squaredMarkerErrors[j];
                     if(squaredMarkerErrors[j] > maxSquaredMarkerError){
@@ -397,7 +533,6 @@ bool InverseKinematicsTool::run()
             }
 
             if(_reportMarkerLocations){
-                ikSolver.computeCurrentMarkerLocations(markerLocations);
                 Array<double> locations(0.0, 3*nm);
                 for(int j=0; j<nm; ++j){
                     for(int k=0; k<3; ++k)
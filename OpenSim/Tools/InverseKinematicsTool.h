@@ -29,6 +29,7 @@
 #include <OpenSim/Common/PropertyDbl.h>
 #include <OpenSim/Common/PropertyStr.h>
 #include <OpenSim/Common/PropertyDblArray.h>
+#include <OpenSim/Common/PropertyInt.h>
 #include "Tool.h"
 
 #ifdef SWIG
@@ -108,6 +109,10 @@ private:
     PropertyBool _reportMarkerLocationsProp;
     bool &_reportMarkerLocations;
 
+    // number of threads used to solve contiguous chunks of frames
+    PropertyInt _numThreadsProp;
+    int &_numThreads;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -138,6 +143,11 @@ public:
 
     void setCoordinateFileName(const std::string& coordDataFileName) { _coordinateFileName=coordDataFileName;};
     const std::string& getCoordinateFileName() const { return  _coordinateFileName;};
+
+    /** Solve the frames in numThreads contiguous chunks, each on its own copy
+        of the model. A value of 1 (the default) solves frames serially. */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; };
+    int getNumThreads() const { return _numThreads; };
     
     //const OpenSim::Storage& getOutputStorage() const;
 private:
@@ -389,7 +389,6 @@ bool MarkerPlacer::processModel(Model* aModel, const string& aPathToSubject)
 void MarkerPlacer::moveModelMarkersToPose(SimTK::State& s, Model& aModel, MarkerData& aPose)
 {
     aPose.averageFrames(0.01);
-    const MarkerFrame &frame = aPose.getFrame(0);
 
     const SimbodyEngine& engine = aModel.getSimbodyEngine();
 
@@ -405,7 +404,7 @@ void MarkerPlacer::moveModelMarkersToPose(SimTK::State& s, Model& aModel, Marker
             int index = aPose.getMarkerIndex(modelMarker.getName());
             if (index >= 0)
             {
-                Vec3 globalMarker = frame.getMarker(index);
+                Vec3 globalMarker = aPose.getMarker(0, index);
                 if (!globalMarker.isNaN())
                 {
                     Vec3 pt, pt2;
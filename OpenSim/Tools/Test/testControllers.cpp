@@ -28,6 +28,9 @@
 //  Tests Include:
 //      1. Test a control set controller on a block with an ideal actuator
 //      2. Test a corrective controller on a block with an ideal actuator
+//      3. Test that the values of a control set found with a shared node
+//         cursor are those of the individual controls
+//      4. Time a forward simulation driven by a large controls file
 //      
 //     Add tests here as new controller types are added to OpenSim
 //
@@ -39,6 +42,8 @@ using namespace OpenSim;
 using namespace std;
 
 void testControlSetControllerOnBlock();
+void testControlSetValues();
+void benchmarkControlSetController(int numActuators, int numRows);
 void testPrescribedControllerOnBlock(bool disabled);
 void testCorrectionControllerOnBlock();
 void testPrescribedControllerFromFile(const std::string& modelFile,
@@ -50,6 +55,8 @@ int main()
     try {
         cout << "Testing ControlSetController" << endl; 
         testControlSetControllerOnBlock();
+        testControlSetValues();
+        benchmarkControlSetController(100, 5000);
         cout << "Testing PrescribedController" << endl; 
         testPrescribedControllerOnBlock(false);
         testPrescribedControllerOnBlock(true);
@@ -163,6 +170,130 @@ void testControlSetControllerOnBlock()
 }// end of testControlSetControllerOnBlock()
 
 
+//==========================================================================================================
+// Build a storage of numColumns controls named act0, act1, ..., with the
+// value of control j at time t being sin(t + j)/(j + 1).
+Storage createControlsStorage(int numColumns, int numRows, double finalTime)
+{
+    Storage controls(numRows);
+    Array<string> labels;
+    labels.append("time");
+    for (int j = 0; j < numColumns; ++j)
+        labels.append("act" + to_string(j));
+    controls.setColumnLabels(labels);
+    Array<double> row(0.0, numColumns);
+    for (int i = 0; i < numRows; ++i) {
+        double t = finalTime*i/(numRows - 1);
+        for (int j = 0; j < numColumns; ++j)
+            row[j] = sin(t + j)/(j + 1);
+        controls.append(t, row);
+    }
+    return controls;
+}
+
+void testControlSetValues()
+{
+    ControlSet controlSet(createControlsStorage(12, 200, 1.0));
+
+    // Controls with other node times, held in steps, or not extrapolated.
+    ControlLinear* other = new ControlLinear();
+    other->setName("other");
+    for (int i = 0; i < 7; ++i)
+        other->setControlValue(0.17*i, i%2);
+    controlSet.adoptAndAppend(other);
+    ControlLinear* steps = dynamic_cast<ControlLinear*>(controlSet.get(3).clone());
+    steps->setName("steps");
+    steps->setUseSteps(true);
+    controlSet.adoptAndAppend(steps);
+    ControlLinear* constant = dynamic_cast<ControlLinear*>(controlSet.get(4).clone());
+    constant->setName("constant");
+    constant->setExtrapolate(false);
+    controlSet.adoptAndAppend(constant);
+
+    // Forward and backward, on and between the nodes, and beyond them.
+    std::vector<double> times;
+    for (int i = -20; i < 220; ++i) times.push_back(i/199.0);
+    for (int i = 219; i >= -20; i -= 3) times.push_back(i/199.0 + 0.001);
+    for (int i = 0; i < 100; ++i) times.push_back(0.01*((37*i)%101));
+
+    int n = controlSet.getSize(false);
+    std::vector<double> values(n);
+    for (double t : times) {
+        controlSet.getControlValues(t, &values[0], false);
+        for (int j = 0; j < n; ++j)
+            ASSERT(values[j] == controlSet.get(j).getControlValue(t),
+                __FILE__, __LINE__, "ControlSet::getControlValues() differs"
+                " from Control::getControlValue() for " + 
+                controlSet.get(j).getName());
+    }
+    cout << "testControlSetValues passed" << endl;
+}
+
+// Time a forward simulation of a block pushed by numActuators actuators,
+// each driven by a column of a controls file of numRows rows.
+void benchmarkControlSetController(int numActuators, int numRows)
+{
+    using namespace SimTK;
+
+    const double finalTime = 1.0;
+    const string controlsFile = "testControllers_benchmark_controls.sto";
+    createControlsStorage(numActuators, numRows, finalTime).print(controlsFile);
+
+    Model osimModel;
+    osimModel.setName("blockWithManyActuators");
+    OpenSim::Body* block = new OpenSim::Body("block", 20.0, Vec3(0), 
+        20.0*Inertia::brick(0.1, 0.1, 0.1));
+    SliderJoint* slider = new SliderJoint("slider", osimModel.getGround(), 
+        Vec3(0), Vec3(0), *block, Vec3(0), Vec3(0));
+    slider->upd_CoordinateSet()[0].setName("x");
+    osimModel.addBody(block);
+    osimModel.addJoint(slider);
+    for (int j = 0; j < numActuators; ++j) {
+        CoordinateActuator* actuator = new CoordinateActuator("x");
+        actuator->setName("act" + to_string(j));
+        osimModel.addForce(actuator);
+    }
+    ControlSetController* controller = new ControlSetController();
+    // The controller takes its actuators from the names of the controls.
+    controller->setControlSetFileName(controlsFile);
+    osimModel.addController(controller);
+
+    SimTK::State& s = osimModel.initSystem();
+
+    // Computing the controls alone.
+    const int numCalls = 10000;
+    SimTK::Vector controls(osimModel.getNumControls(), 0.0);
+    double start = SimTK::realTime();
+    for (int i = 0; i < numCalls; ++i) {
+        s.updTime() = finalTime*i/numCalls;
+        controls = 0;
+        controller->computeControls(s, controls);
+    }
+    double computeTime = SimTK::realTime() - start;
+    s.updTime() = 0.5;
+    controls = 0;
+    controller->computeControls(s, controls);
+    for (int j = 0; j < numActuators; ++j)
+        ASSERT_EQUAL(sin(0.5 + j)/(j + 1), controls[j], 1e-3);
+
+    // A forward simulation.
+    s.updTime() = 0;
+    SimTK::RungeKuttaMersonIntegrator integrator(osimModel.getMultibodySystem());
+    integrator.setAccuracy(1.0e-5);
+    Manager manager(osimModel, integrator);
+    manager.setInitialTime(0);
+    manager.setFinalTime(finalTime);
+    start = SimTK::realTime();
+    manager.integrate(s);
+    double simulateTime = SimTK::realTime() - start;
+
+    cout << "ControlSetController with " << numActuators << " actuators and "
+         << numRows << " rows of controls: " << numCalls 
+         << " computeControls() calls in " << computeTime << "s, forward "
+         << "simulation (" << integrator.getNumStepsTaken() << " steps) in " 
+         << simulateTime << "s" << endl;
+}
+
 //==========================================================================================================
 void testPrescribedControllerOnBlock(bool disabled)
 {
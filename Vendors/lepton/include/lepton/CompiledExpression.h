@@ -77,6 +77,27 @@ public:
      * Evaluate the expression.  The values of all variables should have been set before calling this.
      */
     double evaluate() const;
+    /**
+     * Bind variables to consecutive slots, in the order given, so that their values can be passed to
+     * evaluate(const double*) and evaluateBatch() without looking them up by name.  Names of variables
+     * that the expression does not use are allowed; the values passed for them are ignored.
+     */
+    void bindVariables(const std::vector<std::string>& names);
+    /**
+     * Get the number of variables bound by bindVariables().
+     */
+    int getNumBoundVariables() const;
+    /**
+     * Evaluate the expression.  values[i] is the value of the i'th variable passed to bindVariables().
+     * Variables that were not bound keep the values they were last set to.
+     */
+    double evaluate(const double* values) const;
+    /**
+     * Evaluate the expression for count sets of values of the bound variables.  values[i] points to the
+     * count values of the i'th variable passed to bindVariables(), and results receives the count values
+     * of the expression.
+     */
+    void evaluateBatch(const double* const* values, int count, double* results) const;
 private:
     friend class ParsedExpression;
     CompiledExpression(const ParsedExpression& expression);
@@ -90,6 +111,7 @@ private:
     mutable std::vector<double> workspace;
     mutable std::vector<double> argValues;
     std::map<std::string, double> dummyVariables;
+    std::vector<int> boundIndices; // workspace index of each bound variable, or -1 if it is unused
     void* jitCode;
 #ifdef LEPTON_USE_JIT
     void generateJitCode();
@@ -72,6 +72,7 @@ CompiledExpression& CompiledExpression::operator=(const CompiledExpression& expr
     target = expression.target;
     variableIndices = expression.variableIndices;
     variableNames = expression.variableNames;
+    boundIndices = expression.boundIndices;
     workspace.resize(expression.workspace.size());
     argValues.resize(expression.argValues.size());
     operation.resize(expression.operation.size());
@@ -143,6 +144,34 @@ double& CompiledExpression::getVariableReference(const string& name) {
     return workspace[index->second];
 }
 
+void CompiledExpression::bindVariables(const vector<string>& names) {
+    boundIndices.resize(names.size());
+    for (int i = 0; i < (int) names.size(); i++) {
+        map<string, int>::const_iterator index = variableIndices.find(names[i]);
+        boundIndices[i] = (index == variableIndices.end() ? -1 : index->second);
+    }
+}
+
+int CompiledExpression::getNumBoundVariables() const {
+    return (int) boundIndices.size();
+}
+
+double CompiledExpression::evaluate(const double* values) const {
+    for (int i = 0; i < (int) boundIndices.size(); i++)
+        if (boundIndices[i] != -1)
+            workspace[boundIndices[i]] = values[i];
+    return evaluate();
+}
+
+void CompiledExpression::evaluateBatch(const double* const* values, int count, double* results) const {
+    for (int k = 0; k < count; k++) {
+        for (int i = 0; i < (int) boundIndices.size(); i++)
+            if (boundIndices[i] != -1)
+                workspace[boundIndices[i]] = values[i][k];
+        results[k] = evaluate();
+    }
+}
+
 double CompiledExpression::evaluate() const {
 #ifdef LEPTON_USE_JIT
     return ((double (*)()) jitCode)();
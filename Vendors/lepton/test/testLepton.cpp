@@ -39,6 +39,23 @@ int main() {
         value = Lepton::Parser::parse("sqrt(x)-1").evaluate(variables);
         ASSERT(fabs(value-2.) < 1E-7);
         Lepton::Parser::parse("state.muscle1.activation^2");
+        Lepton::CompiledExpression compiled = Lepton::Parser::parse("2*x-y^2").createCompiledExpression();
+        vector<string> names;
+        names.push_back("y");
+        names.push_back("unused");
+        names.push_back("x");
+        compiled.bindVariables(names);
+        ASSERT(compiled.getNumBoundVariables() == 3);
+        double slots[3] = {3.0, 100.0, 5.0};
+        ASSERT(fabs(compiled.evaluate(slots)-1.) < 1E-7);
+        double ys[3] = {0.0, 1.0, 2.0};
+        double unused[3] = {0.0, 0.0, 0.0};
+        double xs[3] = {1.0, 2.0, 3.0};
+        const double* columns[3] = {ys, unused, xs};
+        double results[3];
+        compiled.evaluateBatch(columns, 3, results);
+        for (int i = 0; i < 3; i++)
+            ASSERT(fabs(results[i]-(2*xs[i]-ys[i]*ys[i])) < 1E-7);
     }
     catch (...) {
         //cout << "Failed" << endl;